@@ -0,0 +1,614 @@
+//************************************************************/
+//
+//	Spectrum Benchmark Generator
+//
+//	Writes a synthetic, reproducible input set for benchmarking
+//	Spectrum (make bench) without the real grids and PDF sets:
+//
+//	 - APPLgrid grids of configurable size (observable bins, x and
+//	   Q2 nodes, sub-grids per plot), filled with events from a
+//	   fixed random sequence
+//	 - an analytic PDF set in LHAPDF6 (lhagrid1) format with any
+//	   number of error members
+//	 - data files with individual systematics, total correlation
+//	   matrices, and the data, grid, PDF and top-level steering
+//	   files tying them together
+//
+//	The same arguments always produce the same files.
+//
+//	@usage: SPXBenchGenerate --dir <dir> [--plots <n>] [--bins <n>]
+//	        [--grids <n>] [--members <n>] [--nx <n>] [--nq2 <n>]
+//	        [--events <n>] [--systematics <n>] [--seed <n>]
+//
+//	@Author: 	Spectrum contributors
+//	@Date:		19.10.2026
+//
+//************************************************************/
+
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include "TH1D.h"
+
+#include "appl_grid/appl_grid.h"
+
+//Centre of mass energy of the synthetic measurement [GeV]
+const double SQRT_S = 7000.0;
+
+//Observable (jet pT) range [GeV]
+const double OBS_MIN = 100.0;
+const double OBS_MAX = 2000.0;
+
+//Rapidity range of the synthetic jets
+const double Y_MAX = 1.0;
+
+//Number of nlojet subprocesses
+const int NLOJET_SUBPROCESSES = 7;
+
+typedef struct SPXBenchOptions_t {
+	std::string dir;
+	int plots;		// Plots in the top-level steering file
+	int bins;		// Observable bins of each grid and data set
+	int grids;		// Grids convoluted (and summed) per plot
+	int members;		// PDF members (central + 2 per eigenvector)
+	int nx;			// x nodes of each grid
+	int nq2;		// Q2 nodes of each grid
+	int events;		// Events filled into each grid
+	int systematics;	// Individual systematics of each data set
+	unsigned long seed;
+} SPXBenchOptions_t;
+
+//Deterministic random numbers (64 bit linear congruential generator), independent of the platform
+class SPXBenchRandom {
+public:
+	explicit SPXBenchRandom(unsigned long seed) : state(seed * 2862933555777941757ULL + 3037000493ULL) {}
+
+	//Uniform in [0, 1)
+	double Uniform(void) {
+		state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+		return (double)(state >> 11) / 9007199254740992.0;
+	}
+
+private:
+	unsigned long long state;
+};
+
+static void MakeDirectory(const std::string &path) {
+	if(mkdir(path.c_str(), 0755) != 0) {
+		struct stat st;
+		if(stat(path.c_str(), &st) != 0 || !S_ISDIR(st.st_mode)) {
+			std::cerr << "FATAL: Unable to create directory " << path << std::endl;
+			exit(-1);
+		}
+	}
+}
+
+static std::string Name(const std::string &prefix, int i) {
+	std::ostringstream oss;
+	oss << prefix << i;
+	return oss.str();
+}
+
+//Logarithmically spaced observable bin edges
+static std::vector<double> GetBinEdges(int bins) {
+	std::vector<double> edges(bins + 1);
+
+	for(int i = 0; i <= bins; i++) {
+		edges[i] = OBS_MIN * std::pow(OBS_MAX / OBS_MIN, (double)i / bins);
+	}
+
+	return edges;
+}
+
+//Steeply falling synthetic spectrum [pb/GeV]
+static double GetCrossSection(double pt) {
+	return 1.0e5 * std::pow(pt / OBS_MIN, -5.0) * std::exp(-pt / SQRT_S * 10.);
+}
+
+//=========================================================
+//   PDF set
+//=========================================================
+
+//x*f(x,Q) of the analytic PDF: member 0 is the central value, members 2k-1 and 2k shift eigenvector k up and down
+static double GetXF(int pid, double x, double q, int member) {
+	if(x >= 1.) {
+		return 0.;
+	}
+
+	double l = std::log(q / 10.);
+	double sea = 0.2 * std::pow(x, -0.15) * std::pow(1. - x, 7.) * (1. + 0.05 * l);
+	double xf = 0;
+
+	switch(std::abs(pid)) {
+		case 21:
+			xf = 2.0 * std::pow(x, -0.15) * std::pow(1. - x, 5.) * (1. + 0.05 * l);
+			break;
+		case 1:
+			xf = sea + (pid > 0 ? 1.0 * std::pow(x, 0.6) * std::pow(1. - x, 4.) * (1. - 0.02 * l) : 0.);
+			break;
+		case 2:
+			xf = sea + (pid > 0 ? 2.0 * std::pow(x, 0.6) * std::pow(1. - x, 3.) * (1. - 0.02 * l) : 0.);
+			break;
+		case 3:
+			xf = 0.5 * sea;
+			break;
+		default:
+			xf = 0.25 * sea;
+			break;
+	}
+
+	if(member > 0) {
+		int eigenvector = (member - 1) / 2;
+		double sign = (member % 2) ? 1. : -1.;
+		double size = 0.03 / (1. + 0.1 * eigenvector);
+		double shape;
+
+		switch(eigenvector % 3) {
+			case 0:  shape = 1. - x; break;
+			case 1:  shape = std::sqrt(x); break;
+			default: shape = l / 7.; break;
+		}
+
+		//Each eigenvector acts on a different flavour
+		if((eigenvector % 4) == 0 || std::abs(pid) % 4 == eigenvector % 4) {
+			xf *= 1. + sign * size * shape;
+		}
+	}
+
+	return xf;
+}
+
+//One loop running coupling, alpha_s(MZ) = 0.118
+static double GetAlphaS(double q) {
+	const double MZ = 91.1876;
+	const double ALPHAS_MZ = 0.118;
+	const double B0 = (33. - 2. * 5.) / (12. * M_PI);
+
+	return ALPHAS_MZ / (1. + ALPHAS_MZ * B0 * std::log(q * q / (MZ * MZ)));
+}
+
+static std::vector<double> GetLogKnots(double min, double max, int n) {
+	std::vector<double> knots(n);
+
+	for(int i = 0; i < n; i++) {
+		knots[i] = min * std::pow(max / min, (double)i / (n - 1));
+	}
+
+	//No rounding errors at the edges
+	knots[0] = min;
+	knots[n - 1] = max;
+
+	return knots;
+}
+
+static void WritePDFSet(const std::string &lhapdfDir, const std::string &name, int members) {
+	std::string dir = lhapdfDir + "/" + name;
+	MakeDirectory(dir);
+
+	const int pids[] = {-5, -4, -3, -2, -1, 1, 2, 3, 4, 5, 21};
+	const int npids = sizeof(pids) / sizeof(pids[0]);
+
+	std::vector<double> xs = GetLogKnots(1.0e-6, 1.0, 80);
+	std::vector<double> qs = GetLogKnots(1.0, 1.0e4, 50);
+
+	std::ofstream info((dir + "/" + name + ".info").c_str());
+	info << "SetDesc: \"Spectrum benchmark: analytic PDF with " << (members - 1) / 2 << " eigenvectors\"" << std::endl;
+	info << "Authors: Spectrum" << std::endl;
+	info << "Format: lhagrid1" << std::endl;
+	info << "DataVersion: 1" << std::endl;
+	info << "NumMembers: " << members << std::endl;
+	info << "Particle: 2212" << std::endl;
+	info << "Flavors: [";
+	for(int i = 0; i < npids; i++) info << (i ? ", " : "") << pids[i];
+	info << "]" << std::endl;
+	info << "OrderQCD: 1" << std::endl;
+	info << "ErrorType: hessian" << std::endl;
+	info << "XMin: " << xs.front() << std::endl;
+	info << "XMax: " << xs.back() << std::endl;
+	info << "QMin: " << qs.front() << std::endl;
+	info << "QMax: " << qs.back() << std::endl;
+	info << "MZ: 91.1876" << std::endl;
+	info << "MUp: 0" << std::endl << "MDown: 0" << std::endl << "MStrange: 0" << std::endl;
+	info << "MCharm: 1.4" << std::endl << "MBottom: 4.75" << std::endl << "MTop: 172.5" << std::endl;
+	info << "AlphaS_MZ: 0.118" << std::endl;
+	info << "AlphaS_OrderQCD: 1" << std::endl;
+	info << "AlphaS_Type: ipol" << std::endl;
+	info << std::scientific << std::setprecision(8);
+	info << "AlphaS_Qs: [";
+	for(int i = 0; i < qs.size(); i++) info << (i ? ", " : "") << qs[i];
+	info << "]" << std::endl;
+	info << "AlphaS_Vals: [";
+	for(int i = 0; i < qs.size(); i++) info << (i ? ", " : "") << GetAlphaS(qs[i]);
+	info << "]" << std::endl;
+	info.close();
+
+	for(int m = 0; m < members; m++) {
+		std::ostringstream filename;
+		filename << dir << "/" << name << "_" << std::setw(4) << std::setfill('0') << m << ".dat";
+
+		std::ofstream dat(filename.str().c_str());
+		dat << "PdfType: " << (m == 0 ? "central" : "error") << std::endl;
+		dat << "Format: lhagrid1" << std::endl;
+		dat << "---" << std::endl;
+		dat << std::scientific << std::setprecision(8);
+
+		for(int i = 0; i < xs.size(); i++) dat << (i ? " " : "") << xs[i];
+		dat << std::endl;
+		for(int i = 0; i < qs.size(); i++) dat << (i ? " " : "") << qs[i];
+		dat << std::endl;
+		for(int i = 0; i < npids; i++) dat << (i ? " " : "") << pids[i];
+		dat << std::endl;
+
+		//x varies slowest
+		for(int ix = 0; ix < xs.size(); ix++) {
+			for(int iq = 0; iq < qs.size(); iq++) {
+				for(int ip = 0; ip < npids; ip++) {
+					dat << (ip ? " " : "") << GetXF(pids[ip], xs[ix], qs[iq], m);
+				}
+				dat << std::endl;
+			}
+		}
+
+		dat << "---" << std::endl;
+		dat.close();
+	}
+}
+
+//=========================================================
+//   Grids
+//=========================================================
+
+//Synthetic dijet-like event: jet pT, rapidities, momentum fractions and subprocess weights (LO and NLO)
+static bool GetEvent(SPXBenchRandom &random, double &pt, double &x1, double &x2, double *lo, double *nlo) {
+	pt = OBS_MIN * std::pow(OBS_MAX / OBS_MIN, random.Uniform());
+
+	double y1 = Y_MAX * (2. * random.Uniform() - 1.);
+	double y2 = Y_MAX * (2. * random.Uniform() - 1.);
+
+	x1 = pt / SQRT_S * (std::exp(y1) + std::exp(y2));
+	x2 = pt / SQRT_S * (std::exp(-y1) + std::exp(-y2));
+
+	//The random numbers of the weights are always drawn: both fill passes see the same sequence
+	double w = std::pow(pt / OBS_MIN, -4.);
+	for(int i = 0; i < NLOJET_SUBPROCESSES; i++) {
+		lo[i] = w * (0.5 + random.Uniform()) / (1. + i);
+		nlo[i] = lo[i] * (0.2 * random.Uniform() - 0.05);
+	}
+
+	return (x1 < 1.) && (x2 < 1.);
+}
+
+static void FillGrid(appl::grid &grid, unsigned long seed, int events) {
+	SPXBenchRandom random(seed);
+
+	double lo[NLOJET_SUBPROCESSES];
+	double nlo[NLOJET_SUBPROCESSES];
+	double pt, x1, x2;
+
+	for(int i = 0; i < events; i++) {
+		if(!GetEvent(random, pt, x1, x2, lo, nlo)) {
+			continue;
+		}
+
+		grid.fill(x1, x2, pt * pt, pt, lo, 0);
+		grid.fill(x1, x2, pt * pt, pt, nlo, 1);
+	}
+}
+
+static void WriteGrid(const std::string &filename, const SPXBenchOptions_t &o, unsigned long seed) {
+	std::vector<double> edges = GetBinEdges(o.bins);
+
+	double xmin = OBS_MIN / SQRT_S * 2. * std::exp(-Y_MAX);
+
+	appl::grid grid(o.bins, &edges[0], o.nq2, OBS_MIN * OBS_MIN, OBS_MAX * OBS_MAX, 5, o.nx, xmin, 1., 5, "nlojet", 2, 1);
+
+	//First pass: phase space, to optimise the x and Q2 ranges; second pass: the weights
+	FillGrid(grid, seed, o.events);
+	grid.optimise();
+	FillGrid(grid, seed, o.events);
+
+	//Reference: sum of the LO weights (no PDF)
+	SPXBenchRandom random(seed);
+	double lo[NLOJET_SUBPROCESSES];
+	double nlo[NLOJET_SUBPROCESSES];
+	double pt, x1, x2;
+	for(int i = 0; i < o.events; i++) {
+		if(!GetEvent(random, pt, x1, x2, lo, nlo)) continue;
+
+		double sum = 0;
+		for(int j = 0; j < NLOJET_SUBPROCESSES; j++) sum += lo[j];
+		grid.getReference()->Fill(pt, sum);
+	}
+
+	grid.run() = o.events;
+	grid.Write(filename);
+}
+
+//=========================================================
+//   Data
+//=========================================================
+
+static void WriteData(const std::string &dataDir, const std::string &name, const SPXBenchOptions_t &o, unsigned long seed) {
+	std::vector<double> edges = GetBinEdges(o.bins);
+	SPXBenchRandom random(seed);
+
+	//Data: x xlow xhigh sigma stat syst+ syst-, errors in percent
+	std::ofstream data((dataDir + "/" + name + "_data.txt").c_str());
+	data << ";Spectrum benchmark: synthetic inclusive jet cross section" << std::endl;
+	data << ";x\txlow\txhigh\ty\tstat\tsyst+\tsyst-" << std::endl;
+	data << std::setprecision(6);
+
+	std::vector<std::vector<double> > syst(o.systematics, std::vector<double>(o.bins));
+	std::vector<double> total(o.bins, 0.);
+
+	for(int s = 0; s < o.systematics; s++) {
+		double size = 0.5 + 4. * random.Uniform();
+		double slope = random.Uniform() - 0.5;
+
+		for(int i = 0; i < o.bins; i++) {
+			double t = (double)i / (o.bins > 1 ? o.bins - 1 : 1);
+			syst[s][i] = size * (1. + slope * t);
+			total[i] += syst[s][i] * syst[s][i];
+		}
+	}
+
+	for(int i = 0; i < o.bins; i++) {
+		double x = std::sqrt(edges[i] * edges[i + 1]);
+		double stat = 0.5 + 10. * std::pow((double)i / o.bins, 3.);
+		double sigma = GetCrossSection(x) * (1. + 0.02 * (random.Uniform() - 0.5));
+
+		data << x << "\t" << edges[i] << "\t" << edges[i + 1] << "\t" << sigma << "\t" << stat << "\t"
+		     << std::sqrt(total[i]) << "\t" << std::sqrt(total[i]) << std::endl;
+	}
+
+	for(int s = 0; s < o.systematics; s++) {
+		for(int sign = 0; sign < 2; sign++) {
+			data << "syst_bench" << s << (sign ? "-" : "+");
+			for(int i = 0; i < o.bins; i++) {
+				data << " " << (sign ? -syst[s][i] : syst[s][i]);
+			}
+			data << std::endl;
+		}
+	}
+	data.close();
+
+	//Total correlation: rho^|i-j| is positive definite for |rho| < 1
+	std::ofstream corr((dataDir + "/" + name + "_corr.txt").c_str());
+	corr << ";Spectrum benchmark: total correlation matrix" << std::endl;
+	corr << "is_correlation_matrix" << std::endl;
+	corr << "is_totalerror" << std::endl;
+	corr << std::setprecision(6);
+	for(int i = 0; i < o.bins; i++) {
+		for(int j = 0; j < o.bins; j++) {
+			corr << (j ? " " : "") << std::pow(0.7, std::abs(i - j));
+		}
+		corr << std::endl;
+	}
+	corr.close();
+
+	std::ofstream steering((dataDir + "/" + name + ".txt").c_str());
+	steering << ";Spectrum benchmark data steering file" << std::endl;
+	steering << "[GEN]" << std::endl;
+	steering << "debug = false" << std::endl;
+	steering << "[DESC]" << std::endl;
+	steering << "comments = Synthetic benchmark data" << std::endl;
+	steering << "data_set_year = 2026" << std::endl;
+	steering << "data_set_lumi = 1 fb^{-1}" << std::endl;
+	steering << "publication_status = internal" << std::endl;
+	steering << "experiment = BENCH" << std::endl;
+	steering << "[GRAPH]" << std::endl;
+	steering << "sqrt_s = " << SQRT_S << std::endl;
+	steering << "legend_label = Benchmark" << std::endl;
+	steering << "x_label = p_{T,jet} [GeV]" << std::endl;
+	steering << "y_label = d#sigma/dp_{T,jet} [pb/GeV]" << std::endl;
+	steering << "x_units = GeV" << std::endl;
+	steering << "y_units = pb" << std::endl;
+	steering << "y_bin_width_units = GeV" << std::endl;
+	steering << "[DATA]" << std::endl;
+	steering << "data_format = spectrum" << std::endl;
+	steering << "data_file = " << name << "_data.txt" << std::endl;
+	steering << "corr_total_file_name = " << name << "_corr.txt" << std::endl;
+	steering << "divided_by_bin_width = true" << std::endl;
+	steering << "error_in_percent = true" << std::endl;
+	steering << "lumi_scale_factor = 1.0" << std::endl;
+	steering.close();
+}
+
+//=========================================================
+//   Steering
+//=========================================================
+
+static void WriteGridSteering(const std::string &gridDir, const std::string &name, const std::vector<std::string> &files) {
+	std::ofstream steering((gridDir + "/" + name + ".txt").c_str());
+	steering << ";Spectrum benchmark grid steering file" << std::endl;
+	steering << "[GEN]" << std::endl;
+	steering << "debug = false" << std::endl;
+	steering << "[DESC]" << std::endl;
+	steering << "name = " << name << std::endl;
+	steering << "author = Spectrum benchmark" << std::endl;
+	steering << "scale = p_{T,jet}" << std::endl;
+	steering << "nlo_program_name = SPXBenchGenerate" << std::endl;
+	steering << "grid_program_name = APPLgrid" << std::endl;
+	steering << "[GRAPH]" << std::endl;
+	steering << "x_units = GeV" << std::endl;
+	steering << "y_units = pb" << std::endl;
+	steering << "grid_divided_by_bin_width = false" << std::endl;
+	steering << "[GRID]" << std::endl;
+	steering << "grid_file = ";
+	for(int i = 0; i < files.size(); i++) steering << (i ? ", " : "") << files[i];
+	steering << std::endl;
+	steering << "lowest_order = 2" << std::endl;
+	steering.close();
+}
+
+static void WritePDFSteering(const std::string &pdfDir, const std::string &set, int members) {
+	std::ofstream steering((pdfDir + "/" + set + ".txt").c_str());
+	steering << ";Spectrum benchmark PDF steering file" << std::endl;
+	steering << "[GEN]" << std::endl;
+	steering << "debug = false" << std::endl;
+	steering << "[DESC]" << std::endl;
+	steering << "name = " << set << std::endl;
+	steering << "type = " << set << std::endl;
+	steering << "order = 1" << std::endl;
+	steering << "num_members = " << members << std::endl;
+	steering << "[STYLE]" << std::endl;
+	steering << "fill_style = 3005" << std::endl;
+	steering << "fill_color = 797" << std::endl;
+	steering << "marker_style = 20" << std::endl;
+	steering << "[PDF]" << std::endl;
+	steering << "default_id = 0" << std::endl;
+	steering << "default_id_var = 0" << std::endl;
+	steering << "band_type = use_error_band" << std::endl;
+	steering << "ErrorPropagationType = 1" << std::endl;
+	steering << "error_type = pdf_band" << std::endl;
+	steering << "error_size = one_sigma" << std::endl;
+	steering.close();
+}
+
+static void WriteTopLevelSteering(const std::string &filename, const std::string &set, const SPXBenchOptions_t &o) {
+	std::ofstream steering(filename.c_str());
+	steering << ";Spectrum benchmark steering file: " << o.plots << " plots, " << o.bins << " bins, " << o.grids
+	         << " grids, " << o.members << " PDF members" << std::endl;
+	steering << "[GEN]" << std::endl;
+	steering << "debug = false" << std::endl;
+	steering << "output_rootfile = true" << std::endl;
+	steering << "output_graphicformat = png" << std::endl;
+	steering << "[GRAPH]" << std::endl;
+	steering << "plot_marker = true" << std::endl;
+	steering << "match_binning = true" << std::endl;
+	steering << "band_with_pdf = true" << std::endl;
+	steering << "label_chi2 = true" << std::endl;
+	steering << "x_legend = 0.9" << std::endl;
+	steering << "y_legend = 0.9" << std::endl;
+
+	for(int p = 0; p < o.plots; p++) {
+		steering << "[PLOT_" << p << "]" << std::endl;
+		steering << "plot_type = data, grid, pdf" << std::endl;
+		steering << "desc = bench_plot" << p << std::endl;
+		steering << "data_directory = Data" << std::endl;
+		steering << "grid_directory = Grids" << std::endl;
+		steering << "pdf_directory = PDF" << std::endl;
+		steering << "data_steering_files = " << Name("bench_data", p) << ".txt" << std::endl;
+		steering << "grid_steering_files = " << Name("bench_grid", p) << ".txt" << std::endl;
+		steering << "pdf_steering_files = " << set << ".txt" << std::endl;
+		steering << "data_marker_style = 20" << std::endl;
+		steering << "data_marker_color = 1" << std::endl;
+		steering << "pdf_fill_style = 3005" << std::endl;
+		steering << "pdf_fill_color = 797" << std::endl;
+		steering << "pdf_marker_style = 20" << std::endl;
+		steering << "x_log = true" << std::endl;
+		steering << "y_log = true" << std::endl;
+		steering << "display_style = overlay, ratio" << std::endl;
+		steering << "overlay_style = data, convolute" << std::endl;
+		steering << "ratio_title = Theory / Data" << std::endl;
+		steering << "ratio_style_0 = data_tot" << std::endl;
+		steering << "ratio_0 = data_0" << std::endl;
+		steering << "ratio_style_1 = convolute / data" << std::endl;
+		steering << "ratio_1 = ([grid_0, pdf_0]) / (data_0)" << std::endl;
+	}
+
+	steering.close();
+}
+
+//=========================================================
+//   Main
+//=========================================================
+
+static void Usage(void) {
+	std::cout << "@usage: SPXBenchGenerate --dir <dir> [--plots <n>] [--bins <n>] [--grids <n>] [--members <n>]" << std::endl;
+	std::cout << "        [--nx <n>] [--nq2 <n>] [--events <n>] [--systematics <n>] [--seed <n>]" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+	SPXBenchOptions_t o;
+	o.plots = 1;
+	o.bins = 20;
+	o.grids = 1;
+	o.members = 21;
+	o.nx = 30;
+	o.nq2 = 20;
+	o.events = 100000;
+	o.systematics = 10;
+	o.seed = 1;
+
+	for(int i = 1; i < argc; i++) {
+		std::string arg = std::string(argv[i]);
+
+		if(i + 1 >= argc) {
+			Usage();
+			exit(-1);
+		}
+
+		std::string value = std::string(argv[++i]);
+
+		if(!arg.compare("--dir")) o.dir = value;
+		else if(!arg.compare("--plots")) o.plots = atoi(value.c_str());
+		else if(!arg.compare("--bins")) o.bins = atoi(value.c_str());
+		else if(!arg.compare("--grids")) o.grids = atoi(value.c_str());
+		else if(!arg.compare("--members")) o.members = atoi(value.c_str());
+		else if(!arg.compare("--nx")) o.nx = atoi(value.c_str());
+		else if(!arg.compare("--nq2")) o.nq2 = atoi(value.c_str());
+		else if(!arg.compare("--events")) o.events = atoi(value.c_str());
+		else if(!arg.compare("--systematics")) o.systematics = atoi(value.c_str());
+		else if(!arg.compare("--seed")) o.seed = strtoul(value.c_str(), 0, 10);
+		else {
+			Usage();
+			exit(-1);
+		}
+	}
+
+	if(o.dir.empty() || o.plots < 1 || o.bins < 1 || o.grids < 1 || o.members < 1 || o.nx < 6 || o.nq2 < 6 || o.events < 1 || o.systematics < 0) {
+		Usage();
+		exit(-1);
+	}
+
+	//Central member and pairs of eigenvector members
+	if(o.members % 2 == 0) {
+		o.members++;
+		std::cout << "SPXBenchGenerate: Number of PDF members must be odd: using " << o.members << std::endl;
+	}
+
+	//The set name carries the number of members: results of a sweep are never read from another set
+	std::string set = Name("SPXBench_m", o.members);
+
+	MakeDirectory(o.dir);
+	MakeDirectory(o.dir + "/LHAPDF");
+	MakeDirectory(o.dir + "/PDF");
+	MakeDirectory(o.dir + "/Data");
+	MakeDirectory(o.dir + "/Grids");
+
+	std::cout << "SPXBenchGenerate: PDF set " << set << " (" << o.members << " members)" << std::endl;
+	WritePDFSet(o.dir + "/LHAPDF", set, o.members);
+	WritePDFSteering(o.dir + "/PDF", set, o.members);
+
+	for(int p = 0; p < o.plots; p++) {
+		std::vector<std::string> files;
+
+		for(int g = 0; g < o.grids; g++) {
+			std::ostringstream file;
+			file << "bench_grid" << p << "_" << g << ".root";
+			files.push_back(file.str());
+
+			std::cout << "SPXBenchGenerate: Grid " << file.str() << " (" << o.bins << " bins, " << o.nx << " x " << o.nq2
+			          << " nodes, " << o.events << " events)" << std::endl;
+			WriteGrid(o.dir + "/Grids/" + file.str(), o, o.seed + 1000 * p + g);
+		}
+
+		WriteGridSteering(o.dir + "/Grids", Name("bench_grid", p), files);
+		WriteData(o.dir + "/Data", Name("bench_data", p), o, o.seed + 1000 * p + 999);
+	}
+
+	WriteTopLevelSteering(o.dir + "/bench.txt", set, o);
+
+	std::cout << "SPXBenchGenerate: Wrote " << o.dir << "/bench.txt" << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,71 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Compares two Spectrum benchmark results files (bench/run_bench.sh)
+#
+# usage: python bench/compare_bench.py <reference.csv> <new.csv> [threshold_percent] [min_ms]
+#
+# The median total time of every (config, stage) over the repeats is compared.
+# A stage is a regression if it is slower by more than threshold_percent (default 10)
+# and by more than min_ms (default 5 ms); the exit status is 1 if there is one.
+#
+import csv
+import sys
+
+def Median(values):
+ values=sorted(values)
+ n=len(values)
+ if n%2: return values[n//2]
+ return 0.5*(values[n//2-1]+values[n//2])
+
+def ReadResults(filename):
+ times={}
+ with open(filename) as f:
+  for row in csv.DictReader(f):
+   key=(row['config'],row['stage'])
+   times.setdefault(key,[]).append(float(row['total_ms']))
+ return dict((key,Median(values)) for key,values in times.items())
+
+if len(sys.argv)<3:
+ print('usage: python compare_bench.py <reference.csv> <new.csv> [threshold_percent] [min_ms]')
+ sys.exit(2)
+
+reference=ReadResults(sys.argv[1])
+new=ReadResults(sys.argv[2])
+threshold=float(sys.argv[3]) if len(sys.argv)>3 else 10.
+minms=float(sys.argv[4]) if len(sys.argv)>4 else 5.
+
+regressions=0
+
+print('%-40s %-14s %12s %12s %9s' % ('config','stage','ref [ms]','new [ms]','change'))
+for key in sorted(set(reference)|set(new)):
+ config,stage=key
+ if key not in reference or key not in new:
+  print('%-40s %-14s %12s %12s %9s' % (config,stage,
+        '%.1f' % reference[key] if key in reference else '-',
+        '%.1f' % new[key] if key in new else '-','missing'))
+  continue
+
+ old=reference[key]
+ delta=new[key]-old
+ flag=''
+
+ # no relative change from a zero reference time: only the absolute threshold applies
+ if old<=0.:
+  if delta>minms:
+   flag=' <-- REGRESSION'
+   regressions+=1
+  print('%-40s %-14s %12.1f %12.1f %9s%s' % (config,stage,old,new[key],'from 0',flag))
+  continue
+
+ percent=100.*delta/old
+ if percent>threshold and delta>minms:
+  flag=' <-- REGRESSION'
+  regressions+=1
+
+ print('%-40s %-14s %12.1f %12.1f %+8.1f%%%s' % (config,stage,old,new[key],percent,flag))
+
+print('')
+print('%d regression(s) above %.1f%% and %.1f ms' % (regressions,threshold,minms))
+
+sys.exit(1 if regressions else 0)
@@ -0,0 +1,125 @@
+#!/bin/bash
+#
+# Spectrum benchmark (make bench)
+#
+# Generates synthetic grids, PDF sets and data (SPXBenchGenerate) for
+# every point of a parameter sweep, runs Spectrum on each with
+# --timing, and appends the time of every stage to one CSV file:
+#
+#   config,plots,bins,grids,members,nx,nq2,events,repeat,stage,calls,total_ms,max_ms
+#
+# The sweep is set with environment variables (lists are space separated):
+#
+#   BENCH_PLOTS    plots per steering file       (default "1")
+#   BENCH_BINS     observable bins per plot      (default "10 50")
+#   BENCH_GRIDS    grids summed per plot         (default "1 4")
+#   BENCH_MEMBERS  PDF members                   (default "21 101")
+#   BENCH_NX       x nodes per grid              (default "30")
+#   BENCH_NQ2      Q2 nodes per grid             (default "20")
+#   BENCH_EVENTS   events filled per grid        (default "100000")
+#   BENCH_REPEAT   runs of each point            (default "3")
+#   BENCH_FLAGS    extra Spectrum flags          (default "-p")
+#   BENCH_WORK     generated inputs              (default bench/work)
+#   BENCH_OUTPUT   results file                  (default bench/results/bench_<date>.csv)
+#
+# Generated inputs are kept in BENCH_WORK and reused: the generator is
+# deterministic, so a point is only generated once.
+#
+# Compare two results files with:
+#   python bench/compare_bench.py <reference.csv> <new.csv>
+#
+
+BENCH_DIR=$(cd "$(dirname "$0")" && pwd)
+TOP_DIR=$(dirname "$BENCH_DIR")
+
+SPECTRUM="$TOP_DIR/Spectrum"
+GENERATE="$BENCH_DIR/SPXBenchGenerate"
+
+BENCH_PLOTS=${BENCH_PLOTS:-"1"}
+BENCH_BINS=${BENCH_BINS:-"10 50"}
+BENCH_GRIDS=${BENCH_GRIDS:-"1 4"}
+BENCH_MEMBERS=${BENCH_MEMBERS:-"21 101"}
+BENCH_NX=${BENCH_NX:-"30"}
+BENCH_NQ2=${BENCH_NQ2:-"20"}
+BENCH_EVENTS=${BENCH_EVENTS:-"100000"}
+BENCH_REPEAT=${BENCH_REPEAT:-3}
+BENCH_FLAGS=${BENCH_FLAGS:-"-p"}
+BENCH_WORK=${BENCH_WORK:-"$BENCH_DIR/work"}
+BENCH_OUTPUT=${BENCH_OUTPUT:-"$BENCH_DIR/results/bench_$(date +%Y%m%d_%H%M%S).csv"}
+
+if [ ! -x "$SPECTRUM" ]; then
+	echo "FATAL: $SPECTRUM not found: run make first"
+	exit 1
+fi
+
+if [ ! -x "$GENERATE" ]; then
+	echo "FATAL: $GENERATE not found: run make bench"
+	exit 1
+fi
+
+mkdir -p "$BENCH_WORK" "$(dirname "$BENCH_OUTPUT")"
+
+echo "config,plots,bins,grids,members,nx,nq2,events,repeat,stage,calls,total_ms,max_ms" > "$BENCH_OUTPUT"
+
+failures=0
+
+for plots in $BENCH_PLOTS; do
+for bins in $BENCH_BINS; do
+for grids in $BENCH_GRIDS; do
+for members in $BENCH_MEMBERS; do
+for nx in $BENCH_NX; do
+for nq2 in $BENCH_NQ2; do
+for events in $BENCH_EVENTS; do
+
+	config="p${plots}_b${bins}_g${grids}_m${members}_x${nx}_q${nq2}_e${events}"
+	work="$BENCH_WORK/$config"
+
+	if [ ! -f "$work/bench.txt" ]; then
+		echo "Generating $config"
+		"$GENERATE" --dir "$work" --plots $plots --bins $bins --grids $grids --members $members \
+		            --nx $nx --nq2 $nq2 --events $events > "$work.generate.log" 2>&1
+		if [ $? -ne 0 ]; then
+			echo "WARNING: Could not generate $config (see $work.generate.log)"
+			rm -f "$work/bench.txt"
+			failures=$((failures + 1))
+			continue
+		fi
+	fi
+
+	mkdir -p "$work/plots"
+
+	for repeat in $(seq 1 $BENCH_REPEAT); do
+		echo "Running $config ($repeat/$BENCH_REPEAT)"
+
+		rm -f "$work/timing.csv"
+		(cd "$work" && LHAPDF_DATA_PATH="$work/LHAPDF:$LHAPDF_DATA_PATH" \
+			"$SPECTRUM" $BENCH_FLAGS --timing timing.csv bench.txt > spectrum.log 2>&1)
+
+		if [ $? -ne 0 ] || [ ! -f "$work/timing.csv" ]; then
+			echo "WARNING: Spectrum failed for $config (see $work/spectrum.log)"
+			failures=$((failures + 1))
+			break
+		fi
+
+		tail -n +2 "$work/timing.csv" | while read line; do
+			echo "$config,$plots,$bins,$grids,$members,$nx,$nq2,$events,$repeat,$line" >> "$BENCH_OUTPUT"
+		done
+	done
+
+done
+done
+done
+done
+done
+done
+done
+
+echo
+echo "Results: $BENCH_OUTPUT"
+
+if [ $failures -ne 0 ]; then
+	echo "$failures benchmark point(s) failed"
+	exit 1
+fi
+
+exit 0
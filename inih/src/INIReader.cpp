@@ -56,6 +56,11 @@ bool INIReader::GetBoolean(string section, string name, bool default_value)
         return default_value;
 }
 
+void INIReader::Set(string section, string name, string value)
+{
+    _values[MakeKey(section, name)] = value;
+}
+
 string INIReader::MakeKey(string section, string name)
 {
     string key = section + "." + name;
@@ -42,6 +42,9 @@ public:
     // and valid false values are "false", "no", "off", "0" (not case sensitive).
     bool GetBoolean(std::string section, std::string name, bool default_value);
 
+    // Set a value, replacing the value read from the INI file (if any).
+    void Set(std::string section, std::string name, std::string value);
+
 private:
     int _error;
     std::map<std::string, std::string> _values;
@@ -206,6 +206,7 @@ class Gen(SpectrumSteering):
     self.debug = True
     self.output_rootfile=''
     self.output_graphicformat=''
+    self.output_table=''
 
 class Graph(SpectrumSteering):
 
@@ -0,0 +1,234 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Spectrum golden-output regression runner
+#
+# Runs every top-level steering file (Steering/ and examples/Steering/ by default)
+# headless (--no-draw --dump), and compares the canonical results of every plot
+# (nominal values, bands, PDF members, scale/alphas variations, data, chi2, ratios) with
+# the golden tables in regression/golden/, using the per-quantity tolerances of
+# regression/tolerances.txt. The wall time and peak memory of each run are reported
+# next to the comparison, with the change to the values stored with the golden tables.
+#
+# usage: python regression/run_regression.py [options] [steering files]
+#
+#   --update             store the results of this run as the golden tables
+#   --only <text>        run only the steering files whose path contains <text>
+#   --spectrum <path>    Spectrum executable (default ./Spectrum)
+#   --golden <dir>       golden tables (default regression/golden)
+#   --output <dir>       results of this run (default regression/output)
+#   --tolerances <file>  tolerances (default regression/tolerances.txt)
+#   --max-diffs <n>      differences listed per steering file (default 10)
+#
+# Must be run from the top directory of Spectrum (steering files use relative paths).
+# Exit status: 0 if all runs agree with their golden tables, 1 otherwise.
+#
+from __future__ import print_function
+
+import csv
+import fnmatch
+import glob
+import math
+import os
+import shutil
+import subprocess
+import sys
+import time
+
+def Usage():
+ print('usage: python regression/run_regression.py [--update] [--only <text>] [--spectrum <path>] [--golden <dir>]')
+ print('       [--output <dir>] [--tolerances <file>] [--max-diffs <n>] [steering files]')
+ sys.exit(2)
+
+def ParseArguments(argv):
+ options={'update':False, 'only':'', 'spectrum':'./Spectrum', 'golden':'regression/golden',
+          'output':'regression/output', 'tolerances':'regression/tolerances.txt', 'maxdiffs':10, 'files':[]}
+ i=1
+ while i<len(argv):
+  arg=argv[i]
+  if arg=='--update':
+   options['update']=True
+  elif arg in ('--only','--spectrum','--golden','--output','--tolerances','--max-diffs'):
+   if i+1>=len(argv): Usage()
+   i+=1
+   if arg=='--max-diffs': options['maxdiffs']=int(argv[i])
+   else: options[arg[2:]]=argv[i]
+  elif arg.startswith('-'):
+   Usage()
+  else:
+   options['files'].append(arg)
+  i+=1
+ return options
+
+# Top-level steering files: those with plot sections
+def FindSteeringFiles():
+ files=[]
+ for pattern in ('Steering/*.txt','examples/Steering/*.txt'):
+  for name in sorted(glob.glob(pattern)):
+   with open(name) as f:
+    if '[PLOT_' in f.read(): files.append(name)
+ return files
+
+def GetKey(filename):
+ return os.path.splitext(filename)[0].replace('/','__')
+
+# Tolerances: lines "<quantity pattern> <relative> <absolute>", the first matching pattern applies
+def ReadTolerances(filename):
+ tolerances=[]
+ with open(filename) as f:
+  for line in f:
+   line=line.split(';')[0].strip()
+   if not line: continue
+   fields=line.split()
+   if len(fields)!=3:
+    print('FATAL: Invalid tolerance line in '+filename+': '+line)
+    sys.exit(2)
+   tolerances.append((fields[0],float(fields[1]),float(fields[2])))
+ tolerances.append(('*',0.,0.))
+ return tolerances
+
+def GetTolerance(tolerances, quantity):
+ for pattern,relative,absolute in tolerances:
+  if fnmatch.fnmatchcase(quantity,pattern): return relative,absolute
+
+# Canonical tables of one run: {(table, quantity, bin): value}
+def ReadResults(directory):
+ values={}
+ for name in sorted(glob.glob(os.path.join(directory,'*_plot_*.csv'))):
+  table=os.path.basename(name)
+  with open(name) as f:
+   for row in csv.DictReader(f):
+    values[(table,row['quantity'],int(row['bin']))]=float(row['value'])
+ return values
+
+def ReadRunInfo(directory):
+ info={}
+ name=os.path.join(directory,'run.txt')
+ if os.path.exists(name):
+  with open(name) as f:
+   for line in f:
+    if '=' in line:
+     key,value=line.strip().split('=',1)
+     info[key]=float(value)
+ return info
+
+def WriteRunInfo(directory, wall, peak):
+ with open(os.path.join(directory,'run.txt'),'w') as f:
+  f.write('wall_s=%.3f\n' % wall)
+  f.write('peak_mb=%.1f\n' % peak)
+
+# Runs Spectrum headless; returns (exit status, wall time [s], peak resident memory [MB])
+def RunSpectrum(spectrum, steering, directory):
+ if os.path.exists(directory): shutil.rmtree(directory)
+ os.makedirs(directory)
+
+ log=open(os.path.join(directory,'spectrum.log'),'w')
+ start=time.time()
+ process=subprocess.Popen([spectrum,'--no-draw','--dump',directory,'--timing',os.path.join(directory,'timing.csv'),steering],
+                          stdout=log,stderr=subprocess.STDOUT)
+ # wait4: resources of this child only
+ pid,status,usage=os.wait4(process.pid,0)
+ wall=time.time()-start
+ log.close()
+
+ # ru_maxrss is in kB on Linux, in bytes on macOS
+ peak=usage.ru_maxrss/(1024.*1024. if sys.platform=='darwin' else 1024.)
+
+ if os.WIFEXITED(status): status=os.WEXITSTATUS(status)
+ else: status=-1
+
+ return status,wall,peak
+
+def Differs(new, old, relative, absolute):
+ if math.isnan(new) or math.isnan(old): return not (math.isnan(new) and math.isnan(old))
+ if math.isinf(new) or math.isinf(old): return new!=old
+ return abs(new-old)>max(absolute,relative*abs(old))
+
+# Returns the list of differences: (relative difference, description)
+def Compare(new, golden, tolerances):
+ diffs=[]
+ for key in sorted(set(golden)|set(new)):
+  table,quantity,ibin=key
+  where='%s %s[%d]' % (table,quantity,ibin)
+  if key not in new:
+   diffs.append((float('inf'),where+': missing'))
+  elif key not in golden:
+   diffs.append((float('inf'),where+': not in golden tables'))
+  else:
+   relative,absolute=GetTolerance(tolerances,quantity)
+   if Differs(new[key],golden[key],relative,absolute):
+    old=golden[key]
+    change=abs(new[key]-old)/abs(old) if old!=0 and not math.isnan(old) else float('inf')
+    diffs.append((change,'%s: %.17g (golden %.17g, relative %.3g, tolerance %.3g/%.3g)' % (where,new[key],old,change,relative,absolute)))
+ diffs.sort(key=lambda d: -d[0])
+ return diffs
+
+def Change(new, old):
+ if not old: return '-'
+ return '%+.0f%%' % (100.*(new-old)/old)
+
+def main():
+ options=ParseArguments(sys.argv)
+
+ if not os.path.exists(options['spectrum']):
+  print('FATAL: '+options['spectrum']+' not found: run make first')
+  sys.exit(2)
+
+ tolerances=ReadTolerances(options['tolerances'])
+
+ files=options['files'] or FindSteeringFiles()
+ files=[f for f in files if options['only'] in f]
+
+ failures=0
+ summary=[]
+
+ for steering in files:
+  key=GetKey(steering)
+  directory=os.path.join(options['output'],key)
+  goldenDirectory=os.path.join(options['golden'],key)
+
+  print('Running '+steering)
+  status,wall,peak=RunSpectrum(options['spectrum'],steering,directory)
+  WriteRunInfo(directory,wall,peak)
+
+  new=ReadResults(directory)
+  golden=ReadResults(goldenDirectory)
+  info=ReadRunInfo(goldenDirectory)
+
+  diffs=[]
+  if status!=0:
+   result='CRASH'
+   failures+=1
+  elif options['update']:
+   if os.path.exists(goldenDirectory): shutil.rmtree(goldenDirectory)
+   os.makedirs(goldenDirectory)
+   for name in glob.glob(os.path.join(directory,'*_plot_*.csv'))+[os.path.join(directory,'run.txt')]:
+    shutil.copy(name,goldenDirectory)
+   result='UPDATED'
+  elif not golden:
+   result='NO GOLDEN'
+  else:
+   diffs=Compare(new,golden,tolerances)
+   result='FAIL' if diffs else 'OK'
+   if diffs: failures+=1
+
+  summary.append((steering,result,len(new),len(diffs),wall,info.get('wall_s'),peak,info.get('peak_mb')))
+
+  if status!=0:
+   print('  Spectrum exited with status %d: see %s' % (status,os.path.join(directory,'spectrum.log')))
+  for change,text in diffs[:options['maxdiffs']]:
+   print('  '+text)
+  if len(diffs)>options['maxdiffs']:
+   print('  ... %d more differences' % (len(diffs)-options['maxdiffs']))
+
+ print('')
+ print('%-50s %-10s %8s %7s %9s %7s %9s %7s' % ('steering file','result','values','diffs','wall [s]','change','peak [MB]','change'))
+ for steering,result,nvalues,ndiffs,wall,goldenWall,peak,goldenPeak in summary:
+  print('%-50s %-10s %8d %7d %9.1f %7s %9.1f %7s' % (steering,result,nvalues,ndiffs,wall,Change(wall,goldenWall),peak,Change(peak,goldenPeak)))
+ print('')
+ print('%d of %d steering file(s) failed' % (failures,len(summary)))
+
+ sys.exit(1 if failures else 0)
+
+if __name__=='__main__':
+ main()
@@ -16,7 +16,12 @@
 #ifndef SPXANALYSIS_H
 #define SPXANALYSIS_H
 
+#include <sstream>
+
 #include "SPXPlot.h"
+#include "SPXRenderPool.h"
+#include "SPXHERAFitterTable.h"
+#include "SPXWorkQueue.h"
 #include "SPXSteeringFile.h"
 #include "SPXException.h"
 
@@ -24,6 +29,10 @@
 #include "SPXpValue.h"
 #endif      
 
+//Streaming (--stream): grids no plot refers to and LHAPDF members kept cached between plots
+const unsigned int STREAM_MAX_UNUSED_GRIDS = 4;
+const unsigned int STREAM_MAX_PDF_MEMBERS = 500;
+
 class SPXAnalysis {
 
 public:
@@ -38,33 +47,209 @@ public:
 	}
 
 	void Run(void) {
+		unsigned int window = Options::StreamWindow;
+
+		//Render workers: plots are computed here and drawn in parallel by forked processes
+		if(Options::RenderWorkers && !Options::NoDraw && !Options::KeepPlots) {
+			RunWorkers();
+			return;
+		}
+
 		try {
 			for(int i = 0; i < plots.size(); i++) {
-				plots[i].Plot();
+				RunPlot(i);
+
+				//Nothing refers to the objects of a written plot any more: free them before the next one
+				if(!Options::KeepPlots) {
+					ReleasePlot(i);
+				} else if(window && i >= window) {
+					ReleasePlot(i - window);
+				}
+
+				//Streaming: the caches shared between plots are bounded as well
+				if(window) {
+					SPXGrid::TrimGridCache(STREAM_MAX_UNUSED_GRIDS);
+					SPXPDF::TrimPDFMemberCache(STREAM_MAX_PDF_MEMBERS);
+				}
 			}
-		} catch(const SPXException &e) {
+		} catch(...) {
+			//The analysis may be destroyed or replaced by the caller: the plots own their objects through their arenas
+			ReleasePlots();
+			SPXOutputManager::Wait();
+			throw;
+		}
+
+		//Raster files are written in the background while the next plots are computed
+		if(SPXOutputManager::Wait()) {
+			throw SPXGraphException("SPXAnalysis::Run: Could not write all graphic files");
+		}
+	}
+
+	unsigned int GetNumberOfPlots(void) const {
+		return plots.size();
+	}
+
+	//Rebuilds plot i from the (updated) steering file: data, convolutions and ratios
+	void InitializePlot(unsigned int i) {
+		ReleasePlot(i);
+
+		SPXPlot plot = SPXPlot(steeringFile, i);
+		try {
+			plot.Initialize();
+		} catch(...) {
+			plot.Release();
 			throw;
 		}
+		plots.at(i) = plot;
+		initialized.at(i) = true;
+	}
+
+	//Draws and writes plot i (or only writes its results in --no-draw mode): a plot which is
+	// not initialized (streaming, or released) is initialized first
+	void RunPlot(unsigned int i) {
+		if(!initialized.at(i)) {
+			InitializePlot(i);
+		}
+
+		if(Options::NoDraw) {
+			plots.at(i).Process();
+		} else {
+			plots.at(i).Plot();
+		}
+	}
+
+	//Rebuilds the ratios of plot i from its data and convolutions (which are computed if it is not initialized)
+	void RebuildRatios(unsigned int i) {
+		if(!initialized.at(i)) {
+			InitializePlot(i);
+			return;
+		}
+
+		plots.at(i).RebuildRatios();
+	}
+
+	//Points the initialized plots at the configuration of the steering file, after it was re-read
+	// with the same number of plots and instances
+	void ReconfigurePlots(void) {
+		for(int i = 0; i < plots.size(); i++) {
+			if(initialized.at(i)) {
+				plots.at(i).Reconfigure();
+			}
+		}
+	}
+
+	//Frees the objects of plot i: it is initialized again if it is run again
+	void ReleasePlot(unsigned int i) {
+		plots.at(i).Release();
+		initialized.at(i) = false;
+	}
+
+	//Frees the objects of all plots (before the analysis is replaced)
+	void ReleasePlots(void) {
+		for(int i = 0; i < plots.size(); i++) {
+			ReleasePlot(i);
+		}
+	}
+
+	//All files written by the plots (or by the render workers) during Run
+	std::vector<std::string> GetOutputFiles(void) const {
+		std::vector<std::string> files = workerOutputFiles;
+
+		for(int i = 0; i < plots.size(); i++) {
+			const std::vector<std::string> &f = plots[i].GetOutputFiles();
+			files.insert(files.end(), f.begin(), f.end());
+		}
+
+		return files;
 	}
 
 private:
 	SPXSteeringFile *steeringFile;		//Pointer to a fully parsed steering file
 	std::vector<SPXPlot> plots;		//Vector of plots
+	std::vector<bool> initialized;		//Plot has its data, convolutions and ratios
+	std::vector<std::string> workerOutputFiles;	//Files written by the render workers
+
+	//Each plot is initialized here, then drawn by a worker process while the next one is initialized:
+	// the worker has its own copy of the plot, which is released here as soon as the worker is started
+	void RunWorkers(void) {
+		SPXRenderPool pool = SPXRenderPool(Options::RenderWorkers);
+
+		workerOutputFiles.clear();
+
+		try {
+			for(int i = 0; i < plots.size(); i++) {
+				if(!initialized.at(i)) {
+					InitializePlot(i);
+				}
+
+				pool.Submit(plots.at(i), i);
+				ReleasePlot(i);
+
+				if(Options::StreamWindow) {
+					SPXGrid::TrimGridCache(STREAM_MAX_UNUSED_GRIDS);
+					SPXPDF::TrimPDFMemberCache(STREAM_MAX_PDF_MEMBERS);
+				}
+			}
+		} catch(...) {
+			pool.Wait();
+			ReleasePlots();
+			throw;
+		}
+
+		pool.Wait();
+		pool.PrintSummary(std::cout);
+
+		workerOutputFiles = pool.GetOutputFiles();
+
+		if(pool.GetNumberOfFailures()) {
+			std::ostringstream oss;
+			oss << "SPXAnalysis::Run: " << pool.GetNumberOfFailures() << " render worker(s) failed";
+			throw SPXGeneralException(oss.str());
+		}
+	}
 
 	void Initialize(void) {
 
 		//Turn on debug modes for Plot
 		if(steeringFile->GetDebug()) {
 			SPXPlot::SetDebug(true);
+			SPXRenderPool::SetDebug(true);
+			SPXHERAFitterTable::SetDebug(true);
+			SPXWorkQueue::SetDebug(true);
 		}
 
+		//HERAFitter tables of all plots are parsed concurrently up front: the plots then take them from the cache
+		std::vector<std::string> tables;
+		for(int i = 0; i < steeringFile->GetNumberOfPlotConfigurations(); i++) {
+			SPXPlotConfiguration &pc = steeringFile->GetPlotConfiguration(i);
+
+			for(int j = 0; j < pc.GetNumberOfConfigurationInstances(); j++) {
+				SPXPlotConfigurationInstance &pci = pc.GetPlotConfigurationInstance(j);
+
+				if(pci.dataSteeringFile.GetDataFormat().IsHERAFitter()) {
+					tables.push_back(pci.dataSteeringFile.GetDataFile());
+				}
+			}
+		}
+		SPXHERAFitterTable::Preload(tables);
+
+		//Streaming: plots are initialized one at a time by Run, so that only the plots of the window are in memory
+		bool stream = (Options::StreamWindow != 0);
+
 		try {
 			for(int i = 0; i < steeringFile->GetNumberOfPlotConfigurations(); i++) {
 				SPXPlot plot = SPXPlot(steeringFile, i);
-				plot.Initialize();
 				plots.push_back(plot);
+				initialized.push_back(false);
+
+				if(!stream) {
+					plots.back().Initialize();
+					initialized.back() = true;
+				}
 			}
-		} catch(const SPXException &e) {
+		} catch(...) {
+			//Including the plot which failed: it is already in the vector
+			ReleasePlots();
 			throw;
 		}
 	}
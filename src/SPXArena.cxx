@@ -0,0 +1,217 @@
+//************************************************************/
+//
+//	Arena Implementation
+//
+//	Implements the SPXArena class
+//
+//	@Author: 	Spectrum contributors
+//	@Date:		19.10.2026
+//
+//************************************************************/
+
+#include <cstdio>
+#include <iomanip>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "SPXArena.h"
+#include "SPXUtilities.h"
+
+//Class name for debug statements
+const std::string cn = "SPXArena::";
+
+//Must define the static debug variable in the implementation
+bool SPXArena::debug;
+
+SPXArena * SPXArena::current = 0;
+unsigned long SPXArena::liveObjects = 0;
+unsigned long SPXArena::liveBytes = 0;
+std::vector<SPXArenaPhase_t> SPXArena::phases;
+int SPXArena::phase = -1;
+
+//Objects may be adopted from the convolution threads
+static pthread_mutex_t arenaMutex = PTHREAD_MUTEX_INITIALIZER;
+
+SPXArena::SPXArena(const std::string &name) {
+	this->name = name;
+}
+
+SPXArena::~SPXArena() {
+	Release();
+
+	if(current == this) {
+		current = 0;
+	}
+}
+
+bool SPXArena::Owns(const void *object) {
+	pthread_mutex_lock(&arenaMutex);
+	bool owned = (objects.count(object) != 0);
+	pthread_mutex_unlock(&arenaMutex);
+
+	return owned;
+}
+
+bool SPXArena::Insert(const void *object, SPXArenaEntry *entry) {
+	pthread_mutex_lock(&arenaMutex);
+
+	if(!objects.insert(object).second) {
+		pthread_mutex_unlock(&arenaMutex);
+		return false;
+	}
+
+	entries.push_back(entry);
+
+	if(entry->root) {
+		liveObjects++;
+		liveBytes += entry->bytes;
+		UpdatePeak();
+	}
+
+	pthread_mutex_unlock(&arenaMutex);
+
+	return true;
+}
+
+//Deletes all adopted objects, the last adopted first: canvases and pads go before what is drawn on them,
+// and derived objects before the objects (e.g. the SPXPDF) they were obtained from
+void SPXArena::Release(void) {
+	std::string mn = "Release: ";
+	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+	if(entries.empty()) {
+		return;
+	}
+
+	unsigned long numberOfObjects = 0;
+	unsigned long numberOfBytes = 0;
+
+	for(int i = entries.size() - 1; i >= 0; i--) {
+		SPXArenaEntry *entry = entries[i];
+
+		if(entry->root) {
+			numberOfObjects++;
+			numberOfBytes += entry->bytes;
+		}
+
+		delete entry;
+	}
+
+	pthread_mutex_lock(&arenaMutex);
+	liveObjects -= numberOfObjects;
+	liveBytes -= numberOfBytes;
+	pthread_mutex_unlock(&arenaMutex);
+
+	if(debug) {
+		std::cout << cn << mn << name << ": Released " << entries.size() << " objects (" << numberOfObjects << " ROOT objects, "
+		          << numberOfBytes / 1024 << " kB)" << std::endl;
+	}
+
+	entries.clear();
+	objects.clear();
+}
+
+//Detaches histograms from their directory (the arena owns them) and estimates the size of the object
+bool SPXArena::Prepare(TObject *object, unsigned long &bytes) {
+	bytes = object->IsA()->Size();
+
+	if(object->InheritsFrom(TH1::Class())) {
+		TH1 *h = (TH1 *)object;
+		h->SetDirectory(0);
+		bytes += (h->GetNcells() + h->GetSumw2N()) * sizeof(Double_t);
+	} else if(object->InheritsFrom(TGraph::Class())) {
+		int values = 2;
+		if(object->InheritsFrom(TGraphAsymmErrors::Class())) values = 6;
+		else if(object->InheritsFrom(TGraphErrors::Class())) values = 4;
+		bytes += ((TGraph *)object)->GetN() * values * sizeof(Double_t);
+	}
+
+	return true;
+}
+
+void SPXArena::UpdatePeak(void) {
+	if(phase < 0) {
+		return;
+	}
+
+	SPXArenaPhase_t &p = phases[phase];
+	if(liveObjects > p.peakObjects) p.peakObjects = liveObjects;
+	if(liveBytes > p.peakBytes) p.peakBytes = liveBytes;
+}
+
+//Resident set size of the process (0 if not available)
+unsigned long SPXArena::GetResidentKB(void) {
+	unsigned long pages = 0, resident = 0;
+
+	FILE *file = fopen("/proc/self/statm", "r");
+	if(!file) {
+		return 0;
+	}
+
+	if(fscanf(file, "%lu %lu", &pages, &resident) != 2) {
+		resident = 0;
+	}
+	fclose(file);
+
+	return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+void SPXArena::BeginPhase(const std::string &name) {
+	pthread_mutex_lock(&arenaMutex);
+
+	phase = -1;
+	for(int i = 0; i < phases.size(); i++) {
+		if(phases[i].name == name) {
+			phase = i;
+			break;
+		}
+	}
+
+	if(phase < 0) {
+		SPXArenaPhase_t p;
+		p.name = name;
+		p.calls = 0;
+		p.peakObjects = 0;
+		p.peakBytes = 0;
+		p.residentKB = 0;
+		phases.push_back(p);
+		phase = phases.size() - 1;
+	}
+
+	phases[phase].calls++;
+	UpdatePeak();
+
+	pthread_mutex_unlock(&arenaMutex);
+}
+
+void SPXArena::EndPhase(void) {
+	if(phase < 0) {
+		return;
+	}
+
+	unsigned long resident = GetResidentKB();
+	if(resident > phases[phase].residentKB) phases[phase].residentKB = resident;
+
+	phase = -1;
+}
+
+void SPXArena::PrintReport(std::ostream &out) {
+	out << std::endl;
+	out << "==================================" << std::endl;
+	out << "      	Memory Report		        " << std::endl;
+	out << "==================================" << std::endl;
+	out << std::left << std::setw(16) << "phase" << std::right << std::setw(8) << "calls" << std::setw(16) << "peak objects"
+	    << std::setw(14) << "peak MB" << std::setw(14) << "resident MB" << std::endl;
+
+	for(int i = 0; i < phases.size(); i++) {
+		const SPXArenaPhase_t &p = phases[i];
+
+		out << std::left << std::setw(16) << p.name << std::right << std::setw(8) << p.calls << std::setw(16) << p.peakObjects
+		    << std::setw(14) << std::fixed << std::setprecision(2) << p.peakBytes / (1024. * 1024.)
+		    << std::setw(14) << p.residentKB / 1024. << std::endl;
+	}
+
+	out << "ROOT objects still owned at exit: " << liveObjects << " (" << std::fixed << std::setprecision(2)
+	    << liveBytes / (1024. * 1024.) << " MB)" << std::endl;
+	out << "==================================" << std::endl;
+}
@@ -0,0 +1,171 @@
+//************************************************************/
+//
+//	Arena Header
+//
+//	Outlines the SPXArena class, which owns the objects created
+//	for one plot: histograms, graphs, canvases and the objects
+//	holding them (SPXData, SPXGrid, SPXPDF). Objects are adopted
+//	when they are created and are deleted together, in reverse
+//	order, when the plot is released. Adopted histograms are
+//	detached from gDirectory.
+//
+//	The arena of the plot being initialized or drawn is the
+//	current arena (SPXArenaScope), so that classes without a
+//	reference to their plot (SPXCrossSection, SPXPDF) can hand
+//	over what they create with SPXArena::AdoptCurrent.
+//
+//	The number and (estimated) size of the ROOT objects alive in
+//	all arenas is kept, with its peak in each phase of the run
+//	(Spectrum --mem-report)
+//
+//	@Author: 	Spectrum contributors
+//	@Date:		19.10.2026
+//
+//************************************************************/
+
+#ifndef SPXARENA_H
+#define SPXARENA_H
+
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "SPXROOT.h"
+
+//Type-erased owner of one adopted object
+class SPXArenaEntry {
+public:
+	SPXArenaEntry() : root(false), bytes(0) {}
+	virtual ~SPXArenaEntry() {}
+
+	bool root;			// ROOT object (counted in the memory report)
+	unsigned long bytes;		// Estimated size of a ROOT object
+};
+
+template<class T> class SPXArenaHolder : public SPXArenaEntry {
+public:
+	explicit SPXArenaHolder(T *object) : object(object) {}
+	~SPXArenaHolder() {
+		delete object;
+	}
+
+	T *object;
+};
+
+//Peak of the live ROOT objects during one phase of the run
+typedef struct SPXArenaPhase_t {
+	std::string name;
+	unsigned int calls;		// Number of times the phase was entered
+	unsigned long peakObjects;
+	unsigned long peakBytes;
+	unsigned long residentKB;	// Largest resident set size at the end of the phase
+} SPXArenaPhase_t;
+
+class SPXArena {
+
+public:
+	explicit SPXArena(const std::string &name);
+	~SPXArena();
+
+	//Takes ownership of object (0 and objects already owned are ignored) and returns it
+	template<class T> T * Adopt(T *object) {
+		if(!object) {
+			return object;
+		}
+
+		SPXArenaHolder<T> *entry = new SPXArenaHolder<T>(object);
+		entry->root = Prepare(object, entry->bytes);
+
+		if(!Insert(object, entry)) {
+			entry->object = 0;
+			delete entry;
+		}
+
+		return object;
+	}
+
+	//Adopts object into the current arena, if any: otherwise the caller keeps the ownership
+	template<class T> static T * AdoptCurrent(T *object) {
+		if(current) {
+			current->Adopt(object);
+		}
+
+		return object;
+	}
+
+	bool Owns(const void *object);
+	void Release(void);
+
+	const std::string & GetName(void) const {
+		return name;
+	}
+
+	unsigned int GetNumberOfObjects(void) const {
+		return entries.size();
+	}
+
+	static SPXArena * GetCurrent(void) {
+		return current;
+	}
+
+	static void SetCurrent(SPXArena *arena) {
+		current = arena;
+	}
+
+	static void BeginPhase(const std::string &phase);
+	static void EndPhase(void);
+	static void PrintReport(std::ostream &out);
+
+	static bool GetDebug(void) {
+		return debug;
+	}
+
+	static void SetDebug(bool b) {
+		debug = b;
+	}
+
+private:
+	static bool debug;				// Flag indicating debug mode
+	static SPXArena *current;			// Arena of the plot being processed
+
+	static unsigned long liveObjects;		// ROOT objects alive in all arenas
+	static unsigned long liveBytes;
+	static std::vector<SPXArenaPhase_t> phases;	// In order of first use
+	static int phase;				// Current phase (-1: none)
+
+	std::string name;
+	std::vector<SPXArenaEntry *> entries;		// In order of adoption
+	std::set<const void *> objects;			// Adopted objects, against double ownership
+
+	bool Insert(const void *object, SPXArenaEntry *entry);
+
+	static bool Prepare(TObject *object, unsigned long &bytes);
+	static bool Prepare(void *object, unsigned long &bytes) {
+		bytes = 0;
+		return false;
+	}
+
+	static void UpdatePeak(void);
+	static unsigned long GetResidentKB(void);
+};
+
+//Makes an arena current (and enters a phase of the memory report) for the lifetime of the scope
+class SPXArenaScope {
+public:
+	SPXArenaScope(SPXArena *arena, const std::string &phase) : previous(SPXArena::GetCurrent()) {
+		SPXArena::SetCurrent(arena);
+		SPXArena::BeginPhase(phase);
+	}
+
+	~SPXArenaScope() {
+		SPXArena::EndPhase();
+		SPXArena::SetCurrent(previous);
+	}
+
+private:
+	SPXArena *previous;
+};
+
+#endif
@@ -10,6 +10,7 @@
 //************************************************************/
 
 #include "SPXChi2.h"
+#include "SPXStageTimer.h"
 
 const std::string cn = "SPXChi2::";
 
@@ -51,6 +52,8 @@ double SPXChi2::CalculateSimpleChi2(SPXPDF *pdf, SPXData *data) {
  std::string mn = "CalculateSimpleChi2: ";
  if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
 
+ SPXStageScope stage("chi2");
+
  if (!pdf) {
   std::ostringstream oss;
   oss << cn <<mn<<"PDF object found !";
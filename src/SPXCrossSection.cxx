@@ -15,6 +15,7 @@
 #include "SPXCrossSection.h"
 #include "SPXUtilities.h"
 #include "SPXException.h"
+#include "SPXStageTimer.h"
 
 //Class name for debug statements
 const std::string cn = "SPXCrossSection::";
@@ -38,7 +39,7 @@ void SPXCrossSection::Create(SPXSteeringFile *mainsteeringfile) {
 
   if (debug) std::cout<<cn<<mn<<"Create grid with name= "<<gridname.c_str()<<std::endl;
 
-  grid = new SPXGrid(pci);
+  grid = SPXArena::AdoptCurrent(new SPXGrid(pci));
 
   if (debug) std::cout<<cn<<mn<<"Created grid with name= "<<gridname.c_str()<<std::endl;
 
@@ -52,7 +53,7 @@ void SPXCrossSection::Create(SPXSteeringFile *mainsteeringfile) {
  if (debug) std::cout<<cn<<mn<<"Attach the GRID "<<std::endl;
  //Attempt to create the PDF object and perform convolution
  try {
-  pdf = new SPXPDF(psf, grid);
+  pdf = SPXArena::AdoptCurrent(new SPXPDF(psf, grid));
  } catch(const SPXException &e) {
   throw;
  }
@@ -154,7 +155,7 @@ void SPXCrossSection::ParseCorrections(void) {
  //Check if grid contains corrections
  if (pci->gridSteeringFile.GetNumberOfCorrectionFiles() != 0) {
   try {
-   gridcorrection = new SPXGridCorrections(*pci);
+   gridcorrection = SPXArena::AdoptCurrent(new SPXGridCorrections(*pci));
    gridcorrection->Parse();
 
    if (debug) {
@@ -311,6 +312,9 @@ void SPXCrossSection::ApplyCorrections() {
   // correct PDF band
   if (debug) std::cout<<cn<<mn<<"Now correct PDF band includeinband="<<(includeinband ? "ON" : "OFF")<<std::endl;
   pdf->ApplyBandCorrection(gcorr,corrLabel,includeinband);
+
+  // the correction values are copied into the bands, the graph is not kept
+  delete gcorr;
  }
 
  if (debug) std::cout<<cn<<mn<<"finished !"<<std::endl;
@@ -368,6 +372,8 @@ void SPXCrossSection::MatchBinning(StringGraphMap_T dataFileGraphMap) {
  std::string mn = "MatchBinning: ";
  if (debug) SPXUtilities::PrintMethodHeader(cn, mn);
 
+ SPXStageScope stage("matchbinning");
+
  //Match binning of all graphs within each PCI, if matchBinning set
  if (mainsteeringFile->GetMatchBinning()) {
 
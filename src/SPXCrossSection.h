@@ -25,6 +25,7 @@
 
 #include "SPXGrid.h"
 #include "SPXPDF.h"
+#include "SPXArena.h"
 
 class SPXCrossSection {
 
@@ -36,14 +37,13 @@ public:
 		this->pci = pci;
              
 		//Create graphs for grid reference and nominal
-		gridReference = new TGraphAsymmErrors();
-		nominal = new TGraphAsymmErrors();
+		gridReference = SPXArena::AdoptCurrent(new TGraphAsymmErrors());
+		nominal = SPXArena::AdoptCurrent(new TGraphAsymmErrors());
 
 	}
 
+	//Cross sections are copied by value: graphs, grid and PDF are owned by the arena of the plot
 	~SPXCrossSection(void) {
-	 //delete grid;
-	 //delete pdf;
 	}
 
 	void Create(SPXSteeringFile *mainsteeringFile);
@@ -70,6 +70,13 @@ public:
 		return pci;
 	}
 
+	//Points the cross section and its grid at the same instance of a re-read steering file (--watch)
+	void SetPlotConfigurationInstance(SPXPlotConfigurationInstance *pci) {
+		this->pci = pci;
+		this->psf = &pci->pdfSteeringFile;
+		grid->SetPlotConfigurationInstance(pci);
+	}
+
 	SPXGrid *GetGrid(void) {
 		return grid;
 	}
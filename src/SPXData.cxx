@@ -13,9 +13,12 @@
 //************************************************************/
 
 #include <iomanip>
+#include <algorithm>
 #include <string.h> //malloc
 
 #include "SPXData.h"
+#include "SPXStageTimer.h"
+#include "SPXHERAFitterTable.h"
 
 //Class name for debug statements
 const std::string cn = "SPXData::";
@@ -54,6 +57,7 @@ SPXData::SPXData(const SPXPlotConfigurationInstance &pci) {
  statisticalErrorGraph=0;
  systematicErrorGraph=0;
  totalErrorGraph=0;
+ boundsValid=false;
  
  cov_matrixtot=0;
  cov_matrixstat=0;
@@ -87,6 +91,8 @@ void SPXData::Parse(void) {
 	std::string mn = "Parse: ";
 	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
 
+	SPXStageScope stage("load");
+
 	if(debug) std::cout << cn << mn << "Parsing data file: " << pci.dataSteeringFile.GetDataFile() << std::endl;
 	if(debug) std::cout << cn << mn << "Parsing filename: " << pci.dataSteeringFile.GetFilename() << std::endl;
 
@@ -107,15 +113,15 @@ void SPXData::Parse(void) {
 			std::cerr << e.what() << std::endl;
 			throw SPXParseException(pci.dataSteeringFile.GetDataFile(), "Error parsing data file");
 		}
-		//} else if(dataFormat.IsHERAFitter()) {
-		//if(debug) std::cout << cn << mn << "Data format is " << dataFormat.ToString() << std::endl;
-
-		//try {
-		//	ParseHERAFitter();
-		//} catch(const SPXException &e) {
-		//	std::cerr << e.what() << std::endl;
-		//	throw SPXParseException(pci.dataSteeringFile.GetDataFile(), "Error parsing data file");
-		//}
+	} else if(dataFormat.IsHERAFitter()) {
+		if(debug) std::cout << cn << mn << "Data format is " << dataFormat.ToString() << std::endl;
+
+		try {
+			ParseHERAFitter();
+		} catch(const SPXException &e) {
+			std::cerr << e.what() << std::endl;
+			throw SPXParseException(pci.dataSteeringFile.GetDataFile(), "Error parsing data file");
+		}
 	} else {
 	 throw SPXParseException("DataSteeringFile " + pci.dataSteeringFile.GetFilename() + " has invalid data format");
 	}
@@ -770,6 +776,13 @@ void SPXData::ParseSpectrum(void) {
 
 	if(debug) std::cout<<cn<<mn<<"Successfully added data to map" << std::endl;
 
+	FillSystematicsCorrelationType();
+}
+
+//Sets individualSystematicsIsCorrelated: systematics are correlated between bins, unless listed in the data steering file
+void SPXData::FillSystematicsCorrelationType(void) {
+	std::string mn = "FillSystematicsCorrelationType: ";
+
 	if(debug) std::cout<<cn<<mn<<"Filling correlation Type of systematics components" << std::endl;
         std::vector<std::string> SystematicsUncorrelatedBetweenBins=pci.dataSteeringFile.GetUncertaintyCorrelationTypeVector();
 	for(StringDoubleVectorMap_T::iterator it = individualSystematics.begin(); it != individualSystematics.end(); ++it) {
@@ -799,268 +812,217 @@ void SPXData::ParseSpectrum(void) {
 	   std::cout<<cn<<mn<<"name= "<<it->first.c_str()<<(it->second ? " CORRELATED" : " UNCORRELATED") <<std::endl;
          }
         }
-
 }
 
-/*
+//Reads a HERAFitter (xFitter) table (SPXHERAFitterTable) into the same data map and systematics as ParseSpectrum:
+//	'stat*' error columns are added in quadrature into stat, 'ignore' and 'total' columns are skipped, and every
+//	other error column is an individual systematic (syst_<name>; names ending in +/- are asymmetric pairs)
 void SPXData::ParseHERAFitter(void) {
 	std::string mn = "ParseHERAFitter: ";
 	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
 
-	//Fixed column indices (starting at Column 0)
-	const unsigned int XLOW_COL = 1;
-	const unsigned int XHIGH_COL = 2;
-	const unsigned int SIGMA_COL = 5;
-	const unsigned int STAT_P_COL = 6;
-	const unsigned int STAT_N_COL = 7;
-	const unsigned int SYST_BEGIN_COL = 8;
+	const std::string &filepath = pci.dataSteeringFile.GetDataFile();
 
-	if(debug) std::cout << cn << mn << "Beginning to parse data file: " << pci.dataSteeringFile.GetDataFile() << std::endl;
+	if(debug) std::cout << cn << mn << "Beginning to parse data file: " << filepath << std::endl;
 
-	if(!(*dataFile)) {
-		throw SPXFileIOException("Something went awry with the dataFile ifstream...");
-	}
-
-	unsigned int numberOfBins = 0;
-	unsigned int numberOfColumns = 0;
-	unsigned int numberOfSystematics = 0;
+	const SPXHERAFitterTable &table = SPXHERAFitterTable::Get(filepath);
+	if(debug) table.Print();
 
-	std::string line;
-	double xm_t, xlow_t, xhigh_t, sigma_t, stat_t, syst_p_t, syst_n_t;
-	std::vector<double> xm;				//Mean x
-	std::vector<double> xlow;			//X min
-	std::vector<double> xhigh;			//X max
-	std::vector<double> sigma;			//Sigma (cross-section)
-	std::vector<double> stat;			//Statistical error
-	std::vector<double> syst_p;			//Total systematic error (+)
-	std::vector<double> syst_n;			//Total systematic error (-)
+	std::vector<unsigned int> binColumns = table.GetColumnsOfType("Bin");
+	std::vector<unsigned int> sigmaColumns = table.GetColumnsOfType("Sigma");
+	std::vector<unsigned int> errorColumns = table.GetColumnsOfType("Error");
 
-	//Individual systematic error namess
-	std::vector<std::string> names;
+	if(sigmaColumns.empty()) {
+		throw SPXParseException(filepath, cn + mn + "HERAFitter table has no 'Sigma' column");
+	}
+	if(sigmaColumns.size() > 1) {
+		std::cerr << cn << mn << "WARNING: HERAFitter table has " << sigmaColumns.size() << " 'Sigma' columns: Using " << table.GetColumnName(sigmaColumns.at(0)) << std::endl;
+	}
 
-	while(dataFile->good()) {
-		std::getline(*dataFile, line);
+	unsigned int sigmaColumn = sigmaColumns.at(0);
 
-		//String stream to parse the individual lines
-		std::istringstream iss(line);
+	//x bin edges: the 'Bin' columns named in the data steering file, or the first two
+	int xlowColumn = -1;
+	int xhighColumn = -1;
 
-		//Temp string
-		std::string tmp;
-		tmp.clear();
+	const std::vector<std::string> &xColumns = pci.dataSteeringFile.GetHERAFitterXColumns();
 
-		if(debug) std::cout << cn << mn << "Line: " << line << std::endl;
+	if(!xColumns.empty()) {
+		xlowColumn = table.GetColumnIndex(xColumns.at(0));
+		xhighColumn = table.GetColumnIndex(xColumns.at(1));
 
-		//Skip empty lines
-		if(line.empty()) {
-			continue;
+		if(xlowColumn < 0 || xhighColumn < 0 || table.GetColumnType(xlowColumn) != "Bin" || table.GetColumnType(xhighColumn) != "Bin") {
+			throw SPXParseException(filepath, cn + mn + "herafitter_x_columns must name two 'Bin' columns of the table: " + xColumns.at(0) + ", " + xColumns.at(1));
 		}
+	} else if(binColumns.size() >= 2) {
+		xlowColumn = binColumns.at(0);
+		xhighColumn = binColumns.at(1);
 
-		//Skip comments
-		if(!line.empty() && (line[0] == ';')) {
-			continue;
-		} else if(!line.empty()) {
+		if(binColumns.size() > 2) {
+			std::cout << cn << mn << "INFO: HERAFitter table has " << binColumns.size() << " 'Bin' columns: Using " << table.GetColumnName(xlowColumn) << \
+				", " << table.GetColumnName(xhighColumn) << " as x bins (set herafitter_x_columns to change)" << std::endl;
+		}
+	} else if(binColumns.size() == 1) {
+		xlowColumn = xhighColumn = binColumns.at(0);
+	} else {
+		throw SPXParseException(filepath, cn + mn + "HERAFitter table has no 'Bin' column");
+	}
 
-			//Get the number of bins
-			if(line.find("NDATA") != std::string::npos) {
-				iss >> tmp;	//NDATA
-				iss >> tmp;	//=
-				iss >> tmp;
-				numberOfBins = atoi(tmp.c_str());
-				if(debug) std::cout << cn << mn << "Number of Bins set to " << numberOfBins << std::endl;
-			}
+	//Sort the error columns: statistical, skipped and systematic
+	std::vector<unsigned int> statColumns;
+	std::vector<unsigned int> systColumns;
+	std::vector<std::string> systNames;
+	std::vector<std::string> uncorrelatedNames;
 
-			//Get number of columns and initialize individual vector
-			if(line.find("NColumn") != std::string::npos) {
-				iss >> tmp;
-				iss >> tmp;
-				iss >> tmp;
-				numberOfColumns = atoi(tmp.c_str());
-				if(debug) std::cout << cn << mn << "Number of Columns set to "  << numberOfColumns << std::endl;
-
-				//Determine number of individual systematics
-				numberOfSystematics = numberOfColumns - SYST_BEGIN_COL;
-				if(debug) std::cout << cn << mn << "Number of Systematics set to " << numberOfSystematics << std::endl;
-			}
+	for(int i = 0; i < errorColumns.size(); i++) {
+		unsigned int column = errorColumns.at(i);
+		std::string name = table.GetColumnName(column);
+		std::string lower = name;
+		std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
 
-			//Compile the list of all individual systematic error names
-			if(line.find("ColumnName") != std::string::npos) {
+		if(lower.compare(0, 4, "stat") == 0) {
+			statColumns.push_back(column);
+			continue;
+		}
 
-				tmp = line;
+		if(lower == "ignore" || lower == "total") {
+			if(debug) std::cout << cn << mn << "Skipping error column " << name << std::endl;
+			continue;
+		}
 
-				//Get rid of 'ColumnName = '
-				tmp = SPXStringUtilities::RemoveFirstSubstring(tmp, "ColumnName = ");
+		name = SPXStringUtilities::ReplaceAll(name, " ", "_");
+		if(name.compare(0, 5, "syst_") != 0) name = "syst_" + name;
 
-				//Remove all single quotes and spaces and delimit with "," returning a vector of tokens
-				tmp = SPXStringUtilities::RemoveCharacters(tmp, "\' ");
-				names = SPXStringUtilities::SplitString(tmp, ",");
+		//Uncorrelated systematics are not correlated between bins
+		if(lower.compare(0, 5, "uncor") == 0) {
+			uncorrelatedNames.push_back(SPXStringUtilities::RemoveCharacters(name, "+-"));
+		}
 
-				//Remove the non-systematic error names
-				names.erase(names.begin(), names.begin() + SYST_BEGIN_COL);
+		systColumns.push_back(column);
+		systNames.push_back(name);
+	}
 
-				//DEBUG: Print all names
-				if(debug) {
-					std::cout << cn << mn << "names.size() = " << names.size() << std::endl;
-					std::cout << cn << mn << "Individual Systematic Error Names: " << std::endl;
-				}
+	if(statColumns.empty()) {
+		std::cerr << cn << mn << "WARNING: HERAFitter table has no 'stat' error column: Statistical errors set to 0" << std::endl;
+	}
 
-				unsigned int pos_count = 0;
-				unsigned int neg_count = 0;
+	//Errors are stored as the data steering file says (error_in_percent), whatever the Percent flag of their column
+	bool percent = pci.dataSteeringFile.IsErrorInPercent();
 
-				//Make sure there are the same number of +/- errors, if not issue a warning
-				for(int i = 0; i < names.size(); i++) {
-					if(debug) std::cout << "\t " << names.at(i) << std::endl;
+	double faclumi = pci.dataSteeringFile.GetLumiScaleFactor();
+	if(faclumi != 1 && debug) std::cout << cn << mn << "Rescale data by factor= " << faclumi << std::endl;
 
-					if(names.at(i).find("+") != std::string::npos) {
-						pos_count++;
-					}
-					else if(names.at(i).find("-") != std::string::npos) {
-						neg_count++;
-					}
-				}
+	std::vector<double> xm, xlow, xhigh, sigma, stat, syst_p, syst_n;
+	StringDoubleVectorMap_T systematics;
 
-				if(pos_count != neg_count) {
-				 std::cerr << cn << mn << "WARNING: Different number of positive/negative systematic errors: Data errors could be skewed" 
-				 <<" pos_count= "<<pos_count<< " neg_count= "<<neg_count<< std::endl;
-				}
+	keepbin.clear();
 
-				//Check size against calculated number of columns
-				if(names.size() != numberOfSystematics) {
-					std::ostringstream oss;
-					oss << cn << mn << "Error parsing systematic names: Name vector size (" << names.size() << \
-						") is not equal to the expected number of systematics (" << numberOfSystematics << ")" << std::endl;
-					throw SPXParseException(oss.str());
-				}
+	for(int row = 0; row < table.GetNumberOfRows(); row++) {
+		double xlow_t = table.GetValue(row, xlowColumn);
+		double xhigh_t = table.GetValue(row, xhighColumn);
+		double sigma_t = table.GetValue(row, sigmaColumn);
 
-				//Initialize a data vector for each name found
-				for(int i = 0; i < numberOfSystematics; i++) {
-					individualSystematics[names[i]] = std::vector<double>();
-				}
+		if(RemoveXbins) {
+			if(xlow_t < DataCutXmin || xhigh_t > DataCutXmax) {
+				if(debug) std::cout << cn << mn << "------> Remove bin " << row + 1 << " with xlow= " << xlow_t << " xhigh= " << xhigh_t << std::endl;
+				continue;
 			}
+			keepbin[row] = xm.size();
+		}
 
-			//Data begins with numeric character at position 0 (and # bins and # columns have already been read correctly)
-			if(isdigit((int)line.at(0)) && (numberOfBins) && (numberOfColumns)) {
+		//Error of a column in the units of the data steering file
+		std::vector<double> errors(table.GetNumberOfColumns(), 0.);
+		for(int i = 0; i < errorColumns.size(); i++) {
+			unsigned int column = errorColumns.at(i);
+			double e = table.GetValue(row, column);
 
-				//Parse line into vector of doubles
-				std::vector<double> dataVector;
+			if(table.IsPercent(column) && !percent) {
+				e *= sigma_t / 100.;
+			} else if(!table.IsPercent(column) && percent) {
+				e = (sigma_t != 0) ? e / sigma_t * 100. : 0.;
+			}
 
-				try {
-					dataVector = SPXStringUtilities::ParseStringToDoubleVector(line, ' ');
-				} catch(const SPXException &e) {
-					std::cerr << e.what() << std::endl;
-					throw SPXParseException(cn + mn + "Could not parse HERAFitter data file " + pci.dataSteeringFile.GetDataFile());
-				}
+			//Errors are rescaled with the data, as for the spectrum format
+			e *= faclumi;
 
-				if(dataVector.size() != numberOfColumns) {
-					std::ostringstream oss;
-					oss << cn << mn << "Error parsing data: line's data vector size (" << dataVector.size() << \
-						") is not equal to the expected number of columns (" << numberOfColumns << ")" << std::endl;
-					throw SPXParseException(oss.str());
-				}
+			errors.at(column) = e;
+		}
 
-				xlow_t = dataVector[XLOW_COL];
-				xhigh_t = dataVector[XHIGH_COL];
-				xm_t = (xlow_t + xhigh_t) / 2;
-				sigma_t = dataVector[SIGMA_COL];
-				double stat_p = dataVector[STAT_P_COL];
-				double stat_n = dataVector[STAT_N_COL];
-				stat_t = (stat_p + stat_n) / 2;
-
-				//Read in systematics: Must use names vector instead of map keys to ensure correct order
-				for(int i = SYST_BEGIN_COL; i < numberOfSystematics; i++) {
-					if(debug) std::cout << "[" << i << "]" << " --> Adding error for " << names.at(i) << ": " << dataVector.at(i) << std::endl;
-
-					if(individualSystematics.count(names.at(i)) == 0) {
-						throw SPXParseException(cn + mn + "Name \"" + names.at(i) + "\" not found in systematics map");
-					} else {
-						std::vector<double> &v = individualSystematics[names.at(i)];
-						v.push_back(dataVector.at(i));
-					}
-				}
+		double stat2 = 0;
+		for(int i = 0; i < statColumns.size(); i++) {
+			stat2 += pow(errors.at(statColumns.at(i)), 2.0);
+		}
 
-				//Fill vectors with temp variables
-				xm.push_back(xm_t);
-				xlow.push_back(xlow_t);
-				xhigh.push_back(xhigh_t);
-				sigma.push_back(sigma_t);
-				stat.push_back(stat_t);
+		xm.push_back((xlow_t + xhigh_t) / 2);
+		xlow.push_back(xlow_t);
+		xhigh.push_back(xhigh_t);
+		sigma.push_back(sigma_t * faclumi);
+		stat.push_back(sqrt(stat2));
+
+		for(int i = 0; i < systColumns.size(); i++) {
+			const std::string &name = systNames.at(i);
+			double e = errors.at(systColumns.at(i));
+			char last = name.at(name.size() - 1);
+
+			if(last == '+' || last == '-') {
+				systematics[name].push_back(e);
+			} else {
+				//Symmetric: the negative error has a negative sign
+				systematics[name + "+"].push_back(e);
+				systematics[name + "-"].push_back(-e);
 			}
 		}
 	}
 
-	//Set master size
-	int masterSize = numberOfBins;
-	if(debug) std::cout << cn << mn << "Master size set to size of \"NDATA\" " << masterSize << std::endl;
+	int masterSize = xm.size();
+
+	if(masterSize == 0) {
+		if(RemoveXbins) {
+			throw SPXParseException(cn + mn + "No data found or all data removed !");
+		} else
+			throw SPXParseException(cn + mn + "No data found !");
+	}
 
-	//Compute total positive/negative systematics for each bin using the individual systematic errors
+	if(pci.dataSteeringFile.AddLuminosityUncertainyToSystematics()) {
+		if(debug) std::cout << cn << mn << "Add luminosity as systematic components" << std::endl;
+		double elumi = pci.dataSteeringFile.GetDatasetLumiUncertainty();
+		systematics["syst_lumi+"] = std::vector<double>(masterSize, elumi);
+		systematics["syst_lumi-"] = std::vector<double>(masterSize, -elumi);
+	}
+
+	if(!AddMCStattoTotalStatError.empty()) {
+		std::cerr << cn << mn << "WARNING: Adding the MC statistics to the statistical error is not supported for HERAFitter tables" << std::endl;
+	}
+
+	//Total systematics: individuals added in quadrature
 	for(int i = 0; i < masterSize; i++) {
 		std::vector<double> p_errors;
 		std::vector<double> n_errors;
-		p_errors.clear();
-		n_errors.clear();
-
-		for(StringDoubleVectorMap_T::iterator it = individualSystematics.begin(); it != individualSystematics.end(); ++it) {
 
+		for(StringDoubleVectorMap_T::iterator it = systematics.begin(); it != systematics.end(); ++it) {
 			const std::string &name = it->first;
-			std::vector<double> &syst = it->second;
-
-			//Positive systematic
-			if(name.find("+") != std::string::npos) {
-				p_errors.push_back(syst.at(i));
-			}
+			double e = it->second.at(i);
+			bool positive = (name.at(name.size() - 1) == '+');
 
-			//Negative systematic
-			else if(name.find("-") != std::string::npos) {
-				n_errors.push_back(syst.at(i));
+			if(TakeSignforTotalError) {
+				positive = (e > 0);
 			}
 
-			//Symmetric systematic: +/- are the same
-			else {
-				p_errors.push_back(syst.at(i));
-				n_errors.push_back(syst.at(i));
-			}
-		}
-
-		syst_p_t = SPXMathUtilities::AddErrorsInQuadrature(p_errors);
-		syst_n_t = SPXMathUtilities::AddErrorsInQuadrature(n_errors);
-		syst_p.push_back(syst_p_t);
-		syst_n.push_back(syst_n_t);
-
-		if(debug) std::cout << cn << mn << "Total positive systematic error for bin " << i << " calculated as: " << syst_p_t << std::endl;
-		if(debug) std::cout << cn << mn << "Total negative systematic error for bin " << i << " calculated as: " << syst_n_t << std::endl;
-	}
-
-	//Check vector sizes: all vectors should be the same size
-	if(debug) std::cout << cn << mn << "Checking sizes of all vectors.." << std::endl;
-
-	try {
-		CheckVectorSize(xm, "xm", masterSize);
-		CheckVectorSize(xlow, "xlow", masterSize);
-		CheckVectorSize(xhigh, "xhigh", masterSize);
-		CheckVectorSize(sigma, "sigma", masterSize);
-		CheckVectorSize(stat, "stat", masterSize);
-		CheckVectorSize(syst_p, "syst_p", masterSize);
-		CheckVectorSize(syst_n, "syst_n", masterSize);
-
-		//Check size of all individual systematic errors
-		for(StringDoubleVectorMap_T::iterator it = individualSystematics.begin(); it != individualSystematics.end(); it++) {
-			const std::string &syst_name = it->first;
-			std::vector<double> &systematic = it->second;
-			CheckVectorSize(systematic, syst_name, masterSize);
+			if(positive) p_errors.push_back(e);
+			else n_errors.push_back(e);
 		}
 
-	} catch(const SPXException &e) {
-		throw;
+		syst_p.push_back(SPXMathUtilities::AddErrorsInQuadrature(p_errors));
+		syst_n.push_back(SPXMathUtilities::AddErrorsInQuadrature(n_errors));
 	}
 
-	//All vectors passed size check
-	if(debug) std::cout << cn << mn << "Success: All vector sizes match master size" << std::endl;
+	individualSystematics = systematics;
 
 	//Set numberOfBins based on master size
-	if(debug) std::cout << cn << mn << "Setting numberOfBins to match master size" << std::endl;
-	this->numberOfBins = masterSize;
-	if(debug) std::cout << cn << mn << "numberOfBins = " << this->numberOfBins << std::endl;
+	numberOfBins = masterSize;
+	if(debug) std::cout << cn << mn << "Number of Bins set to match master size: " << numberOfBins << std::endl;
 
-	//Add to data map
+	//Add all data to map
 	data.insert(StringDoubleVectorPair_T("xm", xm));
 	data.insert(StringDoubleVectorPair_T("xlow", xlow));
 	data.insert(StringDoubleVectorPair_T("xhigh", xhigh));
@@ -1069,17 +1031,24 @@ void SPXData::ParseHERAFitter(void) {
 	data.insert(StringDoubleVectorPair_T("syst_p", syst_p));
 	data.insert(StringDoubleVectorPair_T("syst_n", syst_n));
 
-	PrintHERAFitter();
-	while(1);
+	FillSystematicsCorrelationType();
+
+	for(int i = 0; i < uncorrelatedNames.size(); i++) {
+		const std::string &name = uncorrelatedNames.at(i);
+		if(individualSystematicsIsCorrelated.count(name + "+")) individualSystematicsIsCorrelated[name + "+"] = false;
+		if(individualSystematicsIsCorrelated.count(name + "-")) individualSystematicsIsCorrelated[name + "-"] = false;
+	}
+
+	if(debug) PrintHERAFitter();
 }
-*/
+
 //Helper method to choose correct print method based on data format
 void SPXData::Print(void) {
 
 	if(dataFormat.IsSpectrum()) {
 		PrintSpectrum();
-	 //} else if(dataFormat.IsHERAFitter()) {
-	 //PrintHERAFitter();
+	} else if(dataFormat.IsHERAFitter()) {
+		PrintHERAFitter();
 	}
 }
 
@@ -1162,7 +1131,6 @@ void SPXData::PrintSpectrum(void) {
 	//std::cout << std::endl << std::endl;
 }
 
-/*
 void SPXData::PrintHERAFitter(void) {
 	std::string mn = "PrintHERAFitter: ";
 	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
@@ -1220,7 +1188,6 @@ void SPXData::PrintHERAFitter(void) {
 
 	std::cout << "" << std::endl << std::endl;
 }
-*/
 
 void SPXData::PrintGraphs(void) {
  std::string mn = "PrintGraphs: ";
@@ -1246,10 +1213,24 @@ void SPXData::PrintGraphs(void) {
 
  return;
 }
+const SPXGraphBounds_t & SPXData::GetBounds(void) {
+	if(!boundsValid) {
+		//NOTE: Total should be the largest, but one of the other errors can be negative
+		bounds = SPXGraphUtilities::GetBounds(GetStatisticalErrorGraph());
+		SPXGraphUtilities::ExtendBounds(bounds, SPXGraphUtilities::GetBounds(GetSystematicErrorGraph()));
+		SPXGraphUtilities::ExtendBounds(bounds, SPXGraphUtilities::GetBounds(GetTotalErrorGraph()));
+		boundsValid = true;
+	}
+
+	return bounds;
+}
+
 void SPXData::CreateGraphs(void) {
 	std::string mn = "CreateGraphs: ";
 	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
 
+	boundsValid = false;
+
 	//Create name strings
 	TString name;
 	TString statName;
@@ -2387,6 +2368,7 @@ void  SPXData::KeepSystematicthatContains(std::string systclassname){
 void SPXData::UpdateSystematics(void){
  std::string mn ="UpdateSystematics: ";
  if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+ boundsValid=false;
  //
  // recalculate total systematic error from individual errors components
  // update data map
@@ -244,6 +244,14 @@ public:
 	  return this->totalErrorGraph;
 	}
 
+	//Extent of the statistical, systematic and total error graphs: computed when first asked for
+	// (frame of the plot), kept until the graphs are created again
+	const SPXGraphBounds_t & GetBounds(void);
+
+	void ResetBounds(void) {
+		boundsValid = false;
+	}
+
         TMatrixT <double> * GetDataTotalCovarianceMatrix() {return cov_matrixtot; };
         TMatrixT <double> * GetDataStatCovarianceMatrix()  {return cov_matrixstat;};
         TMatrixT <double> * GetDataSystCovarianceMatrix()  {return cov_matrixsyst;};
@@ -309,6 +317,9 @@ private:
 	//Actual data graph containing total errors
 	TGraphAsymmErrors *totalErrorGraph;
 
+	SPXGraphBounds_t bounds;	//Extent of the graphs (GetBounds)
+	bool boundsValid;
+
         // stuff related to covariance matrix
 
         TMatrixT<double>  *cov_matrixtot;
@@ -329,10 +340,11 @@ private:
         // parsing and print methods
 
 	void ParseSpectrum(void);
-	//void ParseHERAFitter(void);
+	void ParseHERAFitter(void);
+	void FillSystematicsCorrelationType(void);
 	void PrintMap(StringDoubleVectorMap_T &m); 
 	void PrintSpectrum(void);
-	//void PrintHERAFitter(void);
+	void PrintHERAFitter(void);
 
         void PrintSystematics(StringDoubleVectorMap_T syst);
 
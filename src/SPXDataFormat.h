@@ -74,13 +74,15 @@ public:
 		return false;
 	}
 
-	//bool IsHERAFitter(void) const {
-	//	if((format == DF_HERAFITTER) && this->IsValid()) {
-	//		return true;
-	//	}
-	//
-	//	return false;
-	//}
+	bool IsHERAFitter(void) const {
+		if((format == DF_HERAFITTER) && this->IsValid()) {
+			return true;
+		}
+
+		return false;
+	}
+
+	friend class SPXSteeringBundle;
 
 private:
 	static bool debug;
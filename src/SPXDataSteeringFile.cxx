@@ -109,6 +109,9 @@ void SPXDataSteeringFile::SetDefaults(void) {
 	dataFilepath.clear();
 	if(debug) std::cout << cn << mn << "dataFilepath set to default: \" \"" << std::endl;
 
+	heraFitterXColumns.clear();
+	if(debug) std::cout << cn << mn << "heraFitterXColumns set to default: first two 'Bin' columns" << std::endl;
+
 	corrtotalfilename.clear();
 	if(debug) std::cout << cn << mn << "corrtotalfilename set to default: \" \"" << std::endl;
 
@@ -190,6 +193,9 @@ void SPXDataSteeringFile::Print(void) {
 	std::cout << "\t Data Options [DATA]" << std::endl;
 	std::cout << "\t\t Data Format: " << dataFormat.ToString() << std::endl;
 	std::cout << "\t\t Data File: " << dataFilepath << std::endl;
+	if(!heraFitterXColumns.empty()) {
+		std::cout << "\t\t HERAFitter x bin columns: " << SPXStringUtilities::VectorToCommaSeparatedList(heraFitterXColumns) << std::endl;
+	}
 	std::cout << "\t\t Total Correlation File: " << corrtotalfilename << std::endl;
 	std::cout << "\t\t Statistical Correlation File: " << corrstatfilename << std::endl;
 	std::cout << "\t\t Data Divided by Bin Width? " << (dividedByBinWidth ? "YES" : "NO") << std::endl;
@@ -450,6 +456,16 @@ void SPXDataSteeringFile::Parse(void) {
                 std::cout << cn << mn << "Successfully read Data File: " << dataFilepath << std::endl;
 	}
 
+	//HERAFitter tables may have several 'Bin' columns (e.g. y and pT bins): choose the ones of the x axis
+	tmp = reader->Get("DATA", "herafitter_x_columns", "EMPTY");
+	if(tmp.compare("EMPTY")) {
+		heraFitterXColumns = SPXStringUtilities::CommaSeparatedListToVector(tmp);
+		if(heraFitterXColumns.size() != 2) {
+			throw SPXINIParseException("DATA", "herafitter_x_columns", "Must give the names of two 'Bin' columns (low, high): " + tmp);
+		}
+		if(debug) std::cout << cn << mn << "HERAFitter x bin columns: " << tmp << std::endl;
+	}
+
 	tmp = reader->Get("DATA", "corr_total_file_name", "EMPTY");
 	if(!tmp.compare("EMPTY")) {
 	  std::cout<<cn<<mn<<"INFO no total correllation file specified !"<<std::endl;
@@ -27,6 +27,8 @@
 
 class SPXDataSteeringFile {
 
+	friend class SPXSteeringBundle;
+
 private:
 
 	//INI Reader
@@ -73,6 +75,7 @@ private:
 	//[DATA]
 	SPXDataFormat dataFormat;		// The format of the data: Current supported formats are: Spectrum, HERAPDF
 	std::string dataFilepath;		// The data filepath
+	std::vector<std::string> heraFitterXColumns;	// HERAFitter: names of the 'Bin' columns giving the low/high x bin edges
         std::string corrtotalfilename;          // name of correlation file
         std::string corrstatfilename;           // name of correlation file
 
@@ -312,6 +315,10 @@ public:
          return SystematicsUncorrelatedBetweenBins; 
         }
 
+	const std::vector<std::string> & GetHERAFitterXColumns(void) const {
+		return heraFitterXColumns;
+	}
+
 };
 
 #endif
@@ -86,6 +86,8 @@ public:
 		return false;
 	}
 
+	friend class SPXSteeringBundle;
+
 private:
 	static bool debug;
 	unsigned int style;
@@ -14,6 +14,10 @@
 #define SPXFILEUTILITIES_H
 
 #include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
 
 class SPXFileUtilities {
 
@@ -26,6 +30,52 @@ public:
 	  		return false;
 	  	}
 	}
+
+	//Last modification time of the file, or 0 if it cannot be accessed
+	static time_t GetModificationTime(const std::string &filepath) {
+		struct stat st;
+
+		if(stat(filepath.c_str(), &st) != 0) {
+			return 0;
+		}
+
+		return st.st_mtime;
+	}
+
+	//Reads the whole (binary) file into contents: false if it cannot be opened
+	static bool ReadFile(const std::string &filepath, std::string &contents) {
+		std::ifstream file(filepath.c_str(), std::ios::in | std::ios::binary);
+
+		if(!file.is_open()) {
+			return false;
+		}
+
+		std::ostringstream oss;
+		oss << file.rdbuf();
+		contents = oss.str();
+
+		return true;
+	}
+
+	//Type sizes and byte order: binary files written as byte copies are only valid on the same kind of machine
+	static unsigned int GetBinaryLayout(void) {
+		unsigned int one = 1;
+		bool littleEndian = (*(unsigned char *)&one == 1);
+
+		return (sizeof(int) << 24) | (sizeof(double) << 16) | (sizeof(unsigned long long) << 8) | (littleEndian ? 1 : 2);
+	}
+
+	//64 bit FNV-1a hash of the bytes: detects changed or damaged files, not meant to be cryptographic
+	static unsigned long long GetChecksum(const char *data, std::size_t n) {
+		unsigned long long hash = 14695981039346656037ULL;
+
+		for(std::size_t i = 0; i < n; i++) {
+			hash ^= (unsigned char)data[i];
+			hash *= 1099511628211ULL;
+		}
+
+		return hash;
+	}
 };
 
 #endif
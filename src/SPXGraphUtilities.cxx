@@ -110,6 +110,70 @@ double SPXGraphUtilities::GetYMax(std::vector<TGraphAsymmErrors *> graphs) {
     return max;
 }
 
+SPXGraphBounds_t SPXGraphUtilities::GetEmptyBounds(void) {
+    SPXGraphBounds_t bounds;
+
+    bounds.xMin = bounds.yMin = 1e30;
+    bounds.xMax = bounds.yMax = -1e30;
+    bounds.xMinPositive = bounds.yMinPositive = 1e30;
+
+    return bounds;
+}
+
+//All extrema of a graph in one pass over its points
+SPXGraphBounds_t SPXGraphUtilities::GetBounds(TGraphAsymmErrors *graph) {
+    std::string mn = "GetBounds: ";
+
+    if (!graph) throw SPXGraphException(cn+mn+"graph not found !");
+
+    SPXGraphBounds_t bounds = GetEmptyBounds();
+
+    for(int i = 0; i < graph->GetN(); i++) {
+        double x, y;
+        graph->GetPoint(i, x, y);
+
+        double xlow  = x - graph->GetErrorXlow(i);
+        double xhigh = x + graph->GetErrorXhigh(i);
+        double ylow  = y - graph->GetErrorYlow(i);
+        double yhigh = y + graph->GetErrorYhigh(i);
+
+        if(xlow < bounds.xMin) bounds.xMin = xlow;
+        if(xhigh > bounds.xMax) bounds.xMax = xhigh;
+        if(ylow < bounds.yMin) bounds.yMin = ylow;
+        if(yhigh > bounds.yMax) bounds.yMax = yhigh;
+
+        double xpos = (xlow > 0 ? xlow : x);
+        double ypos = (ylow > 0 ? ylow : y);
+        if(xpos > 0 && xpos < bounds.xMinPositive) bounds.xMinPositive = xpos;
+        if(ypos > 0 && ypos < bounds.yMinPositive) bounds.yMinPositive = ypos;
+    }
+
+    return bounds;
+}
+
+void SPXGraphUtilities::ExtendBounds(SPXGraphBounds_t &bounds, const SPXGraphBounds_t &other) {
+    if(other.xMin < bounds.xMin) bounds.xMin = other.xMin;
+    if(other.xMax > bounds.xMax) bounds.xMax = other.xMax;
+    if(other.yMin < bounds.yMin) bounds.yMin = other.yMin;
+    if(other.yMax > bounds.yMax) bounds.yMax = other.yMax;
+    if(other.xMinPositive < bounds.xMinPositive) bounds.xMinPositive = other.xMinPositive;
+    if(other.yMinPositive < bounds.yMinPositive) bounds.yMinPositive = other.yMinPositive;
+}
+
+//Frame of the bounds, with the same extra space as GetXMin/GetXMax/GetYMin/GetYMax
+void SPXGraphUtilities::GetFrameBounds(const SPXGraphBounds_t &bounds, double &xMin, double &xMax, double &yMin, double &yMax) {
+    xMin = bounds.xMin;
+    xMax = bounds.xMax;
+    yMin = bounds.yMin;
+    yMax = bounds.yMax;
+
+#if PERFORM_DELTA_MIN_MAX == 1
+    xMin -= (xMin * DELTA_MIN_MAX);
+    xMax += (xMax * DELTA_MIN_MAX);
+    yMin -= (yMin * DELTA_MIN_MAX);
+    yMax += (yMax * DELTA_MIN_MAX);
+#endif
+}
 
 double SPXGraphUtilities::GetLargestRelativeError(TGraphAsymmErrors* graph) {
  // return systematics in the bin where it is largest
@@ -286,6 +350,7 @@ TH1D* SPXGraphUtilities::MatchBinning(TGraphAsymmErrors *master, TH1D *hslave, b
  }
 
  TH1D* hslave2=SPXGraphUtilities::GraphToHistogram(gslave);
+ delete gslave;
  if (!hslave2) {
   throw SPXGraphException(cn + mn + "Problem converting graph to histogram ");
  }
@@ -799,6 +864,131 @@ TGraphAsymmErrors * SPXGraphUtilities::Divide(TGraphAsymmErrors *g1, TGraphAsymm
     return result;
 }
 
+//Same result as Divide for every numerator, in one pass over the bands of a ratio: the denominator values and
+//relative errors are read once, the point matching is done once per numerator binning and the result graphs
+//are allocated with their final size
+std::vector<TGraphAsymmErrors *> SPXGraphUtilities::DivideBands(const std::vector<TGraphAsymmErrors *> &numerators, TGraphAsymmErrors *denominator, DivideErrorType_t dt) {
+    std::string mn = "DivideBands: ";
+
+    if(!denominator) {
+     throw SPXGraphException(cn + mn + "Denominator graph not found");
+    }
+
+    const int n2 = denominator->GetN();
+    const double *x2 = denominator->GetX();
+    const double *y2 = denominator->GetY();
+    const double *exl2 = denominator->GetEXlow();
+    const double *exh2 = denominator->GetEXhigh();
+
+    std::vector<double> rel2l(n2, 0.), rel2h(n2, 0.);
+    if(dt != ZeroDenGraphErrors && dt != ZeroAllErrors) {
+        for(int i2 = 0; i2 < n2; i2++) {
+            if(y2[i2] != 0.0) {
+                rel2l[i2] = denominator->GetEYlow()[i2] / y2[i2];
+                rel2h[i2] = denominator->GetEYhigh()[i2] / y2[i2];
+            }
+        }
+    }
+
+    std::vector<TGraphAsymmErrors *> results;
+    std::vector<int> match;	//Denominator point of each numerator point, -1 if none
+    TGraphAsymmErrors *gmatched = 0;	//Numerator the matching was done for
+
+    for(int ig = 0; ig < numerators.size(); ig++) {
+        TGraphAsymmErrors *g1 = numerators[ig];
+        if(!g1) {
+         throw SPXGraphException(cn + mn + "Numerator graph not found");
+        }
+
+        if(g1->GetN() != n2) {
+         std::ostringstream oss;
+         oss << cn << mn << "Graphs do not contain the same number of bins: Graph1= "
+             << g1->GetName() << " n1= " << g1->GetN() << " Graph2= " << denominator->GetName() << " n2= " << n2;
+         throw SPXGraphException(oss.str());
+        }
+
+        const int n1 = g1->GetN();
+        const double *x1 = g1->GetX();
+        const double *exl1 = g1->GetEXlow();
+        const double *exh1 = g1->GetEXhigh();
+
+        //Bands of one prediction share their binning: only match again if it differs from the last numerator
+        bool sameBinning = (gmatched != 0);
+        for(int i1 = 0; sameBinning && i1 < n1; i1++) {
+            sameBinning = (x1[i1] == gmatched->GetX()[i1]) && (exl1[i1] == gmatched->GetEXlow()[i1]) && (exh1[i1] == gmatched->GetEXhigh()[i1]);
+        }
+
+        if(!sameBinning) {
+            match.assign(n1, -1);
+            for(int i1 = 0; i1 < n1; i1++) {
+                for(int i2 = 0; i2 < n2; i2++) {
+                    double emean = (exh1[i1] + exh2[i2] + exl1[i1] + exl2[i2]) / 4.0;
+                    if(fabs(x1[i1] - x2[i2]) <= emean) {
+                        if(match[i1] >= 0) {
+                            throw SPXGraphException(cn + mn + "Too many X-Points matched");
+                        }
+                        match[i1] = i2;
+                    }
+                }
+            }
+            gmatched = g1;
+        }
+
+        int nmatch = 0;
+        for(int i1 = 0; i1 < n1; i1++) {
+            if(match[i1] >= 0) nmatch++;
+        }
+
+        TGraphAsymmErrors *result = new TGraphAsymmErrors(nmatch);
+        result->SetName(g1->GetName());
+        SPXGraphUtilities::SPXCopyGraphProperties((TGraphErrors *)g1, (TGraphErrors *)result);
+
+        const double *y1 = g1->GetY();
+        const double *eyl1 = g1->GetEYlow();
+        const double *eyh1 = g1->GetEYhigh();
+        bool zeroNum = (dt == ZeroNumGraphErrors || dt == ZeroAllErrors);
+
+        double *rx = result->GetX();
+        double *ry = result->GetY();
+        double *rexl = result->GetEXlow();
+        double *rexh = result->GetEXhigh();
+        double *reyl = result->GetEYlow();
+        double *reyh = result->GetEYhigh();
+
+        int iv = 0;
+        for(int i1 = 0; i1 < n1; i1++) {
+            int i2 = match[i1];
+            if(i2 < 0) continue;
+
+            rx[iv] = x1[i1];
+            rexl[iv] = exl1[i1];
+            rexh[iv] = exh1[i1];
+            reyl[iv] = 0.;
+            reyh[iv] = 0.;
+
+            if(y2[i2] != 0.0) {
+                double ratio = y1[i1] / y2[i2];
+                ry[iv] = ratio;
+
+                if(y1[i1] != 0.0) {
+                    double rel1l = zeroNum ? 0. : eyl1[i1] / y1[i1];
+                    double rel1h = zeroNum ? 0. : eyh1[i1] / y1[i1];
+                    reyl[iv] = sqrt(rel1l * rel1l + rel2l[i2] * rel2l[i2]) * ratio;
+                    reyh[iv] = sqrt(rel1h * rel1h + rel2h[i2] * rel2h[i2]) * ratio;
+                }
+            } else {
+                ry[iv] = y2[i2];
+            }
+
+            iv++;
+        }
+
+        results.push_back(result);
+    }
+
+    return results;
+}
+
 void SPXGraphUtilities::ClearXErrors(TGraphAsymmErrors * g) {
     for(int i = 0; i < g->GetN(); i++) {
         g->SetPointEXhigh(i, 0.0);
@@ -40,11 +40,23 @@ typedef enum DivideErrorType_t {
 typedef std::pair<std::string, std::string> StringPair_T;
 typedef std::map<std::string, TGraphAsymmErrors *> StringGraphMap_T;
 typedef std::map<std::string, std::string> StringLabelMap_T;
+typedef std::map<std::string, std::vector<TGraphAsymmErrors *> > StringGraphVectorMap_T;
 
 typedef std::map<std::pair<std::string, std::string>, TGraphAsymmErrors *> StringPairGraphMap_T;
 typedef std::pair<std::string, TGraphAsymmErrors *> StringGraphPair_T;
 typedef std::pair<StringPair_T, TGraphAsymmErrors *> StringPairGraphPair_T;
 
+//Extent of one or more graphs including their errors; the positive minima (smallest lower edge > 0,
+// or point > 0) are the bounds of a logarithmic axis. Empty bounds have min > max
+typedef struct SPXGraphBounds_t {
+	double xMin;
+	double xMax;
+	double yMin;
+	double yMax;
+	double xMinPositive;
+	double yMinPositive;
+} SPXGraphBounds_t;
+
 
 
 class SPXGraphUtilities {
@@ -56,6 +68,11 @@ public:
 	static double GetYMin(std::vector<TGraphAsymmErrors *> graphs);
 	static double GetYMax(std::vector<TGraphAsymmErrors *> graphs);
 
+	static SPXGraphBounds_t GetEmptyBounds(void);
+	static SPXGraphBounds_t GetBounds(TGraphAsymmErrors *graph);
+	static void ExtendBounds(SPXGraphBounds_t &bounds, const SPXGraphBounds_t &other);
+	static void GetFrameBounds(const SPXGraphBounds_t &bounds, double &xMin, double &xMax, double &yMin, double &yMax);
+
         static double GetLargestRelativeError(TGraphAsymmErrors* graphs);
 
 	static void MatchBinning(TGraphAsymmErrors *master, TGraphAsymmErrors *slave, bool dividedByBinWidth);
@@ -65,6 +82,7 @@ public:
         static TGraphAsymmErrors * FindCommonBins(TGraphAsymmErrors* master, TGraphAsymmErrors* slave);
 
 	static TGraphAsymmErrors * Divide(TGraphAsymmErrors *g1, TGraphAsymmErrors *g2, DivideErrorType_t dt);
+	static std::vector<TGraphAsymmErrors *> DivideBands(const std::vector<TGraphAsymmErrors *> &numerators, TGraphAsymmErrors *denominator, DivideErrorType_t dt);
 
 	static void ClearXErrors(TGraphAsymmErrors * g);
 	static void ClearYErrors(TGraphAsymmErrors * g);
@@ -13,17 +13,93 @@
 
 #include "SPXGrid.h"
 #include "SPXUtilities.h"
+#include "SPXStageTimer.h"
 
 const std::string cn = "SPXGrid::";
 
 //Must define the static debug variable in the implementation
 bool SPXGrid::debug;
 
+std::map<std::string, SPXGridCacheEntry_t> SPXGrid::gridCache;
+unsigned long SPXGrid::gridRequests = 0;
+
+appl::grid * SPXGrid::GetCachedGrid(const std::string &gridFile) {
+ std::string mn = "GetCachedGrid: ";
+
+ time_t mtime = SPXFileUtilities::GetModificationTime(gridFile);
+ gridRequests++;
+
+ std::map<std::string, SPXGridCacheEntry_t>::iterator it = gridCache.find(gridFile);
+ if (it != gridCache.end() && it->second.mtime == mtime) {
+  if (debug) std::cout<<cn<<mn<<"Reusing cached grid "<<gridFile<<std::endl;
+  it->second.users++;
+  it->second.lastUse = gridRequests;
+  return it->second.grid;
+ }
+
+ //Not cached yet, or the file changed on disk: the old grid is deleted unless it is still referenced
+ if (it != gridCache.end() && it->second.users == 0) {
+  delete it->second.grid;
+ }
+
+ if (debug) std::cout<<cn<<mn<<"Reading grid "<<gridFile<<std::endl;
+
+ appl::grid * grid = new appl::grid(gridFile);
+ if (!grid) {
+  throw SPXGeneralException(cn+mn+"APPLGrid: appl::grid(" + gridFile + ") did not return a valid object pointer");
+ }
+
+ SPXGridCacheEntry_t entry;
+ entry.mtime = mtime;
+ entry.grid = grid;
+ entry.users = 1;
+ entry.lastUse = gridRequests;
+ gridCache[gridFile] = entry;
+
+ return grid;
+}
+
+void SPXGrid::ReleaseCachedGrid(appl::grid *grid) {
+ for (std::map<std::string, SPXGridCacheEntry_t>::iterator it = gridCache.begin(); it != gridCache.end(); ++it) {
+  if (it->second.grid == grid) {
+   if (it->second.users > 0) it->second.users--;
+   return;
+  }
+ }
+}
+
+//Deletes the least recently used grids nobody refers to, until at most maxUnusedGrids of them are left
+void SPXGrid::TrimGridCache(unsigned int maxUnusedGrids) {
+ std::string mn = "TrimGridCache: ";
+
+ while (true) {
+  unsigned int unused = 0;
+  std::map<std::string, SPXGridCacheEntry_t>::iterator oldest = gridCache.end();
+
+  for (std::map<std::string, SPXGridCacheEntry_t>::iterator it = gridCache.begin(); it != gridCache.end(); ++it) {
+   if (it->second.users != 0) continue;
+   unused++;
+   if (oldest == gridCache.end() || it->second.lastUse < oldest->second.lastUse) oldest = it;
+  }
+
+  if (unused <= maxUnusedGrids) {
+   return;
+  }
+
+  if (debug) std::cout<<cn<<mn<<"Dropping grid "<<oldest->first<<std::endl;
+
+  delete oldest->second.grid;
+  gridCache.erase(oldest);
+ }
+}
+
 TH1D * SPXGrid::CreateGrid(void) {
  //debug=true;
  std::string mn = "CreateGrid: ";
  if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
 
+ SPXStageScope stage("load");
+
 
  TH1D *referenceHistogramsum;
 
@@ -46,15 +122,12 @@ TH1D * SPXGrid::CreateGrid(void) {
    throw SPXFileIOException(gridFile, cn+mn+"Unable to open grid file");
   }
 
-  //Create a new grid object from the grid file
-  appl::grid * grid = new appl::grid(gridFile);
-  if (!grid) {
-   throw SPXGeneralException(cn+mn+"APPLGrid: appl::grid(" + gridFile + ") did not return a valid object pointer");
-  }
+  //Get the (shared) grid object for the grid file
+  appl::grid * grid = GetCachedGrid(gridFile);
   vgrid.push_back(grid);
 
-  //Create a reference histogram from the grid
-  TH1D *referenceHistogram = (TH1D *)grid->getReference();
+  //Create a reference histogram from the grid: a copy, since the grid is shared and the reference is rescaled below
+  TH1D *referenceHistogram = grid->getReference() ? (TH1D *)grid->getReference()->Clone() : 0;
 
   if (!referenceHistogram) {
    throw SPXGeneralException("Reference histogram from appl::grid::getReference() for grid file " + gridFile + " was unsuccessful");
@@ -98,10 +171,7 @@ TH1D * SPXGrid::CreateGrid(void) {
 
   if (debug) std::cout <<cn<<mn<<"Get alternative scale choice grid igrid= "<< igrid << std::endl;
 
-  appl::grid * gridAlternativeScaleChoice = new appl::grid(gridFileAlternativeScaleChoice);
-  if (!gridAlternativeScaleChoice) {
-   throw SPXGeneralException(cn+mn+"APPLGrid: appl::grid(" + gridFileAlternativeScaleChoice + ") did not return a valid object pointer");
-  }
+  appl::grid * gridAlternativeScaleChoice = GetCachedGrid(gridFileAlternativeScaleChoice);
   vgridAlternativeScaleChoice.push_back(gridAlternativeScaleChoice);
 
  }
@@ -14,6 +14,9 @@
 #ifndef SPXGRID_H
 #define SPXGRID_H
 
+#include <map>
+#include <ctime>
+
 #include "appl_grid/appl_grid.h"
 #include "appl_grid/generic_pdf.h"
 
@@ -22,6 +25,14 @@
 #include "SPXPlotConfiguration.h"
 #include "SPXException.h"
 
+//Grid read from one file, shared by all SPXGrid objects using that file
+typedef struct SPXGridCacheEntry_t {
+	time_t mtime;			// Modification time of the file when it was read
+	appl::grid *grid;
+	unsigned int users;		// Number of references held by SPXGrid objects
+	unsigned long lastUse;		// Request counter value at the last request (least recently used go first)
+} SPXGridCacheEntry_t;
+
 class SPXGrid {
 
 public:
@@ -35,9 +46,12 @@ public:
 		//CreateGrid();
 	}
 
-	//@TODO Delete here: Could be a source of errors
+	//The grids stay in the cache: only the references are given back
 	~SPXGrid(void) {
-          if (debug) std::cout<<" SPXGrid() constructor "<<std::endl;
+          if (debug) std::cout<<" SPXGrid() destructor "<<std::endl;
+
+	  for (int i=0; i<vgrid.size(); i++) ReleaseCachedGrid(vgrid[i]);
+	  for (int i=0; i<vgridAlternativeScaleChoice.size(); i++) ReleaseCachedGrid(vgridAlternativeScaleChoice[i]);
 	}
 
 	static bool GetDebug(void) {
@@ -62,6 +76,11 @@ public:
 	 return pci->gridSteeringFile.GetName();
 	}
 
+	//Same instance of a re-read steering file (--watch)
+	void SetPlotConfigurationInstance(SPXPlotConfigurationInstance *pci) {
+	 this->pci = pci;
+	}
+
 	//const std::string & GetAlternativeScaleChoiceName(void) const {
 	// return pci->gridSteeringFile.GetAlternativeScaleChoiceName();
 	//}
@@ -77,6 +96,16 @@ public:
 	//Creates the Grid and return the reference histogram
 	TH1D * CreateGrid(void);
 
+	//Grids are read once per file (and modification time) and shared: each call holds a reference
+	// until ReleaseCachedGrid, grids without references stay cached until TrimGridCache
+	static appl::grid * GetCachedGrid(const std::string &gridFile);
+	static void ReleaseCachedGrid(appl::grid *grid);
+	static void TrimGridCache(unsigned int maxUnusedGrids);
+
+	static unsigned int GetNumberOfCachedGrids(void) {
+		return gridCache.size();
+	}
+
         appl::grid *GetGrid(int i){ 
 	 if (i>=vgrid.size()) {
           std::ostringstream oss;
@@ -119,6 +148,10 @@ public:
 	 return pci->gridSteeringFile.GetChangeSqrtS();
 	}
 
+        const std::vector<double> & GetSqrtSSweep(void) const {
+	 return pci->gridSteeringFile.GetSqrtSSweep();
+	}
+
         double GetParameterValue(void) const {
          return this->parameterValue;
         }            
@@ -148,6 +181,9 @@ private:
 	static bool debug;		     // Flag indicating debug mode
 	SPXPlotConfigurationInstance *pci;   // Plot configuration instance
 
+	static std::map<std::string, SPXGridCacheEntry_t> gridCache; // grid file -> cached grid
+	static unsigned long gridRequests;                           // Number of GetCachedGrid calls (LRU clock)
+
 	//appl::grid *grid;		     // APPLGrid Grid
 	std::vector <appl::grid *> vgrid;    // vector of APPLGrid Grid
 
@@ -161,6 +197,9 @@ private:
 	std::string parameterName;          // name of parameter 
 	std::string parameterUnit;          // unit of parameter 
 
+	//Not copyable: each object holds its own references to the cached grids (released by the destructor)
+	SPXGrid(const SPXGrid &);
+	SPXGrid & operator=(const SPXGrid &);
 };
 
 #endif
@@ -11,6 +11,8 @@
 //
 //************************************************************/
 
+#include <sys/stat.h>
+
 #include "SPXGridCorrections.h"
 
 //Class name for debug statements
@@ -19,6 +21,9 @@ const std::string cn = "SPXGridCorrections::";
 //Must define the static debug variable in the implementation
 bool SPXGridCorrections::debug;
 
+std::map<std::string, SPXCorrectionTable_T> SPXGridCorrections::correctionTableCache;
+pthread_mutex_t SPXGridCorrections::cacheMutex = PTHREAD_MUTEX_INITIALIZER;
+
 void SPXGridCorrections::Parse(void) {
  std::string mn = "Parse: ";
  if (debug) SPXUtilities::PrintMethodHeader(cn, mn);
@@ -41,166 +46,42 @@ void SPXGridCorrections::Parse(void) {
   std::string filename = pci.gridSteeringFile.GetCorrectionFile(i);
   filename=pci.gridDirectory+'/'+filename;
 
-  if (debug) std::cout << std::endl;
-  if (debug) std::cout << cn << mn << "Beginning to parse correction file: " << filename << std::endl;
-
-  //Open the file
-  OpenCorrectionFile(filename);
-  if (!(*correctionFile)) {
-   throw SPXFileIOException("Something went wrong with the correctionFile ifstream...");
-  }
-
-  std::string line;
-  std::vector<double> x;
-  std::vector<double> xmin;
-  std::vector<double> xmax;
-  std::vector<double> y;
-  std::vector<double> eyl;
-  std::vector<double> eyh;
-  unsigned int bin_count = 0;
-  unsigned int numberOfColumns = 0;
-
-  name="";
-  comment="";
-  errortype="relative";
-  xbinformat="normal";
-
-   try {
-    //Process the file
-    while (correctionFile->good()) {
-     std::getline(*correctionFile, line);
-
-     if (line.empty() || (line[0] == ';')) {
-      continue;
-     } 
-     if (isalpha((int)SPXStringUtilities::LeftTrim(line).at(0))) {
-      std::vector<std::string> vtmp=SPXStringUtilities::ParseString(line,'=');
-      if (vtmp.size()!=2) {
-       std::cout<<cn<<mn<<"Vector should have exactly size= 2 but is "<<vtmp.size()<<" line= "<<line<<std::endl;
-      }
-
-      if (TString(vtmp.at(0)).Contains("name")) { 
-       name    =vtmp.at(1);
-       if (debug) std::cout<<cn<<mn<<"name= "<<name.c_str()<<std::endl;
-      }
-
-      if (TString(vtmp.at(0)).Contains("comment")) { 
-       comment  =vtmp.at(1);
-       if (debug) std::cout<<cn<<mn<<"comment= "<<comment.c_str()<<std::endl;
-      }
-
-      if (TString(vtmp.at(0)).Contains("errortype")) {
-       errortype=vtmp.at(1);
-       if (debug) std::cout<<cn<<mn<<"errortype= "<<errortype.c_str()<<std::endl;
-      }
-
-      if (TString(vtmp.at(0)).Contains("xbinformat")) {
-       xbinformat=vtmp.at(1);
-       if (debug) std::cout<<cn<<mn<<"xbinformat= "<<xbinformat.c_str()<<std::endl;
-      }
-
-     }
-
-     //Read in line if it starts with a digit
-     if (isdigit((int)SPXStringUtilities::LeftTrim(line).at(0))) {
-
-      if (debug) std::cout << cn << mn << "Line: " << line << std::endl;
-
-      // Parse line into vector
-      // Convert all tabs to spaces
-      std::string formatted_line = SPXStringUtilities::ReplaceAll(line, "\t", " ");
-      std::vector<double> tmp = SPXStringUtilities::ParseStringToDoubleVector(formatted_line, ' ');
-
-      if (tmp.size() < 3) {
-       throw SPXParseException(cn + mn + "There must be at least 3 correction columns");
-      }
-
-      // Set number of columns to the size of the 0th bin
-      if (!bin_count) {
-       //Set number of columns
-       numberOfColumns = tmp.size();
-
-       int ncol=0;
-       if (xbinformat=="xminxmaxonly") ncol=2;       // only xmin and xmax is given
-       else                            ncol=3;       // central value, xmin and xmax are given
-       if (errortype=="noerror")       ncol=ncol+1;  // only central value no error
-       else ncol=ncol+3;                             // central value and errors
-
+  //Parse each file only once: later cross sections using the same file get the parsed table
+  struct stat fileStat;
+  long modificationTime = (stat(filename.c_str(), &fileStat) == 0) ? (long)fileStat.st_mtime : -1;
 
+  StringDoubleVectorMap_T m;
+  bool cached = false;
 
-       // Only 2 options: 4 columns or 6 columns (without eyl/eyh or with)
-       //if ((numberOfColumns != 4) && (numberOfColumns != 6)) {
-       if (numberOfColumns != ncol) {
-        std::ostringstream oss;
-        oss<<cn<<mn<<"There should be "<<ncol<<" columns xbinformat="<<xbinformat<<" errortype="<<errortype;
-        throw SPXParseException(oss.str());
-       }
-
-       if (debug) std::cout << cn << mn << "The remaining bins MUST also have exactly " << numberOfColumns << " columns" << std::endl;
-      }
-
-      //After the 0th bin, make sure all other bins have the exact same number of columns
-      else {
-       if (tmp.size() != numberOfColumns) {
-        std::ostringstream oss;
-        oss << cn << mn << "Number of columns for bin " << bin_count + 1<< " (" << tmp.size() << ") does NOT match expected (" << numberOfColumns << ")" << std::endl;
-        throw SPXParseException(oss.str());
+  pthread_mutex_lock(&cacheMutex);
+  std::map<std::string, SPXCorrectionTable_T>::const_iterator it = correctionTableCache.find(filename);
+  if (it != correctionTableCache.end() && it->second.modificationTime == modificationTime) {
+   m = it->second.table;
+   cached = true;
+  }
+  pthread_mutex_unlock(&cacheMutex);
 
-       }
-      }
+  if (cached) {
+   if (debug) std::cout << cn << mn << "Correction file already parsed: " << filename << std::endl;
+  } else {
+   ParseFile(filename, m);
 
-      // Increment bin count
-      bin_count++;
+   SPXCorrectionTable_T entry;
+   entry.modificationTime = modificationTime;
+   entry.table = m;
 
-     //Obtain the correction type (SPXGridCorrectionType???)
-     //Build the matrix based on the xm, dx-, dx+, sigma, dsigma-, dsigma+
-     int ioff=0;
-     if (xbinformat=="xminxmaxonly") {
-      ioff=-1;
-      double xm=(tmp[ioff+1]+tmp[ioff+2])/2.;
-      x.push_back(xm);
-     } else {
-      x.push_back(tmp[0]);
-     }
-     xmin.push_back(tmp[ioff+1]);
-     xmax.push_back(tmp[ioff+2]);
-
-     //if (debug) std::cout<<cn<<mn<<"ioff= "<<ioff<<std::endl;
-
-     //std::cout<<cn<<mn<<" Number of bins= "<<numberOfBins<<std::endl;
-
-     if (numberOfColumns == ioff+4) { // no uncertainties given
-      y.push_back(tmp[ioff+3]);
-      eyl.push_back(0.);
-      eyh.push_back(0.);
-     } else if(numberOfColumns == ioff+6) { // uncertainties are given
-      y.push_back(tmp[ioff+3]);
-      if (errortype.compare("relative")==0) {
-
-       eyh.push_back(tmp[ioff+3]-tmp[ioff+4]*tmp[ioff+3]);
-       eyl.push_back(tmp[ioff+5]*tmp[ioff+3]-tmp[ioff+3]);
-      } else if (errortype.compare("absolute")==0) {
-       eyh.push_back(tmp[ioff+4]);
-       eyl.push_back(tmp[ioff+5]);
-      } else {
-       std::cout<<cn<<mn<<"Do not know what to do errortype= "<<errortype.c_str()<<std::endl;
-       throw SPXParseException(cn+mn+"Do not know what to do errortype= "+errortype);
-      }
-      if (debug) {
-	std::cout<<cn<<mn<<" y= "<<y.back()<<" eyl= "<<eyl.back()<<" eyh= "<<eyh.back()<<std::endl;
-      }
-     } else {
-      std::ostringstream oss;
-      oss<<cn<<mn<<"Do not know what to do numberOfColumns="<<numberOfColumns;
-      throw SPXParseException(oss.str());
-     }
-    }
-   }
-  } catch(const SPXException &e) {
-   std::cerr << e.what() << std::endl;
-   throw SPXParseException(cn + mn + "Unable to parse corrections file: " + filename);
+   pthread_mutex_lock(&cacheMutex);
+   correctionTableCache[filename] = entry;
+   pthread_mutex_unlock(&cacheMutex);
   }
 
+  const std::vector<double> &x    = m["x"];
+  const std::vector<double> &xmin = m["xmin"];
+  const std::vector<double> &xmax = m["xmax"];
+  const std::vector<double> &y    = m["y"];
+  const std::vector<double> &eyl  = m["eyl"];
+  const std::vector<double> &eyh  = m["eyh"];
+
   if (debug) {
     std::cout<<cn<<mn<<"Number of bins= "<<numberOfBins<<" xsize= "<< x.size()<<std::endl;
   }
@@ -237,15 +118,6 @@ void SPXGridCorrections::Parse(void) {
    throw SPXParseException(cn + mn + "Unable to parse corrections file: " + filename);
   }
 
-  //Create the double vector map based on the 6 vectors
-  StringDoubleVectorMap_T m;
-  m.insert(StringDoubleVectorPair_T("x", x));
-  m.insert(StringDoubleVectorPair_T("xmin", xmin));
-  m.insert(StringDoubleVectorPair_T("xmax", xmax));
-  m.insert(StringDoubleVectorPair_T("y", y));
-  m.insert(StringDoubleVectorPair_T("eyl", eyl));
-  m.insert(StringDoubleVectorPair_T("eyh", eyh));
-
   //Insert it into the map
   corrections.insert(CorrectionsPair_T(filename, m));
 
@@ -271,8 +143,6 @@ void SPXGridCorrections::Parse(void) {
 
   if (debug) std::cout << cn << mn <<" i= "<<i<< " ---> Successfully added total correction to correction map" << std::endl;
 
-  //Close the file
-  CloseCorrectionFile();
  }
 
  // add up relative errors in quadrature
@@ -310,6 +180,182 @@ void SPXGridCorrections::Parse(void) {
     
 }
 
+//Reads one correction file into the x, xmin, xmax, y, eyl, eyh vectors of m
+void SPXGridCorrections::ParseFile(const std::string &filename, StringDoubleVectorMap_T &m) {
+ std::string mn = "ParseFile: ";
+ if (debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+ if (debug) std::cout << cn << mn << "Beginning to parse correction file: " << filename << std::endl;
+
+ //Open the file
+ OpenCorrectionFile(filename);
+ if (!(*correctionFile)) {
+  throw SPXFileIOException("Something went wrong with the correctionFile ifstream...");
+ }
+
+ std::string line;
+ std::vector<double> x;
+ std::vector<double> xmin;
+ std::vector<double> xmax;
+ std::vector<double> y;
+ std::vector<double> eyl;
+ std::vector<double> eyh;
+ unsigned int bin_count = 0;
+ unsigned int numberOfColumns = 0;
+
+ name="";
+ comment="";
+ errortype="relative";
+ xbinformat="normal";
+
+  try {
+   //Process the file
+   while (correctionFile->good()) {
+    std::getline(*correctionFile, line);
+
+    if (line.empty() || (line[0] == ';')) {
+     continue;
+    } 
+    if (isalpha((int)SPXStringUtilities::LeftTrim(line).at(0))) {
+     std::vector<std::string> vtmp=SPXStringUtilities::ParseString(line,'=');
+     if (vtmp.size()!=2) {
+      std::cout<<cn<<mn<<"Vector should have exactly size= 2 but is "<<vtmp.size()<<" line= "<<line<<std::endl;
+     }
+
+     if (TString(vtmp.at(0)).Contains("name")) { 
+      name    =vtmp.at(1);
+      if (debug) std::cout<<cn<<mn<<"name= "<<name.c_str()<<std::endl;
+     }
+
+     if (TString(vtmp.at(0)).Contains("comment")) { 
+      comment  =vtmp.at(1);
+      if (debug) std::cout<<cn<<mn<<"comment= "<<comment.c_str()<<std::endl;
+     }
+
+     if (TString(vtmp.at(0)).Contains("errortype")) {
+      errortype=vtmp.at(1);
+      if (debug) std::cout<<cn<<mn<<"errortype= "<<errortype.c_str()<<std::endl;
+     }
+
+     if (TString(vtmp.at(0)).Contains("xbinformat")) {
+      xbinformat=vtmp.at(1);
+      if (debug) std::cout<<cn<<mn<<"xbinformat= "<<xbinformat.c_str()<<std::endl;
+     }
+
+    }
+
+    //Read in line if it starts with a digit
+    if (isdigit((int)SPXStringUtilities::LeftTrim(line).at(0))) {
+
+     if (debug) std::cout << cn << mn << "Line: " << line << std::endl;
+
+     // Parse line into vector
+     // Convert all tabs to spaces
+     std::string formatted_line = SPXStringUtilities::ReplaceAll(line, "\t", " ");
+     std::vector<double> tmp = SPXStringUtilities::ParseStringToDoubleVector(formatted_line, ' ');
+
+     if (tmp.size() < 3) {
+      throw SPXParseException(cn + mn + "There must be at least 3 correction columns");
+     }
+
+     // Set number of columns to the size of the 0th bin
+     if (!bin_count) {
+      //Set number of columns
+      numberOfColumns = tmp.size();
+
+      int ncol=0;
+      if (xbinformat=="xminxmaxonly") ncol=2;       // only xmin and xmax is given
+      else                            ncol=3;       // central value, xmin and xmax are given
+      if (errortype=="noerror")       ncol=ncol+1;  // only central value no error
+      else ncol=ncol+3;                             // central value and errors
+
+
+
+      // Only 2 options: 4 columns or 6 columns (without eyl/eyh or with)
+      //if ((numberOfColumns != 4) && (numberOfColumns != 6)) {
+      if (numberOfColumns != ncol) {
+       std::ostringstream oss;
+       oss<<cn<<mn<<"There should be "<<ncol<<" columns xbinformat="<<xbinformat<<" errortype="<<errortype;
+       throw SPXParseException(oss.str());
+      }
+
+      if (debug) std::cout << cn << mn << "The remaining bins MUST also have exactly " << numberOfColumns << " columns" << std::endl;
+     }
+
+     //After the 0th bin, make sure all other bins have the exact same number of columns
+     else {
+      if (tmp.size() != numberOfColumns) {
+       std::ostringstream oss;
+       oss << cn << mn << "Number of columns for bin " << bin_count + 1<< " (" << tmp.size() << ") does NOT match expected (" << numberOfColumns << ")" << std::endl;
+       throw SPXParseException(oss.str());
+
+      }
+     }
+
+     // Increment bin count
+     bin_count++;
+
+    //Obtain the correction type (SPXGridCorrectionType???)
+    //Build the matrix based on the xm, dx-, dx+, sigma, dsigma-, dsigma+
+    int ioff=0;
+    if (xbinformat=="xminxmaxonly") {
+     ioff=-1;
+     double xm=(tmp[ioff+1]+tmp[ioff+2])/2.;
+     x.push_back(xm);
+    } else {
+     x.push_back(tmp[0]);
+    }
+    xmin.push_back(tmp[ioff+1]);
+    xmax.push_back(tmp[ioff+2]);
+
+    //if (debug) std::cout<<cn<<mn<<"ioff= "<<ioff<<std::endl;
+
+    //std::cout<<cn<<mn<<" Number of bins= "<<numberOfBins<<std::endl;
+
+    if (numberOfColumns == ioff+4) { // no uncertainties given
+     y.push_back(tmp[ioff+3]);
+     eyl.push_back(0.);
+     eyh.push_back(0.);
+    } else if(numberOfColumns == ioff+6) { // uncertainties are given
+     y.push_back(tmp[ioff+3]);
+     if (errortype.compare("relative")==0) {
+
+      eyh.push_back(tmp[ioff+3]-tmp[ioff+4]*tmp[ioff+3]);
+      eyl.push_back(tmp[ioff+5]*tmp[ioff+3]-tmp[ioff+3]);
+     } else if (errortype.compare("absolute")==0) {
+      eyh.push_back(tmp[ioff+4]);
+      eyl.push_back(tmp[ioff+5]);
+     } else {
+      std::cout<<cn<<mn<<"Do not know what to do errortype= "<<errortype.c_str()<<std::endl;
+      throw SPXParseException(cn+mn+"Do not know what to do errortype= "+errortype);
+     }
+     if (debug) {
+	std::cout<<cn<<mn<<" y= "<<y.back()<<" eyl= "<<eyl.back()<<" eyh= "<<eyh.back()<<std::endl;
+     }
+    } else {
+     std::ostringstream oss;
+     oss<<cn<<mn<<"Do not know what to do numberOfColumns="<<numberOfColumns;
+     throw SPXParseException(oss.str());
+    }
+   }
+  }
+ } catch(const SPXException &e) {
+  std::cerr << e.what() << std::endl;
+  throw SPXParseException(cn + mn + "Unable to parse corrections file: " + filename);
+ }
+
+ //Create the double vector map based on the 6 vectors
+ m.insert(StringDoubleVectorPair_T("x", x));
+ m.insert(StringDoubleVectorPair_T("xmin", xmin));
+ m.insert(StringDoubleVectorPair_T("xmax", xmax));
+ m.insert(StringDoubleVectorPair_T("y", y));
+ m.insert(StringDoubleVectorPair_T("eyl", eyl));
+ m.insert(StringDoubleVectorPair_T("eyh", eyh));
+
+ //Close the file
+ CloseCorrectionFile();
+}
+
 //@TODO Move this to some sort of utilities library? SPXStandardUtilities/SPXGeneralUtilities???
 void SPXGridCorrections::PrintMap(std::string &s, StringDoubleVectorMap_T &m) {
     std::string mn = "PrintMap: ";
@@ -20,6 +20,7 @@
 #include <map>
 #include <string>
 #include <vector>
+#include <pthread.h>
 
 #include "SPXPlotConfiguration.h"
 #include "SPXException.h"
@@ -28,6 +29,13 @@
 typedef std::map<std::string, StringDoubleVectorMap_T >  CorrectionsMap_T;
 typedef std::pair<std::string, StringDoubleVectorMap_T >  CorrectionsPair_T;
 
+//Parsed content of one correction file, shared by all cross sections (and plots) using the file:
+//  it is only re-parsed when the modification time of the file changes
+typedef struct SPXCorrectionTable_T {
+    long modificationTime;
+    StringDoubleVectorMap_T table;
+} SPXCorrectionTable_T;
+
 class SPXGridCorrections {
 
 public:
@@ -119,6 +127,12 @@ private:
     //Number of bins in correction
     unsigned int numberOfBins;
 
+    //Correction files parsed so far (key: correction file path), guarded by cacheMutex
+    static std::map<std::string, SPXCorrectionTable_T> correctionTableCache;
+    static pthread_mutex_t cacheMutex;
+
+    void ParseFile(const std::string &filename, StringDoubleVectorMap_T &m);
+
     //Actual corrections map: Keys are correction filenames, values are Nx6 matrices (6 columns, N rows) where the
     //  columns correspond to x, eyl, eyh, y, eyl, and eyh corrections, and the rows correspond to each bin
     CorrectionsMap_T corrections;
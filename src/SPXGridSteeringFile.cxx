@@ -100,6 +100,9 @@ void SPXGridSteeringFile::SetDefaults(void) {
 	changesqrts = 1.;
 	if(debug) std::cout << cn << mn << "changesqrts set to default: 1. " << std::endl;
 
+	sqrtssweep.clear();
+	if(debug) std::cout << cn << mn << "sqrtssweep set to default: empty " << std::endl;
+
 	ParameterValue = 0.;
 	if(debug) std::cout << cn << mn << "Parameter value set to default: 0. " << std::endl;
 
@@ -180,6 +183,14 @@ void SPXGridSteeringFile::Print(void) {
 	std::cout << "\t\t Lowest Order: " << lowestOrder << std::endl;
 	std::cout << "\t\t Change cross section by: " << changesqrts<<"%" << std::endl;
 
+	if(!sqrtssweep.empty()) {
+		std::cout << "\t\t Beam energy sweep sqrt(s) factors:";
+		for(int i = 0; i < sqrtssweep.size(); i++) {
+			std::cout << " " << sqrtssweep.at(i);
+		}
+		std::cout << std::endl;
+	}
+
 <<<<<<< HEAD
         if (ParameterName.empty() !! ParameterName=="EMPTY") {
 =======
@@ -524,6 +535,20 @@ void SPXGridSteeringFile::Parse(void) {
 	 std::cerr << "Changed cms energy needs to be positive Escale is relative energy scale (old/new), i.e. one corresponds to the nominal CMS energy " << std::endl;
 	}
 
+	//sqrt(s) factors relative to the nominal energy, e.g. 13000/7000 = 1.857 for a 7 TeV grid at 13 TeV
+	tmp = reader->Get("GRID", "sqrts_sweep", "EMPTY");
+	if(tmp.compare("EMPTY")) {
+	 sqrtssweep = SPXStringUtilities::ParseStringToDoubleVector(tmp, ',');
+	 for(int i = 0; i < sqrtssweep.size(); i++) {
+	  if(sqrtssweep.at(i) <= 0.) {
+	   std::ostringstream oss;
+	   oss << cn << mn << "sqrts_sweep factors must be positive, but factor " << i << " is " << sqrtssweep.at(i);
+	   throw SPXParseException(oss.str());
+	  }
+	 }
+	 std::cout << cn << mn << "Beam energy sweep with " << sqrtssweep.size() << " sqrt(s) factors" << std::endl;
+	}
+
 
 	ParameterName = reader->Get("GRID", "parameter_name", "EMPTY");
 	if(!ParameterName.compare("EMPTY")) {
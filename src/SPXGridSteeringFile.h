@@ -26,6 +26,8 @@
 
 class SPXGridSteeringFile {
 
+	friend class SPXSteeringBundle;
+
 private:
 
 	//INI Reader
@@ -80,6 +82,7 @@ private:
 	unsigned int lowestOrder;
 
 	double changesqrts;
+	std::vector<double> sqrtssweep;		// sqrt(s) factors (new/nominal) of the beam energy sweep
 
 	void SetDefaults(void);
 
@@ -295,6 +298,10 @@ public:
 		return changesqrts;
 	}
 
+	const std::vector<double> & GetSqrtSSweep(void) const {
+		return sqrtssweep;
+	}
+
 	double GetParameterValue(void) const {
   	        return ParameterValue;
         }
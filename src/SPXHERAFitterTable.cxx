@@ -0,0 +1,592 @@
+//************************************************************/
+//
+//	HERAFitter Table Implementation
+//
+//	Implements the SPXHERAFitterTable class
+//
+//	@Author: 	Spectrum contributors
+//	@Date:		19.10.2026
+//
+//************************************************************/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <set>
+#include <sstream>
+
+#include "SPXHERAFitterTable.h"
+#include "SPXFileUtilities.h"
+#include "SPXStageTimer.h"
+#include "SPXStringUtilities.h"
+#include "SPXUtilities.h"
+#include "SPXWorkQueue.h"
+
+//Class name for debug statements
+const std::string cn = "SPXHERAFitterTable::";
+
+//Upper limit on the number of threads used to preload the tables
+const unsigned int MAX_TABLE_THREADS = 8;
+
+const std::string SPX_TABLE_CACHE_MAGIC = "SPXTABLE";
+
+//Must define the static debug variable and the table cache in the implementation
+bool SPXHERAFitterTable::debug;
+std::map<std::string, SPXHERAFitterTable> SPXHERAFitterTable::tableCache;
+
+//A single preload job: the table points into its (already inserted) cache entry
+typedef struct SPXTableLoadJob_t {
+	std::string filename;
+	SPXHERAFitterTable *table;
+	std::string error;
+} SPXTableLoadJob_t;
+
+//Loads one preload job: exceptions are recorded in the job
+void SPXHERAFitterTable::LoadJob(void *context, unsigned int i, unsigned int thread) {
+	SPXTableLoadJob_t &job = ((std::vector<SPXTableLoadJob_t> *)context)->at(i);
+
+	try {
+		job.table->Load(job.filename);
+	} catch(const std::exception &e) {
+		job.error = e.what();
+	} catch(...) {
+		job.error = "Unknown exception";
+	}
+}
+
+static std::string ToLower(std::string s) {
+	for(int i = 0; i < s.size(); i++) {
+		s[i] = tolower(s[i]);
+	}
+
+	return s;
+}
+
+//Splits a Fortran namelist into its assignments: key (lower case, without array index) -> values, with
+//	repetitions ('2*'Bin'', '5*T') expanded
+static void ParseNamelist(const std::string &block, std::map<std::string, std::vector<std::string> > &assignments) {
+	//Tokens: quoted strings, '=' and unquoted words; commas and whitespace only separate tokens
+	std::vector<std::string> tokens;
+	std::vector<bool> quoted;
+
+	for(unsigned int i = 0; i < block.size(); ) {
+		char c = block[i];
+
+		if(c == '\'' || c == '"') {
+			std::string s;
+			i++;
+			while(i < block.size()) {
+				//A doubled quote is a quote character in the string
+				if(block[i] == c) {
+					if(i + 1 < block.size() && block[i + 1] == c) {
+						s += c;
+						i += 2;
+						continue;
+					}
+					break;
+				}
+				s += block[i++];
+			}
+			i++;
+			tokens.push_back(s);
+			quoted.push_back(true);
+		} else if(c == '=') {
+			tokens.push_back("=");
+			quoted.push_back(false);
+			i++;
+		} else if(c == ',' || isspace((unsigned char)c)) {
+			i++;
+		} else {
+			std::string s;
+			while(i < block.size() && block[i] != ',' && block[i] != '=' && block[i] != '\'' && block[i] != '"' && !isspace((unsigned char)block[i])) {
+				s += block[i++];
+			}
+			tokens.push_back(s);
+			quoted.push_back(false);
+		}
+	}
+
+	std::string key;
+	unsigned int repeat = 0;
+
+	for(unsigned int i = 0; i < tokens.size(); i++) {
+		const std::string &t = tokens[i];
+
+		//New assignment: 'key =' (array indices such as CInfo(1) are dropped)
+		if(!quoted[i] && (i + 1 < tokens.size()) && !quoted[i + 1] && (tokens[i + 1] == "=")) {
+			key = ToLower(t.substr(0, t.find('(')));
+			assignments[key].clear();
+			repeat = 0;
+			i++;
+			continue;
+		}
+
+		if(key.empty() || (!quoted[i] && t == "=")) {
+			continue;
+		}
+
+		std::vector<std::string> &values = assignments[key];
+
+		if(!quoted[i]) {
+			size_t star = t.find('*');
+
+			//'N*' followed by the repeated (quoted) value
+			if(star != std::string::npos && star + 1 == t.size()) {
+				repeat = atoi(t.substr(0, star).c_str());
+				continue;
+			}
+
+			//'N*value'
+			if(star != std::string::npos && star > 0) {
+				values.insert(values.end(), atoi(t.substr(0, star).c_str()), t.substr(star + 1));
+				continue;
+			}
+		}
+
+		values.insert(values.end(), repeat ? repeat : 1, t);
+		repeat = 0;
+	}
+}
+
+//Fortran logical: T, F, .true., .false.
+static bool ParseLogical(const std::string &s) {
+	std::string l = ToLower(s);
+	return (!l.empty() && (l[0] == 't' || (l.size() > 1 && l[0] == '.' && l[1] == 't')));
+}
+
+void SPXHERAFitterTable::Parse(const std::string &text) {
+	std::string mn = "Parse: ";
+
+	std::istringstream iss(text);
+	std::string line;
+
+	std::string block;		// Text of the &Data namelist
+	bool inNamelist = false;
+	bool inData = false;
+
+	values.clear();
+	numberOfRows = 0;
+
+	std::vector<std::string> rows;
+
+	while(std::getline(iss, line)) {
+
+		if(!line.empty() && line[line.size() - 1] == '\r') {
+			line.erase(line.size() - 1);
+		}
+
+		std::string t = SPXStringUtilities::Trim(line);
+
+		if(inNamelist) {
+			//'&End' or '/' ends the namelist
+			std::string l = ToLower(t);
+			if(l.compare(0, 4, "&end") == 0 || t == "/") {
+				inNamelist = false;
+				inData = false;
+				continue;
+			}
+
+			if(inData) {
+				//'!' starts a comment (outside of quoted strings, which never contain one in practice)
+				block += line.substr(0, line.find('!'));
+				block += "\n";
+			}
+			continue;
+		}
+
+		//Empty and comment lines
+		if(t.empty() || t[0] == '*' || t[0] == '!' || t[0] == '#' || t[0] == ';') {
+			continue;
+		}
+
+		//Start of a namelist: only &Data describes the table
+		if(t[0] == '&') {
+			inNamelist = true;
+			inData = (ToLower(t).compare(0, 5, "&data") == 0);
+			if(inData) {
+				std::string rest = t.substr(5);
+				block += rest.substr(0, rest.find('!'));
+				block += "\n";
+			}
+			continue;
+		}
+
+		rows.push_back(line);
+	}
+
+	std::map<std::string, std::vector<std::string> > assignments;
+	ParseNamelist(block, assignments);
+
+	if(assignments["ndata"].empty() || assignments["ncolumn"].empty()) {
+		throw SPXParseException(filename, "HERAFitter table: the &Data namelist must give NData and NColumn");
+	}
+
+	unsigned int nData = atoi(assignments["ndata"].at(0).c_str());
+	unsigned int nColumn = atoi(assignments["ncolumn"].at(0).c_str());
+
+	if(!assignments["name"].empty()) {
+		name = assignments["name"].at(0);
+	}
+
+	const std::vector<std::string> &types = assignments["columntype"];
+	const std::vector<std::string> &names = assignments["columnname"];
+	const std::vector<std::string> &percents = assignments["percent"];
+
+	if(types.size() != nColumn || names.size() != nColumn) {
+		std::ostringstream oss;
+		oss << "HERAFitter table: NColumn = " << nColumn << ", but ColumnType has " << types.size() << " and ColumnName has " << names.size() << " entries";
+		throw SPXParseException(filename, oss.str());
+	}
+
+	columnTypes.clear();
+	columnNames.clear();
+	percent.clear();
+
+	unsigned int errorIndex = 0;
+
+	for(int i = 0; i < nColumn; i++) {
+		std::string type = ToLower(SPXStringUtilities::Trim(types[i]));
+
+		if(type == "flag") type = "Flag";
+		else if(type == "bin") type = "Bin";
+		else if(type == "sigma") type = "Sigma";
+		else if(type == "error") type = "Error";
+		else if(type == "dummy") type = "Dummy";
+		else {
+			throw SPXParseException(filename, "HERAFitter table: unknown column type '" + types[i] + "'");
+		}
+
+		columnTypes.push_back(type);
+		columnNames.push_back(SPXStringUtilities::Trim(names[i]));
+
+		//Percent has one flag per Error column, missing flags are false
+		bool p = false;
+		if(type == "Error") {
+			if(errorIndex < percents.size()) p = ParseLogical(percents[errorIndex]);
+			errorIndex++;
+		}
+		percent.push_back(p);
+	}
+
+	if(rows.size() != nData) {
+		std::ostringstream oss;
+		oss << "HERAFitter table: NData = " << nData << ", but the table has " << rows.size() << " rows";
+		throw SPXParseException(filename, oss.str());
+	}
+
+	values.reserve(nData * nColumn);
+
+	for(int i = 0; i < rows.size(); i++) {
+		const char *p = rows[i].c_str();
+		unsigned int n = 0;
+
+		while(true) {
+			char *end;
+			double v = strtod(p, &end);
+			if(end == p) break;
+			values.push_back(v);
+			p = end;
+			n++;
+		}
+
+		//Anything left but whitespace is not a number
+		while(*p && isspace((unsigned char)*p)) p++;
+
+		if(*p || n != nColumn) {
+			std::ostringstream oss;
+			oss << "HERAFitter table: row " << i + 1 << " has " << n << " numbers, but NColumn = " << nColumn << ": " << rows[i];
+			throw SPXParseException(filename, oss.str());
+		}
+	}
+
+	numberOfRows = nData;
+}
+
+//Binary copy: appends/reads raw bytes
+static void PutBytes(std::string &buffer, const void *p, std::size_t n) {
+	buffer.append((const char *)p, n);
+}
+
+static void PutStringBytes(std::string &buffer, const std::string &s) {
+	unsigned int n = s.size();
+	PutBytes(buffer, &n, sizeof(n));
+	buffer.append(s);
+}
+
+static bool GetBytes(const std::string &buffer, std::size_t &position, void *p, std::size_t n) {
+	if(position + n > buffer.size()) return false;
+	memcpy(p, buffer.data() + position, n);
+	position += n;
+	return true;
+}
+
+static bool GetStringBytes(const std::string &buffer, std::size_t &position, std::string &s) {
+	unsigned int n = 0;
+	if(!GetBytes(buffer, position, &n, sizeof(n)) || position + n > buffer.size()) return false;
+	s.assign(buffer, position, n);
+	position += n;
+	return true;
+}
+
+void SPXHERAFitterTable::WriteCache(const std::string &cacheFilename, unsigned long long checksum, unsigned long long size) const {
+	std::string mn = "WriteCache: ";
+
+	std::string buffer = SPX_TABLE_CACHE_MAGIC;
+
+	unsigned int version = SPX_TABLE_CACHE_VERSION;
+	unsigned int layout = SPXFileUtilities::GetBinaryLayout();
+	PutBytes(buffer, &version, sizeof(version));
+	PutBytes(buffer, &layout, sizeof(layout));
+	PutBytes(buffer, &size, sizeof(size));
+	PutBytes(buffer, &checksum, sizeof(checksum));
+
+	PutStringBytes(buffer, name);
+
+	unsigned int rows = numberOfRows;
+	unsigned int columns = columnNames.size();
+	PutBytes(buffer, &rows, sizeof(rows));
+	PutBytes(buffer, &columns, sizeof(columns));
+
+	for(int i = 0; i < columns; i++) {
+		PutStringBytes(buffer, columnTypes[i]);
+		PutStringBytes(buffer, columnNames[i]);
+		unsigned char p = percent[i] ? 1 : 0;
+		PutBytes(buffer, &p, sizeof(p));
+	}
+
+	if(!values.empty()) {
+		PutBytes(buffer, &values[0], values.size() * sizeof(double));
+	}
+
+	unsigned long long total = SPXFileUtilities::GetChecksum(buffer.data(), buffer.size());
+	PutBytes(buffer, &total, sizeof(total));
+
+	//Written next to the table, which may be read-only: the cache is then just not used
+	std::string tmp = cacheFilename + ".tmp";
+	std::ofstream file(tmp.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+
+	if(!file.is_open()) {
+		if(debug) std::cout << cn << mn << "Cannot write " << tmp << ": table is not cached" << std::endl;
+		return;
+	}
+
+	file.write(buffer.data(), buffer.size());
+	file.close();
+
+	if(!file || rename(tmp.c_str(), cacheFilename.c_str()) != 0) {
+		remove(tmp.c_str());
+		if(debug) std::cout << cn << mn << "Cannot write " << cacheFilename << ": table is not cached" << std::endl;
+	}
+}
+
+//False if the binary copy is missing, damaged, written by another version or machine type, or not of this text
+bool SPXHERAFitterTable::ReadCache(const std::string &cacheFilename, unsigned long long checksum, unsigned long long size) {
+	std::string buffer;
+
+	if(!SPXFileUtilities::ReadFile(cacheFilename, buffer)) {
+		return false;
+	}
+
+	std::size_t position = SPX_TABLE_CACHE_MAGIC.size();
+	unsigned long long total = 0;
+
+	if(buffer.size() < position + sizeof(total) || buffer.compare(0, position, SPX_TABLE_CACHE_MAGIC) != 0) {
+		return false;
+	}
+
+	std::size_t end = buffer.size() - sizeof(total);
+	memcpy(&total, buffer.data() + end, sizeof(total));
+
+	if(total != SPXFileUtilities::GetChecksum(buffer.data(), end)) {
+		return false;
+	}
+
+	buffer.resize(end);
+
+	unsigned int version = 0;
+	unsigned int layout = 0;
+	unsigned long long sourceSize = 0;
+	unsigned long long sourceChecksum = 0;
+
+	if(!GetBytes(buffer, position, &version, sizeof(version)) || !GetBytes(buffer, position, &layout, sizeof(layout)) ||
+	   !GetBytes(buffer, position, &sourceSize, sizeof(sourceSize)) || !GetBytes(buffer, position, &sourceChecksum, sizeof(sourceChecksum))) {
+		return false;
+	}
+
+	if(version != SPX_TABLE_CACHE_VERSION || layout != SPXFileUtilities::GetBinaryLayout() || sourceSize != size || sourceChecksum != checksum) {
+		return false;
+	}
+
+	SPXHERAFitterTable table;
+	unsigned int rows = 0;
+	unsigned int columns = 0;
+
+	if(!GetStringBytes(buffer, position, table.name) || !GetBytes(buffer, position, &rows, sizeof(rows)) || !GetBytes(buffer, position, &columns, sizeof(columns))) {
+		return false;
+	}
+
+	for(int i = 0; i < columns; i++) {
+		std::string type;
+		std::string columnName;
+		unsigned char p = 0;
+
+		if(!GetStringBytes(buffer, position, type) || !GetStringBytes(buffer, position, columnName) || !GetBytes(buffer, position, &p, sizeof(p))) {
+			return false;
+		}
+
+		table.columnTypes.push_back(type);
+		table.columnNames.push_back(columnName);
+		table.percent.push_back(p != 0);
+	}
+
+	std::size_t n = (std::size_t)rows * columns;
+	if(buffer.size() - position != n * sizeof(double)) {
+		return false;
+	}
+
+	table.values.resize(n);
+	if(n) memcpy(&table.values[0], buffer.data() + position, n * sizeof(double));
+
+	name = table.name;
+	numberOfRows = rows;
+	columnTypes.swap(table.columnTypes);
+	columnNames.swap(table.columnNames);
+	percent.swap(table.percent);
+	values.swap(table.values);
+
+	return true;
+}
+
+//The text is always read to compare its checksum with the binary copy: hashing is much cheaper than
+//	converting every number of the table
+void SPXHERAFitterTable::Load(const std::string &filename) {
+	std::string mn = "Load: ";
+
+	std::string text;
+	if(!SPXFileUtilities::ReadFile(filename, text)) {
+		throw SPXFileIOException(filename, "Unable to open HERAFitter table");
+	}
+
+	unsigned long long checksum = SPXFileUtilities::GetChecksum(text.data(), text.size());
+	std::string cacheFilename = GetCacheFilename(filename);
+
+	this->filename = filename;
+	this->checksum = checksum;
+	this->size = text.size();
+
+	if(ReadCache(cacheFilename, checksum, text.size())) {
+		if(debug) std::cout << cn << mn << "Read " << filename << " from " << cacheFilename << std::endl;
+		return;
+	}
+
+	Parse(text);
+	WriteCache(cacheFilename, checksum, text.size());
+
+	if(debug) std::cout << cn << mn << "Parsed " << filename << ": " << numberOfRows << " rows, " << columnNames.size() << " columns" << std::endl;
+}
+
+//The text is hashed again: a table rewritten within the same second, or copied over with its old time, is not
+//	taken from the cache
+bool SPXHERAFitterTable::IsCached(const std::string &filename) {
+	std::map<std::string, SPXHERAFitterTable>::iterator it = tableCache.find(filename);
+
+	if(it == tableCache.end()) {
+		return false;
+	}
+
+	std::string text;
+	if(!SPXFileUtilities::ReadFile(filename, text)) {
+		return false;
+	}
+
+	return (it->second.size == text.size()) && (it->second.checksum == SPXFileUtilities::GetChecksum(text.data(), text.size()));
+}
+
+const SPXHERAFitterTable & SPXHERAFitterTable::Get(const std::string &filename) {
+	std::string mn = "Get: ";
+	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+	if(!IsCached(filename)) {
+		SPXHERAFitterTable table;
+		table.Load(filename);
+		tableCache[filename] = table;
+	}
+
+	return tableCache[filename];
+}
+
+void SPXHERAFitterTable::Preload(const std::vector<std::string> &filenames) {
+	std::string mn = "Preload: ";
+	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+	SPXStageScope stage("load");
+
+	//Cache entries are inserted here, so that the threads only ever write into their own map node
+	std::vector<SPXTableLoadJob_t> jobs;
+	std::set<std::string> seen;
+
+	for(int i = 0; i < filenames.size(); i++) {
+		const std::string &filename = filenames[i];
+
+		if(filename.empty() || !seen.insert(filename).second || IsCached(filename)) {
+			continue;
+		}
+
+		SPXTableLoadJob_t job;
+		job.filename = filename;
+		job.table = &(tableCache[filename] = SPXHERAFitterTable());
+		jobs.push_back(job);
+	}
+
+	if(jobs.empty()) {
+		return;
+	}
+
+	//Keep debug output readable by parsing serially in debug mode
+	unsigned int numberOfThreads = SPXWorkQueue::GetNumberOfThreads(jobs.size(), MAX_TABLE_THREADS);
+	if(debug) numberOfThreads = 1;
+
+	if(debug) std::cout << cn << mn << "Loading " << jobs.size() << " HERAFitter table(s) with " << numberOfThreads << " thread(s)" << std::endl;
+
+	SPXWorkQueue::Run(LoadJob, &jobs, jobs.size(), numberOfThreads, "table load");
+
+	//Failed tables are dropped from the cache: the error is reported by the plot using the table (Get)
+	for(int i = 0; i < jobs.size(); i++) {
+		if(!jobs[i].error.empty()) {
+			if(debug) std::cout << cn << mn << "Could not preload " << jobs[i].filename << ": " << jobs[i].error << std::endl;
+			tableCache.erase(jobs[i].filename);
+		}
+	}
+}
+
+int SPXHERAFitterTable::GetColumnIndex(const std::string &columnName) const {
+	for(int i = 0; i < columnNames.size(); i++) {
+		if(columnNames[i] == columnName) return i;
+	}
+
+	return -1;
+}
+
+std::vector<unsigned int> SPXHERAFitterTable::GetColumnsOfType(const std::string &type) const {
+	std::vector<unsigned int> columns;
+
+	for(int i = 0; i < columnTypes.size(); i++) {
+		if(columnTypes[i] == type) columns.push_back(i);
+	}
+
+	return columns;
+}
+
+void SPXHERAFitterTable::Print(void) const {
+	std::cout << std::endl << "HERAFitter Table: " << filename << std::endl;
+	std::cout << "\t Name: " << name << std::endl;
+	std::cout << "\t Rows: " << numberOfRows << ", Columns: " << columnNames.size() << std::endl;
+
+	for(int i = 0; i < columnNames.size(); i++) {
+		std::cout << "\t\t " << std::left << std::setw(6) << i << std::setw(8) << columnTypes[i] << std::setw(24) << columnNames[i]
+		          << (percent[i] ? "percent" : "") << std::right << std::endl;
+	}
+}
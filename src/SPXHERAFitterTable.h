@@ -0,0 +1,135 @@
+//************************************************************/
+//
+//	HERAFitter Table Header
+//
+//	Outlines the SPXHERAFitterTable class, which reads a data
+//	table in the HERAFitter (xFitter) format: the &Data namelist
+//	(NData, NColumn, ColumnType, ColumnName, Percent) followed by
+//	NData rows of NColumn numbers. Column types are expanded
+//	('2*'Bin'' gives two 'Bin' columns), and every column can be
+//	accessed by its name.
+//
+//	Parsed tables are cached in memory, keyed by file name and
+//	checksum of the text, and on disk in a binary copy next to the
+//	table (<table>.spxt) holding the size and checksum of the
+//	text it was parsed from: as long as the table is unchanged,
+//	the binary copy is read instead of parsing the text. Preload
+//	parses the tables of a steering file concurrently.
+//
+//	@Author: 	Spectrum contributors
+//	@Date:		19.10.2026
+//
+//************************************************************/
+
+#ifndef SPXHERAFITTERTABLE_H
+#define SPXHERAFITTERTABLE_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include <time.h>
+
+#include "SPXException.h"
+
+//Must be incremented whenever the layout of the binary copy changes
+const unsigned int SPX_TABLE_CACHE_VERSION = 1;
+
+class SPXHERAFitterTable {
+
+public:
+	SPXHERAFitterTable(void) : numberOfRows(0), checksum(0), size(0) {}
+
+	//Parsed table of the file, from the in-memory cache if the file did not change
+	static const SPXHERAFitterTable & Get(const std::string &filename);
+
+	//Parses the tables not cached yet, concurrently
+	static void Preload(const std::vector<std::string> &filenames);
+
+	static void ClearCache(void) {
+		tableCache.clear();
+	}
+
+	static std::string GetCacheFilename(const std::string &filename) {
+		return filename + ".spxt";
+	}
+
+	const std::string & GetFilename(void) const {
+		return filename;
+	}
+
+	const std::string & GetName(void) const {
+		return name;
+	}
+
+	unsigned int GetNumberOfRows(void) const {
+		return numberOfRows;
+	}
+
+	unsigned int GetNumberOfColumns(void) const {
+		return columnNames.size();
+	}
+
+	const std::string & GetColumnName(unsigned int column) const {
+		return columnNames.at(column);
+	}
+
+	//Flag, Bin, Sigma, Error or Dummy
+	const std::string & GetColumnType(unsigned int column) const {
+		return columnTypes.at(column);
+	}
+
+	//Errors only: given in percent of Sigma
+	bool IsPercent(unsigned int column) const {
+		return percent.at(column);
+	}
+
+	//Index of the column, or -1 if there is none with that name
+	int GetColumnIndex(const std::string &columnName) const;
+
+	//Indices of all columns of the type, in table order
+	std::vector<unsigned int> GetColumnsOfType(const std::string &type) const;
+
+	double GetValue(unsigned int row, unsigned int column) const {
+		return values.at(row * columnNames.size() + column);
+	}
+
+	void Print(void) const;
+
+	static bool GetDebug(void) {
+		return debug;
+	}
+
+	static void SetDebug(bool b) {
+		debug = b;
+	}
+
+private:
+	static bool debug;
+
+	//Parsed tables keyed by file name, shared by all plots in the process
+	static std::map<std::string, SPXHERAFitterTable> tableCache;
+
+	std::string filename;
+	std::string name;			// Name of the &Data namelist
+	unsigned int numberOfRows;
+	std::vector<std::string> columnTypes;
+	std::vector<std::string> columnNames;
+	std::vector<bool> percent;		// One per column: false for non-Error columns
+	std::vector<double> values;		// Row by row
+	unsigned long long checksum;		// Checksum of the text the table was read from
+	unsigned long long size;		// Size of that text
+
+	//Reads the table from its binary copy or parses it (and writes the binary copy): may run in a preload thread
+	void Load(const std::string &filename);
+
+	void Parse(const std::string &text);
+	bool ReadCache(const std::string &cacheFilename, unsigned long long checksum, unsigned long long size);
+	void WriteCache(const std::string &cacheFilename, unsigned long long checksum, unsigned long long size) const;
+
+	static bool IsCached(const std::string &filename);
+
+	//Preload job (SPXWorkQueue): loads one table
+	static void LoadJob(void *context, unsigned int job, unsigned int thread);
+};
+
+#endif
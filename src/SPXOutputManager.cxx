@@ -0,0 +1,172 @@
+//************************************************************/
+//
+//	Output Manager Implementation
+//
+//	Implements the SPXOutputManager class
+//
+//	@Author: 	Spectrum contributors
+//	@Date:		19.10.2026
+//
+//************************************************************/
+
+#include <algorithm>
+#include <ctime>
+
+#include "TSystem.h"
+
+#include "SPXOutputManager.h"
+#include "SPXUtilities.h"
+#include "SPXStageTimer.h"
+
+//Class name for debug statements
+const std::string cn = "SPXOutputManager::";
+
+//Must define the static debug variable in the implementation
+bool SPXOutputManager::debug;
+
+std::vector<SPXRasterJob_t *> SPXOutputManager::jobs;
+unsigned int SPXOutputManager::failures = 0;
+
+SPXOutputManager::SPXOutputManager(const std::vector<std::string> &formats) {
+	std::string mn = "SPXOutputManager: ";
+
+	for(int i = 0; i < formats.size(); i++) {
+		if(std::find(this->formats.begin(), this->formats.end(), formats[i]) == this->formats.end()) {
+			this->formats.push_back(formats[i]);
+		}
+	}
+}
+
+//Format of a file name: its extension
+std::string SPXOutputManager::GetFormat(const std::string &filename) {
+	size_t pos = filename.find_last_of('.');
+
+	if(pos == std::string::npos) {
+		return std::string();
+	}
+
+	return filename.substr(pos + 1);
+}
+
+//basename.<format> for each format
+std::vector<std::string> SPXOutputManager::GetFilenames(const std::string &basename) const {
+	std::vector<std::string> filenames;
+
+	for(int i = 0; i < formats.size(); i++) {
+		filenames.push_back(basename + "." + formats[i]);
+	}
+
+	return filenames;
+}
+
+//Writes the (painted) canvas to each file, in the format of its extension: vector files are printed
+// here, raster files are written in the background from one capture of the canvas, and files of
+// any other format are left to TCanvas::Print
+void SPXOutputManager::Write(TCanvas *canvas, const std::vector<std::string> &filenames) {
+	std::string mn = "Write: ";
+	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+	if(!canvas) {
+		throw SPXGraphException(cn + mn + "Canvas is NULL");
+	}
+
+	std::vector<std::string> raster;
+
+	for(int i = 0; i < filenames.size(); i++) {
+		std::string format = GetFormat(filenames[i]);
+
+		if(IsRasterFormat(format)) {
+			if(std::find(raster.begin(), raster.end(), filenames[i]) == raster.end()) {
+				raster.push_back(filenames[i]);
+			}
+		} else {
+			if(debug) std::cout << cn << mn << "Print " << filenames[i] << std::endl;
+			canvas->Print(filenames[i].c_str());
+		}
+	}
+
+	if(raster.empty()) {
+		return;
+	}
+
+	//Painting is not thread safe: the capture is made here, only the encoding runs in the background
+	TImage *image = TImage::Create();
+	if(!image) {
+		throw SPXROOTException(cn + mn + "Unable to create an image of the canvas: no ROOT image library");
+	}
+	image->FromPad(canvas);
+
+	//Bound the memory held by the captures waiting to be written
+	while(jobs.size() >= MAX_PENDING_RASTER_JOBS) {
+		Join(jobs.front());
+		jobs.erase(jobs.begin());
+	}
+
+	SPXRasterJob_t *job = new SPXRasterJob_t;
+	job->image = image;
+	job->filenames = raster;
+	job->start = time(0);
+
+	if(pthread_create(&job->thread, NULL, WriteImages, job) != 0) {
+		std::cerr << cn << mn << "WARNING: Unable to start a thread: raster files are written now" << std::endl;
+		WriteImages(job);
+		delete image;
+		delete job;
+		return;
+	}
+
+	jobs.push_back(job);
+}
+
+//Runs on the encoder thread: it only touches its own TImage, captured by FromPad on the main thread, and
+// WriteImage only encodes that libAfterImage buffer to a file (no pad, gPad or gVirtualX is used). The
+// ROOT globals it may still reach (type lookups, error handler) are guarded since main enabled the ROOT
+// thread safety
+void * SPXOutputManager::WriteImages(void *arg) {
+	SPXRasterJob_t *job = (SPXRasterJob_t *)arg;
+
+	for(int i = 0; i < job->filenames.size(); i++) {
+		job->image->WriteImage(job->filenames[i].c_str());
+	}
+
+	return 0;
+}
+
+void SPXOutputManager::Join(SPXRasterJob_t *job) {
+	std::string mn = "Join: ";
+
+	pthread_join(job->thread, NULL);
+
+	for(int i = 0; i < job->filenames.size(); i++) {
+		//A file left from an earlier run is not a success: it must be written (modified) since the job started
+		Long_t id, flags, modtime;
+		Long64_t size;
+		bool written = (gSystem->GetPathInfo(job->filenames[i].c_str(), &id, &size, &flags, &modtime) == 0)
+		               && (size > 0) && (modtime >= job->start);
+
+		if(!written) {
+			std::cerr << cn << mn << "WARNING: Could not write " << job->filenames[i] << std::endl;
+			failures++;
+		} else if(debug) {
+			std::cout << cn << mn << "Wrote " << job->filenames[i] << std::endl;
+		}
+	}
+
+	delete job->image;
+	delete job;
+}
+
+//Waits until all raster files are written; returns the number of files which could not be written
+unsigned int SPXOutputManager::Wait(void) {
+	SPXStageScope stage("write");
+
+	for(int i = 0; i < jobs.size(); i++) {
+		Join(jobs[i]);
+	}
+	jobs.clear();
+
+	unsigned int n = failures;
+	failures = 0;
+
+	return n;
+}
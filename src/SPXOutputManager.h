@@ -0,0 +1,93 @@
+//************************************************************/
+//
+//	Output Manager Header
+//
+//	Outlines the SPXOutputManager class, which writes a canvas
+//	in all graphic formats of the steering file (output_graphicformat,
+//	a comma separated list of png, gif, jpg, pdf, eps, ps, svg; other
+//	formats are passed to TCanvas::Print as they are).
+//
+//	The canvas is painted once (SPXPlot::UpdateCanvas) before it
+//	is written: the vector formats are printed from the painted
+//	canvas one after the other, and the raster formats share one
+//	capture of the canvas, which is encoded and written by a
+//	background thread while the next plot is computed.
+//	SPXOutputManager::Wait must be called before the files are
+//	used (and before the process forks or exits).
+//
+//	@Author: 	Spectrum contributors
+//	@Date:		19.10.2026
+//
+//************************************************************/
+
+#ifndef SPXOUTPUTMANAGER_H
+#define SPXOUTPUTMANAGER_H
+
+#include <string>
+#include <vector>
+#include <ctime>
+#include <pthread.h>
+
+#include "SPXROOT.h"
+#include "TImage.h"
+#include "SPXException.h"
+
+//Raster captures being written at the same time, at most
+const unsigned int MAX_PENDING_RASTER_JOBS = 4;
+
+//One capture of a canvas written to one or more raster files
+typedef struct SPXRasterJob_t {
+	pthread_t thread;
+	TImage *image;
+	std::vector<std::string> filenames;
+	time_t start;				// Files older than this were not written by the job
+} SPXRasterJob_t;
+
+class SPXOutputManager {
+
+public:
+	explicit SPXOutputManager(const std::vector<std::string> &formats);
+
+	std::vector<std::string> GetFilenames(const std::string &basename) const;
+	void Write(TCanvas *canvas, const std::vector<std::string> &filenames);
+
+	const std::vector<std::string> & GetFormats(void) const {
+		return formats;
+	}
+
+	static unsigned int Wait(void);
+
+	static bool IsValidFormat(const std::string &format) {
+		return IsRasterFormat(format) || IsVectorFormat(format);
+	}
+
+	static bool IsRasterFormat(const std::string &format) {
+		return (format == "png") || (format == "gif") || (format == "jpg");
+	}
+
+	static bool IsVectorFormat(const std::string &format) {
+		return (format == "pdf") || (format == "eps") || (format == "ps") || (format == "svg");
+	}
+
+	static std::string GetFormat(const std::string &filename);
+
+	static bool GetDebug(void) {
+		return debug;
+	}
+
+	static void SetDebug(bool b) {
+		debug = b;
+	}
+
+private:
+	static bool debug;				// Flag indicating debug mode
+	static std::vector<SPXRasterJob_t *> jobs;	// Raster jobs not joined yet, oldest first
+	static unsigned int failures;			// Raster files not written since the last Wait
+
+	std::vector<std::string> formats;		// Graphic formats, in steering file order
+
+	static void Join(SPXRasterJob_t *job);
+	static void * WriteImages(void *arg);
+};
+
+#endif
@@ -108,6 +108,8 @@ public:
 		return false;
 	}
 
+	friend class SPXSteeringBundle;
+
 private:
 	static bool debug;
 	unsigned int style;
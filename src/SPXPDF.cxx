@@ -10,9 +10,15 @@
 //
 //************************************************************/
 
+#include <algorithm>
+#include <map>
 #include <sstream>
+#include <pthread.h>
 
 #include "SPXPDF.h"
+#include "SPXArena.h"
+#include "SPXStageTimer.h"
+#include "SPXWorkQueue.h"
 
 //Patch for faulty G++ compiler <string> guards...
 // Somewhere in <string> there is an issue where there are some #ifdef guards
@@ -34,6 +40,9 @@ const std::string cn = "SPXPDF::";
 //Must define the static debug variable in the implementation
 bool SPXPDF::debug;
 
+//Upper limit on the threads sweeping PDF members in FillPdfBands
+const unsigned int MAX_SWEEP_THREADS = 8;
+
 
 std::string SPXPDF::GetEnv( const std::string & var ) {
 		const char* res= getenv( var.c_str() );
@@ -46,6 +55,15 @@ std::string SPXPDF::GetEnv( const std::string & var ) {
 #if defined LHAPDF_MAJOR_VERSION && LHAPDF_MAJOR_VERSION == 6
 // version 6
 LHAPDF::PDF* mypdf=0;
+
+//PDF members are loaded once per (set, member) and kept until TrimPDFMemberCache drops the least recently used
+typedef struct SPXPDFMemberCacheEntry_t {
+ LHAPDF::PDF *pdf;
+ unsigned long lastUse;
+} SPXPDFMemberCacheEntry_t;
+
+std::map<std::pair<std::string, int>, SPXPDFMemberCacheEntry_t> lhapdfMemberCache;
+unsigned long lhapdfMemberRequests=0;
 //void getPDF(const double &X, const double &Q, double xfs[13]) {
 void getPDF(const double &X, const double &Q, double *xfs) {
   std::vector <double> xf; xf.resize(13);
@@ -78,7 +96,6 @@ void getPDF(const double& x, const double& Q, double* xf) {
 
 #endif
 
-
 /******************************************************************
  ** Method Implementations
  ******************************************************************/
@@ -91,6 +108,8 @@ SPXPDF::SPXPDF(SPXPDFSteeringFile *psf, int iflpdf, double Q2value, TH1D* h1)
  //
  SetVariablesDefault();
  gridName="";
+ spxgrid=0;
+ my_grid=0;
  nLoops = 1; //default is NLO, steering will overwrite
 
  ReadPDFSteeringFile(psf);
@@ -113,6 +132,31 @@ SPXPDF::SPXPDF(SPXPDFSteeringFile *psf, int iflpdf, double Q2value, TH1D* h1)
  if (debug) std::cout<<cn<<"SPXPDF: end constructor PDF-only "<<std::endl;
 }
 
+SPXPDF::SPXPDF(SPXPDFSteeringFile *psf)
+{
+ //
+ // constructor for PDF-vs-x bands (FillPdfBands) without grid or histogram
+ //
+ SetVariablesDefault();
+ gridName="";
+ spxgrid=0;
+ my_grid=0;
+ hpdf=0;
+ ifl=0;
+ Q2=0;
+ nLoops = 1;
+
+ ReadPDFSteeringFile(psf);
+
+#if defined LHAPDF_MAJOR_VERSION && LHAPDF_MAJOR_VERSION == 6
+ default_pdf_set_name = (std::string) (PDFname);
+#else
+ default_pdf_set_name = (std::string) (pdfSetPath+"/"+PDFname+".LHgrid");
+#endif
+
+ ParameterScan=false;
+}
+
 SPXPDF::SPXPDF(SPXPDFSteeringFile *psf, const std::string &_gridName)
 {
   //
@@ -325,54 +369,16 @@ TH1D *  SPXPDF::GetHisto(double renscale, double facscale){
 
  } else {
   applgridok=false;
-  TH1D *htmp=0;
- 
-  for (int igrid=0; igrid<ngrid; igrid++) {
-   my_grid=spxgrid->GetGrid(igrid);
-   if (!my_grid) { 
-    if (debug) std::cout<<cn<<mn<<"igrid= "<<igrid<<"No applgrid found gridname= "<<TString(gridName).Data()<<std::endl;
-    throw SPXParseException(cn+mn+"Grid not found !");
-   }
- 
-   gridName=spxgrid->GetName();
- 
-   htmp= (TH1D*) my_grid->convolute( getPDF, alphasPDF, nLoops, renscale, facscale, xEscale);
-   if (!htmp) {
-    throw SPXParseException(cn+mn+"Can not find histogram from convolution !");
-   }
-
-   gridName=GetName(gridName);
-   htmp->SetName(gridName.c_str());
-   if (debug) {
-    std::cout<<cn<<mn<<" igrid= "<<igrid<<" adding "<<gridName<<std::endl;
 
-    std::cout<<cn<<mn<<"Print "<<htmp->GetName()<<std::endl;
-    htmp->Print("all");
-   }
-
-   //if (do_AlternativeScaleChoice && (renscale==1&&facscale==1)) {
-   // appl::grid *gridAlternativeScaleChoice=spxgrid->GetGridAlternativeScaleChoice(igrid);
-   // if (!gridAlternativeScaleChoice) {
-   //  throw SPXParseException(cn+mn+"Alternative scale choice grid not found !");
-   // }
+  // sub-grids (e.g. gg, qqbar, qg) are one logical grid: summed into a single histogram
+  htmpsum=this->ConvoluteSubGrids(renscale, facscale, xEscale);
 
-   // htmpAlternativeScaleChoice= (TH1D*) gridAlternativeScaleChoice->convolute( getPDF, alphasPDF, nLoops, renscale, facscale, xEscale);
-   // if (!htmpAlternativeScaleChoice) {
-   //  throw SPXParseException(cn+mn+"Can not find AlternativeScaleChoice histogram from convolution !");
-   // }
-   //}
+  gridName=GetName(spxgrid->GetName());
+  htmpsum->SetName(gridName.c_str());
 
-   if (igrid==0) {
-    htmpsum=htmp;
-    //if (do_AlternativeScaleChoice && (renscale==1&&facscale==1)) htmpsumAlternativeScaleChoice=htmpAlternativeScaleChoice;
-   } else {
-    SPXGraphUtilities::Add(htmpsum,htmp);
-    //if (do_AlternativeScaleChoice && (renscale==1&&facscale==1) ) SPXGraphUtilities::Add(htmpsumAlternativeScaleChoice,htmpAlternativeScaleChoice);
-   }
-   if (debug) {
-    std::cout<<cn<<mn<<"igrid= "<<igrid<<" Print "<<htmpsum->GetName()<<std::endl;
-    htmpsum->Print("all");
-   }
+  if (debug) {
+   std::cout<<cn<<mn<<"Sum of "<<ngrid<<" grids "<<htmpsum->GetName()<<std::endl;
+   htmpsum->Print("all");
   }
  }
   
@@ -462,7 +468,7 @@ void SPXPDF::Initialize()
  }
 
  // If beam energy comes from Grid steering change everything
- double GridEscale=spxgrid->GetChangeSqrtS();
+ double GridEscale=spxgrid ? spxgrid->GetChangeSqrtS() : 1.;
 
  if (GridEscale!=1.) {
   Escale=GridEscale;
@@ -534,6 +540,12 @@ void SPXPDF::Initialize()
  h_errors_Scale.clear();
  h_errors_AlternativeScaleChoice.clear();
  h_errors_BeamUncertainty.clear();
+ beamEnergySweepFactors.clear();
+ for (int i=0; i<h_BeamEnergySweepRatio.size(); ++i) {
+  delete h_BeamEnergySweepRatio.at(i);
+ }
+ h_BeamEnergySweepRatio.clear();
+ h_errors_AlternativeScaleChoicePDF.clear();
 
  TH1D* temp_hist=0;
 
@@ -655,7 +667,7 @@ void SPXPDF::Initialize()
  // set-up defaults
  if (do_AlphaS) {
   h_errors_AlphaS.push_back(temp_hist);
-  h_AlphaS_results=SPXGraphUtilities::TH1TOTGraphAsymm(temp_hist);
+  h_AlphaS_results=SPXArena::AdoptCurrent(SPXGraphUtilities::TH1TOTGraphAsymm(temp_hist));
   std::string name="xsec_alphas_"+default_pdf_set_name;
   //if (spxgrid) name+="_"+gridName;;
   name=GetName(name);
@@ -663,7 +675,7 @@ void SPXPDF::Initialize()
  }
 
  if (do_Scale)   {
-  h_Scale_results=SPXGraphUtilities::TH1TOTGraphAsymm(temp_hist);
+  h_Scale_results=SPXArena::AdoptCurrent(SPXGraphUtilities::TH1TOTGraphAsymm(temp_hist));
   std::string name="xsec_scale_"+default_pdf_set_name;
   //if (spxgrid) name+="_"+gridName;
   name=GetName(name);
@@ -672,7 +684,7 @@ void SPXPDF::Initialize()
 
  if (do_AlternativeScaleChoice)   {
   std::string gridNameAlternativeScaleChoice="";
-  h_AlternativeScaleChoice_results=SPXGraphUtilities::TH1TOTGraphAsymm(temp_hist);
+  h_AlternativeScaleChoice_results=SPXArena::AdoptCurrent(SPXGraphUtilities::TH1TOTGraphAsymm(temp_hist));
   //TString name="xsec_AlternativeScaleChoice_"+default_pdf_set_name;
   std::string name="xsec_AlternativeScaleChoice_"+default_pdf_set_name;
   if (spxgrid) {
@@ -686,14 +698,14 @@ void SPXPDF::Initialize()
  }
 
  if (do_PDFBand) {
-  h_PDF_results=SPXGraphUtilities::TH1TOTGraphAsymm(temp_hist);
+  h_PDF_results=SPXArena::AdoptCurrent(SPXGraphUtilities::TH1TOTGraphAsymm(temp_hist));
   std::string name="xsec_pdf_"+default_pdf_set_name;
   name=GetName(name);
   if (h_PDF_results) h_PDF_results->SetName(name.c_str());
  }
 
  if (do_Escale) {
-  h_BeamUncertainty_results=SPXGraphUtilities::TH1TOTGraphAsymm(temp_hist);
+  h_BeamUncertainty_results=SPXArena::AdoptCurrent(SPXGraphUtilities::TH1TOTGraphAsymm(temp_hist));
   std::string name="xsec_BeamUncertainty_"+default_pdf_set_name;
   //if (spxgrid) name+="_"+gridName;
   name=GetName(name);
@@ -776,6 +788,7 @@ void SPXPDF::Initialize()
      hratio->Divide(hdef);
      //std::cout<<cn<<mn<<" hvariation["<<iscale<<"]="<<hvar->GetName()<<std::endl;
      hratio->Print("all");
+     delete hratio;
     }
    }
   }
@@ -1034,112 +1047,31 @@ void SPXPDF::Initialize()
 // 
 */
   TH1D *hdefault=0;
-  for (int pdferri = 0; pdferri < n_PDFMembers; pdferri++) {
-   if (debug) std::cout<<cn<<mn<<"pdferri: "<<pdferri<<" of "<<n_PDFMembers<<" pdftype="<<PDFtype.c_str()<<std::endl;
-
-   if (ErrorPropagationType==StyleHeraPDF) {
-    if (!includeEIG&&!includeQUAD&&!includeMAX) std::cout<<cn<<mn<<"No error band included !! "<<std::endl;
-
-    if (defaultpdfidvar<0) {
-     std::cout<<cn<<mn<<"WARNING: No default PDF id found in steering. Check steering for missing 'defaultpdfidvar'. pdferri= "<<pdferri<<std::endl;
-     std::cerr<<cn<<mn<<"WARNING: No default PDF id found in steering. Check steering for missing 'defaultpdfidvar'. pdferri= "<<pdferri<<std::endl;
-    }
-
-    if (pdferri <= lasteig ) {
-#ifdef TIMER
-     quick_timer ti;
-     std::cout<<cn<<mn<<"TIMER call initPDF/mkPDF pdferri <= lasteig PDF= "<<PDFname.c_str()<<" pdferri= "<<pdferri<<" running..." << std::endl; 
-     quick_timer t0;
-#endif
-     this->SetLHAPDFPDFset(PDFname, pdferri);
-     //#if defined LHAPDF_MAJOR_VERSION && LHAPDF_MAJOR_VERSION == 6
-     // if (debug) std::cout<<cn<<mn<<"...mkPDF "<<PDFname.c_str()<<" pdferri= "<<pdferri<<std::endl;
-     // mypdf=LHAPDF::mkPDF(PDFname.c_str(), pdferri);
-     //#else
-     // if (debug) std::cout<<cn<<mn<<"...initPDFSet "<<PDFname.c_str()<<" pdferri= "<<pdferri<<std::endl;
-     // LHAPDF::initPDF(pdferri);
-     //#endif
 
-#ifdef TIMER
-      std::cout<<cn<<mn<<"TIMER done call initPDF/mkPDF t0= " << t0.time()<<" [ms]"<<std::endl;
-#endif
+  if (!applgridok) {
+   // PDF-only: evaluate all members in one sweep, at the same x points as FillPdfHisto
+   const double xmin=hpdf->GetBinCenter(1);
+   const int    nbin=hpdf->GetNbinsX();
+   const double xmax=hpdf->GetBinWidth(nbin)/2.+hpdf->GetBinCenter(nbin);
+   std::vector<double> xvalues(nbin);
+   for (int i=0; i<nbin; i++) xvalues[i]=xmin+i*(xmax-xmin)/nbin;
+   this->FillPdfBands(std::vector<double>(1,Q2), xvalues);
+  }
 
-    } else if( pdferri == lasteig+1 ) {
-     //account for PDF set "ATLAS.txt" and "ATLAS3jet" with no error bands?
-     //if (debug) std::cout<<cn<<mn<<"A 'PDFnamevar' was "
-     //			 <<(PDFnamevar.empty()? "":"NOT")<<" found name= "<<PDFnamevar.c_str()<<std::endl;
-     //
-     //Band-aid for accounting for no error bands - This needs to be handled better
-     if(PDFnamevar.empty() == false) {
+  for (int pdferri = 0; pdferri < n_PDFMembers; pdferri++) {
+   if (debug) std::cout<<cn<<mn<<"pdferri: "<<pdferri<<" of "<<n_PDFMembers<<" pdftype="<<PDFtype.c_str()<<std::endl;
 
 #ifdef TIMER
-     quick_timer ti;
-     std::cout<<cn<<mn<<"TIMER call initPDF/mkPDF pdferri==lasteig+1 PDF= "<<PDFname.c_str()<<" pdferri= "<<pdferri<<" running..." << std::endl; 
-     quick_timer t0;
+   std::cout<<cn<<mn<<"TIMER call initPDF/mkPDF PDF= "<<PDFname.c_str()<<" pdferri= "<<pdferri<<" running..." << std::endl;
+   quick_timer t0;
 #endif
 
-     this->SetLHAPDFPDFset(PDFnamevar, defaultpdfidvar);
-     //#if defined LHAPDF_MAJOR_VERSION && LHAPDF_MAJOR_VERSION == 6
-     // if (debug) std::cout<<cn<<mn<<"Initialize: mkPDF name= "<<PDFnamevar.c_str()<<" set= "<<defaultpdfidvar<<std::endl;
-     // mypdf=LHAPDF::mkPDF(PDFnamevar.c_str(), defaultpdfidvar);
-     //#else
-     // TString pdfname=TString(pdfSetPath)+"/"+PDFnamevar+".LHgrid";
-     // LHAPDF::initPDFSet(pdfname.Data(), defaultpdfidvar);
-     //#endif
+   // PDF-only: members were already evaluated by FillPdfBands
+   if (applgridok) this->SetLHAPDFMember(pdferri);
 
 #ifdef TIMER
-      std::cout<<cn<<mn<<"TIMER done call initPDF/mkPDF t0= " << t0.time()<<" [ms]"<<std::endl;
-#endif
-
-     } else {
-      std::cout<<cn<<mn<<"WARNING: Can not intitalize name= "<<PDFnamevar.c_str()<<" set= "<<defaultpdfidvar<<std::endl;
-      std::cerr<<cn<<mn<<"WARNING: Can not intitalize name= "<<PDFnamevar.c_str()<<" set= "<<defaultpdfidvar<<std::endl;
-     }
-    } else if ( pdferri > lasteig+1 ) {
-      //>> modification P Berta 28.8.14>>
-     int pdfset=pdferri - lasteig-1;
-
-#ifdef TIMER     
-     std::cout<<cn<<mn<<"TIMER initPDF/mkPDF  pdferri>lasteig+1 running PDF= "<<PDFnamevar.c_str()<<" pdfset= "<<pdfset<<std::endl;
-     quick_timer t0;
-#endif
-
-     if (debug) std::cout<<cn<<mn<<"Initialize: pdferri> lasteig+1 initPDF name= "<<PDFnamevar.c_str()<<" set= "<<pdfset<<std::endl;
-     this->SetLHAPDFPDFset(PDFnamevar, pdfset);
-     //#if defined LHAPDF_MAJOR_VERSION && LHAPDF_MAJOR_VERSION == 6
-     // mypdf=LHAPDF::mkPDF(PDFnamevar.c_str(), pdfset);
-     //#else
-     //LHAPDF::initPDF(pdfset);
-     //#endif
-
-#ifdef TIMER     
-     std::cout<<cn<<mn<<"TIMER done initPDF/mkPDF t0= "<<  t0.time()<<" [ms]"<< std::endl;
-#endif
-
-    }
-   } else {
-    if (debug) std::cout<<cn<<mn<<"Initialize normal PDF set= "<<pdferri<<std::endl;
-
-#ifdef TIMER     
-    std::cout<<cn<<mn<<"TIMER call initPDF/mkPDF normal PDF set PDF= "<<default_pdf_set_name.c_str()<<" pdferri= "<<pdferri<<" running... " << std::endl;
-     quick_timer t0;
-#endif
-
-     this->SetLHAPDFPDFset(default_pdf_set_name, pdferri);
-     //#if defined LHAPDF_MAJOR_VERSION && LHAPDF_MAJOR_VERSION == 6
-     //if (debug) {
-     //std::cout<<cn<<mn<<" "<<std::endl;
-     //std::cout<<cn<<mn<<"Running LHAPDF6 mkPDF for "<<default_pdf_set_name.c_str()<<std::endl;
-     //}
-     //mypdf=LHAPDF::mkPDF(default_pdf_set_name.c_str(), pdferri);
-     //#else
-     //LHAPDF::initPDF(pdferri);
-     //#endif
-
-#ifdef TIMER     
-    std::cout<<cn<<mn<<"TIMER call initPDF/mkPDF done "<<t0.time()<<" [ms]"<< std::endl;
+   std::cout<<cn<<mn<<"TIMER done call initPDF/mkPDF t0= " << t0.time()<<" [ms]"<<std::endl;
 #endif
-   }
 
    TH1D* temp_hist = 0;
    if (applgridok) {
@@ -1166,12 +1098,15 @@ void SPXPDF::Initialize()
 
    } else {
     if (debug) std::cout<<cn<<mn<<"Histogram from PDF not applgrid ! "<<std::endl;
-    TH1D *tmp=this->FillPdfHisto();
-    if (!tmp) std::cout<<cn<<mn<<"tmp histogram not found "<<std::endl;
-    temp_hist=(TH1D*)tmp->Clone(tmp->GetName());
-    std::string name=tmp->GetName();
+    temp_hist=(TH1D*)hpdf->Clone(hpdf->GetName());
+    std::string name=hpdf->GetName();
     name=this->GetName(name);
     temp_hist->SetName(name.c_str());
+    // member values from the sweep done before the loop, filled like FillPdfHisto
+    const std::vector<double> &xvalues=this->GetPdfBandX();
+    for (unsigned int ix=0; ix<xvalues.size(); ix++) {
+     temp_hist->SetBinContent(temp_hist->FindBin(xvalues[ix]), this->GetPdfBandValue(pdferri, ifl, 0, ix));
+    }
    }
 
    if (!temp_hist) std::cout<<cn<<mn<<"temp_hist histogram not found "<<std::endl;
@@ -1193,11 +1128,24 @@ void SPXPDF::Initialize()
      TH1D * hratio=(TH1D*) temp_hist->Clone(hname);
      hratio->Divide(hdefault);
      hratio->Print("all");
+     delete hratio;
     }
    }
 
    h_errors_PDF.push_back(temp_hist);
 
+   // same member with the alternative scale choice grids: PDF band at the alternative scale in the same loop
+   if (applgridok && do_AlternativeScaleChoice) {
+    // nominal beam energy, as the alternative scale choice always had
+    TH1D *halt=this->ConvoluteSubGrids(1., 1., 1., true);
+    std::string aname="xsec_AlternativeScaleChoice_pdf_"+default_pdf_set_name;
+    aname+=Form("_set_%d",pdferri);
+    aname=this->GetName(aname);
+    halt->SetName(aname.c_str());
+
+    h_errors_AlternativeScaleChoicePDF.push_back(halt);
+   }
+
   }   /// pdf errors loop
 
   if (debug) std::cout<<cn<<mn<<"End of PDF errors loop"<<std::endl;
@@ -1228,6 +1176,7 @@ void SPXPDF::Initialize()
 #endif
 
  if (debug) std::cout<<cn<<mn<<"Now fill map Mapallbands "<<std::endl;
+ bandBounds.clear();
 
  if (do_PDFBand) if(h_PDF_results) {
   if (debug) std::cout<<cn<<mn<<"Fill in map "<<h_PDF_results->GetName()<<std::endl;
@@ -1294,6 +1243,8 @@ void SPXPDF::CalcSystErrors()
 {
  std::string mn = "CalcSystErrors: ";
  if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+ SPXStageScope stage("bands");
  if (debug) {
   std::cout<<cn<<mn<<"Start systematic error calculation for: "<<PDFtype<<std::endl;
   if (do_Scale)  std::cout<<cn<<mn<<"Calculate Scale uncertainty band "<<std::endl;
@@ -1308,6 +1259,7 @@ void SPXPDF::CalcSystErrors()
  if (do_Scale)   CalcScaleErrors();
  if (do_AlternativeScaleChoice) CalcAlternativeScaleChoiceErrors();
  if (do_Escale)  CalcBeamEnergyErrors();
+ if (applgridok && spxgrid && !spxgrid->GetSqrtSSweep().empty()) CalcBeamEnergySweep();
 
  if (debug) std::cout<<cn<<mn<<"End systematic error calculation for: "<<PDFtype<<std::endl;
 }
@@ -1352,6 +1304,7 @@ void SPXPDF::CalcBeamEnergyErrors()
   TH1D * hratio=(TH1D*) hnom->Clone("hnom");
   hratio->Divide(hpdfdefault);
   hratio->Print("all");
+  delete hratio;
  }
 
  TH1D *htmp= (TH1D*) my_grid->convolute( getPDF, alphasPDF, nLoops, renscale, facscale,  1./Escale);
@@ -1367,6 +1320,7 @@ void SPXPDF::CalcBeamEnergyErrors()
   TH1D * hratio=(TH1D*) htmp->Clone(hname.c_str());
   hratio->Divide(hnom);
   hratio->Print("all");
+  delete hratio;
  }
 
  htmp= (TH1D*) my_grid->convolute( getPDF, alphasPDF, nLoops, renscale, facscale, Escale);
@@ -1382,6 +1336,7 @@ void SPXPDF::CalcBeamEnergyErrors()
   TH1D * hratio=(TH1D*) htmp->Clone(hname.c_str());
   hratio->Divide(hnom);
   hratio->Print("all");
+  delete hratio;
  }
 
  for (int ibin=1;ibin<hpdfdefault->GetNbinsX()+1;++ibin){
@@ -1431,6 +1386,234 @@ void SPXPDF::CalcBeamEnergyErrors()
 
 }
 
+//Callback context of one sub-grid thread: the APPLgrid callbacks have no user argument, so each thread
+//finds its context through a thread-specific key. A thread has its own PDF object (LHAPDF6), so that
+//no LHAPDF object is used by two threads
+typedef struct SPXSubGridContext_t {
+#if defined LHAPDF_MAJOR_VERSION && LHAPDF_MAJOR_VERSION == 6
+ LHAPDF::PDF *pdf;
+ std::vector<double> xf;
+#endif
+} SPXSubGridContext_t;
+
+static pthread_key_t subGridKey;
+static pthread_once_t subGridKeyOnce=PTHREAD_ONCE_INIT;
+
+static void CreateSubGridKey(void) {
+ pthread_key_create(&subGridKey, NULL);
+}
+
+void getSubGridPDF(const double &x, const double &Q, double *xf) {
+#if defined LHAPDF_MAJOR_VERSION && LHAPDF_MAJOR_VERSION == 6
+  SPXSubGridContext_t *context=(SPXSubGridContext_t *)pthread_getspecific(subGridKey);
+  double xx=x;
+  if (xx>=1) xx-=1.e-12;
+  context->pdf->xfxQ(xx, Q, context->xf);
+  std::copy(context->xf.begin(), context->xf.end(), xf);
+#else
+  getPDF(x, Q, xf);
+#endif
+}
+
+double alphasSubGridPDF(const double &Q) {
+#if defined LHAPDF_MAJOR_VERSION && LHAPDF_MAJOR_VERSION == 6
+  SPXSubGridContext_t *context=(SPXSubGridContext_t *)pthread_getspecific(subGridKey);
+  return context->pdf->alphasQ(Q);
+#else
+  return alphasPDF(Q);
+#endif
+}
+
+#if defined LHAPDF_MAJOR_VERSION && LHAPDF_MAJOR_VERSION == 6
+//PDF objects of the sub-grid threads 1, 2, ... (thread 0 uses mypdf): copies of the member subGridPDFMember,
+//made again when the member changes
+std::vector<LHAPDF::PDF*> subGridPDFCopies;
+std::pair<std::string, int> subGridPDFMember;
+#endif
+
+//Sub-grid queue: one job is one grid, its bin values go to its own slot
+typedef struct SPXSubGridQueue_t {
+ std::vector<appl::grid *> *grids;
+ std::vector<std::vector<double> > *values;
+ std::vector<SPXSubGridContext_t> *contexts;
+ int nloops;
+ double renscale;
+ double facscale;
+ double escale;
+} SPXSubGridQueue_t;
+
+static void SubGridJob(void *arg, unsigned int igrid, unsigned int thread) {
+ SPXSubGridQueue_t *queue = (SPXSubGridQueue_t *)arg;
+
+ pthread_setspecific(subGridKey, &(queue->contexts->at(thread)));
+
+ queue->values->at(igrid)=queue->grids->at(igrid)->vconvolute(getSubGridPDF, alphasSubGridPDF, queue->nloops,
+                                                               queue->renscale, queue->facscale, queue->escale);
+}
+
+TH1D *SPXPDF::ConvoluteSubGrids(double renscale, double facscale, double escale,
+                                 bool alternativeScaleChoice)
+{
+ //
+ // all grids of the steering entry convoluted as one: the bin values of every grid are summed
+ // into one buffer and a single histogram is booked at the end
+ // distinct grids are convoluted in parallel, a grid listed twice is not (its state is not shared safely);
+ // each thread has its own PDF object
+ //
+ std::string mn = "ConvoluteSubGrids: ";
+ if (debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+ SPXStageScope stage("convolute");
+
+ const int ngrid=(alternativeScaleChoice ? spxgrid->GetNumberofAlternativeScaleChoiceGrids() : this->ngrid);
+ if (ngrid<1) throw SPXParseException(cn+mn+"No grid found !");
+
+ std::vector<appl::grid *> grids(ngrid);
+ bool independent=true;
+ for (int igrid=0; igrid<ngrid; igrid++) {
+  grids[igrid]=(alternativeScaleChoice ? spxgrid->GetGridAlternativeScaleChoice(igrid) : spxgrid->GetGrid(igrid));
+  if (!grids[igrid]) {
+   std::ostringstream oss;
+   oss<<cn<<mn<<"Grid "<<igrid<<" not found !";
+   throw SPXParseException(oss.str());
+  }
+  for (int jgrid=0; jgrid<igrid; jgrid++) {
+   if (grids[jgrid]==grids[igrid]) independent=false;
+  }
+ }
+
+ const int nobs=grids[0]->Nobs();
+ for (int igrid=1; igrid<ngrid; igrid++) {
+  if (grids[igrid]->Nobs()!=nobs) {
+   std::ostringstream oss;
+   oss<<cn<<mn<<"Grid "<<igrid<<" has "<<grids[igrid]->Nobs()<<" bins, grid 0 has "<<nobs<<": Can not add them";
+   throw SPXParseException(oss.str());
+  }
+ }
+
+ std::vector<std::vector<double> > values(ngrid);
+
+ unsigned int nthreads=SPXWorkQueue::GetNumberOfThreads(ngrid, MAX_SWEEP_THREADS);
+ if (!independent) nthreads=1;
+#if !defined LHAPDF_MAJOR_VERSION || LHAPDF_MAJOR_VERSION != 6
+ // LHAPDF5 keeps a single global PDF
+ nthreads=1;
+#endif
+
+ std::vector<SPXSubGridContext_t> contexts(nthreads);
+
+#if defined LHAPDF_MAJOR_VERSION && LHAPDF_MAJOR_VERSION == 6
+ if (!mypdf) throw SPXParseException(cn+mn+"No PDF member set !");
+
+ // copies of the current member for the other threads: loading is not thread safe, so it is done here
+ std::pair<std::string, int> member(mypdf->set().name(), mypdf->memberID());
+ if (member!=subGridPDFMember) {
+  for (int i=0; i<subGridPDFCopies.size(); i++) delete subGridPDFCopies[i];
+  subGridPDFCopies.clear();
+  subGridPDFMember=member;
+ }
+ while (subGridPDFCopies.size()+1<nthreads) {
+  LHAPDF::PDF *copy=LHAPDF::mkPDF(member.first, member.second);
+  if (!copy) break;
+  subGridPDFCopies.push_back(copy);
+ }
+ if (nthreads>subGridPDFCopies.size()+1) nthreads=subGridPDFCopies.size()+1;
+ contexts.resize(nthreads);
+
+ for (unsigned int i=0; i<nthreads; i++) {
+  contexts[i].pdf=(i==0 ? mypdf : subGridPDFCopies[i-1]);
+  contexts[i].xf.resize(13);
+ }
+#endif
+
+ pthread_once(&subGridKeyOnce, CreateSubGridKey);
+
+ SPXSubGridQueue_t queue;
+ queue.grids=&grids;
+ queue.values=&values;
+ queue.contexts=&contexts;
+ queue.nloops=nLoops;
+ queue.renscale=renscale;
+ queue.facscale=facscale;
+ queue.escale=escale;
+
+ try {
+  nthreads=SPXWorkQueue::Run(SubGridJob, &queue, ngrid, nthreads, "grid");
+ } catch(...) {
+  pthread_setspecific(subGridKey, NULL);
+  throw;
+ }
+ pthread_setspecific(subGridKey, NULL);
+
+ // summed in grid order, independent of which thread finished first
+ std::vector<double> sum(nobs, 0.);
+ for (int igrid=0; igrid<ngrid; igrid++) {
+  if (values[igrid].size()!=(unsigned int)nobs) {
+   throw SPXParseException(cn+mn+"Can not find bin values from convolution !");
+  }
+  for (int iobs=0; iobs<nobs; iobs++) sum[iobs]+=values[igrid][iobs];
+ }
+
+ // binning of the first grid
+ std::vector<double> edges(nobs+1);
+ for (int iobs=0; iobs<nobs; iobs++) edges[iobs]=grids[0]->obslow(iobs);
+ edges[nobs]=grids[0]->obslow(nobs-1)+grids[0]->deltaobs(nobs-1);
+
+ std::string name=GetName(spxgrid->GetName());
+ TH1D *hsum=new TH1D(name.c_str(), name.c_str(), nobs, &edges[0]);
+ for (int iobs=0; iobs<nobs; iobs++) {
+  hsum->SetBinContent(iobs+1, sum[iobs]);
+  hsum->SetBinError(iobs+1, 0.);
+ }
+
+ if (debug) std::cout<<cn<<mn<<"Summed "<<ngrid<<" grids with "<<nthreads<<" thread(s) into "<<hsum->GetName()<<std::endl;
+
+ return hsum;
+}
+
+void SPXPDF::CalcBeamEnergySweep()
+{
+ //
+ // cross sections at several sqrt(s) (grid steering sqrts_sweep) with the default PDF member
+ // stored relative to the nominal cross section, so that they follow every later normalisation
+ //
+ // one plain convolution per factor: applgrid rescales x with the energy inside convolute(), so the
+ // PDF nodes of one energy are not those of another and the PDF is evaluated again for each
+ // applgrid has Escale = old/new, so a sqrt(s) factor f is Escale= 1/f
+ //
+ std::string mn = "CalcBeamEnergySweep: ";
+ if (debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+ const std::vector<double> &factors=spxgrid->GetSqrtSSweep();
+
+ // nominal as in GetHisto
+ double xEscale=1.;
+ if (!do_Escale) xEscale=Escale;
+
+ TH1D *hnom=this->ConvoluteSubGrids(1., 1., xEscale);
+
+ for (int i=0; i<factors.size(); i++) {
+  TH1D *hratio=this->ConvoluteSubGrids(1., 1., 1./factors.at(i));
+  hratio->Divide(hnom);
+
+  std::string name=Form("xsec_sqrts_%4.3f_%s",factors.at(i),default_pdf_set_name.c_str());
+  name=this->GetName(name);
+  hratio->SetName(name.c_str());
+
+  if (debug) {
+   std::cout<<cn<<mn<<"sqrt(s) factor= "<<factors.at(i)<<" ratio to nominal: "<<std::endl;
+   hratio->Print("all");
+  }
+
+  beamEnergySweepFactors.push_back(factors.at(i));
+  h_BeamEnergySweepRatio.push_back(hratio);
+ }
+
+ std::cout<<cn<<mn<<PDFtype<<": "<<factors.size()<<" beam energies"<<std::endl;
+
+ delete hnom;
+}
+
 void SPXPDF::CalcPDFBandErrors()
 {
  // needs some more checking for uncertainty bands
@@ -1462,171 +1645,19 @@ void SPXPDF::CalcPDFBandErrors()
  for (int bi = 1; bi <= h_errors_PDF.at(0)->GetNbinsX(); bi++) { // loop over bins
   if (debug) std::cout<<cn<<mn<<"bin= "<<bi<<std::endl;
 
-  double this_err_up         = 0.;
-  double this_err_down       = 0.;
-  double central_val         = 0.;    // needed for MSTW2008nlo and HERAPDF
-  double average             = 0.;    // needed for NNPDF
-  double extreme_pos_diff    = 0.;    // needed for HERAPDF
-  double extreme_neg_diff    = 0.;    // needed for HERAPDF
-  double diff_central        = 0.;    // needed for HERAPDF
-  double mod_val             = 0.;    // needed for MSTW2008nlo
+  std::vector<double> values(h_errors_PDF.size());
+  for (int pdferri = 0; pdferri < (int) h_errors_PDF.size(); pdferri++) {
+   values.at(pdferri) = h_errors_PDF.at(pdferri)->GetBinContent(bi);
+  }
+
+  double this_err_up   = 0.;
+  double this_err_down = 0.;
+  double average       = 0.;    // needed for NNPDF
+  this->CalcPDFBandError(values, average, this_err_up, this_err_down);
 
   if (ErrorPropagationType==StyleNNPDF) {
-   // NNPDF are replicatas, calculate the RMS
-   // better use formulaa with sum^2 and sum ?
-   for (int pdferri = 0; pdferri < (int) h_errors_PDF.size(); pdferri++) {
-    average += h_errors_PDF.at(pdferri)->GetBinContent(bi);
-   }
-   average /= h_errors_PDF.size()-1;
-   //
    // update default histogram
    hpdfdefault->SetBinContent(bi,average);
-
-   for (int pdferri = 1; pdferri < (int) h_errors_PDF.size(); pdferri++)  {
-    this_err_up += pow(h_errors_PDF.at(pdferri)->GetBinContent(bi)-average, 2.);
-   }
-   this_err_up = TMath::Sqrt(this_err_up / (h_errors_PDF.size()-1));
-   // error with respect to average
-   this_err_down = this_err_up;
-  } else if (ErrorPropagationType==EigenvectorSymmetricHessian) {
-   // Symmetric hessian
-   for (int pdferri = 1; pdferri < (int) h_errors_PDF.size()-1; pdferri += 2) {
-    this_err_up += pow( h_errors_PDF.at(pdferri)->GetBinContent(bi) - h_errors_PDF.at(pdferri+1)->GetBinContent(bi), 2.);
-   }
-   // here errors are symmetrized
-   this_err_up = 0.5*TMath::Sqrt(this_err_up);
-   //if (debug)
-   //std::cout<<cn<<mn<<"this_err_up= "<<this_err_up<<" PDFErrorSize= "<<PDFErrorSize.c_str()<<std::endl;
-   //if (PDFErrorSize.compare("OneSigma")==0) {
-   // if (debug) std::cout<<cn<<mn<<" put to one sigma "<<std::endl;
-   // this_err_up /= 1.645;
-   //}
-   this_err_down = this_err_up;
-
-  } else if (ErrorPropagationType==EigenvectorAsymmetricHessian) {
-  //
-  // Asymmetric hessian
-  //
-   central_val = h_errors_PDF.at(defaultpdfid)->GetBinContent(bi);
-   //https://twiki.cern.ch/twiki/bin/viewauth/AtlasProtected/TopPdfUncertainty
-   //>>>> modifications by P. Berta 28th August
-   //
-   //for (int pdferri = 1; pdferri < (int) h_errors_PDF.size(); pdferri ++) {
-   // mod_val = h_errors_PDF.at(pdferri)->GetBinContent(bi);
-   // if (mod_val > central_val ) this_err_up  += pow(mod_val-central_val, 2.);
-   // else                        this_err_down+= pow(central_val - mod_val, 2.);
-   //}
-   for (int pdferri = 1; pdferri < (int) h_errors_PDF.size()-1; pdferri += 2) {
-    double delta_up_variation  =h_errors_PDF.at(pdferri)  ->GetBinContent(bi)-central_val;
-    double delta_down_variation=h_errors_PDF.at(pdferri+1)->GetBinContent(bi)-central_val;
-    if (delta_up_variation>0   && delta_up_variation>delta_down_variation) this_err_up+=pow(delta_up_variation,2.);
-    if (delta_down_variation>0 && delta_down_variation>delta_up_variation) this_err_up+=pow(delta_down_variation,2.);
-    if (delta_up_variation<0   && delta_up_variation<delta_down_variation) this_err_down+=pow(delta_up_variation,2.);
-    if (delta_down_variation<0 && delta_down_variation<delta_up_variation) this_err_down+=pow(delta_down_variation,2.);
-   }
-
-   this_err_down = TMath::Sqrt(this_err_down);
-   this_err_up   = TMath::Sqrt(this_err_up);
-  } else if (ErrorPropagationType==StyleHeraPDF) {
-   if (debug) {
-    std::cout<<cn<<mn<<"HERA/ATLAS type PDF "<<std::endl;
-    std::cout<<cn<<mn<<"PDFname= "<<PDFname.c_str()<<" PDFnamevar= "<<PDFnamevar.c_str()<<std::endl;
-    std::cout<<cn<<mn<<"firsteig= "<<firsteig<<" lasteig= "<<lasteig<<std::endl;
-    std::cout<<cn<<mn<<"firstquadvar= "<<firstquadvar<<" lastquadvar= "<<lastquadvar<<std::endl;
-    std::cout<<cn<<mn<<"firstmaxvar= "<<firstmaxvar<<" lastmaxvar= "<<lastmaxvar<<std::endl;
-    std::cout<<cn<<mn<<"defaultpdfid= "<<defaultpdfid<<" defaultpdfidvar= "<<defaultpdfidvar<<std::endl;
-   }
-
-   central_val = h_errors_PDF.at(defaultpdfid)->GetBinContent(bi);
-
-   if (debug) std::cout<<cn<<mn<<"Default sample id= "<<defaultpdfid<<" "<<" central_val= "<<central_val<<std::endl;
-   if (includeEIG) {
-    for (int pdferri = firsteig; pdferri <=lasteig; pdferri += 2) {   //// experimental errors
-     this_err_up += pow( 0.5*(h_errors_PDF.at(pdferri+1)->GetBinContent(bi)
-                            - h_errors_PDF.at(pdferri)  ->GetBinContent(bi)), 2.);
-
-     if (debug) std::cout<<cn<<mn<<PDFtype.c_str()
-		    <<"pdferri= "<<pdferri<<" , "<<pdferri+1<<" EIG "<<pdferri/2
-		  //<<" this_err_up= "<<this_err_up
-		    <<" diff/nom= "<<(h_errors_PDF.at(pdferri+1)->GetBinContent(bi)-h_errors_PDF.at(pdferri)  ->GetBinContent(bi))/central_val
-		    <<" (var+1)/nom= "<<h_errors_PDF.at(pdferri+1)->GetBinContent(bi)/central_val
-		    <<" (var)/nom= "  <<h_errors_PDF.at(pdferri)  ->GetBinContent(bi)/central_val
-		    <<std::endl;
-    }
-   }
- 
-   if (debug) std::cout<<cn<<mn<<"finished includeEIG "<<std::endl;
-
-   this_err_down = this_err_up;
-
-   int firstvar=lasteig+1; // uncertainties start at last eigenvector previous set + default of variation sample
-
-   if (includeQUAD || includeMAX) {
-    if (debug) std::cout<<cn<<mn<<"Now access h_errors_PDF at= "<<firstvar+defaultpdfidvar<<std::endl;
-    if (firstvar+defaultpdfidvar>=h_errors_PDF.size()) {
-     std::ostringstream oss;
-     oss << cn << mn << "ERROR: h_error_PDF is too small "<<h_errors_PDF.size()<<" but firstvar+defaultpdfidvar= "<<firstvar+defaultpdfidvar<<std::endl; 
-     throw SPXParseException(oss.str());
-    }
-
-    central_val = h_errors_PDF.at(firstvar+defaultpdfidvar)->GetBinContent(bi);
-    if (debug) std::cout<<cn<<mn<<" variation sample id= "<<firstvar+defaultpdfidvar<<" "<<" central_val= "<<central_val<<std::endl;
-   }
-
-   if (includeQUAD) {
-    for (int pdferri = firstvar+firstquadvar; pdferri < firstvar+lastquadvar; pdferri++) {// parameterisation errors
-     if (h_errors_PDF.at(pdferri)->GetBinContent(bi) > central_val ) {
-      this_err_up  += pow( h_errors_PDF.at(pdferri)->GetBinContent(bi) - central_val, 2.);
-      this_err_down+= 0.;
-     } else  {
-      this_err_up  += 0.;
-      this_err_down+= pow( central_val - h_errors_PDF.at(pdferri)->GetBinContent(bi), 2.);
-     }
-     if (debug) std::cout<<cn<<mn<<" "<<PDFtype.c_str()
-			 <<" pdferri= "<<pdferri<<" , "<<pdferri+1<<" parameterisation "
-			 <<" this_err_up= "<<this_err_up
-			 <<" this_err_down= "<<this_err_down
-			 <<" (var)/nom= "  <<h_errors_PDF.at(pdferri)  ->GetBinContent(bi)/central_val
-			 <<std::endl;
-    }
-   }
-
-   if (includeMAX) {
-    for (int pdferri = firstvar+firstmaxvar; pdferri < firstvar+lastmaxvar; pdferri++) { // model errors
-     diff_central = h_errors_PDF.at(pdferri)->GetBinContent(bi) - central_val;
-     //if (debug) std::cout<<cn<<mn<<" diff_central= "<<diff_central
-     //                    <<" var/nom= "<<h_errors_PDF.at(pdferri)->GetBinContent(bi)/central_val
-     //                    <<endl;
-     if (diff_central > 0 && diff_central > extreme_pos_diff ) extreme_pos_diff = diff_central;
-     if (diff_central < 0 && diff_central < extreme_neg_diff ) extreme_neg_diff = diff_central;
-
-     if (debug) std::cout<<cn<<mn<<" "<<PDFtype.c_str()<<" pdferri= "
-		    <<pdferri<<" , "<<pdferri+1<<" model "
-		    <<" extreme_pos_diff= "<<extreme_pos_diff
-		    <<" extreme_neg_diff= "<<extreme_neg_diff
-		    <<std::endl;
-    }
-    if (extreme_pos_diff > 0. ) this_err_up   += pow(extreme_pos_diff, 2.);
-    if (extreme_neg_diff < 0. ) this_err_down += pow(extreme_neg_diff, 2.);
-   }
-
-   this_err_up   = TMath::Sqrt(this_err_up);
-   this_err_down = TMath::Sqrt(this_err_down);
-
-  } else {
-  std::ostringstream oss;
-  oss << cn << mn << "ERROR Unsupported pdfCode encountered ErrorPropagationType= "<<ErrorPropagationType
-             <<" PDFtype= "<<PDFtype.c_str();
-  throw SPXParseException(oss.str());
-  }
-
-  if (debug) std::cout<<cn<<mn<<"this_err_up= "  <<this_err_up  <<std::endl;
-  if (debug) std::cout<<cn<<mn<<"this_err_down= "<<this_err_down<<std::endl;
-
-  if (f_PDFErrorSize90Percent){
-   if (debug) std::cout<<cn<<mn<<"PDF has 90Percent error -> change to 68% "<<std::endl;
-   this_err_up  /= 1.645;
-   this_err_down/= 1.645;
   }
 
   if (ErrorPropagationType==StyleNNPDF) {
@@ -1637,17 +1668,9 @@ void SPXPDF::CalcPDFBandErrors()
    h_PDF_results->GetPoint(bi-1, x_val, y_val);
    h_PDF_results->SetPoint(bi-1, x_val,average);
 
-   if (h_errors_PDF.size()==0) {
-     std::cerr<<cn<<mn<<"WARNING: h_PDF_errors not found. Can not be updated !"<<std::endl;
-    } else {
-     if (h_errors_PDF.at(0)==0) {    
-      std::cerr<<cn<<mn<<"WARNING: h_PDF_errors not found. Can not be updated !"<<std::endl;
-     } else {
-      if (debug) std::cout<<cn<<mn<<"Update h_errors_PDF[0] "<<h_errors_PDF.at(0)->GetName()<<" with x= "<<x_val<<" average= "<<average<<std::endl;
-      h_errors_PDF.at(0)->SetBinContent(bi,x_val,average); 
-     }
-    } 
-   
+   // the average is kept in hpdfdefault: h_errors_PDF stays the members, which
+   // GetCorrelatedRatioErrors divides member by member
+
    //
    // Update also other defaults
    //
@@ -1751,18 +1774,192 @@ void SPXPDF::CalcPDFBandErrors()
  return;
 }
 
-void SPXPDF::CalcAlphaSErrors()
+void SPXPDF::CalcPDFBandError(const std::vector<double> &values, double &average, double &this_err_up, double &this_err_down)
 {
- std::string mn = "CalcAlphaSErrors: ";
- if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
- if(debug) std::cout<<cn<<mn<<"Starting calculation of AlphaSErrors for: "<<PDFtype<<std::endl;
+ //
+ // PDF uncertainty of one observable from its values for all members
+ // according to ErrorPropagationType (shared by the cross section and PDF-vs-x bands)
+ //
+ std::string mn = "CalcPDFBandError: ";
+
+ this_err_up               = 0.;
+ this_err_down             = 0.;
+ average                   = 0.;    // needed for NNPDF
+ double central_val         = 0.;    // needed for MSTW2008nlo and HERAPDF
+ double extreme_pos_diff    = 0.;    // needed for HERAPDF
+ double extreme_neg_diff    = 0.;    // needed for HERAPDF
+ double diff_central        = 0.;    // needed for HERAPDF
+ double mod_val             = 0.;    // needed for MSTW2008nlo
+
+ if (ErrorPropagationType==StyleNNPDF) {
+  // NNPDF are replicatas, calculate the RMS
+  // better use formulaa with sum^2 and sum ?
+  for (int pdferri = 0; pdferri < (int) values.size(); pdferri++) {
+   average += values.at(pdferri);
+  }
+  average /= values.size()-1;
+  //
 
- //assert(h_errors_AlphaS.size() == 3);
+  for (int pdferri = 1; pdferri < (int) values.size(); pdferri++)  {
+   this_err_up += pow(values.at(pdferri)-average, 2.);
+  }
+  this_err_up = TMath::Sqrt(this_err_up / (values.size()-1));
+  // error with respect to average
+  this_err_down = this_err_up;
+ } else if (ErrorPropagationType==EigenvectorSymmetricHessian) {
+  // Symmetric hessian
+  for (int pdferri = 1; pdferri < (int) values.size()-1; pdferri += 2) {
+   this_err_up += pow( values.at(pdferri) - values.at(pdferri+1), 2.);
+  }
+  // here errors are symmetrized
+  this_err_up = 0.5*TMath::Sqrt(this_err_up);
+  //if (debug)
+  //std::cout<<cn<<mn<<"this_err_up= "<<this_err_up<<" PDFErrorSize= "<<PDFErrorSize.c_str()<<std::endl;
+  //if (PDFErrorSize.compare("OneSigma")==0) {
+  // if (debug) std::cout<<cn<<mn<<" put to one sigma "<<std::endl;
+  // this_err_up /= 1.645;
+  //}
+  this_err_down = this_err_up;
 
- double this_default_val = 0.;
- double this_err_down = 0.;
- double this_err_up = 0.;
- double error_up = 0.;
+ } else if (ErrorPropagationType==EigenvectorAsymmetricHessian) {
+ //
+ // Asymmetric hessian
+ //
+  central_val = values.at(defaultpdfid);
+  //https://twiki.cern.ch/twiki/bin/viewauth/AtlasProtected/TopPdfUncertainty
+  //>>>> modifications by P. Berta 28th August
+  //
+  //for (int pdferri = 1; pdferri < (int) values.size(); pdferri ++) {
+  // mod_val = values.at(pdferri);
+  // if (mod_val > central_val ) this_err_up  += pow(mod_val-central_val, 2.);
+  // else                        this_err_down+= pow(central_val - mod_val, 2.);
+  //}
+  for (int pdferri = 1; pdferri < (int) values.size()-1; pdferri += 2) {
+   double delta_up_variation  =values.at(pdferri)-central_val;
+   double delta_down_variation=values.at(pdferri+1)-central_val;
+   if (delta_up_variation>0   && delta_up_variation>delta_down_variation) this_err_up+=pow(delta_up_variation,2.);
+   if (delta_down_variation>0 && delta_down_variation>delta_up_variation) this_err_up+=pow(delta_down_variation,2.);
+   if (delta_up_variation<0   && delta_up_variation<delta_down_variation) this_err_down+=pow(delta_up_variation,2.);
+   if (delta_down_variation<0 && delta_down_variation<delta_up_variation) this_err_down+=pow(delta_down_variation,2.);
+  }
+
+  this_err_down = TMath::Sqrt(this_err_down);
+  this_err_up   = TMath::Sqrt(this_err_up);
+ } else if (ErrorPropagationType==StyleHeraPDF) {
+  if (debug) {
+   std::cout<<cn<<mn<<"HERA/ATLAS type PDF "<<std::endl;
+   std::cout<<cn<<mn<<"PDFname= "<<PDFname.c_str()<<" PDFnamevar= "<<PDFnamevar.c_str()<<std::endl;
+   std::cout<<cn<<mn<<"firsteig= "<<firsteig<<" lasteig= "<<lasteig<<std::endl;
+   std::cout<<cn<<mn<<"firstquadvar= "<<firstquadvar<<" lastquadvar= "<<lastquadvar<<std::endl;
+   std::cout<<cn<<mn<<"firstmaxvar= "<<firstmaxvar<<" lastmaxvar= "<<lastmaxvar<<std::endl;
+   std::cout<<cn<<mn<<"defaultpdfid= "<<defaultpdfid<<" defaultpdfidvar= "<<defaultpdfidvar<<std::endl;
+  }
+
+  central_val = values.at(defaultpdfid);
+
+  if (debug) std::cout<<cn<<mn<<"Default sample id= "<<defaultpdfid<<" "<<" central_val= "<<central_val<<std::endl;
+  if (includeEIG) {
+   for (int pdferri = firsteig; pdferri <=lasteig; pdferri += 2) {   //// experimental errors
+    this_err_up += pow( 0.5*(values.at(pdferri+1)
+                           - values.at(pdferri)), 2.);
+
+    if (debug) std::cout<<cn<<mn<<PDFtype.c_str()
+		    <<"pdferri= "<<pdferri<<" , "<<pdferri+1<<" EIG "<<pdferri/2
+		  //<<" this_err_up= "<<this_err_up
+		    <<" diff/nom= "<<(values.at(pdferri+1)-values.at(pdferri))/central_val
+		    <<" (var+1)/nom= "<<values.at(pdferri+1)/central_val
+		    <<" (var)/nom= "  <<values.at(pdferri)/central_val
+		    <<std::endl;
+   }
+  }
+
+  if (debug) std::cout<<cn<<mn<<"finished includeEIG "<<std::endl;
+
+  this_err_down = this_err_up;
+
+  int firstvar=lasteig+1; // uncertainties start at last eigenvector previous set + default of variation sample
+
+  if (includeQUAD || includeMAX) {
+   if (debug) std::cout<<cn<<mn<<"Now access h_errors_PDF at= "<<firstvar+defaultpdfidvar<<std::endl;
+   if (firstvar+defaultpdfidvar>=values.size()) {
+    std::ostringstream oss;
+    oss << cn << mn << "ERROR: h_error_PDF is too small "<<values.size()<<" but firstvar+defaultpdfidvar= "<<firstvar+defaultpdfidvar<<std::endl; 
+    throw SPXParseException(oss.str());
+   }
+
+   central_val = values.at(firstvar+defaultpdfidvar);
+   if (debug) std::cout<<cn<<mn<<" variation sample id= "<<firstvar+defaultpdfidvar<<" "<<" central_val= "<<central_val<<std::endl;
+  }
+
+  if (includeQUAD) {
+   for (int pdferri = firstvar+firstquadvar; pdferri < firstvar+lastquadvar; pdferri++) {// parameterisation errors
+    if (values.at(pdferri) > central_val ) {
+     this_err_up  += pow( values.at(pdferri) - central_val, 2.);
+     this_err_down+= 0.;
+    } else  {
+     this_err_up  += 0.;
+     this_err_down+= pow( central_val - values.at(pdferri), 2.);
+    }
+    if (debug) std::cout<<cn<<mn<<" "<<PDFtype.c_str()
+			 <<" pdferri= "<<pdferri<<" , "<<pdferri+1<<" parameterisation "
+			 <<" this_err_up= "<<this_err_up
+			 <<" this_err_down= "<<this_err_down
+			 <<" (var)/nom= "  <<values.at(pdferri)/central_val
+			 <<std::endl;
+   }
+  }
+
+  if (includeMAX) {
+   for (int pdferri = firstvar+firstmaxvar; pdferri < firstvar+lastmaxvar; pdferri++) { // model errors
+    diff_central = values.at(pdferri) - central_val;
+    //if (debug) std::cout<<cn<<mn<<" diff_central= "<<diff_central
+    //                    <<" var/nom= "<<values.at(pdferri)/central_val
+    //                    <<endl;
+    if (diff_central > 0 && diff_central > extreme_pos_diff ) extreme_pos_diff = diff_central;
+    if (diff_central < 0 && diff_central < extreme_neg_diff ) extreme_neg_diff = diff_central;
+
+    if (debug) std::cout<<cn<<mn<<" "<<PDFtype.c_str()<<" pdferri= "
+		    <<pdferri<<" , "<<pdferri+1<<" model "
+		    <<" extreme_pos_diff= "<<extreme_pos_diff
+		    <<" extreme_neg_diff= "<<extreme_neg_diff
+		    <<std::endl;
+   }
+   if (extreme_pos_diff > 0. ) this_err_up   += pow(extreme_pos_diff, 2.);
+   if (extreme_neg_diff < 0. ) this_err_down += pow(extreme_neg_diff, 2.);
+  }
+
+  this_err_up   = TMath::Sqrt(this_err_up);
+  this_err_down = TMath::Sqrt(this_err_down);
+
+ } else {
+ std::ostringstream oss;
+ oss << cn << mn << "ERROR Unsupported pdfCode encountered ErrorPropagationType= "<<ErrorPropagationType
+            <<" PDFtype= "<<PDFtype.c_str();
+ throw SPXParseException(oss.str());
+ }
+
+ if (debug) std::cout<<cn<<mn<<"this_err_up= "  <<this_err_up  <<std::endl;
+ if (debug) std::cout<<cn<<mn<<"this_err_down= "<<this_err_down<<std::endl;
+
+ if (f_PDFErrorSize90Percent){
+  if (debug) std::cout<<cn<<mn<<"PDF has 90Percent error -> change to 68% "<<std::endl;
+  this_err_up  /= 1.645;
+  this_err_down/= 1.645;
+ }
+}
+
+void SPXPDF::CalcAlphaSErrors()
+{
+ std::string mn = "CalcAlphaSErrors: ";
+ if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+ if(debug) std::cout<<cn<<mn<<"Starting calculation of AlphaSErrors for: "<<PDFtype<<std::endl;
+
+ //assert(h_errors_AlphaS.size() == 3);
+
+ double this_default_val = 0.;
+ double this_err_down = 0.;
+ double this_err_up = 0.;
+ double error_up = 0.;
  double error_down = 0.;
 
  if (debug) std::cout<<cn<<mn<<"Size h_errors_AlphaS= "<<h_errors_AlphaS.size()<<std::endl;
@@ -1937,18 +2134,18 @@ void SPXPDF::CalcAlternativeScaleChoiceErrors()
 
  if (debug) std::cout<<cn<<mn<<"Starting calculation of AlternativeScaleChoiceErrors for: "<<PDFtype<<std::endl;
 
- int ngrid=spxgrid->GetNumberofAlternativeScaleChoiceGrids();
- if (ngrid>1) throw SPXParseException(cn+mn+"More than one alternative grids not yet implemented !");
- if (ngrid<1) throw SPXParseException(cn+mn+"No alternative grid found !");
- 
- my_gridAlternativeScaleChoice=spxgrid->GetGridAlternativeScaleChoice(0);
- if (!my_gridAlternativeScaleChoice) {
-  std::cout<<cn<<mn<<"WARNING: No alternative scale choice grid found ! "<<std::endl; 
-  std::cerr<<cn<<mn<<"WARNING: No alternative scale choice grid found ! "<<std::endl; 
-  return;
+ if (spxgrid->GetNumberofAlternativeScaleChoiceGrids()<1) throw SPXParseException(cn+mn+"No alternative grid found !");
+
+ TH1D *htmpsumAlternativeScaleChoice=0;
+ if (h_errors_AlternativeScaleChoicePDF.size()>defaultpdfid) {
+  // already convoluted in the PDF member loop
+  TH1D *hdef=h_errors_AlternativeScaleChoicePDF.at(defaultpdfid);
+  std::string name=this->GetName("xsec_AlternativeScaleChoice_"+default_pdf_set_name);
+  htmpsumAlternativeScaleChoice=(TH1D*)hdef->Clone(name.c_str());
+ } else {
+  htmpsumAlternativeScaleChoice=this->ConvoluteSubGrids(1., 1., 1., true);
  }
 
- TH1D *htmpsumAlternativeScaleChoice= (TH1D*) my_gridAlternativeScaleChoice->convolute( getPDF, alphasPDF, nLoops);
  if (!htmpsumAlternativeScaleChoice) {
   throw SPXParseException(cn+mn+"Can not find histogram from convolution !");
  }
@@ -1985,6 +2182,7 @@ void SPXPDF::CalcAlternativeScaleChoiceErrors()
 
   std::cout<<cn<<mn<<"Ratio alternative/nominal "<<std::endl;
   htmp->Print("all");
+  delete htmp;
  }
 
  for (int ibin=1;ibin<h_errors_AlternativeScaleChoice[0]->GetNbinsX()+1;++ibin){
@@ -2040,10 +2238,67 @@ void SPXPDF::CalcAlternativeScaleChoiceErrors()
   h_AlternativeScaleChoice_results->Print();
  }
 
+ if (h_errors_AlternativeScaleChoicePDF.size()>1) this->CalcAlternativeScaleChoicePDFBand();
+
  return;
 
 }
 
+void SPXPDF::CalcAlternativeScaleChoicePDFBand()
+{
+ //
+ // PDF band from all members convoluted with the alternative scale choice grids,
+ // stored relative to the nominal cross section, so that it follows every later normalisation
+ // the member histograms are not needed afterwards
+ //
+ std::string mn = "CalcAlternativeScaleChoicePDFBand: ";
+ if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+ const int nmem=h_errors_AlternativeScaleChoicePDF.size();
+ const int nbin=hpdfdefault->GetNbinsX();
+
+ for (int imem=0; imem<nmem; imem++) {
+  if (h_errors_AlternativeScaleChoicePDF.at(imem)->GetNbinsX()!=nbin) {
+   std::ostringstream oss;
+   oss<<cn<<mn<<"Alternative scale choice member "<<imem<<" has "<<h_errors_AlternativeScaleChoicePDF.at(imem)->GetNbinsX()
+      <<" bins, nominal has "<<nbin;
+   throw SPXParseException(oss.str());
+  }
+ }
+
+ delete h_AlternativeScaleChoicePDF_ratio;
+ h_AlternativeScaleChoicePDF_ratio=new TGraphAsymmErrors(nbin);
+ std::string name=this->GetName("xsec_AlternativeScaleChoice_pdf_"+default_pdf_set_name);
+ h_AlternativeScaleChoicePDF_ratio->SetName(name.c_str());
+
+ std::vector<double> values(nmem);
+ for (int ibin=1; ibin<=nbin; ibin++) {
+  for (int imem=0; imem<nmem; imem++) {
+   values.at(imem)=h_errors_AlternativeScaleChoicePDF.at(imem)->GetBinContent(ibin);
+  }
+
+  double average=0., err_up=0., err_down=0.;
+  this->CalcPDFBandError(values, average, err_up, err_down);
+
+  double central=(ErrorPropagationType==StyleNNPDF ? average : values.at(defaultpdfid));
+  double nominal=hpdfdefault->GetBinContent(ibin);
+  double scale=(nominal!=0. ? 1./nominal : 0.);
+
+  double x =hpdfdefault->GetBinCenter(ibin);
+  double ex=0.5*hpdfdefault->GetBinWidth(ibin);
+  h_AlternativeScaleChoicePDF_ratio->SetPoint(ibin-1, x, central*scale);
+  h_AlternativeScaleChoicePDF_ratio->SetPointError(ibin-1, ex, ex, err_down*scale, err_up*scale);
+ }
+
+ if (debug) {
+  std::cout<<cn<<mn<<"Alternative scale choice PDF band / nominal "<<h_AlternativeScaleChoicePDF_ratio->GetName()<<std::endl;
+  h_AlternativeScaleChoicePDF_ratio->Print();
+ }
+
+ for (int imem=0; imem<nmem; imem++) delete h_errors_AlternativeScaleChoicePDF.at(imem);
+ h_errors_AlternativeScaleChoicePDF.clear();
+}
+
 void SPXPDF::CalcTotalErrors()
 {
  std::string mn = "CalcTotalErrors: ";
@@ -2084,7 +2339,7 @@ void SPXPDF::CalcTotalErrors()
  std::string name="xsec_total_"+default_pdf_set_name;
  if (spxgrid) name+="_"+spxgrid->GetName();
  name=this->GetName(name);
- h_Total_results=(TGraphAsymmErrors *) (Mapallbands.begin()->second)->Clone(name.c_str());
+ h_Total_results=SPXArena::AdoptCurrent((TGraphAsymmErrors *) (Mapallbands.begin()->second)->Clone(name.c_str()));
  if (!h_Total_results) {
   throw SPXGraphException(cn+mn+"Could not create h_Total_results !");
  } else {
@@ -2148,6 +2403,7 @@ void SPXPDF::CalcTotalErrors()
  }
 
  Mapallbands["total"]=h_Total_results;
+ bandBounds.erase("total");
 
  h_Total_results->SetFillStyle  (fillStyleCode);
  SPXGraphUtilities::SetColors( h_Total_results,fillColorCode);
@@ -2218,6 +2474,7 @@ TH1D* SPXPDF::GetPDFRatio(int iset1, int iset2)
  TH1D *hratio=(TH1D*) h_errors_PDF[iset1]->Clone( ratio_to_ref_name);
  TH1D *htmp=(TH1D*) h_errors_PDF[iset2]->Clone("htmp");
  hratio->Divide(htmp);
+ delete htmp;
 
  hratio->SetLineColor(fillColorCode);
 
@@ -2351,6 +2608,8 @@ void SPXPDF::SetVariablesDefault()
 
  Escale=1.;
 
+ h_AlternativeScaleChoicePDF_ratio=0;
+
  if (debug) std::cout<<cn<<mn<<"End default values are set."<<std::endl;
 }
 
@@ -2467,6 +2726,22 @@ void SPXPDF::CleanUpSPXPDF() {
   }
  }
 
+ for (int i=0; i<pdfBands.size(); ++i) {
+  delete pdfBands.at(i);
+ }
+
+ for (int i=0; i<h_errors_AlternativeScaleChoicePDF.size(); ++i) {
+  delete h_errors_AlternativeScaleChoicePDF.at(i);
+ }
+ delete h_AlternativeScaleChoicePDF_ratio;
+
+ for (int i=0; i<h_BeamEnergySweepRatio.size(); ++i) {
+  delete h_BeamEnergySweepRatio.at(i);
+ }
+ h_BeamEnergySweepRatio.clear();
+ beamEnergySweepFactors.clear();
+ pdfBands.clear();
+
  if (debug) std::cout<<cn<<mn<<"Finished clean up!"<<std::endl;
 }
 
@@ -2503,6 +2778,325 @@ TH1D * SPXPDF::FillPdfHisto(){
  return hpdf;
 };
 
+std::string SPXPDF::GetFlavourName(int iflpdf){
+ // iflpdf convention [-6,0,6] zero is gluon
+ static const char *names[13]={"tbar","bbar","cbar","sbar","ubar","dbar","g","d","u","s","c","b","t"};
+ if (iflpdf<-6 || iflpdf>6) return "unknown";
+ return names[6+iflpdf];
+}
+
+#if defined LHAPDF_MAJOR_VERSION && LHAPDF_MAJOR_VERSION == 6
+//Member sweep shared by the PDF band threads: one job is one LHAPDF::PDF object, evaluated by one thread
+//only, together with all members using that object (HERAPDF variations may repeat a member)
+typedef struct SPXPDFSweep_t {
+ std::vector<LHAPDF::PDF*> *pdfs;
+ std::vector<std::vector<unsigned int> > *members;
+ const std::vector<double> *q2values;
+ const std::vector<double> *xvalues;
+ std::vector<double> *values;
+} SPXPDFSweep_t;
+
+static void PdfSweepJob(void *arg, unsigned int job, unsigned int thread) {
+ SPXPDFSweep_t *sweep = (SPXPDFSweep_t *)arg;
+
+ const unsigned int nq2 = sweep->q2values->size();
+ const unsigned int nx  = sweep->xvalues->size();
+ const unsigned int size = nq2*nx*13;
+ std::vector<double> xf(13);
+
+ LHAPDF::PDF *pdf = sweep->pdfs->at(job);
+ const std::vector<unsigned int> &members = sweep->members->at(job);
+ double *first = &(sweep->values->at(members.at(0)*size));
+ double *out = first;
+
+ for (unsigned int iq2=0; iq2<nq2; iq2++) {
+  for (unsigned int ix=0; ix<nx; ix++) {
+   double x=sweep->xvalues->at(ix);
+   if (x>=1) x-=1.e-12;
+   // all 13 flavours in one call
+   pdf->xfxQ2(x, sweep->q2values->at(iq2), xf);
+   for (int k=0; k<13; k++) *out++ = xf[k];
+  }
+ }
+
+ for (unsigned int i=1; i<members.size(); i++) {
+  std::copy(first, first+size, &(sweep->values->at(members.at(i)*size)));
+ }
+}
+#endif
+
+void SPXPDF::FillPdfBands(const std::vector<double> &q2values, int nx, double xmin, double xmax){
+ std::string mn = "FillPdfBands: ";
+
+ if (nx<2 || xmin<=0 || xmax>1 || xmin>=xmax) {
+  std::ostringstream oss;
+  oss<<cn<<mn<<"Invalid x grid nx= "<<nx<<" xmin= "<<xmin<<" xmax= "<<xmax;
+  throw SPXParseException(oss.str());
+ }
+
+ // log-x grid
+ std::vector<double> xvalues(nx);
+ for (int ix=0; ix<nx; ix++) {
+  xvalues[ix]=xmin*pow(xmax/xmin, double(ix)/double(nx-1));
+ }
+
+ this->FillPdfBands(q2values, xvalues);
+}
+
+void SPXPDF::FillPdfBands(const std::vector<double> &q2values, const std::vector<double> &xvalues){
+ //
+ // PDF-vs-x bands for all 13 flavours at all Q2 values:
+ // every member is evaluated once for all (Q2, x, flavour) and all bands are built from this single sweep
+ //
+ std::string mn = "FillPdfBands: ";
+ if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+ if (q2values.size()==0 || xvalues.size()==0) {
+  throw SPXParseException(cn+mn+"No Q2 or x values given");
+ }
+
+ const unsigned int nmem=n_PDFMembers>0 ? n_PDFMembers : 1;
+ const unsigned int nq2=q2values.size();
+ const unsigned int nx=xvalues.size();
+
+ if (defaultpdfid<0 || defaultpdfid>=(int)nmem) {
+  std::ostringstream oss;
+  oss<<cn<<mn<<"Default PDF member "<<defaultpdfid<<" not in [0,"<<nmem<<")";
+  throw SPXParseException(oss.str());
+ }
+
+ pdfBandQ2=q2values;
+ pdfBandX=xvalues;
+ pdfBandValues.assign(nmem*nq2*nx*13, 0.);
+
+ for (int i=0; i<pdfBands.size(); i++) delete pdfBands[i];
+ pdfBands.clear();
+
+#ifdef TIMER
+ std::cout<<cn<<mn<<"TIMER sweep over "<<nmem<<" members running..."<<std::endl;
+ quick_timer t0;
+#endif
+
+#if defined LHAPDF_MAJOR_VERSION && LHAPDF_MAJOR_VERSION == 6
+ // loading members is not thread safe: do it here (members stay cached), evaluate them in parallel.
+ // Members using the same PDF object are evaluated in one job, so that no object is used by two threads
+ std::vector<LHAPDF::PDF*> pdfs;
+ std::vector<std::vector<unsigned int> > members;
+ std::map<LHAPDF::PDF*, unsigned int> jobs;
+ for (unsigned int m=0; m<nmem; m++) {
+  this->SetLHAPDFMember(m);
+  if (!mypdf) {
+   std::ostringstream oss;
+   oss<<cn<<mn<<"PDF member "<<m<<" of "<<PDFname<<" not found";
+   throw SPXParseException(oss.str());
+  }
+  if (jobs.count(mypdf)==0) {
+   jobs[mypdf]=pdfs.size();
+   pdfs.push_back(mypdf);
+   members.push_back(std::vector<unsigned int>());
+  }
+  members.at(jobs[mypdf]).push_back(m);
+ }
+
+ if (debug) std::cout<<cn<<mn<<nmem<<" members use "<<pdfs.size()<<" PDF objects"<<std::endl;
+
+ SPXPDFSweep_t sweep;
+ sweep.pdfs=&pdfs;
+ sweep.members=&members;
+ sweep.q2values=&pdfBandQ2;
+ sweep.xvalues=&pdfBandX;
+ sweep.values=&pdfBandValues;
+
+ SPXWorkQueue::Run(PdfSweepJob, &sweep, pdfs.size(), SPXWorkQueue::GetNumberOfThreads(pdfs.size(), MAX_SWEEP_THREADS), "sweep");
+#else
+ // LHAPDF5 keeps a single global PDF: members one after the other
+ double xf[13];
+ for (unsigned int m=0; m<nmem; m++) {
+  this->SetLHAPDFMember(m);
+  double *out=&pdfBandValues[m*nq2*nx*13];
+  for (unsigned int iq2=0; iq2<nq2; iq2++) {
+   double Q=sqrt(pdfBandQ2[iq2]);
+   for (unsigned int ix=0; ix<nx; ix++) {
+    getPDF(pdfBandX[ix], Q, xf);
+    for (int k=0; k<13; k++) *out++ = xf[k];
+   }
+  }
+ }
+#endif
+
+ // Set back to default PDF
+ this->SetLHAPDFPDFset(default_pdf_set_name, defaultpdfid);
+
+#ifdef TIMER
+ std::cout<<cn<<mn<<"TIMER sweep done t0= "<<t0.time()<<" [ms]"<<std::endl;
+#endif
+
+ // x bin edges half way (in log x) between neighbouring points
+ std::vector<double> exl(nx,0.), exh(nx,0.);
+ for (unsigned int ix=0; ix<nx; ix++) {
+  if (ix>0)    exl[ix]=pdfBandX[ix]-sqrt(pdfBandX[ix]*pdfBandX[ix-1]);
+  if (ix<nx-1) exh[ix]=sqrt(pdfBandX[ix]*pdfBandX[ix+1])-pdfBandX[ix];
+ }
+ if (nx>1) {
+  exl[0]=exh[0];
+  exh[nx-1]=exl[nx-1];
+ }
+
+ std::vector<double> values(nmem);
+ for (unsigned int iq2=0; iq2<nq2; iq2++) {
+  for (int k=0; k<13; k++) {
+   std::ostringstream name;
+   name<<"xf_"<<GetFlavourName(k-6)<<"_Q2_"<<pdfBandQ2[iq2]<<"_pdf_"<<PDFtype;
+
+   TGraphAsymmErrors *band=new TGraphAsymmErrors(nx);
+   band->SetName(name.str().c_str());
+
+   for (unsigned int ix=0; ix<nx; ix++) {
+    for (unsigned int m=0; m<nmem; m++) values[m]=pdfBandValues[((m*nq2+iq2)*nx+ix)*13+k];
+
+    double central=0., err_up=0., err_down=0.;
+    this->GetPDFBand(values, central, err_up, err_down);
+
+    band->SetPoint(ix, pdfBandX[ix], central);
+    band->SetPointError(ix, exl[ix], exh[ix], err_down, err_up);
+   }
+
+   pdfBands.push_back(band);
+  }
+ }
+
+ if (debug) std::cout<<cn<<mn<<"Filled "<<pdfBands.size()<<" bands from "<<nmem<<" members x "<<nq2<<" Q2 x "<<nx<<" x values"<<std::endl;
+}
+
+void SPXPDF::GetPDFBand(const std::vector<double> &values, double &central, double &err_up, double &err_down){
+ std::string mn = "GetPDFBand: ";
+
+ if (defaultpdfid<0 || (int)values.size()<=defaultpdfid) {
+  std::ostringstream oss;
+  oss<<cn<<mn<<"Default PDF member "<<defaultpdfid<<" not in "<<values.size()<<" values";
+  throw SPXParseException(oss.str());
+ }
+
+ central=values[defaultpdfid];
+ err_up=0.;
+ err_down=0.;
+
+ // a single member has no uncertainty
+ if (values.size()<2) return;
+
+ double average=0.;
+ this->CalcPDFBandError(values, average, err_up, err_down);
+
+ // replicas: central value is the average
+ if (ErrorPropagationType==StyleNNPDF) central=average;
+}
+
+//
+// The members (pdf) or scale variations (scale) of the numerator and the denominator
+// are divided first and the error rule of the set is applied to the ratios, so that
+// everything correlated between the two predictions cancels. The relative errors are
+// returned for each point of graph, found by its x in the member histograms. Returns
+// false if the two predictions do not share the members (other PDF set, error type,
+// scale choices or binning) or a point of graph is outside the histograms
+//
+bool SPXPDF::GetCorrelatedRatioErrors(SPXPDF *den, const std::string &type, TGraphAsymmErrors *graph,
+                                      std::vector<double> &err_up, std::vector<double> &err_down){
+ std::string mn = "GetCorrelatedRatioErrors: ";
+ if (debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+ if (!den || !graph) return false;
+
+ std::vector<TH1D*> *hnum=0;
+ std::vector<TH1D*> *hden=0;
+ if (type=="pdf") {
+  if (PDFtype!=den->PDFtype || ErrorPropagationType!=den->ErrorPropagationType) return false;
+  hnum=&h_errors_PDF;
+  hden=&den->h_errors_PDF;
+ } else if (type=="scale") {
+  // the same scale choices, in the same order
+  if (RenScales!=den->RenScales || FacScales!=den->FacScales) return false;
+  hnum=&h_errors_Scale;
+  hden=&den->h_errors_Scale;
+ } else {
+  return false;
+ }
+
+ unsigned int nmem=hnum->size();
+ if (nmem<2 || hden->size()!=nmem) return false;
+
+ for (unsigned int m=0; m<nmem; m++) {
+  if (!hnum->at(m) || !hden->at(m)) return false;
+  if (hnum->at(m)->GetNbinsX()!=hnum->at(0)->GetNbinsX() || hden->at(m)->GetNbinsX()!=hnum->at(0)->GetNbinsX()) return false;
+ }
+
+ // histogram bin of each point
+ unsigned int npoints=graph->GetN();
+ std::vector<int> bins(npoints);
+ for (unsigned int ip=0; ip<npoints; ip++) {
+  bins[ip]=hnum->at(0)->FindBin(graph->GetX()[ip]);
+  if (bins[ip]<1 || bins[ip]>hnum->at(0)->GetNbinsX()) return false;
+ }
+
+ // member ratios for all points in one pass, [point][member]
+ std::vector<double> ratios(npoints*nmem, 0.);
+ for (unsigned int m=0; m<nmem; m++) {
+  TH1D *hn=hnum->at(m);
+  TH1D *hd=hden->at(m);
+  for (unsigned int ip=0; ip<npoints; ip++) {
+   double d=hd->GetBinContent(bins[ip]);
+   ratios[ip*nmem+m]=(d!=0.) ? hn->GetBinContent(bins[ip])/d : 0.;
+  }
+ }
+
+ err_up.assign(npoints, 0.);
+ err_down.assign(npoints, 0.);
+
+ std::vector<double> values(nmem);
+ for (unsigned int bi=0; bi<npoints; bi++) {
+  values.assign(ratios.begin()+bi*nmem, ratios.begin()+(bi+1)*nmem);
+
+  double central=0., up=0., down=0.;
+  if (type=="pdf") {
+   this->GetPDFBand(values, central, up, down);
+  } else {
+   // envelope of the scale choices around the default (first) one
+   central=values[0];
+   double max=central, min=central;
+   for (unsigned int m=1; m<nmem; m++) {
+    if (values[m]>max) max=values[m];
+    if (values[m]<min) min=values[m];
+   }
+   up=max-central;
+   down=central-min;
+  }
+
+  if (central!=0.) {
+   err_up[bi]  =up/fabs(central);
+   err_down[bi]=down/fabs(central);
+  }
+
+  if (debug) std::cout<<cn<<mn<<type<<" point= "<<bi<<" bin= "<<bins[bi]<<" ratio= "<<central<<" +"<<err_up[bi]<<" -"<<err_down[bi]<<" (relative)"<<std::endl;
+ }
+
+ return true;
+}
+
+TGraphAsymmErrors * SPXPDF::GetPdfBand(int iflpdf, unsigned int iq2){
+ std::string mn = "GetPdfBand: ";
+
+ if (iflpdf<-6 || iflpdf>6 || iq2>=pdfBandQ2.size() || pdfBands.size()!=13*pdfBandQ2.size()) {
+  std::ostringstream oss;
+  oss<<cn<<mn<<"No PDF band for ifl= "<<iflpdf<<" iQ2= "<<iq2<<": Call FillPdfBands first";
+  throw SPXGraphException(oss.str());
+ }
+
+ return pdfBands[iq2*13+6+iflpdf];
+}
+
+double SPXPDF::GetPdfBandValue(unsigned int member, int iflpdf, unsigned int iq2, unsigned int ix){
+ return pdfBandValues.at(((member*pdfBandQ2.size()+iq2)*pdfBandX.size()+ix)*13+6+iflpdf);
+}
+
 void SPXPDF::PrintMap(BandMap_T &m) {
  std::string mn = "PrintMap: ";
  if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
@@ -2535,6 +3129,23 @@ TGraphAsymmErrors * SPXPDF::GetBand(int i){
  return 0;
 };
 
+const SPXGraphBounds_t & SPXPDF::GetBandBounds(int i){
+ std::string mn = "GetBandBounds: ";
+
+ std::string type=GetBandType(i);
+ std::map<std::string, SPXGraphBounds_t>::iterator it=bandBounds.find(type);
+ if (it!=bandBounds.end()) return it->second;
+
+ TGraphAsymmErrors *gband=GetBand(i);
+ if (!gband) {
+  std::ostringstream oss;
+  oss << cn <<mn<<"Band "<<i<<" not found";
+  throw SPXGeneralException(oss.str());
+ }
+
+ return bandBounds[type]=SPXGraphUtilities::GetBounds(gband);
+}
+
 std::string SPXPDF::GetBandType(int i){ 
  std::string mn = "GetBandType: ";
  //if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
@@ -2559,6 +3170,9 @@ void SPXPDF::ApplyBandCorrection(TGraphAsymmErrors *gcorr, std::string corrLabel
  std::string mn = "ApplyBandCorrections: ";
  if (debug) SPXUtilities::PrintMethodHeader(cn, mn);
 
+ //The bands are corrected in place
+ bandBounds.clear();
+
  if (!gcorr) {
   std::ostringstream oss;
   oss << cn << mn << "Correction graph not found ";
@@ -2569,6 +3183,12 @@ void SPXPDF::ApplyBandCorrection(TGraphAsymmErrors *gcorr, std::string corrLabel
   std::cout<<cn<<mn<<"Apply "<<corrLabel.c_str()<<" correction from graph: "<<gcorr->GetName()<<std::endl;
   gcorr->Print();
  }
+
+ // usual case: everything already has the binning of the correction
+ if (this->IsBinAlignedCorrection(gcorr)) {
+  this->ApplyAlignedBandCorrection(gcorr,corrLabel,includeinband);
+  return;
+ }
  
  bool dividebybinwidth=true; // Is this correct HUHU ???
 
@@ -2693,6 +3313,8 @@ void SPXPDF::ApplyBandCorrection(TGraphAsymmErrors *gcorr, std::string corrLabel
    std::cout <<cn<<mn<< "After MatchandMultiply Print hcorr: "<< hcorr->GetName()<< std::endl;
    hcorr->Print("all");
   }
+  // MatchandMultiply works in place unless the binning had to be matched
+  if (htmp!=h_errors_PDF.at(ipdf)) SPXArena::AdoptCurrent(h_errors_PDF.at(ipdf));
   h_errors_PDF.at(ipdf)=htmp;
   hname=this->GetName(hname);
   h_errors_PDF.at(ipdf)->SetName(hname.c_str());
@@ -2708,6 +3330,7 @@ void SPXPDF::ApplyBandCorrection(TGraphAsymmErrors *gcorr, std::string corrLabel
   hname+="_"+corrLabel;
 
   TH1D* htmp=SPXGraphUtilities::MatchandMultiply(hcorr,h_errors_Scale.at(iscale),false);
+  if (htmp!=h_errors_Scale.at(iscale)) SPXArena::AdoptCurrent(h_errors_Scale.at(iscale));
   h_errors_Scale.at(iscale)=htmp;
   hname=this->GetName(hname);
   h_errors_Scale.at(iscale)->SetName(hname.c_str());
@@ -2718,6 +3341,7 @@ void SPXPDF::ApplyBandCorrection(TGraphAsymmErrors *gcorr, std::string corrLabel
   hname+="_"+corrLabel;
 
   TH1D* htmp=SPXGraphUtilities::MatchandMultiply(hcorr,h_errors_AlternativeScaleChoice.at(iscale),false);
+  if (htmp!=h_errors_AlternativeScaleChoice.at(iscale)) SPXArena::AdoptCurrent(h_errors_AlternativeScaleChoice.at(iscale));
   h_errors_AlternativeScaleChoice.at(iscale)=htmp;
   hname=this->GetName(hname);
   h_errors_AlternativeScaleChoice.at(iscale)->SetName(hname.c_str());
@@ -2730,6 +3354,7 @@ void SPXPDF::ApplyBandCorrection(TGraphAsymmErrors *gcorr, std::string corrLabel
   hname+="_"+corrLabel;
 
   TH1D* htmp=SPXGraphUtilities::MatchandMultiply(hcorr,h_errors_AlphaS.at(ialphas),false);
+  if (htmp!=h_errors_AlphaS.at(ialphas)) SPXArena::AdoptCurrent(h_errors_AlphaS.at(ialphas));
   h_errors_AlphaS.at(ialphas)=htmp;
   hname=this->GetName(hname);
   h_errors_AlphaS.at(ialphas)->SetName(hname.c_str());
@@ -2741,6 +3366,7 @@ void SPXPDF::ApplyBandCorrection(TGraphAsymmErrors *gcorr, std::string corrLabel
   hname+="_"+corrLabel;
 
   TH1D* htmp=SPXGraphUtilities::MatchandMultiply(hcorr,h_errors_BeamUncertainty.at(ibeam),false);
+  if (htmp!=h_errors_BeamUncertainty.at(ibeam)) SPXArena::AdoptCurrent(h_errors_BeamUncertainty.at(ibeam));
   h_errors_BeamUncertainty.at(ibeam)=htmp;
   hname=this->GetName(hname);
   h_errors_BeamUncertainty.at(ibeam)->SetName(hname.c_str());
@@ -2816,7 +3442,7 @@ void SPXPDF::ApplyBandCorrection(TGraphAsymmErrors *gcorr, std::string corrLabel
     std::cout <<cn<<mn<< "Correction band uncertainty as it goes to map["<<corrLabel<<"]: gband2= "<<gband2->GetName()<< std::endl;   
     gband2->Print("all");
    }
-   Mapallbands[corrLabel]=gband2;
+   Mapallbands[corrLabel]=SPXArena::AdoptCurrent(gband2);
    if (debug) std::cout<<cn<<mn<< "Correction "<<gband2->GetName()<<" included in Map "<< std::endl;   
   } else {
    if (debug) std::cout<<cn<<mn<< "Correction "<<gband2->GetName()<<" Not requested to include in Map "<< std::endl;
@@ -2838,6 +3464,130 @@ void SPXPDF::ApplyBandCorrection(TGraphAsymmErrors *gcorr, std::string corrLabel
 
 }
 
+bool SPXPDF::IsBinAlignedCorrection(TGraphAsymmErrors *gcorr){
+ std::string mn = "IsBinAlignedCorrection: ";
+
+ int nbin=gcorr->GetN();
+
+ for (BandMap_T::const_iterator it = Mapallbands.begin(); it != Mapallbands.end(); ++it) {
+  TGraphAsymmErrors *gband=it->second;
+  if (!gband || gband->GetN()!=nbin) return false;
+
+  // same bin edges, as required by SPXGraphUtilities::Multiply
+  for (int ibin=0; ibin<nbin; ibin++) {
+   if (gband->GetX()[ibin]-gband->GetErrorXlow(ibin) != gcorr->GetX()[ibin]-gcorr->GetErrorXlow(ibin)) return false;
+   if (gband->GetX()[ibin]+gband->GetErrorXhigh(ibin)!= gcorr->GetX()[ibin]+gcorr->GetErrorXhigh(ibin)) return false;
+  }
+ }
+
+ if (!hpdfdefault || hpdfdefault->GetNbinsX()!=nbin) return false;
+
+ std::vector<TH1D*> *histos[5]={&h_errors_PDF, &h_errors_Scale, &h_errors_AlternativeScaleChoice, &h_errors_AlphaS, &h_errors_BeamUncertainty};
+ for (int iv=0; iv<5; iv++) {
+  for (int ih=0; ih<histos[iv]->size(); ih++) {
+   if (histos[iv]->at(ih)->GetNbinsX()!=nbin) return false;
+  }
+ }
+
+ if (debug) std::cout<<cn<<mn<<"Bands and histograms have the binning of "<<gcorr->GetName()<<std::endl;
+
+ return true;
+}
+
+//Same result as the general ApplyBandCorrection path for bin-aligned corrections, but the correction factors are
+//multiplied into the nominal, every band and every individual member histogram in place in one loop per object,
+//without matching the binning or cloning graphs and histograms
+void SPXPDF::ApplyAlignedBandCorrection(TGraphAsymmErrors *gcorr, std::string corrLabel, bool includeinband){
+ std::string mn = "ApplyAlignedBandCorrection: ";
+ if (debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+ //The bands are corrected in place
+ bandBounds.clear();
+
+ int nbin=gcorr->GetN();
+ const double *factor=gcorr->GetY();
+
+ // bands: values and uncertainties scale with the correction (its uncertainty is shown separately)
+ TGraphAsymmErrors *glast=0;
+ for (BandMap_T::const_iterator it = Mapallbands.begin(); it != Mapallbands.end(); ++it) {
+  TGraphAsymmErrors *gband=it->second;
+
+  double *y  =gband->GetY();
+  double *eyl=gband->GetEYlow();
+  double *eyh=gband->GetEYhigh();
+  for (int ibin=0; ibin<nbin; ibin++) {
+   y[ibin]*=factor[ibin];
+   eyl[ibin]=(y[ibin]!=0. ? fabs(eyl[ibin]*factor[ibin]) : 0.);
+   eyh[ibin]=(y[ibin]!=0. ? fabs(eyh[ibin]*factor[ibin]) : 0.);
+  }
+
+  std::string newname=gband->GetName();
+  newname+="_"+corrLabel;
+  newname=this->GetName(newname);
+  gband->SetName(newname.c_str());
+
+  glast=gband;
+ }
+
+ // nominal and all individual PDF members, scale, alternative scale, alphas and beam variations
+ std::vector<TH1D*> hall(1,hpdfdefault);
+ hall.insert(hall.end(), h_errors_PDF.begin(), h_errors_PDF.end());
+ hall.insert(hall.end(), h_errors_Scale.begin(), h_errors_Scale.end());
+ hall.insert(hall.end(), h_errors_AlternativeScaleChoice.begin(), h_errors_AlternativeScaleChoice.end());
+ hall.insert(hall.end(), h_errors_AlphaS.begin(), h_errors_AlphaS.end());
+ hall.insert(hall.end(), h_errors_BeamUncertainty.begin(), h_errors_BeamUncertainty.end());
+
+ for (int ih=0; ih<hall.size(); ih++) {
+  TH1D *h=hall.at(ih);
+  for (int ibin=0; ibin<nbin; ibin++) {
+   h->SetBinContent(ibin+1, h->GetBinContent(ibin+1)*factor[ibin]);
+   h->SetBinError  (ibin+1, h->GetBinError(ibin+1)*fabs(factor[ibin]));
+  }
+
+  std::string hname=h->GetName();
+  hname+="_"+corrLabel;
+  hname=this->GetName(hname);
+  h->SetName(hname.c_str());
+ }
+
+ // band of the correction uncertainty: relative uncertainty of the correction around the corrected values
+ TGraphAsymmErrors *gband2=0;
+ if (glast) gband2=(TGraphAsymmErrors*)glast->Clone();
+ else       gband2=SPXGraphUtilities::TH1TOTGraphAsymm(hpdfdefault);
+
+ std::string name="_corrections_"+corrLabel;
+ name=this->GetName(name);
+ gband2->SetName(name.c_str());
+
+ for (int ibin=0; ibin<nbin; ibin++) {
+  double x=0., y=0.;
+  gband2->GetPoint(ibin,x,y);
+
+  double reyl=gcorr->GetErrorYlow(ibin)/factor[ibin];
+  double reyh=gcorr->GetErrorYhigh(ibin)/factor[ibin];
+
+  gband2->SetPointError(ibin,gcorr->GetErrorXlow(ibin),gcorr->GetErrorXhigh(ibin),reyl*y,reyh*y);
+ }
+
+ if (Mapallbands.count(corrLabel)!=0) {
+  std::ostringstream oss;
+  oss << cn << mn << "Band correction apply twice corrections= "<<corrLabel;
+  throw SPXParseException(oss.str());
+ }
+
+ if (includeinband) {
+  Mapallbands[corrLabel]=SPXArena::AdoptCurrent(gband2);
+  if (debug) std::cout<<cn<<mn<< "Correction "<<gband2->GetName()<<" included in Map "<< std::endl;
+ } else {
+  delete gband2;
+ }
+
+ if (debug) {
+  std::cout <<cn<<mn<< "Print new Map: Mapallbands"<< std::endl;
+  PrintMap(Mapallbands);
+ }
+}
+
 bool SPXPDF::BandsHaveDifferentProperties(){
  std::string mn = "BandsHaveDifferentProperties: ";
  if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
@@ -3084,6 +3834,7 @@ void SPXPDF::SetIndividualPDFComponent(int ipdf, TH1D *h){
 
  if (!h) std::cout<<cn<<mn<<"WARNING histogram not found !"<<std::endl;
 
+ if (h_errors_PDF.at(ipdf)!=h) SPXArena::AdoptCurrent(h_errors_PDF.at(ipdf));
  h_errors_PDF.at(ipdf)=h; 
 
  return;
@@ -3141,6 +3892,7 @@ void SPXPDF::SetIndividualScaleVariation(int iscale, TH1D *h){
 
  if (!h) std::cout<<cn<<mn<<"WARNING: histogram not found !"<<std::endl;
 
+ if (h_errors_Scale.at(iscale)!=h) SPXArena::AdoptCurrent(h_errors_Scale.at(iscale));
  h_errors_Scale.at(iscale)=h; 
  return;
 }
@@ -3156,6 +3908,7 @@ void SPXPDF::SetIndividualAlternativeScaleChoiceVariation(int iscale, TH1D *h){
 
  if (!h) std::cout<<cn<<mn<<"WARNING: histogram not found !"<<std::endl;
 
+ if (h_errors_AlternativeScaleChoice.at(iscale)!=h) SPXArena::AdoptCurrent(h_errors_AlternativeScaleChoice.at(iscale));
  h_errors_AlternativeScaleChoice.at(iscale)=h; 
  return;
 }
@@ -3191,6 +3944,7 @@ void SPXPDF::SetIndividualAlphaSVariation(int ialphas, TH1D *h){
 
  if (!h) std::cout<<cn<<mn<<"WARNING: histogram not found !"<<std::endl;
 
+ if (h_errors_AlphaS.at(ialphas)!=h) SPXArena::AdoptCurrent(h_errors_AlphaS.at(ialphas));
  h_errors_AlphaS.at(ialphas)=h; 
 
  return;
@@ -3208,10 +3962,25 @@ void SPXPDF::SetLHAPDFPDFset(std::string pdfname, int id){
    std::cout<<cn<<mn<<"Set PDF "<<pdfname.c_str()<<" id= "<<id<<std::endl;
   }
 
-  mypdf=LHAPDF::mkPDF(pdfname.c_str(),id);
-  if (!mypdf) std::cout<<"PDF not found name= "<<pdfname.c_str()<<" member= "<<id<<std::endl;
+  std::pair<std::string, int> key(pdfname, id);
+  lhapdfMemberRequests++;
+  std::map<std::pair<std::string, int>, SPXPDFMemberCacheEntry_t>::iterator it=lhapdfMemberCache.find(key);
+  if (it!=lhapdfMemberCache.end()) {
+   if (debug) std::cout<<cn<<mn<<"Reuse cached member "<<pdfname.c_str()<<" id= "<<id<<std::endl;
+   mypdf=it->second.pdf;
+   it->second.lastUse=lhapdfMemberRequests;
+  } else {
+   SPXStageScope stage("load");
+   mypdf=LHAPDF::mkPDF(pdfname.c_str(),id);
+   if (!mypdf) std::cout<<"PDF not found name= "<<pdfname.c_str()<<" member= "<<id<<std::endl;
+   else {
+    SPXPDFMemberCacheEntry_t entry;
+    entry.pdf=mypdf;
+    entry.lastUse=lhapdfMemberRequests;
+    lhapdfMemberCache[key]=entry;
+   }
+  }
   //else if (debug) mypdf->print();
-  const LHAPDF::PDFSet set(pdfname.c_str());
 #else
   if (debug) {
    std::cout<<cn<<mn<<"  "<<std::endl;
@@ -3224,6 +3993,83 @@ void SPXPDF::SetLHAPDFPDFset(std::string pdfname, int id){
  return; 
 }
 
+void SPXPDF::SetLHAPDFMember(int pdferri){
+ //
+ // select PDF member pdferri of the error loop
+ // HERAPDF type PDFs take the variations (pdferri > lasteig) from the variation set PDFnamevar
+ //
+ std::string mn = "SetLHAPDFMember: ";
+
+ if (ErrorPropagationType!=StyleHeraPDF) {
+  if (debug) std::cout<<cn<<mn<<"Initialize normal PDF set= "<<pdferri<<std::endl;
+  this->SetLHAPDFPDFset(default_pdf_set_name, pdferri);
+  return;
+ }
+
+ if (!includeEIG&&!includeQUAD&&!includeMAX) std::cout<<cn<<mn<<"No error band included !! "<<std::endl;
+
+ if (defaultpdfidvar<0) {
+  std::cout<<cn<<mn<<"WARNING: No default PDF id found in steering. Check steering for missing 'defaultpdfidvar'. pdferri= "<<pdferri<<std::endl;
+  std::cerr<<cn<<mn<<"WARNING: No default PDF id found in steering. Check steering for missing 'defaultpdfidvar'. pdferri= "<<pdferri<<std::endl;
+ }
+
+ if (pdferri <= lasteig ) {
+  this->SetLHAPDFPDFset(PDFname, pdferri);
+ } else if( pdferri == lasteig+1 ) {
+  //Band-aid for accounting for no error bands - This needs to be handled better
+  if(PDFnamevar.empty() == false) {
+   this->SetLHAPDFPDFset(PDFnamevar, defaultpdfidvar);
+  } else {
+   std::cout<<cn<<mn<<"WARNING: Can not intitalize name= "<<PDFnamevar.c_str()<<" set= "<<defaultpdfidvar<<std::endl;
+   std::cerr<<cn<<mn<<"WARNING: Can not intitalize name= "<<PDFnamevar.c_str()<<" set= "<<defaultpdfidvar<<std::endl;
+  }
+ } else {
+  //>> modification P Berta 28.8.14>>
+  int pdfset=pdferri - lasteig-1;
+  if (debug) std::cout<<cn<<mn<<"pdferri> lasteig+1 initPDF name= "<<PDFnamevar.c_str()<<" set= "<<pdfset<<std::endl;
+  this->SetLHAPDFPDFset(PDFnamevar, pdfset);
+ }
+
+ return;
+}
+
+
+unsigned int SPXPDF::GetNumberOfCachedPDFMembers(void) {
+#if defined LHAPDF_MAJOR_VERSION && LHAPDF_MAJOR_VERSION == 6
+ return lhapdfMemberCache.size();
+#else
+ return 0;
+#endif
+}
+
+//Deletes the least recently used members until at most maxMembers are cached; the member
+// in use (mypdf) is kept. Must not be called while a member sweep holds member pointers
+void SPXPDF::TrimPDFMemberCache(unsigned int maxMembers) {
+ std::string mn = "TrimPDFMemberCache: ";
+#if defined LHAPDF_MAJOR_VERSION && LHAPDF_MAJOR_VERSION == 6
+ if (lhapdfMemberCache.size()<=maxMembers) return;
+
+ //Order the members by their last use
+ std::vector<std::pair<unsigned long, std::pair<std::string, int> > > order;
+ std::map<std::pair<std::string, int>, SPXPDFMemberCacheEntry_t>::iterator it;
+ for (it=lhapdfMemberCache.begin(); it!=lhapdfMemberCache.end(); ++it) {
+  if (it->second.pdf==mypdf) continue;
+  order.push_back(std::make_pair(it->second.lastUse, it->first));
+ }
+ std::sort(order.begin(), order.end());
+
+ unsigned int ndrop=lhapdfMemberCache.size()-maxMembers;
+ if (ndrop>order.size()) ndrop=order.size();
+
+ for (unsigned int i=0; i<ndrop; i++) {
+  it=lhapdfMemberCache.find(order[i].second);
+  delete it->second.pdf;
+  lhapdfMemberCache.erase(it);
+ }
+
+ if (debug) std::cout<<cn<<mn<<"Dropped "<<ndrop<<" members: "<<lhapdfMemberCache.size()<<" left"<<std::endl;
+#endif
+}
 
 std::string SPXPDF::GetName(std::string basename) {
  std::string mn = "GetName: ";	
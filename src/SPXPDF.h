@@ -44,6 +44,7 @@
 #include "SPXException.h"
 #include "SPXUtilities.h"
 #include "SPXGrid.h"
+#include "SPXGraphUtilities.h"
 
 //#define DEFAULT -1
 
@@ -56,6 +57,7 @@ class SPXPDF {
 
         //METHODS
         SPXPDF() {};
+        explicit SPXPDF(SPXPDFSteeringFile *psf);
         SPXPDF(SPXPDFSteeringFile *psf, int ifl, double q2, TH1D *h1);
         SPXPDF(SPXPDFSteeringFile *psf, const std::string &_gridName);
         SPXPDF(SPXPDFSteeringFile *psf, SPXGrid *grid);
@@ -68,6 +70,23 @@ class SPXPDF {
 
         TH1D * FillPdfHisto();
 
+        // PDF-vs-x bands of all 13 flavours at each Q2 (log-x grid or given x values) from one sweep over the members
+        void FillPdfBands(const std::vector<double> &q2values, int nx, double xmin, double xmax);
+        void FillPdfBands(const std::vector<double> &q2values, const std::vector<double> &xvalues);
+        TGraphAsymmErrors *GetPdfBand(int ifl, unsigned int iq2);
+        double GetPdfBandValue(unsigned int member, int ifl, unsigned int iq2, unsigned int ix);
+        const std::vector<double> & GetPdfBandValues() const {return pdfBandValues;}; // xf for [member][Q2][x][flavour]
+        unsigned int GetNumberOfPdfBandMembers() const {return pdfBandQ2.size()*pdfBandX.size()>0 ? pdfBandValues.size()/(13*pdfBandQ2.size()*pdfBandX.size()) : 0;};
+
+        // central value and PDF uncertainty of one observable from its values for all members
+        void GetPDFBand(const std::vector<double> &values, double &central, double &err_up, double &err_down);
+        // relative uncertainty of this prediction over another one, computed member by member (type pdf or scale)
+        bool GetCorrelatedRatioErrors(SPXPDF *denominator, const std::string &type, TGraphAsymmErrors *graph,
+                                      std::vector<double> &err_up, std::vector<double> &err_down);
+        unsigned int GetNumberOfPdfBandQ2() const {return pdfBandQ2.size();};
+        const std::vector<double> & GetPdfBandX() const {return pdfBandX;};
+        static std::string GetFlavourName(int ifl);
+
         void CleanUpSPXPDF();
         void Initialize();
         void Print();
@@ -120,6 +139,10 @@ class SPXPDF {
         TGraphAsymmErrors *GetBand(int i);
 	std::string GetBandType(int i);
 
+        //Extent of band i: computed when first asked for (frame of the plot), kept until the bands change
+        const SPXGraphBounds_t & GetBandBounds(int i);
+        void ResetBandBounds(void) {bandBounds.clear();};
+
         TGraphAsymmErrors *GetTotalBand() {return h_Total_results;}
 
         int GetAlphaSmemberNumDown() const{return AlphaSmemberNumDown;};
@@ -182,6 +205,14 @@ class SPXPDF {
 
         void ApplyBandCorrection(TGraphAsymmErrors *g, std::string corrlabel, bool includeinband);
 
+        // beam energy sweep: cross section at sqrt(s) factor i divided by the nominal cross section
+        unsigned int GetNumberOfBeamEnergySweepPoints() { return beamEnergySweepFactors.size(); };
+        double GetBeamEnergySweepFactor(unsigned int i) { return beamEnergySweepFactors.at(i); };
+        TH1D * GetBeamEnergySweepRatio(unsigned int i) { return h_BeamEnergySweepRatio.at(i); };
+
+        // PDF band with the alternative scale choice grids, relative to the nominal cross section (0 if not calculated)
+        TGraphAsymmErrors * GetAlternativeScaleChoicePDFRatio() { return h_AlternativeScaleChoicePDF_ratio; };
+
         bool BandsHaveDifferentProperties();
         bool BandsHaveDifferentMarker();
         bool BandsHaveDifferentFillStyle();
@@ -205,6 +236,9 @@ class SPXPDF {
         TMatrixT<double> * GetTheoryCovarianceMatrix();
         void  CalculateTheoryCovarianceMatrix();
 
+        static unsigned int GetNumberOfCachedPDFMembers(void); // LHAPDF6 members kept in memory by SetLHAPDFPDFset
+        static void TrimPDFMemberCache(unsigned int maxMembers); // drop the least recently used LHAPDF6 members
+
 
     private:
         //VARIABLES
@@ -214,6 +248,7 @@ class SPXPDF {
 
         // map of bands
 	BandMap_T Mapallbands; // Map to hold uncertainty bands PDF, alphas, scale, total
+	std::map<std::string, SPXGraphBounds_t> bandBounds; // Extents of the bands of Mapallbands (GetBandBounds)
         //bool correctedgrid;    // flag to indicated if Mapallbands are corrected
                                // by hadronisation, electroweak effects etc.
         // bands for individual uncertainties
@@ -282,6 +317,12 @@ class SPXPDF {
         std::vector<TH1D*> h_errors_AlternativeScaleChoice;
         std::vector<TH1D*> h_errors_BeamUncertainty;
 
+        std::vector<double> beamEnergySweepFactors;  // sqrt(s) factors of the beam energy sweep (grid steering sqrts_sweep)
+        std::vector<TH1D*> h_BeamEnergySweepRatio;   // cross section at each factor / nominal cross section
+
+        std::vector<TH1D*> h_errors_AlternativeScaleChoicePDF;  // all PDF members with the alternative scale choice grids
+        TGraphAsymmErrors *h_AlternativeScaleChoicePDF_ratio;   // their PDF band / nominal cross section
+
         TH1D *hpdfdefault;
         std::vector<double> alphaS_variations;  // the values of alphaS variations corresponding to the histograms stored in h_errors_AlphaS
 
@@ -302,6 +343,16 @@ class SPXPDF {
         std::string GetName(std::string basename);
         
 	void SetLHAPDFPDFset(std::string pdfname, int id); // interface to set PDF for LHAPDF5 and LHAPDF6
+	void SetLHAPDFMember(int pdferri); // set member pdferri of the PDF error loop (HERAPDF variations included)
+	void CalcPDFBandError(const std::vector<double> &values, double &average, double &err_up, double &err_down);
+
+	void CalcBeamEnergySweep();
+	TH1D *ConvoluteSubGrids(double renscale, double facscale, double escale,
+	                        bool alternativeScaleChoice=false); // sum of all (alternative scale choice) grids in one histogram
+	void CalcAlternativeScaleChoicePDFBand();
+
+	bool IsBinAlignedCorrection(TGraphAsymmErrors *gcorr); // bands and histograms have the binning of the correction
+	void ApplyAlignedBandCorrection(TGraphAsymmErrors *gcorr, std::string corrlabel, bool includeinband);
 
         void SetVariablesDefault();
         void SetUpParameters(SPXPDFSteeringFile *psf);
@@ -313,6 +364,12 @@ class SPXPDF {
         double Q2; // Q2 value used in LHAPDF
         TH1D * hpdf; //histo to store PDS PDF vs x
 
+        // PDF-vs-x bands
+        std::vector<double> pdfBandQ2;      // Q2 values
+        std::vector<double> pdfBandX;       // x values
+        std::vector<double> pdfBandValues;  // xf for [member][Q2][x][flavour]
+        std::vector<TGraphAsymmErrors*> pdfBands; // band for [Q2][flavour]
+
         std::vector<double> RenScales;
         std::vector<double> FacScales;
 
@@ -42,6 +42,8 @@ StyleNNPDF                         // NNPDF type
 
 class SPXPDFSteeringFile {
 
+	friend class SPXSteeringBundle;
+
 private:
 
 	//INI Reader
@@ -119,6 +121,10 @@ public:
 		return this->name;
 	}
 
+	void SetName(const std::string &name) {
+		this->name = name;
+	}
+
 	const std::string & GetNameVar(void) const {
 		return this->nameVar;
 	}
@@ -159,6 +165,10 @@ public:
 		return this->defaultID;
 	}
 
+	void SetDefaultID(int id) {
+		this->defaultID = id;
+	}
+
 	int GetDefaultIDVar(void) const {
 		return this->defaultIDVar;
 	}
@@ -0,0 +1,388 @@
+//************************************************************/
+//
+//	Parameter Scan Implementation
+//
+//	Implements the SPXParameterScan class
+//
+//	@Author: 	Spectrum contributors
+//	@Date:		19.10.2026
+//
+//************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+
+#include "SPXParameterScan.h"
+#include "SPXUtilities.h"
+
+//Class name for debug statements
+const std::string cn = "SPXParameterScan::";
+
+//Must define the static debug variable in the implementation
+bool SPXParameterScan::debug;
+
+//interpolation: "spline" or "poly<degree>", e.g. "poly2"
+SPXParameterScan::SPXParameterScan(const std::string &interpolation) {
+	std::string mn = "SPXParameterScan: ";
+	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+	spline = false;
+	degree = 2;
+	center = 0.;
+	scale = 1.;
+
+	if(interpolation == "spline") {
+		spline = true;
+	} else if((interpolation.size() > 4) && (interpolation.compare(0, 4, "poly") == 0) &&
+	          (interpolation.find_first_not_of("0123456789", 4) == std::string::npos)) {
+		degree = atoi(interpolation.substr(4).c_str());
+	} else {
+		throw SPXParseException(cn + mn + "Unknown parameter scan interpolation \"" + interpolation + "\": Must be spline or poly<degree>, e.g. poly2");
+	}
+}
+
+void SPXParameterScan::AddPoint(double parameter, TGraphAsymmErrors *theory, TMatrixT<double> *theoryCovariance) {
+	std::string mn = "AddPoint: ";
+
+	if(!theory) {
+		throw SPXGraphException(cn + mn + "Theory graph is invalid");
+	}
+
+	if(!theories.empty() && (theory->GetN() != theories.front()->GetN())) {
+		std::ostringstream oss;
+		oss << cn << mn << "Theory at parameter " << parameter << " has " << theory->GetN() << " bins, but the first point has " << theories.front()->GetN();
+		throw SPXGraphException(oss.str());
+	}
+
+	for(int i = 0; i < parameters.size(); i++) {
+		if(parameters.at(i) == parameter) {
+			std::ostringstream oss;
+			oss << cn << mn << "Parameter value " << parameter << " given twice";
+			throw SPXParseException(oss.str());
+		}
+	}
+
+	parameters.push_back(parameter);
+	theories.push_back(theory);
+	covariances.push_back(theoryCovariance);
+
+	if(debug) std::cout << cn << mn << "Added point " << parameter << " (" << theory->GetName() << ")" << std::endl;
+}
+
+void SPXParameterScan::Build(void) {
+	std::string mn = "Build: ";
+	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+	if(parameters.size() < 2) {
+		throw SPXGeneralException(cn + mn + "At least two parameter values are needed for an interpolation");
+	}
+
+	//Sort the points by parameter value
+	std::vector<std::pair<double, unsigned int> > order;
+	for(unsigned int i = 0; i < parameters.size(); i++) {
+		order.push_back(std::make_pair(parameters[i], i));
+	}
+	std::sort(order.begin(), order.end());
+
+	std::vector<double> p;
+	std::vector<TGraphAsymmErrors *> t;
+	std::vector<TMatrixT<double> *> c;
+	for(unsigned int i = 0; i < order.size(); i++) {
+		p.push_back(parameters[order[i].second]);
+		t.push_back(theories[order[i].second]);
+		c.push_back(covariances[order[i].second]);
+	}
+	parameters = p;
+	theories = t;
+	covariances = c;
+
+	if(spline) {
+		BuildSpline();
+	} else {
+		if(degree > parameters.size() - 1) {
+			std::cout << cn << mn << "WARNING: Polynomial of degree " << degree << " needs more than " << parameters.size()
+			          << " points: Using degree " << parameters.size() - 1 << std::endl;
+			degree = parameters.size() - 1;
+		}
+
+		BuildPolynomial();
+	}
+}
+
+//Least squares fit of y_k = sum_j a_j t_k^j: a = (A^T A)^-1 A^T y, A_kj = t_k^j
+void SPXParameterScan::BuildPolynomial(void) {
+	std::string mn = "BuildPolynomial: ";
+
+	unsigned int n = parameters.size();
+	unsigned int m = degree + 1;
+
+	//Scale the parameter to [-1, 1] for a well conditioned A^T A
+	center = 0.5 * (parameters.front() + parameters.back());
+	scale = 0.5 * (parameters.back() - parameters.front());
+
+	TMatrixT<double> ata(m, m);
+	for(unsigned int i = 0; i < m; i++) {
+		for(unsigned int j = 0; j < m; j++) {
+			double sum = 0.;
+			for(unsigned int k = 0; k < n; k++) {
+				double tk = (parameters[k] - center) / scale;
+				sum += pow(tk, double(i + j));
+			}
+			ata(i, j) = sum;
+		}
+	}
+
+	double det = 0.;
+	ata.Invert(&det);
+	if(det == 0.) {
+		throw SPXGeneralException(cn + mn + "Singular least squares matrix: Check the parameter values of the grids");
+	}
+
+	projection.ResizeTo(m, n);
+	for(unsigned int i = 0; i < m; i++) {
+		for(unsigned int k = 0; k < n; k++) {
+			double tk = (parameters[k] - center) / scale;
+			double sum = 0.;
+			for(unsigned int j = 0; j < m; j++) {
+				sum += ata(i, j) * pow(tk, double(j));
+			}
+			projection(i, k) = sum;
+		}
+	}
+
+	if(debug) std::cout << cn << mn << "Polynomial of degree " << degree << " through " << n << " points" << std::endl;
+}
+
+//Natural cubic spline through each unit vector e_k (tridiagonal system for the second derivatives)
+void SPXParameterScan::BuildSpline(void) {
+	std::string mn = "BuildSpline: ";
+
+	unsigned int n = parameters.size();
+
+	secondDerivatives.assign(n, std::vector<double>(n, 0.));
+
+	for(unsigned int k = 0; k < n; k++) {
+		std::vector<double> &m = secondDerivatives[k];
+		std::vector<double> u(n, 0.);
+
+		for(unsigned int i = 1; i + 1 < n; i++) {
+			double yl = (i - 1 == k) ? 1. : 0.;
+			double y0 = (i == k) ? 1. : 0.;
+			double yh = (i + 1 == k) ? 1. : 0.;
+
+			double sig = (parameters[i] - parameters[i - 1]) / (parameters[i + 1] - parameters[i - 1]);
+			double piv = sig * m[i - 1] + 2.;
+			m[i] = (sig - 1.) / piv;
+			u[i] = (yh - y0) / (parameters[i + 1] - parameters[i]) - (y0 - yl) / (parameters[i] - parameters[i - 1]);
+			u[i] = (6. * u[i] / (parameters[i + 1] - parameters[i - 1]) - sig * u[i - 1]) / piv;
+		}
+
+		m[n - 1] = 0.;
+		for(int i = n - 2; i >= 0; i--) {
+			m[i] = m[i] * m[i + 1] + u[i];
+		}
+	}
+
+	if(debug) std::cout << cn << mn << "Natural cubic spline through " << n << " points" << std::endl;
+}
+
+//Prediction at parameter = sum_k weights[k] * (value of point k)
+void SPXParameterScan::GetWeights(double parameter, std::vector<double> &weights) const {
+	unsigned int n = parameters.size();
+	weights.assign(n, 0.);
+
+	if(!spline) {
+		double t = (parameter - center) / scale;
+		for(unsigned int k = 0; k < n; k++) {
+			double tj = 1.;
+			for(unsigned int j = 0; j <= degree; j++) {
+				weights[k] += projection(j, k) * tj;
+				tj *= t;
+			}
+		}
+		return;
+	}
+
+	//Segment of the parameter (first/last segment outside the range)
+	unsigned int i = 0;
+	while((i + 2 < n) && (parameter > parameters[i + 1])) {
+		i++;
+	}
+
+	double h = parameters[i + 1] - parameters[i];
+	double a = (parameters[i + 1] - parameter) / h;
+	double b = (parameter - parameters[i]) / h;
+
+	for(unsigned int k = 0; k < n; k++) {
+		const std::vector<double> &m = secondDerivatives[k];
+		double yi = (i == k) ? 1. : 0.;
+		double yh = (i + 1 == k) ? 1. : 0.;
+		weights[k] = a * yi + b * yh + ((a * a * a - a) * m[i] + (b * b * b - b) * m[i + 1]) * h * h / 6.;
+	}
+}
+
+//Interpolated theory (central value and band edges) at the parameter value: caller owns the graph
+TGraphAsymmErrors * SPXParameterScan::GetPrediction(double parameter) const {
+	std::vector<double> w;
+	GetWeights(parameter, w);
+
+	TGraphAsymmErrors *first = theories.front();
+	int nbin = first->GetN();
+
+	TGraphAsymmErrors *prediction = new TGraphAsymmErrors(nbin);
+	prediction->SetName(TString(first->GetName()) + Form("_interpolated_%g", parameter));
+
+	for(int ibin = 0; ibin < nbin; ibin++) {
+		double y = 0., eyl = 0., eyh = 0.;
+
+		for(unsigned int k = 0; k < w.size(); k++) {
+			y   += w[k] * theories[k]->GetY()[ibin];
+			eyl += w[k] * theories[k]->GetErrorYlow(ibin);
+			eyh += w[k] * theories[k]->GetErrorYhigh(ibin);
+		}
+
+		prediction->SetPoint(ibin, first->GetX()[ibin], y);
+		prediction->SetPointError(ibin, first->GetErrorXlow(ibin), first->GetErrorXhigh(ibin), fabs(eyl), fabs(eyh));
+	}
+
+	return prediction;
+}
+
+//chi2 = (d - t(p))^T (C_data + C_theory(p))^-1 (d - t(p)), as in SPXChi2::CalculateSimpleChi2
+double SPXParameterScan::GetChi2(double parameter, SPXData *data) const {
+	std::string mn = "GetChi2: ";
+
+	if(!data) {
+		throw SPXGeneralException(cn + mn + "Data object not found !");
+	}
+
+	TGraphAsymmErrors *gdata = data->GetTotalErrorGraph();
+	TMatrixT<double> *dataCovariance = data->GetDataTotalCovarianceMatrix();
+	if(!gdata || !dataCovariance) {
+		throw SPXGeneralException(cn + mn + "Data graph or covariance matrix not found !");
+	}
+
+	int nbin = theories.front()->GetN();
+	if(gdata->GetN() != nbin) {
+		std::ostringstream oss;
+		oss << cn << mn << "Number of bins in data= " << gdata->GetN() << " not equal number of bins in theory= " << nbin;
+		throw SPXGeneralException(oss.str());
+	}
+
+	std::vector<double> w;
+	GetWeights(parameter, w);
+
+	TMatrixT<double> covariance(nbin, nbin);
+	std::vector<double> residual(nbin, 0.);
+
+	for(int i = 0; i < nbin; i++) {
+		double theory = 0.;
+		for(unsigned int k = 0; k < w.size(); k++) {
+			theory += w[k] * theories[k]->GetY()[i];
+		}
+		residual[i] = gdata->GetY()[i] - theory;
+
+		for(int j = 0; j < nbin; j++) {
+			double c = (*dataCovariance)(i, j);
+			for(unsigned int k = 0; k < w.size(); k++) {
+				if(covariances[k]) c += w[k] * (*covariances[k])(i, j);
+			}
+			covariance(i, j) = c;
+		}
+	}
+
+	double det = 0.;
+	covariance.Invert(&det);
+	if(det == 0.) {
+		std::ostringstream oss;
+		oss << cn << mn << "Singular covariance matrix at parameter " << parameter;
+		throw SPXGeneralException(oss.str());
+	}
+
+	double chi2 = 0.;
+	for(int i = 0; i < nbin; i++) {
+		for(int j = 0; j < nbin; j++) {
+			chi2 += residual[i] * covariance(i, j) * residual[j];
+		}
+	}
+
+	return chi2;
+}
+
+//chi2 versus the parameter at numberOfPoints equidistant values: caller owns the graph
+TGraph * SPXParameterScan::Scan(SPXData *data, double parameterMin, double parameterMax, unsigned int numberOfPoints) const {
+	std::string mn = "Scan: ";
+	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+	if(numberOfPoints < 2 || parameterMax <= parameterMin) {
+		std::ostringstream oss;
+		oss << cn << mn << "Invalid scan range [" << parameterMin << ", " << parameterMax << "] with " << numberOfPoints << " points";
+		throw SPXParseException(oss.str());
+	}
+
+	if(parameterMin < parameters.front() || parameterMax > parameters.back()) {
+		std::cout << cn << mn << "WARNING: Scan range [" << parameterMin << ", " << parameterMax << "] extrapolates beyond the grids ["
+		          << parameters.front() << ", " << parameters.back() << "]" << std::endl;
+	}
+
+	TGraph *chi2 = new TGraph(numberOfPoints);
+
+	for(unsigned int i = 0; i < numberOfPoints; i++) {
+		double p = parameterMin + (parameterMax - parameterMin) * i / (numberOfPoints - 1);
+		chi2->SetPoint(i, p, GetChi2(p, data));
+	}
+
+	return chi2;
+}
+
+//Minimum of a chi2 scan (parabola through the lowest point and its neighbours) and the delta chi2 = 1 interval
+void SPXParameterScan::GetMinimum(TGraph *chi2, double &parameter, double &chi2min, double &errorDown, double &errorUp) {
+	std::string mn = "GetMinimum: ";
+
+	int n = chi2->GetN();
+	if(n < 3) {
+		throw SPXGraphException(cn + mn + "Need at least three scan points");
+	}
+
+	const double *x = chi2->GetX();
+	const double *y = chi2->GetY();
+
+	int imin = 0;
+	for(int i = 1; i < n; i++) {
+		if(y[i] < y[imin]) imin = i;
+	}
+
+	parameter = x[imin];
+	chi2min = y[imin];
+
+	if(imin > 0 && imin < n - 1) {
+		double d = y[imin - 1] - 2. * y[imin] + y[imin + 1];
+		if(d > 0.) {
+			double h = x[imin + 1] - x[imin];
+			double shift = 0.5 * h * (y[imin - 1] - y[imin + 1]) / d;
+			parameter = x[imin] + shift;
+			chi2min = y[imin] - 0.25 * (y[imin - 1] - y[imin + 1]) * shift / h;
+		}
+	}
+
+	//First crossings of chi2min + 1 on either side (0 if the scan does not reach it)
+	errorDown = 0.;
+	for(int i = imin; i > 0; i--) {
+		if(y[i - 1] >= chi2min + 1.) {
+			double xc = x[i - 1] + (chi2min + 1. - y[i - 1]) * (x[i] - x[i - 1]) / (y[i] - y[i - 1]);
+			errorDown = parameter - xc;
+			break;
+		}
+	}
+
+	errorUp = 0.;
+	for(int i = imin; i < n - 1; i++) {
+		if(y[i + 1] >= chi2min + 1.) {
+			double xc = x[i] + (chi2min + 1. - y[i]) * (x[i + 1] - x[i]) / (y[i + 1] - y[i]);
+			errorUp = xc - parameter;
+			break;
+		}
+	}
+}
@@ -0,0 +1,87 @@
+//************************************************************/
+//
+//	Parameter Scan Header
+//
+//	Outlines the SPXParameterScan class, which interpolates
+//	the theory prediction between grids produced at different
+//	values of a parameter (e.g. the top mass): each provided
+//	point is convoluted once, and the prediction, the theory
+//	covariance and the chi2 against the data are then given at
+//	any parameter value without further convolution.
+//
+//	Both interpolations (least squares polynomial, natural
+//	cubic spline) are linear in the point values, so the
+//	prediction at p is sum_k w_k(p) y_k with weights that only
+//	depend on p and the parameter values of the points
+//
+//	@Author: 	Spectrum contributors
+//	@Date:		19.10.2026
+//
+//************************************************************/
+
+#ifndef SPXPARAMETERSCAN_H
+#define SPXPARAMETERSCAN_H
+
+#include <string>
+#include <vector>
+
+#include "SPXROOT.h"
+#include "SPXData.h"
+#include "SPXException.h"
+
+class SPXParameterScan {
+
+public:
+	explicit SPXParameterScan(const std::string &interpolation);
+
+	void AddPoint(double parameter, TGraphAsymmErrors *theory, TMatrixT<double> *theoryCovariance);
+	void Build(void);
+
+	unsigned int GetNumberOfPoints(void) const {
+		return parameters.size();
+	}
+
+	double GetParameterMin(void) const {
+		return parameters.front();
+	}
+
+	double GetParameterMax(void) const {
+		return parameters.back();
+	}
+
+	void GetWeights(double parameter, std::vector<double> &weights) const;
+
+	TGraphAsymmErrors * GetPrediction(double parameter) const;
+	double GetChi2(double parameter, SPXData *data) const;
+
+	TGraph * Scan(SPXData *data, double parameterMin, double parameterMax, unsigned int numberOfPoints) const;
+	static void GetMinimum(TGraph *chi2, double &parameter, double &chi2min, double &errorDown, double &errorUp);
+
+	static bool GetDebug(void) {
+		return debug;
+	}
+
+	static void SetDebug(bool b) {
+		debug = b;
+	}
+
+private:
+	static bool debug;					// Flag indicating debug mode
+
+	bool spline;						// Natural cubic spline (true) or least squares polynomial
+	unsigned int degree;					// Polynomial degree
+
+	std::vector<double> parameters;				// Parameter values of the points (sorted by Build)
+	std::vector<TGraphAsymmErrors *> theories;		// Theory prediction of each point
+	std::vector<TMatrixT<double> *> covariances;		// Theory covariance of each point (may be 0)
+
+	double center;						// Polynomial variable t = (p - center) / scale
+	double scale;
+	TMatrixT<double> projection;				// Polynomial: coefficients = projection * values
+	std::vector<std::vector<double> > secondDerivatives;	// Spline: second derivatives of each unit spline
+
+	void BuildPolynomial(void);
+	void BuildSpline(void);
+};
+
+#endif
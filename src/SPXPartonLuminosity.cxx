@@ -0,0 +1,264 @@
+//************************************************************/
+//
+//	Parton Luminosity Implementation
+//
+//	Implements the SPXPartonLuminosity class
+//
+//	@Author: 	Spectrum contributors
+//	@Date:		19.10.2026
+//
+//************************************************************/
+
+#include <cmath>
+#include <sstream>
+
+#include "SPXPartonLuminosity.h"
+#include "SPXUtilities.h"
+#include "SPXWorkQueue.h"
+
+//Class name for debug statements
+const std::string cn = "SPXPartonLuminosity::";
+
+//Must define the static debug variable in the implementation
+bool SPXPartonLuminosity::debug;
+
+//PDF tabulation: x points between the smallest x needed and 1 (log spaced)
+const unsigned int LUMI_NUMBER_OF_X = 150;
+
+//Adaptive Simpson: relative tolerance and maximum recursion depth
+const double LUMI_TOLERANCE = 1.e-6;
+const int LUMI_MAX_DEPTH = 30;
+
+const unsigned int MAX_LUMI_THREADS = 8;
+
+SPXPartonLuminosity::SPXPartonLuminosity(SPXPDFSteeringFile *psf, double sqrtS) {
+	std::string mn = "SPXPartonLuminosity: ";
+	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+	if(sqrtS <= 0) {
+		std::ostringstream oss;
+		oss << cn << mn << "Invalid sqrt(s) = " << sqrtS << ": Set sqrt_s in the data steering file or luminosity_sqrt_s in the plot";
+		throw SPXParseException(oss.str());
+	}
+
+	this->sqrtS = sqrtS;
+	this->pdf = new SPXPDF(psf);
+
+	numberOfMembers = 0;
+	numberOfX = 0;
+	lnxmin = 0;
+	dlnx = 0;
+}
+
+SPXPartonLuminosity::~SPXPartonLuminosity() {
+	for(std::map<std::string, TGraphAsymmErrors *>::iterator it = bands.begin(); it != bands.end(); ++it) {
+		delete it->second;
+	}
+
+	delete pdf;
+}
+
+//Tabulated xf(x, M_X^2) of one member, quadratic interpolation in ln x
+double SPXPartonLuminosity::GetXF(unsigned int member, unsigned int imass, int ifl, double x) const {
+	if(x >= 1.) {
+		return 0.;
+	}
+
+	const std::vector<double> &table = pdf->GetPdfBandValues();
+	const double *t = &table[((member * masses.size() + imass) * numberOfX) * 13 + 6 + ifl];
+
+	double u = (log(x) - lnxmin) / dlnx;
+	int i = (int)floor(u + 0.5) - 1;
+	if(i < 0) i = 0;
+	if(i > (int)numberOfX - 3) i = numberOfX - 3;
+
+	double d = u - i;
+	double f0 = t[i * 13];
+	double f1 = t[(i + 1) * 13];
+	double f2 = t[(i + 2) * 13];
+
+	return 0.5 * (d - 1.) * (d - 2.) * f0 - d * (d - 2.) * f1 + 0.5 * d * (d - 1.) * f2;
+}
+
+double SPXPartonLuminosity::GetIntegrand(unsigned int ichannel, unsigned int member, unsigned int imass, double y) const {
+	double sqrtTau = masses[imass] / sqrtS;
+	double x1 = sqrtTau * exp(y);
+	double x2 = sqrtTau * exp(-y);
+
+	const std::string &channel = channels[ichannel];
+
+	if(channel == "gg") {
+		return GetXF(member, imass, 0, x1) * GetXF(member, imass, 0, x2);
+	}
+
+	double sum = 0.;
+
+	for(int q = 1; q <= 5; q++) {
+		if(channel == "qqbar") {
+			sum += GetXF(member, imass, q, x1) * GetXF(member, imass, -q, x2);
+			sum += GetXF(member, imass, -q, x1) * GetXF(member, imass, q, x2);
+		} else {
+			sum += (GetXF(member, imass, q, x1) + GetXF(member, imass, -q, x1)) * GetXF(member, imass, 0, x2);
+			sum += GetXF(member, imass, 0, x1) * (GetXF(member, imass, q, x2) + GetXF(member, imass, -q, x2));
+		}
+	}
+
+	return sum;
+}
+
+double SPXPartonLuminosity::Simpson(unsigned int ichannel, unsigned int member, unsigned int imass, double a, double b,
+                                    double fa, double fm, double fb, double whole, double eps, int depth) const {
+	double m = 0.5 * (a + b);
+	double lm = 0.5 * (a + m);
+	double rm = 0.5 * (m + b);
+
+	double flm = GetIntegrand(ichannel, member, imass, lm);
+	double frm = GetIntegrand(ichannel, member, imass, rm);
+
+	double left = (m - a) / 6. * (fa + 4. * flm + fm);
+	double right = (b - m) / 6. * (fm + 4. * frm + fb);
+
+	if(depth <= 0 || fabs(left + right - whole) <= 15. * eps) {
+		return left + right + (left + right - whole) / 15.;
+	}
+
+	return Simpson(ichannel, member, imass, a, m, fa, flm, fm, left, 0.5 * eps, depth - 1) +
+	       Simpson(ichannel, member, imass, m, b, fm, frm, fb, right, 0.5 * eps, depth - 1);
+}
+
+//L = 1/s Int dy f f = 1/M^2 Int dy xf(x1) xf(x2), |y| < ln(sqrt(s)/M)
+double SPXPartonLuminosity::Integrate(unsigned int ichannel, unsigned int member, unsigned int imass) const {
+	double ymax = log(sqrtS / masses[imass]);
+
+	double fa = GetIntegrand(ichannel, member, imass, -ymax);
+	double fm = GetIntegrand(ichannel, member, imass, 0.);
+	double fb = GetIntegrand(ichannel, member, imass, ymax);
+
+	double whole = 2. * ymax / 6. * (fa + 4. * fm + fb);
+	double eps = LUMI_TOLERANCE * fabs(whole);
+	if(eps <= 0.) eps = LUMI_TOLERANCE;
+
+	double integral = Simpson(ichannel, member, imass, -ymax, ymax, fa, fm, fb, whole, eps, LUMI_MAX_DEPTH);
+
+	return integral / (masses[imass] * masses[imass]);
+}
+
+void SPXPartonLuminosity::CalculateMember(unsigned int job) {
+	unsigned int member = job / masses.size();
+	unsigned int imass = job % masses.size();
+
+	for(unsigned int ichannel = 0; ichannel < channels.size(); ichannel++) {
+		luminosities[(ichannel * numberOfMembers + member) * masses.size() + imass] = Integrate(ichannel, member, imass);
+	}
+}
+
+//Integration job (SPXWorkQueue): one (member, mass) pair
+void SPXPartonLuminosity::CalculateJob(void *context, unsigned int job, unsigned int thread) {
+	((SPXPartonLuminosity *)context)->CalculateMember(job);
+}
+
+void SPXPartonLuminosity::Calculate(const std::vector<std::string> &channels, double massMin, double massMax, unsigned int numberOfMassPoints) {
+	std::string mn = "Calculate: ";
+	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+	for(int i = 0; i < channels.size(); i++) {
+		if(!IsValidChannel(channels.at(i))) {
+			throw SPXParseException(cn + mn + "Unknown parton luminosity \"" + channels.at(i) + "\": Must be gg, qqbar or qg");
+		}
+	}
+
+	if(massMin <= 0 || massMax <= massMin || massMax >= sqrtS || numberOfMassPoints < 2) {
+		std::ostringstream oss;
+		oss << cn << mn << "Invalid mass range [" << massMin << ", " << massMax << "] with " << numberOfMassPoints << " points for sqrt(s) = " << sqrtS;
+		throw SPXParseException(oss.str());
+	}
+
+	this->channels = channels;
+
+	masses.resize(numberOfMassPoints);
+	std::vector<double> q2values(numberOfMassPoints);
+
+	for(unsigned int i = 0; i < numberOfMassPoints; i++) {
+		masses[i] = massMin * pow(massMax / massMin, double(i) / double(numberOfMassPoints - 1));
+		q2values[i] = masses[i] * masses[i];
+	}
+
+	//Tabulate all members at all M_X^2 once (parallel sweep in SPXPDF): x >= tau = M^2/s
+	double xmin = 0.5 * (massMin / sqrtS) * (massMin / sqrtS);
+
+	numberOfX = LUMI_NUMBER_OF_X;
+	lnxmin = log(xmin);
+	dlnx = -lnxmin / (numberOfX - 1);
+
+	pdf->FillPdfBands(q2values, numberOfX, xmin, 1.);
+	numberOfMembers = pdf->GetNumberOfPdfBandMembers();
+
+	luminosities.assign(channels.size() * numberOfMembers * masses.size(), 0.);
+
+	//Integrate every (member, mass) pair, in parallel: the tabulation is only read
+	unsigned int numberOfJobs = numberOfMembers * masses.size();
+	SPXWorkQueue::Run(CalculateJob, this, numberOfJobs, SPXWorkQueue::GetNumberOfThreads(numberOfJobs, MAX_LUMI_THREADS), "integration");
+
+	FillBands();
+
+	std::cout << cn << mn << pdf->GetPDFtype() << ": " << channels.size() << " luminosities at " << masses.size()
+	          << " masses from " << numberOfMembers << " members" << std::endl;
+}
+
+void SPXPartonLuminosity::FillBands(void) {
+	std::string mn = "FillBands: ";
+	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+	unsigned int n = masses.size();
+
+	//Mass bin edges half way (in log M) between neighbouring points
+	std::vector<double> exl(n, 0.), exh(n, 0.);
+	for(unsigned int i = 0; i < n; i++) {
+		if(i > 0)     exl[i] = masses[i] - sqrt(masses[i] * masses[i - 1]);
+		if(i < n - 1) exh[i] = sqrt(masses[i] * masses[i + 1]) - masses[i];
+	}
+	exl[0] = exh[0];
+	exh[n - 1] = exl[n - 1];
+
+	std::vector<double> values(numberOfMembers);
+
+	//Bands of a previous Calculate
+	for(std::map<std::string, TGraphAsymmErrors *>::iterator it = bands.begin(); it != bands.end(); ++it) {
+		delete it->second;
+	}
+	bands.clear();
+
+	for(unsigned int ichannel = 0; ichannel < channels.size(); ichannel++) {
+		//"_pdf_" gives the band the PDF band style in SPXPlot::DrawBands
+		std::string name = "lumi_" + channels[ichannel] + "_pdf_" + pdf->GetPDFtype();
+
+		TGraphAsymmErrors *band = new TGraphAsymmErrors(n);
+		band->SetName(name.c_str());
+
+		for(unsigned int imass = 0; imass < n; imass++) {
+			for(unsigned int member = 0; member < numberOfMembers; member++) {
+				values[member] = luminosities[(ichannel * numberOfMembers + member) * n + imass];
+			}
+
+			double central = 0, up = 0, down = 0;
+			pdf->GetPDFBand(values, central, up, down);
+
+			band->SetPoint(imass, masses[imass], central);
+			band->SetPointError(imass, exl[imass], exh[imass], down, up);
+
+			if(debug) std::cout << cn << mn << name << " M= " << masses[imass] << " L= " << central << " +" << up << " -" << down << std::endl;
+		}
+
+		bands[channels[ichannel]] = band;
+	}
+}
+
+TGraphAsymmErrors * SPXPartonLuminosity::GetBand(const std::string &channel) {
+	std::string mn = "GetBand: ";
+
+	if(bands.count(channel) == 0) {
+		throw SPXGraphException(cn + mn + "No luminosity band for channel \"" + channel + "\": Call Calculate first");
+	}
+
+	return bands[channel];
+}
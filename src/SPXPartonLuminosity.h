@@ -0,0 +1,97 @@
+//************************************************************/
+//
+//	Parton Luminosity Header
+//
+//	Outlines the SPXPartonLuminosity class, which calculates
+//	the parton luminosities (gg, qqbar, qg) of one PDF set
+//	versus the mass M_X of the produced system at fixed sqrt(s),
+//	with the PDF uncertainty band of the set:
+//
+//		L_ij(M_X) = 1/s Int dy f_i(x1, M_X^2) f_j(x2, M_X^2)
+//		x1,2 = M_X/sqrt(s) exp(+-y)
+//
+//	qqbar sums q qbar + qbar q over the five light flavours,
+//	qg sums (q + qbar) g + g (q + qbar)
+//
+//	@Author: 	Spectrum contributors
+//	@Date:		19.10.2026
+//
+//************************************************************/
+
+#ifndef SPXPARTONLUMINOSITY_H
+#define SPXPARTONLUMINOSITY_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "SPXROOT.h"
+#include "SPXPDF.h"
+#include "SPXPDFSteeringFile.h"
+#include "SPXException.h"
+
+class SPXPartonLuminosity {
+
+public:
+	SPXPartonLuminosity(SPXPDFSteeringFile *psf, double sqrtS);
+	~SPXPartonLuminosity();
+
+	void Calculate(const std::vector<std::string> &channels, double massMin, double massMax, unsigned int numberOfMassPoints);
+
+	TGraphAsymmErrors * GetBand(const std::string &channel);
+
+	std::string GetPDFName(void) const {
+		return pdf->GetPDFtype();
+	}
+
+	double GetSqrtS(void) const {
+		return sqrtS;
+	}
+
+	static bool IsValidChannel(const std::string &channel) {
+		return (channel == "gg") || (channel == "qqbar") || (channel == "qg");
+	}
+
+	static bool GetDebug(void) {
+		return debug;
+	}
+
+	static void SetDebug(bool b) {
+		debug = b;
+	}
+
+private:
+	static bool debug;					// Flag indicating debug mode
+
+	SPXPDF *pdf;						// PDF set (steering only) holding the member tabulation
+	double sqrtS;						// Centre of mass energy [GeV]
+
+	std::vector<std::string> channels;			// Requested channels
+	std::vector<double> masses;				// M_X values [GeV]
+
+	unsigned int numberOfMembers;				// Members in the tabulation
+	unsigned int numberOfX;					// x points per (member, mass) in the tabulation
+	double lnxmin;						// ln x of the first tabulation point
+	double dlnx;						// Tabulation step in ln x
+
+	std::vector<double> luminosities;			// L for [channel][member][mass]
+
+	std::map<std::string, TGraphAsymmErrors *> bands;	// Central value and PDF band per channel
+
+	double GetXF(unsigned int member, unsigned int imass, int ifl, double x) const;
+	double GetIntegrand(unsigned int ichannel, unsigned int member, unsigned int imass, double y) const;
+	double Integrate(unsigned int ichannel, unsigned int member, unsigned int imass) const;
+	double Simpson(unsigned int ichannel, unsigned int member, unsigned int imass, double a, double b,
+	               double fa, double fm, double fb, double whole, double eps, int depth) const;
+
+	void CalculateMember(unsigned int job);
+	static void CalculateJob(void *context, unsigned int job, unsigned int thread);
+
+	void FillBands(void);
+
+	//Owns the PDF and graphs: not copyable
+	SPXPartonLuminosity(const SPXPartonLuminosity &);
+	SPXPartonLuminosity & operator=(const SPXPartonLuminosity &);
+};
+
+#endif
@@ -18,6 +18,7 @@
 
 #include "SPXPlot.h"
 #include "SPXSummaryFigures.h" 
+#include "SPXStageTimer.h"
 
 //#ifdef DEVELOP
 //#include "SPXSummaryFigures.h" 
@@ -53,6 +54,8 @@ void SPXPlot::Initialize(void) {
 
 	if(debug) std::cout << cn << mn << "Initializing Plot with ID id= " << id << std::endl;
 
+	SPXArenaScope scope(arena, "initialize");
+
 	try {
 
 #ifdef TIMER     
@@ -96,6 +99,14 @@ void SPXPlot::Plot(void) {
 
 	if(debug) std::cout << cn << mn << "Plotting Plot with ID " << id << std::endl;
 
+	//A plot drawn again (--watch) first drops the canvas, frames and legends of its previous drawing
+	ReleaseDrawing();
+	outputFiles.clear();
+	drawArena = new SPXArena(arena->GetName() + "_draw");
+
+	SPXArenaScope scope(drawArena, "draw");
+	SPXStageScope stage("draw");
+
 	//Perform plotting
 	CreateCanvas();
 	DivideCanvasIntoPads();
@@ -111,6 +122,7 @@ void SPXPlot::Plot(void) {
         DrawBox(); 
 
 	DrawLegend();
+	DrawBeamEnergySweep();
 
 #ifdef DEVELOP
         if (steeringFile->GetCalculateChi2()>0){       
@@ -199,6 +211,174 @@ void SPXPlot::Plot(void) {
 
 	//Create a PNG of the canvas
 	CanvasToPNG();
+
+	PlotPdfBands(true);
+	PlotPartonLuminosity(true);
+
+	ScanParameter();
+
+	if (!Options::DumpDirectory.empty()) {
+	 this->WriteDump();
+	}
+}
+
+//Batch (--no-draw) counterpart of Plot: all numerical results, but no canvas, pads, frames or legends
+void SPXPlot::Process(void) {
+	std::string mn = "Process: ";
+	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+	if(debug) std::cout << cn << mn << "Processing Plot with ID " << id << std::endl;
+
+	ReleaseDrawing();
+	outputFiles.clear();
+	drawArena = new SPXArena(arena->GetName() + "_draw");
+
+	SPXArenaScope scope(drawArena, "process");
+
+	PrintChi2();
+
+	if (steeringFile->PrintTotalCrossSection()!=0) {
+	 std::cout<<cn<<mn<<"Print total cross sections "<<std::endl;
+	 for (int i=0; i<data.size(); i++)
+	  data.at(i)->PrintTotalCrossSection();
+
+	 for (int i=0; i< crossSections.size(); i++)
+	  crossSections.at(i).PrintTotalCrossSection();
+	}
+
+	//There is no graphic output in batch mode, so the ROOT file is always written
+	SPXPlotConfiguration &pc = steeringFile->GetPlotConfiguration(id);
+	std::string rootfilename = GetROOTFilename(pc.GetDescription());
+
+	std::cout<<cn<<mn<<"Write results to "<<rootfilename<<std::endl;
+	this->WriteRootFile(TString(rootfilename));
+	outputFiles.push_back(rootfilename);
+
+	if (!steeringFile->GetOutputTableFormat().empty()) {
+	 this->WriteResultsTable();
+	}
+
+	PlotPdfBands(false);
+	PlotPartonLuminosity(false);
+
+	ScanParameter();
+
+	if (!Options::DumpDirectory.empty()) {
+	 this->WriteDump();
+	}
+}
+
+//Deletes all objects created for this plot (data, convolutions, ratios, canvas, ROOT file):
+// the plot can not be drawn again, only its output file names remain
+void SPXPlot::Release(void) {
+	std::string mn = "Release: ";
+	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+	if(!arena) {
+		return;
+	}
+
+	SPXArenaScope scope(0, "release");
+
+	ratios.clear();
+	crossSections.clear();
+	data.clear();
+
+	dataFileGraphMap.clear();
+	referenceFileGraphMap.clear();
+	nominalFileGraphMap.clear();
+	convoluteFileGraphMap.clear();
+	convoluteFilePDFMap.clear();
+	dataFileLabelMap.clear();
+	dataFileSystematicsMap.clear();
+
+	//The canvas refers to the ratios, and both to the data and convolutions
+	ReleaseDrawing();
+
+	delete ratioArena;
+	ratioArena = 0;
+
+	delete arena;
+	arena = 0;
+}
+
+//Deletes the objects of the last Plot/Process: only its output files remain
+void SPXPlot::ReleaseDrawing(void) {
+	delete drawArena;
+	drawArena = 0;
+
+	canvas = 0;
+	overlayPad = 0;
+	ratioPad = 0;
+	leg = 0;
+	leginfo = 0;
+	rootfile = 0;
+}
+
+//The cross sections point into the configuration instances of the steering file: after it was
+// re-read with the same number of instances, cross section i is re-pointed at instance i
+void SPXPlot::Reconfigure(void) {
+	std::string mn = "Reconfigure: ";
+	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+	for(int i = 0; i < crossSections.size(); i++) {
+		crossSections[i].SetPlotConfigurationInstance(&steeringFile->GetPlotConfigurationInstance(id, i));
+	}
+}
+
+//Ratios are built from the graph maps filled by InitializeData and InitializeCrossSections:
+// they can be built again from a changed ratio definition without touching data or convolutions
+void SPXPlot::RebuildRatios(void) {
+	std::string mn = "RebuildRatios: ";
+	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+	ReleaseDrawing();
+
+	ratios.clear();
+	delete ratioArena;
+	ratioArena = new SPXArena(arena->GetName() + "_ratios");
+
+	SPXArenaScope scope(ratioArena, "ratios");
+
+	InitializeRatios();
+}
+
+//Prints the chi2 of each cross section against its data (same pairing as the legend)
+void SPXPlot::PrintChi2(void) {
+	std::string mn = "PrintChi2: ";
+	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+	for (int icross=0; icross<crossSections.size(); icross++) {
+	 int idata;
+	 double chi2;
+	 if (!GetChi2(icross, idata, chi2)) continue;
+
+	 int ndf=data.at(idata)->GetTotalErrorGraph()->GetN();
+
+	 std::cout<<cn<<mn<<"id= "<<id<<" "<<crossSections.at(icross).GetPDF()->GetPDFtype()<<" vs "<<data.at(idata)->GetTotalErrorGraph()->GetName()
+	          <<" chi2/ndf= "<<chi2<<"/"<<ndf<<std::endl;
+	}
+}
+
+//Chi2 of cross section icross to its data set idata; false if there is no data set or PDF for it
+bool SPXPlot::GetChi2(int icross, int &idata, double &chi2) {
+	std::string mn = "GetChi2: ";
+
+	//A parameter scan has only one data set
+	idata=(steeringFile->GetParameterScan() ? 0 : icross);
+	if (idata>=data.size()) {
+	 if (debug) std::cout<<cn<<mn<<"No data for cross section icross= "<<icross<<std::endl;
+	 return false;
+	}
+
+	SPXPDF *pdf=crossSections.at(icross).GetPDF();
+	if (!pdf) {
+	 std::cout<<cn<<mn<<"WARNING: PDF object not found for icross= "<<icross<<std::endl;
+	 return false;
+	}
+
+	chi2=SPXChi2::CalculateSimpleChi2(pdf, data.at(idata));
+	return true;
 }
 
 void SPXPlot::SetAxisLabels(void) {
@@ -383,7 +563,7 @@ void SPXPlot::CreateCanvas(void) {
 	int ww = 1000;		//Window width
 	int wh = 1000;		//Window height
 
-	canvas = new TCanvas(canvasID.c_str(), pc.GetDescription().c_str(), wtopx, wtopy, ww, wh);
+	canvas = drawArena->Adopt(new TCanvas(canvasID.c_str(), pc.GetDescription().c_str(), wtopx, wtopy, ww, wh));
 	canvas->SetFillColor(0);
 	canvas->SetGrid();
 	canvas->SetLeftMargin(0.2);
@@ -397,7 +577,7 @@ void SPXPlot::CreateCanvas(void) {
 	}
 }
 
-//Determine frame bounds by calculating the xmin, xmax, ymin, ymax from ALL graphs being drawn
+//Determine frame bounds from the extents of ALL graphs being drawn, kept by the data, PDF and ratio objects
 void SPXPlot::DetermineOverlayFrameBounds(double &xMin, double &xMax, double &yMin, double &yMax) {
 	std::string mn = "DetermineOverlayFrameBounds: ";
 	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
@@ -409,20 +589,15 @@ void SPXPlot::DetermineOverlayFrameBounds(double &xMin, double &xMax, double &yM
 	//Do nothing if overlay is not plotted
 	if(!ds.ContainsOverlay()) {
 		xMin = xMax = yMin = yMax = 0;
+		overlayBounds = SPXGraphUtilities::GetEmptyBounds();
 		return;
 	}
 
-	std::vector<TGraphAsymmErrors *> graphs;
+	SPXGraphBounds_t bounds = SPXGraphUtilities::GetEmptyBounds();
 	{
-		//Data graphs
-		//NOTE: Total should be the largest, but there could be a scenario in which
-		//		one of the other errors is negative, and thus only the stat/syst could be
-		//		slightly larger for some points since the other error is negative and
-		//		would bring the total error down
+		//Data graphs: statistical, systematic and total errors
 		for(int i = 0; i < data.size(); i++) {
-			graphs.push_back(data[i]->GetStatisticalErrorGraph());
-			graphs.push_back(data[i]->GetSystematicErrorGraph());
-			graphs.push_back(data[i]->GetTotalErrorGraph());
+			SPXGraphUtilities::ExtendBounds(bounds, data[i]->GetBounds());
 		}
 
 		//Cross sections
@@ -431,20 +606,12 @@ void SPXPlot::DetermineOverlayFrameBounds(double &xMin, double &xMax, double &yM
                  int nbands=pdf->GetNBands();
                  if (debug) std::cout << cn << mn <<"Number of bands= " <<nbands<< std::endl;
                  for (int iband=0; iband<nbands; iband++) {
-		  TGraphAsymmErrors * gband   =pdf->GetBand(iband);
-		  if (!gband) {
-                   std::ostringstream oss;
-                   oss << cn <<mn<<"Band iband= "<<iband<<" not found at index "<<iband;
-                   throw SPXGeneralException(oss.str());
-                  }
-                  graphs.push_back(gband);
+                  SPXGraphUtilities::ExtendBounds(bounds, pdf->GetBandBounds(iband));
                  }
 		}
 
-		xMin = SPXGraphUtilities::GetXMin(graphs);
-		xMax = SPXGraphUtilities::GetXMax(graphs);
-		yMin = SPXGraphUtilities::GetYMin(graphs);
-		yMax = SPXGraphUtilities::GetYMax(graphs);
+		overlayBounds = bounds;
+		SPXGraphUtilities::GetFrameBounds(bounds, xMin, xMax, yMin, yMax);
 
 		//Sanity check
 		if(xMin > xMax) {
@@ -461,7 +628,7 @@ void SPXPlot::DetermineOverlayFrameBounds(double &xMin, double &xMax, double &yM
 	}
 }
 
-//Determine frame bounds by calculating the xmin, xmax, ymin, ymax from ALL graphs being drawn
+//Determine frame bounds from the extents of ALL ratio graphs being drawn
 void SPXPlot::DetermineRatioFrameBounds(double &xMin, double &xMax, double &yMin, double &yMax) {
 	std::string mn = "DetermineRatioFrameBounds: ";
 	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
@@ -484,21 +651,15 @@ void SPXPlot::DetermineRatioFrameBounds(double &xMin, double &xMax, double &yMin
 		return;
 	}
 
-	std::vector<TGraphAsymmErrors *> graphs;
+	SPXGraphBounds_t bounds = SPXGraphUtilities::GetEmptyBounds();
 	{
 		for(int i = 0; i < ratios.size(); i++) {
-                 //TC GetRatioGraph returns now vectors 
-		 //graphs.push_back(ratios[i].GetRatioGraph());
-		 std::vector<TGraphAsymmErrors *> ratiographs=ratios[i].GetRatioGraph();
-  		 for(int j = 0; j < ratiographs.size(); j++) {
-		  graphs.push_back(ratiographs[j]);
-                 }
+		 //Throws if the ratio has no graph
+		 ratios[i].GetRatioGraph();
+		 SPXGraphUtilities::ExtendBounds(bounds, ratios[i].GetBounds());
 		}
 
-		xMin = SPXGraphUtilities::GetXMin(graphs);
-		xMax = SPXGraphUtilities::GetXMax(graphs);
-		yMin = SPXGraphUtilities::GetYMin(graphs);
-		yMax = SPXGraphUtilities::GetYMax(graphs);
+		SPXGraphUtilities::GetFrameBounds(bounds, xMin, xMax, yMin, yMax);
 
 		//Sanity check
 		if(xMin > xMax) {
@@ -744,16 +905,16 @@ void SPXPlot::DrawOverlayPadFrame(void) {
 	}
 	*/
 
-	//Force to non-negative if plotting logarithmic axis
+	//Force to non-negative if plotting logarithmic axis: smallest positive edge of the graphs, if any
 	if(pc.IsXLog()) {
 		if(xMinOverlay < 0) {
-			xMinOverlay = 1e-10;
+			xMinOverlay = (overlayBounds.xMinPositive < overlayBounds.xMax ? overlayBounds.xMinPositive : 1e-10);
 			if(debug) std::cerr << cn << mn << "WARNING: Forcing non-negative Overlay X Axis since it was specified as Logarithmic" << std::endl;
 		}
 	}
 	if(pc.IsYLog()) {
 		if(yMinOverlay < 0) {
-			yMinOverlay = 1e-10;
+			yMinOverlay = (overlayBounds.yMinPositive < overlayBounds.yMax ? overlayBounds.yMinPositive : 1e-10);
 			if(debug) std::cerr << cn << mn << "WARNING: Forcing non-negative Overlay Y Axis since it was specified as Logarithmic" << std::endl;
 		}
 	}
@@ -955,6 +1116,7 @@ void SPXPlot::StaggerConvoluteOverlay(void) {
                if (debug) std::cout << cn << mn <<"Stagger Graph " <<graph->GetName()<< std::endl;
 	       SPXGraphUtilities::StaggerGraph(i, ncross, graph);
               }
+              pdf->ResetBandBounds();
 	}
 }
 
@@ -1004,6 +1166,9 @@ void SPXPlot::StaggerConvoluteRatio(void) {
          }
         }
 
+	for(int i = 0; i < ratios.size(); i++) {
+	 if(ratios[i].HasConvolute()) ratios[i].UpdateBounds();
+	}
 }
 
 //Matches the overlay binning if the match_binning flag is set
@@ -1573,7 +1738,7 @@ void SPXPlot::DrawLegend(void) {
  //if (steeringFile->GetScaleFunctionalFormLabel() )  linesize+=0.02;
 
 
- leg = new TLegend();
+ leg = drawArena->Adopt(new TLegend());
  leg->SetBorderSize(0);
  leg->SetFillColor(0);
  //leg->SetFillColorAlpha(kYellow,0.);
@@ -1806,7 +1971,7 @@ void SPXPlot::DrawLegend(void) {
    SPXRatioStyle ratioStyle = pc.GetRatioStyle(i);
    if (debug) std::cout<<cn<<mn<<"ratio style= "<<ratioStyle.ToString()<<std::endl;
    //
-   SPXRatio ratioInstance = ratios.at(i);
+   SPXRatio &ratioInstance = ratios.at(i);
    TString datadir=TString(ratioInstance.GetDataDirectory());
    //
    
@@ -1991,8 +2156,8 @@ void SPXPlot::DrawLegend(void) {
        hname+=gband->GetName();
        //hname.ReplaceAll(".txt","");
        hname+="LowEdge";
-       gDirectory->ls();
-       TH1D *hedge=(TH1D*)gDirectory->Get(hname);
+       // edge histograms are not in gDirectory: find the one drawn by DrawBand
+       TH1D *hedge=overlayPad ? (TH1D*)overlayPad->FindObject(hname) : 0;
        // need to use key since name has /
        //TKey *key = gDirectory->GetKey(hname);
        //if (!key) {
@@ -2052,7 +2217,7 @@ void SPXPlot::DrawLegend(void) {
 
       label+=pdf->GetPDFtype();
       if (debug) std::cout<<cn<<mn<<"label= "<< label << std::endl;
-       if (steeringFile->GetLabelChi2() && !pdfsdifferent &&!steeringFile->GetParameterScan() && !scalechoicedifferent) {
+       if (steeringFile->GetLabelChi2() && !pdfsdifferent &&!steeringFile->GetParameterScanLegend() && !scalechoicedifferent) {
         if (debug) std::cout<<cn<<mn<<"Add Chi2 to label icross= "<<icross<<std::endl;
         if (icross>=data.size()) {
          std::cout<<cn<<mn<<"WARNING: Something is wrong Number of cross-sections= "<<data.size()<<" but idata= "<<icross<<std::endl; 
@@ -2069,7 +2234,7 @@ void SPXPlot::DrawLegend(void) {
         if (debug) std::cout<<cn<<mn<<"nlouncertainty " << std::endl;
         if (label.Sizeof()>namesize) namesize=label.Sizeof();
         if (debug) std::cout<<cn<<mn<<"Add in legend nlouncertainty gband= "<<gband->GetName()<<" namesize= "<<namesize<<std::endl;
-        if (scalechoicedifferent || steeringFile->GetParameterScan()) {
+        if (scalechoicedifferent || steeringFile->GetParameterScanLegend()) {
 	 if (debug) std::cout<<cn<<mn<<"empty option "<<""<<std::endl;
 	 leg->AddEntry((TObject*)0, label, "");
         } else { 
@@ -2128,7 +2293,7 @@ void SPXPlot::DrawLegend(void) {
           opt="LF";
          } else std::cout << cn << mn <<"WARNING: do not know what to do not plotMarker, not plotBand"<< std::endl;
 
-         if (!(steeringFile->GetParameterScan() && ratioonly)) { 
+         if (!(steeringFile->GetParameterScanLegend() && ratioonly)) { 
 	  if (debug) std::cout<<cn<<mn<<"Add in legend iband= "<<iband
 	 		     <<" gband= "<<gband->GetName()<<" labelcount= "<<labelcount<<" opt= "<<opt.Data()<<std::endl;
 
@@ -2202,7 +2367,7 @@ void SPXPlot::DrawLegend(void) {
     }
    }
 
-   if (steeringFile->GetParameterScan()) {
+   if (steeringFile->GetParameterScanLegend()) {
     if (debug) std::cout<<cn<<mn<<"Parameter scan "<<std::endl;
     SPXGrid * grid=crossSections[icross].GetGrid();
     if (!grid)  { std::cout<<cn<<mn<<"grid not found ! "<<std::endl; return;}
@@ -2352,7 +2517,7 @@ void SPXPlot::DrawLegend(void) {
 
  // Now build second Legend with info
 
- leginfo = new TLegend();
+ leginfo = drawArena->Adopt(new TLegend());
  leginfo->SetBorderSize(0);
  leginfo->SetFillColor(0);
  leginfo->SetFillStyle(0);
@@ -2367,7 +2532,7 @@ void SPXPlot::DrawLegend(void) {
  for(int idata = 0; idata < data.size(); idata++) {                 
 
   if (etascan&&onedataset && idata>0) break;
-  if (steeringFile->GetParameterScan() && idata>0) break;
+  if (steeringFile->GetParameterScanLegend() && idata>0) break;
   //TString infolabel = "#font[9]{";
   TString infolabel = "";
 
@@ -2521,7 +2686,7 @@ void SPXPlot::DrawLegend(void) {
   // leginfo->AddEntry((TObject*)0, label,"");
   //}
 
-  if ((steeringFile->GetParameterScan() && ratioonly)) { 
+  if ((steeringFile->GetParameterScanLegend() && ratioonly)) { 
    TString label="NLO QCD with ";
    SPXPDF * pdf=crossSections[icross].GetPDF();
    if (!grid) {std::cout<<cn<<mn<<"pdf not found ! "<<std::endl; continue;}
@@ -2605,6 +2770,8 @@ void SPXPlot::CanvasToPNG(void) {
 	std::string mn = "CanvasToPNG: ";
 	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
 
+	SPXStageScope stage("write");
+
 	if(!canvas) {
 		throw SPXROOTException(cn + mn + "You MUST call SPXPlot::CreateCanvas before printing the canvas as a PNG");
 	}
@@ -2614,35 +2781,36 @@ void SPXPlot::CanvasToPNG(void) {
 
 	std::string filename = GetPNGFilename(pc.GetDescription());
 
-	//Create/get the PNG filename
-        if (!steeringFile->GetOutputGraphicFormat().empty()) {
-	 TString epsfilename=filename;
-         //if (debug) std::cout<<cn<<mn<<" output format= "<< steeringFile->GetOutputGraphicFormat()<<std::endl;
-         
-         epsfilename.ReplaceAll("png",TString(steeringFile->GetOutputGraphicFormat()));
-	 if (debug) std::cout<<cn<<mn<<"id= "<<id<<std::endl;
-         TString text="_plot_";
-         text+=id;
-         epsfilename.ReplaceAll(text,"");
-
-         if (debug) {
-          std::cout<<cn<<mn<<"Print epsfilename= "<< epsfilename.Data()<<std::endl;
-         }
-         canvas->Print(epsfilename.Data());
-        }
+	//Files of the output_graphicformat formats: PNG filename without the plot ID
+	TString basename=filename;
+	basename.ReplaceAll(".png","");
+	TString text="_plot_";
+	text+=id;
+	basename.ReplaceAll(text,"");
+
+	SPXOutputManager output(steeringFile->GetOutputGraphicFormats());
+	std::vector<std::string> filenames = output.GetFilenames(std::string(basename.Data()));
+
+	//PNG File
+	filenames.push_back(filename);
+
+	if (debug) {
+	 for (int i=0; i<filenames.size(); i++) std::cout<<cn<<mn<<"Print "<<filenames[i]<<std::endl;
+	}
+
+	//Canvas is painted by UpdateCanvas: all formats are written from it, raster files in the background
+	output.Write(canvas, filenames);
+	outputFiles.insert(outputFiles.end(), filenames.begin(), filenames.end());
 
         if (steeringFile->GetOutputRootfile()) {
-	 TString rootfilename=filename;
-         TString text="_plot_";
-         text+=id;
-         rootfilename.ReplaceAll(text,"");
-         rootfilename.ReplaceAll("png","root");
-	 this->WriteRootFile(rootfilename);
+	 std::string rootfilename=GetROOTFilename(pc.GetDescription());
+	 this->WriteRootFile(TString(rootfilename));
+	 outputFiles.push_back(rootfilename);
         }
 
-	//Print PNG File
-
-	canvas->Print(filename.c_str());
+        if (!steeringFile->GetOutputTableFormat().empty()) {
+	 this->WriteResultsTable();
+        }
 
         return;
 }
@@ -2666,6 +2834,501 @@ std::string SPXPlot::GetPNGFilename(std::string desc) {
  return filename;
 }
 
+//Cross sections at the sqrt(s) factors of the grid steering sqrts_sweep: the nominal (normalised as plotted)
+//times the ratio of the sweep to the nominal from SPXPDF::CalcBeamEnergySweep; caller owns the graphs
+std::vector<TGraphAsymmErrors *> SPXPlot::GetBeamEnergySweepGraphs(int icross) {
+ std::string mn = "GetBeamEnergySweepGraphs: ";
+
+ std::vector<TGraphAsymmErrors *> vsweep;
+
+ SPXPDF *pdf=crossSections.at(icross).GetPDF();
+ if (!pdf || pdf->GetNumberOfBeamEnergySweepPoints()==0) return vsweep;
+
+ TGraphAsymmErrors *gnom=pdf->GetTotalBand();
+ if (!gnom) {
+  std::cout<<cn<<mn<<"WARNING: Total band not found: No beam energy sweep for icross= "<<icross<<std::endl;
+  return vsweep;
+ }
+
+ for (int i=0; i<pdf->GetNumberOfBeamEnergySweepPoints(); i++) {
+  TH1D *hratio=pdf->GetBeamEnergySweepRatio(i);
+
+  TGraphAsymmErrors *gsweep=new TGraphAsymmErrors();
+  gsweep->SetName(hratio->GetName());
+
+  // bins may have been removed or matched to the data later on: bins without a ratio are skipped
+  for (int ibin=0; ibin<gnom->GetN(); ibin++) {
+   double x=0., y=0.;
+   gnom->GetPoint(ibin,x,y);
+
+   int jbin=hratio->FindBin(x);
+   if (jbin<1 || jbin>hratio->GetNbinsX()) continue;
+
+   int n=gsweep->GetN();
+   gsweep->SetPoint(n,x,y*hratio->GetBinContent(jbin));
+   gsweep->SetPointError(n,gnom->GetErrorXlow(ibin),gnom->GetErrorXhigh(ibin),0.,0.);
+  }
+
+  vsweep.push_back(gsweep);
+ }
+
+ return vsweep;
+}
+
+void SPXPlot::DrawBeamEnergySweep(void) {
+ std::string mn = "DrawBeamEnergySweep: ";
+ if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+ if (!overlayPad) return;
+
+ for (int icross=0; icross<crossSections.size(); icross++) {
+  std::vector<TGraphAsymmErrors *> vsweep=this->GetBeamEnergySweepGraphs(icross);
+  if (vsweep.empty()) continue;
+
+  SPXPDF *pdf=crossSections.at(icross).GetPDF();
+  Color_t color=pdf->GetTotalBand()->GetFillColor();
+
+  overlayPad->cd();
+  for (int i=0; i<vsweep.size(); i++) {
+   TGraphAsymmErrors *gsweep=drawArena->Adopt(vsweep.at(i));
+   gsweep->SetLineColor(color);
+   gsweep->SetLineStyle(2+i%9);
+   gsweep->SetLineWidth(2);
+   gsweep->SetMarkerColor(color);
+   gsweep->SetMarkerStyle(24+i%10);
+   gsweep->Draw("P same");
+
+   if (leg) {
+    TString label=Form("#sqrt{s} #times %4.3f",pdf->GetBeamEnergySweepFactor(i));
+    leg->AddEntry(gsweep, label, "P");
+   }
+  }
+ }
+}
+
+//Parameter scan (grid_parameter_scan): the grids of each PDF set, convoluted once at their parameter
+//values, are interpolated in the parameter and the chi2 against the data is scanned without further convolution
+void SPXPlot::ScanParameter(void) {
+ std::string mn = "ScanParameter: ";
+ if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+ if (!steeringFile->GetParameterScan() || steeringFile->GetParameterScanPoints()<=0) return;
+
+ if (data.empty()) {
+  std::cout<<cn<<mn<<"WARNING: No data in plot "<<id<<": No parameter scan"<<std::endl;
+  return;
+ }
+
+ //One scan per PDF set, in the order of the cross sections
+ std::vector<std::string> pdfnames;
+ std::map<std::string, SPXParameterScan *> scans;
+ std::string parname, parunit;
+
+ for (int icross=0; icross<crossSections.size(); icross++) {
+  SPXPDF *pdf=crossSections.at(icross).GetPDF();
+  SPXGrid *grid=crossSections.at(icross).GetGrid();
+  if (!pdf || !grid) {
+   std::cout<<cn<<mn<<"WARNING: PDF or grid not found for icross= "<<icross<<std::endl;
+   continue;
+  }
+
+  std::string pdfname=pdf->GetPDFtype();
+  if (scans.count(pdfname)==0) {
+   scans[pdfname]=new SPXParameterScan(steeringFile->GetParameterScanInterpolation());
+   pdfnames.push_back(pdfname);
+  }
+
+  parname=grid->GetParameterName();
+  parunit=grid->GetParameterUnit();
+
+  scans[pdfname]->AddPoint(grid->GetParameterValue(), pdf->GetTotalBand(), pdf->GetTheoryCovarianceMatrix());
+ }
+
+ SPXPlotConfiguration &pc = steeringFile->GetPlotConfiguration(id);
+
+ TString scanfilename=GetROOTFilename(pc.GetDescription());
+ scanfilename.ReplaceAll(".root","_scan.root");
+
+ TFile *scanfile = new TFile(scanfilename,"recreate");
+ if (!scanfile || scanfile->IsZombie()) {
+  throw SPXFileIOException(scanfilename.Data(), cn + mn + "Unable to open the parameter scan ROOT file");
+ }
+
+ int ndf=data.at(0)->GetTotalErrorGraph()->GetN();
+
+ for (int ipdf=0; ipdf<pdfnames.size(); ipdf++) {
+  SPXParameterScan *scan=scans[pdfnames.at(ipdf)];
+
+  if (scan->GetNumberOfPoints()<2) {
+   std::cout<<cn<<mn<<"WARNING: "<<pdfnames.at(ipdf)<<" has only one "<<parname<<" value: No parameter scan"<<std::endl;
+   delete scan;
+   continue;
+  }
+
+  scan->Build();
+
+  double pmin=steeringFile->GetParameterScanMin();
+  double pmax=steeringFile->GetParameterScanMax();
+  if (pmax<=pmin) {
+   pmin=scan->GetParameterMin();
+   pmax=scan->GetParameterMax();
+  }
+
+  TGraph *chi2=scan->Scan(data.at(0), pmin, pmax, steeringFile->GetParameterScanPoints());
+
+  double best=0., chi2min=0., errdown=0., errup=0.;
+  SPXParameterScan::GetMinimum(chi2, best, chi2min, errdown, errup);
+
+  std::cout<<cn<<mn<<"id= "<<id<<" "<<pdfnames.at(ipdf)<<" "<<parname<<"= "<<best<<" -"<<errdown<<" +"<<errup<<" "<<parunit
+           <<" chi2/ndf= "<<chi2min<<"/"<<ndf<<" ("<<scan->GetNumberOfPoints()<<" grids, "<<steeringFile->GetParameterScanPoints()<<" scan points)"<<std::endl;
+
+  TString name=TString(parname)+"_"+pdfnames.at(ipdf).c_str();
+  name.ReplaceAll("{","");
+  name.ReplaceAll("}","");
+  name.ReplaceAll("#","");
+  name.ReplaceAll(" ","");
+  chi2->SetName("chi2_"+name);
+  chi2->SetTitle(TString(";")+parname.c_str()+" ["+parunit.c_str()+"];#chi^{2}");
+  chi2->Write();
+
+  TGraphAsymmErrors *prediction=scan->GetPrediction(best);
+  prediction->SetName("theory_"+name+"_best");
+  prediction->Write();
+
+  delete prediction;
+  delete chi2;
+  delete scan;
+ }
+
+ scanfile->Close();
+ delete scanfile;
+
+ std::cout<<cn<<mn<<"Parameter scan written to "<<scanfilename.Data()<<std::endl;
+ outputFiles.push_back(std::string(scanfilename.Data()));
+}
+
+//PDF-vs-x bands (pdf_bands = g, u, dbar, ...) of each PDF set in the plot at each pdf_band_q2:
+//all flavours and Q2 values of a set come from one sweep over its members (SPXPDF::FillPdfBands)
+void SPXPlot::PlotPdfBands(bool draw) {
+ std::string mn = "PlotPdfBands: ";
+ if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+ SPXPlotConfiguration &pc = steeringFile->GetPlotConfiguration(id);
+
+ const std::vector<std::string> &flavours = pc.GetPdfBandFlavours();
+ if (flavours.empty()) return;
+
+ const std::vector<double> &q2values = pc.GetPdfBandQ2();
+
+ double xmin = pc.CheckPlotOptions("pdf_band_x_min") ? pc.GetPlotOptions("pdf_band_x_min") : 1.e-4;
+ double xmax = pc.CheckPlotOptions("pdf_band_x_max") ? pc.GetPlotOptions("pdf_band_x_max") : 0.9;
+ int npoints = pc.CheckPlotOptions("pdf_band_x_points") ? int(pc.GetPlotOptions("pdf_band_x_points")) : 100;
+
+ //Flavour index (-6..6, 0 is the gluon) of each requested flavour
+ std::vector<int> iflavours;
+ for (int i=0; i<flavours.size(); i++) {
+  for (int ifl=-6; ifl<=6; ifl++) {
+   if (SPXPDF::GetFlavourName(ifl)==flavours.at(i)) iflavours.push_back(ifl);
+  }
+ }
+
+ //One panel per (Q2, flavour), one band per PDF set: instances sharing a PDF steering file are evaluated once
+ std::vector<std::string> titles;
+ for (int iq2=0; iq2<q2values.size(); iq2++) {
+  for (int i=0; i<iflavours.size(); i++) {
+   std::ostringstream title;
+   title<<"x"<<flavours.at(i)<<" at Q^{2}= "<<q2values.at(iq2)<<" GeV^{2}";
+   titles.push_back(title.str());
+  }
+ }
+
+ std::vector<std::vector<TGraphAsymmErrors *> > bands(titles.size());
+ std::vector<int> instances;
+ std::vector<std::string> names;
+ std::vector<SPXPDF *> pdfs;
+ std::set<std::string> pdfFiles;
+
+ for (int i=0; i<pc.GetNumberOfConfigurationInstances(); i++) {
+  SPXPlotConfigurationInstance &pci = pc.GetPlotConfigurationInstance(i);
+
+  std::string pdffile=pci.pdfSteeringFile.GetFilename();
+  if (pdffile.empty() || pdfFiles.count(pdffile)) continue;
+  pdfFiles.insert(pdffile);
+
+  SPXPDF *pdf = new SPXPDF(&pci.pdfSteeringFile);
+  pdfs.push_back(pdf);
+
+  pdf->FillPdfBands(q2values, npoints, xmin, xmax);
+
+  for (int iq2=0; iq2<q2values.size(); iq2++) {
+   for (int j=0; j<iflavours.size(); j++) {
+    bands.at(iq2*iflavours.size()+j).push_back(pdf->GetPdfBand(iflavours.at(j), iq2));
+   }
+  }
+
+  instances.push_back(i);
+  names.push_back(pdf->GetPDFtype());
+ }
+
+ if (pdfs.empty()) {
+  std::cout<<cn<<mn<<"WARNING: No PDF steering file in plot "<<id<<": No PDF bands"<<std::endl;
+  return;
+ }
+
+ //The page keeps copies of the bands: the PDF objects are not needed anymore
+ try {
+  this->DrawBandPage("pdf", titles, bands, instances, names, "x", "xf(x,Q^{2})", true, true, draw);
+ } catch(...) {
+  for (int i=0; i<pdfs.size(); i++) delete pdfs.at(i);
+  throw;
+ }
+
+ for (int i=0; i<pdfs.size(); i++) {
+  delete pdfs.at(i);
+ }
+}
+
+//Page of the bands of the PDF sets of the plot, one panel for each quantity (bands[panel][set]), with the
+//ratio to the first set below when divide is set. Bands and ratios are written to <desc>_<suffix>.root and,
+//when drawing, printed to <desc>_<suffix>.<format>. Copies of the bands, the canvas and the legends are
+//owned by the drawing arena; each set is drawn with the PDF band style of its plot instance
+void SPXPlot::DrawBandPage(const std::string &suffix, const std::vector<std::string> &titles, const std::vector<std::vector<TGraphAsymmErrors *> > &bands,
+                           const std::vector<int> &instances, const std::vector<std::string> &names, const std::string &xtitle, const std::string &ytitle,
+                           bool logx, bool divide, bool draw) {
+ std::string mn = "DrawBandPage: ";
+ if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+ SPXPlotConfiguration &pc = steeringFile->GetPlotConfiguration(id);
+
+ const int npanels=bands.size();
+ if (npanels==0 || names.empty()) return;
+
+ TString filename=GetROOTFilename(pc.GetDescription());
+ filename.ReplaceAll(".root",TString("_")+suffix.c_str()+".root");
+
+ TFile *file = new TFile(filename,"recreate");
+ if (!file || file->IsZombie()) {
+  delete file;
+  throw SPXFileIOException(filename.Data(), cn + mn + "Unable to open the band ROOT file");
+ }
+
+ std::vector<std::vector<TGraphAsymmErrors *> > graphs(npanels), ratios(npanels);
+
+ for (int ip=0; ip<npanels; ip++) {
+  for (int is=0; is<bands.at(ip).size(); is++) {
+   SPXPlotConfigurationInstance &pci = pc.GetPlotConfigurationInstance(instances.at(is));
+
+   TGraphAsymmErrors *band = drawArena->Adopt((TGraphAsymmErrors *)bands.at(ip).at(is)->Clone(bands.at(ip).at(is)->GetName()));
+   SPXGraphUtilities::SetColors(band, pci.pdfFillColor);
+   band->SetFillStyle(pci.pdfFillStyle);
+   band->Write();
+   graphs.at(ip).push_back(band);
+
+   if (!divide) continue;
+
+   TGraphAsymmErrors *ratio = drawArena->Adopt(SPXGraphUtilities::Divide(band, graphs.at(ip).at(0), ZeroDenGraphErrors));
+   TString rationame=band->GetName();
+   rationame+="_ratio";
+   ratio->SetName(rationame);
+   SPXGraphUtilities::SetColors(ratio, pci.pdfFillColor);
+   ratio->SetFillStyle(pci.pdfFillStyle);
+   ratio->Write();
+   ratios.at(ip).push_back(ratio);
+  }
+ }
+
+ file->Close();
+ delete file;
+
+ std::cout<<cn<<mn<<"Bands written to "<<filename.Data()<<std::endl;
+ outputFiles.push_back(std::string(filename.Data()));
+
+ if (!draw) return;
+
+ double xlegend=steeringFile->GetXLegend();
+ double ylegend=steeringFile->GetYLegend();
+ if (pc.CheckPlotOptions("x_legend")) xlegend=pc.GetPlotOptions("x_legend");
+ if (pc.CheckPlotOptions("y_legend")) ylegend=pc.GetPlotOptions("y_legend");
+
+ //Overlay pads on the first row, ratio pads on the second
+ std::ostringstream oss;
+ oss << "canvas_" << suffix << "_" << id;
+
+ TCanvas *page = drawArena->Adopt(new TCanvas(oss.str().c_str(), pc.GetDescription().c_str(), 400, 0, 500*npanels, divide ? 700 : 500));
+ page->SetFillColor(0);
+ page->Divide(npanels, divide ? 2 : 1);
+
+ for (int ip=0; ip<npanels; ip++) {
+  double xlow=double(ip)/npanels;
+  double xup=double(ip+1)/npanels;
+
+  TPad *overlay=(TPad *)page->cd(ip+1);
+  overlay->SetPad(xlow, divide ? 0.4 : 0., xup, 1.);
+  overlay->SetLeftMargin(0.15);
+  overlay->SetRightMargin(0.05);
+  overlay->SetBottomMargin(divide ? 0.001 : 0.15);
+  overlay->SetLogx(logx);
+
+  SPXGraphBounds_t bounds=SPXGraphUtilities::GetEmptyBounds();
+  for (int is=0; is<graphs.at(ip).size(); is++) {
+   SPXGraphUtilities::ExtendBounds(bounds, SPXGraphUtilities::GetBounds(graphs.at(ip).at(is)));
+  }
+  double xMin, xMax, yMin, yMax;
+  SPXGraphUtilities::GetFrameBounds(bounds, xMin, xMax, yMin, yMax);
+  if (logx) xMin=bounds.xMinPositive;
+
+  TH1F *frame=overlay->DrawFrame(xMin, yMin, xMax, yMax);
+  frame->SetTitle(titles.at(ip).c_str());
+  frame->GetYaxis()->SetTitle(ytitle.c_str());
+  if (!divide) frame->GetXaxis()->SetTitle(xtitle.c_str());
+
+  TLegend *leg = drawArena->Adopt(new TLegend(xlegend-0.35, ylegend-0.06*names.size(), xlegend, ylegend));
+  leg->SetBorderSize(0);
+  leg->SetFillStyle(0);
+
+  for (int is=0; is<graphs.at(ip).size(); is++) {
+   SPXPlotConfigurationInstance &pci = pc.GetPlotConfigurationInstance(instances.at(is));
+   this->DrawBands(std::vector<TGraphAsymmErrors *>(1, graphs.at(ip).at(is)), "E2", pci);
+   leg->AddEntry(graphs.at(ip).at(is), names.at(is).c_str(), "f");
+  }
+  leg->Draw();
+  overlay->RedrawAxis();
+
+  if (!divide) continue;
+
+  TPad *ratiopad=(TPad *)page->cd(npanels+ip+1);
+  ratiopad->SetPad(xlow, 0., xup, 0.4);
+  ratiopad->SetLeftMargin(0.15);
+  ratiopad->SetRightMargin(0.05);
+  ratiopad->SetTopMargin(0.001);
+  ratiopad->SetBottomMargin(0.25);
+  ratiopad->SetLogx(logx);
+
+  bounds=SPXGraphUtilities::GetEmptyBounds();
+  for (int is=0; is<ratios.at(ip).size(); is++) {
+   SPXGraphUtilities::ExtendBounds(bounds, SPXGraphUtilities::GetBounds(ratios.at(ip).at(is)));
+  }
+  SPXGraphUtilities::GetFrameBounds(bounds, xMin, xMax, yMin, yMax);
+  if (logx) xMin=bounds.xMinPositive;
+
+  frame=ratiopad->DrawFrame(xMin, yMin, xMax, yMax);
+  frame->GetXaxis()->SetTitle(xtitle.c_str());
+  frame->GetYaxis()->SetTitle(("Ratio to "+names.at(0)).c_str());
+
+  for (int is=0; is<ratios.at(ip).size(); is++) {
+   SPXPlotConfigurationInstance &pci = pc.GetPlotConfigurationInstance(instances.at(is));
+   this->DrawBands(std::vector<TGraphAsymmErrors *>(1, ratios.at(ip).at(is)), "E2", pci);
+  }
+  ratiopad->RedrawAxis();
+ }
+
+ TString basename=filename;
+ basename.ReplaceAll(".root","");
+
+ SPXOutputManager output(steeringFile->GetOutputGraphicFormats());
+ std::vector<std::string> filenames=output.GetFilenames(std::string(basename.Data()));
+ if (filenames.empty()) filenames.push_back(std::string(basename.Data())+".png");
+
+ page->Update();
+ output.Write(page, filenames);
+ outputFiles.insert(outputFiles.end(), filenames.begin(), filenames.end());
+}
+
+//Parton luminosities (parton_luminosity = gg, qqbar, qg) of each PDF set in the plot versus M_X:
+//bands are written to <desc>_lumi.root and, when drawing, shown with their ratio to the first PDF set
+void SPXPlot::PlotPartonLuminosity(bool draw) {
+ std::string mn = "PlotPartonLuminosity: ";
+ if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+ SPXPlotConfiguration &pc = steeringFile->GetPlotConfiguration(id);
+
+ const std::vector<std::string> &channels = pc.GetPartonLuminosities();
+ if (channels.empty()) return;
+
+ //One luminosity per PDF set: instances sharing a PDF steering file are calculated once
+ std::vector<SPXPartonLuminosity *> lumis;
+ std::vector<int> lumiInstances;
+ std::vector<std::string> names;
+ std::set<std::string> pdfFiles;
+
+ double massMin = pc.CheckPlotOptions("luminosity_mass_min") ? pc.GetPlotOptions("luminosity_mass_min") : 10.;
+ double massMax = pc.CheckPlotOptions("luminosity_mass_max") ? pc.GetPlotOptions("luminosity_mass_max") : 0.;
+ int npoints    = pc.CheckPlotOptions("luminosity_mass_points") ? int(pc.GetPlotOptions("luminosity_mass_points")) : 40;
+
+ //Sets at different sqrt(s) are not divided
+ bool divide=true;
+
+ try {
+  for (int i=0; i<pc.GetNumberOfConfigurationInstances(); i++) {
+   SPXPlotConfigurationInstance &pci = pc.GetPlotConfigurationInstance(i);
+
+   std::string pdffile=pci.pdfSteeringFile.GetFilename();
+   if (pdffile.empty() || pdfFiles.count(pdffile)) continue;
+   pdfFiles.insert(pdffile);
+
+   double sqrtS = pc.CheckPlotOptions("luminosity_sqrt_s") ? pc.GetPlotOptions("luminosity_sqrt_s") : pci.dataSteeringFile.GetSqrtS();
+
+   //Same mass points for all PDF sets, so that the bands can be divided: default upper mass from the first set
+   if (massMax<=0.) massMax=0.25*sqrtS;
+
+   if (!lumis.empty() && sqrtS!=lumis.at(0)->GetSqrtS() && divide) {
+    std::cerr<<cn<<mn<<"WARNING: Parton luminosities of plot "<<id<<" at different sqrt(s) ("<<lumis.at(0)->GetSqrtS()
+             <<" and "<<sqrtS<<" GeV): Not dividing them, set luminosity_sqrt_s to compare them"<<std::endl;
+    divide=false;
+   }
+
+   SPXPartonLuminosity *lumi = new SPXPartonLuminosity(&pci.pdfSteeringFile, sqrtS);
+   lumis.push_back(lumi);
+   lumi->Calculate(channels, massMin, massMax, npoints);
+
+   lumiInstances.push_back(i);
+   names.push_back(lumi->GetPDFName());
+  }
+
+  if (lumis.empty()) {
+   std::cout<<cn<<mn<<"WARNING: No PDF steering file in plot "<<id<<": No parton luminosities"<<std::endl;
+   return;
+  }
+
+  //One panel per channel, one band per PDF set
+  std::vector<std::string> titles;
+  std::vector<std::vector<TGraphAsymmErrors *> > bands(channels.size());
+  for (int ich=0; ich<channels.size(); ich++) {
+   titles.push_back(channels.at(ich)+" luminosity");
+   for (int il=0; il<lumis.size(); il++) {
+    bands.at(ich).push_back(lumis.at(il)->GetBand(channels.at(ich)));
+   }
+  }
+
+  //The page keeps copies of the bands
+  this->DrawBandPage("lumi", titles, bands, lumiInstances, names, "M_{X} [GeV]", "L(M_{X})", true, divide, draw);
+
+ } catch(...) {
+  for (int il=0; il<lumis.size(); il++) delete lumis.at(il);
+  throw;
+ }
+
+ for (int il=0; il<lumis.size(); il++) {
+  delete lumis.at(il);
+ }
+}
+
+std::string SPXPlot::GetROOTFilename(std::string desc) {
+ std::string mn = "GetROOTFilename: ";
+ if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+ //Same as the PNG filename, without the plot ID
+ TString rootfilename=GetPNGFilename(desc);
+ TString text="_plot_";
+ text+=id;
+ rootfilename.ReplaceAll(text,"");
+ rootfilename.ReplaceAll("png","root");
+
+ if(debug) std::cout << cn << mn << "Created ROOT Filename: " << rootfilename.Data() << std::endl;
+
+ return std::string(rootfilename.Data());
+}
+
 void SPXPlot::InitializeRatios(void) {
  std::string mn = "InitializeRatios: ";
  if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
@@ -2681,10 +3344,11 @@ void SPXPlot::InitializeRatios(void) {
   std::string ratioString  = pc.GetRatio(i);
 
   try {
-   SPXRatio ratioInstance = SPXRatio(pc, ratioStyle);
+   SPXRatio ratioInstance = SPXRatio(steeringFile, id, ratioStyle);
    
    ratioInstance.AddDataFileGraphMap(dataFileGraphMap);
    ratioInstance.AddDataFileLabelMap(dataFileLabelMap);
+   ratioInstance.AddDataFileSystematicsMap(dataFileSystematicsMap);
 
    ratioInstance.AddReferenceFileGraphMap(referenceFileGraphMap);
    ratioInstance.AddNominalFileGraphMap(nominalFileGraphMap);
@@ -2713,6 +3377,7 @@ void SPXPlot::InitializeRatios(void) {
 
    if (debug) std::cout<<cn<<mn<<"i= "<<i<<" call Divide "<<std::endl; 
    ratioInstance.Divide();
+   ratioInstance.AdoptGraphs(ratioArena);
 
    ratios.push_back(ratioInstance);
 
@@ -3296,7 +3961,7 @@ void SPXPlot::InitializeData(void) {
 
 		if(debug) std::cout << cn << mn << "Added data with key = [" << key << "] to dataSet" << std::endl;
 
-                SPXData *dataInstance = new SPXData(pci);
+                SPXData *dataInstance = arena->Adopt(new SPXData(pci));
                 if (!dataInstance) throw SPXGeneralException(cn+mn+"Problem to create dataInstance");
 
                 if (steeringFile->GetTakeSignforTotalError()) {
@@ -3432,6 +4097,7 @@ void SPXPlot::InitializeData(void) {
 
 		std::vector <TGraphAsymmErrors *> vsyst=data[i]->GetSystematicsErrorGraphs();
 		if (debug) std::cout<<cn<<mn<<"Number of systematic found= " << vsyst.size() <<std::endl;
+		dataFileSystematicsMap[pci.dataSteeringFile.GetFilename()]=vsyst;
 
                 if (steeringFile->ShowIndividualSystematics()!=0) {
 
@@ -3759,12 +4425,6 @@ void SPXPlot::DrawBand(SPXPDF *pdf, std::string option, SPXPlotConfigurationInst
   }
  }
 
- double edgecolor  =pci.totalEdgeColor;
- double edgestyle  =pci.totalEdgeStyle;
- double fillcolor  =pci.totalFillColor;
- double fillstyle  =pci.totalFillStyle;
- double markerstyle=pci.totalMarkerStyle;
-
  std::vector < TGraphAsymmErrors *> graphs;
 
  for (int iband=0; iband<nbands; iband++) {
@@ -3777,6 +4437,20 @@ void SPXPlot::DrawBand(SPXPDF *pdf, std::string option, SPXPlotConfigurationInst
   graphs.push_back(gband);
  }
 
+ this->DrawBands(graphs, option, pci);
+}
+
+//Draws bands with the style of their type (found in the band name) given in pci: largest band first
+void SPXPlot::DrawBands(std::vector<TGraphAsymmErrors *> graphs, std::string option, SPXPlotConfigurationInstance pci) {
+ std::string mn = "DrawBands: ";
+ if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+ double edgecolor  =pci.totalEdgeColor;
+ double edgestyle  =pci.totalEdgeStyle;
+ double fillcolor  =pci.totalFillColor;
+ double fillstyle  =pci.totalFillStyle;
+ double markerstyle=pci.totalMarkerStyle;
+
  // order bands for better plotting
  std::map<int, TGraphAsymmErrors * > bands=  SPXUtilities::OrderBandMap(graphs);
 
@@ -3849,8 +4523,8 @@ void SPXPlot::DrawBand(SPXPDF *pdf, std::string option, SPXPlotConfigurationInst
                               <<" fillcolor= "<<fillcolor<<" fillstyle= "<<fillstyle<<std::endl;
  
   if (edgecolor!=0) { // 0 is default in SPXPlotConfiguration.h
-   TH1D *hedgelow =SPXGraphUtilities::GetEdgeHistogram(gband,true);
-   TH1D *hedgehigh=SPXGraphUtilities::GetEdgeHistogram(gband,false);
+   TH1D *hedgelow =drawArena->Adopt(SPXGraphUtilities::GetEdgeHistogram(gband,true));
+   TH1D *hedgehigh=drawArena->Adopt(SPXGraphUtilities::GetEdgeHistogram(gband,false));
    hedgelow ->SetLineColor(abs(edgecolor));
    hedgehigh->SetLineColor(abs(edgecolor));
    if (edgestyle!=-1) { // -1 is default in SPXPlotConfiguration.h
@@ -3965,11 +4639,13 @@ void SPXPlot::WriteRootFile(TString rootfilename){
  std::string mn = "WriteRootFile: ";
  if (debug) SPXUtilities::PrintMethodHeader(cn, mn);
 
+ SPXStageScope stage("write");
+
  rootfile=0;
  
  if (debug) std::cout<<cn<<mn<<"Output rootfile "<<rootfilename<<std::endl;
 
- rootfile= new TFile(rootfilename,"recreate");
+ rootfile= drawArena->Adopt(new TFile(rootfilename,"recreate"));
  if (!rootfile) {
 
   std::cout<<cn<<mn<<"Problem to open rootfile= "<<rootfilename.Data()<<std::endl;
@@ -4070,6 +4746,38 @@ void SPXPlot::WriteRootFile(TString rootfilename){
    std::cout<<"Write AlphaS component "<<hcomp->GetName()<<std::endl;
    hcomp->Write();
   }
+
+  std::vector<TGraphAsymmErrors *> vsweep=this->GetBeamEnergySweepGraphs(icross);
+  for (int isweep=0; isweep<vsweep.size(); isweep++) {
+   if (debug) std::cout<<cn<<mn<<"Write beam energy sweep "<<vsweep.at(isweep)->GetName()<<std::endl;
+   vsweep.at(isweep)->Write();
+   delete vsweep.at(isweep);
+  }
+
+  // PDF band at the alternative scale choice: relative band times the nominal as plotted
+  TGraphAsymmErrors *galtratio=pdf->GetAlternativeScaleChoicePDFRatio();
+  TGraphAsymmErrors *gnom=pdf->GetTotalBand();
+  if (galtratio && gnom) {
+   // only the nominal points with a ratio point at the same x
+   TGraphAsymmErrors *galt=new TGraphAsymmErrors();
+   galt->SetName(galtratio->GetName());
+   for (int ibin=0; ibin<gnom->GetN(); ibin++) {
+    double x=0., y=0.;
+    gnom->GetPoint(ibin,x,y);
+    int jbin=-1;
+    for (int j=0; jbin<0 && j<galtratio->GetN(); j++) {
+     if (x>=galtratio->GetX()[j]-galtratio->GetErrorXlow(j) && x<galtratio->GetX()[j]+galtratio->GetErrorXhigh(j)) jbin=j;
+    }
+    if (jbin<0) continue;
+    int n=galt->GetN();
+    galt->SetPoint(n,x,y*galtratio->GetY()[jbin]);
+    galt->SetPointError(n,gnom->GetErrorXlow(ibin),gnom->GetErrorXhigh(ibin),
+                        y*galtratio->GetErrorYlow(jbin),y*galtratio->GetErrorYhigh(jbin));
+   }
+   if (debug) std::cout<<cn<<mn<<"Write alternative scale choice PDF band "<<galt->GetName()<<std::endl;
+   galt->Write();
+   delete galt;
+  }
  }
 
  if(debug) {
@@ -4177,6 +4885,64 @@ void SPXPlot::WriteRootFile(TString rootfilename){
  return;
 }
 
+//Writes all per-bin results of this plot as one table: ./plots/<desc>_table.<csv|root>
+void SPXPlot::WriteResultsTable(void){
+ std::string mn = "WriteResultsTable: ";
+ if (debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+ SPXStageScope stage("write");
+
+ SPXPlotConfiguration &pc = steeringFile->GetPlotConfiguration(id);
+ std::string format=steeringFile->GetOutputTableFormat();
+
+ TString tablefilename=GetROOTFilename(pc.GetDescription());
+ tablefilename.ReplaceAll(".root",TString("_table.")+format.c_str());
+
+ SPXResultsTable table(data, crossSections);
+ table.Write(std::string(tablefilename.Data()), format);
+ outputFiles.push_back(std::string(tablefilename.Data()));
+}
+
+//Writes all results of this plot (table columns, chi2 and ratios) in canonical form: <dump directory>/<desc>_plot_<id>.csv
+void SPXPlot::WriteDump(void){
+ std::string mn = "WriteDump: ";
+ if (debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+ SPXStageScope stage("write");
+
+ SPXPlotConfiguration &pc = steeringFile->GetPlotConfiguration(id);
+
+ std::string desc=pc.GetDescription();
+ if (desc.empty()) desc="general";
+
+ std::ostringstream filename;
+ filename<<Options::DumpDirectory<<"/"<<desc<<"_plot_"<<id<<".csv";
+
+ SPXResultsTable table(data, crossSections);
+
+ for (int icross=0; icross<crossSections.size(); icross++) {
+  int idata;
+  double chi2;
+  if (!GetChi2(icross, idata, chi2)) continue;
+
+  std::ostringstream name;
+  name<<"xsec"<<icross<<"_chi2_data"<<idata;
+  table.AddScalar(name.str(), chi2);
+ }
+
+ for (int iratio=0; iratio<ratios.size(); iratio++) {
+  std::vector<TGraphAsymmErrors *> graphs=ratios.at(iratio).GetRatioGraph();
+  for (int igraph=0; igraph<graphs.size(); igraph++) {
+   std::ostringstream name;
+   name<<"ratio"<<iratio<<"_"<<igraph;
+   table.AddGraph(name.str(), graphs.at(igraph));
+  }
+ }
+
+ table.WriteCanonical(filename.str());
+ outputFiles.push_back(filename.str());
+}
+
 void SPXPlot::SetSystGraphProperties(TGraphAsymmErrors * gsyst, Color_t icol){
  std::string mn = "SetSystGraphProperties: ";
  if (debug) SPXUtilities::PrintMethodHeader(cn, mn);
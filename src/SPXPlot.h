@@ -18,6 +18,7 @@
 #include <vector>
 #include <set>
 #include <map>
+#include <sstream>
 
 // if set timer is on
 //#define TIMER
@@ -41,6 +42,11 @@
 
 #include "SPXLatexTable.h"
 #include "SPXChi2.h"
+#include "SPXResultsTable.h"
+#include "SPXPartonLuminosity.h"
+#include "SPXParameterScan.h"
+#include "SPXArena.h"
+#include "SPXOutputManager.h"
 
 #include "SPXException.h"
 
@@ -51,12 +57,21 @@ public:
 		this->steeringFile = steeringFile;
 		this->id = plotNumber;
 
+		std::ostringstream oss;
+		oss << "plot_" << plotNumber;
+		this->arena = new SPXArena(oss.str());
+		this->ratioArena = new SPXArena(oss.str() + "_ratios");
+		this->drawArena = 0;
+
 		if(debug) {
 		 SPXData::SetDebug(true);
 		 SPXDataFormat::SetDebug(true);
 		 SPXCrossSection::SetDebug(true);
 		 SPXGridCorrections::SetDebug(true);
 		 SPXRatio::SetDebug(true);
+		 SPXRatioExpression::SetDebug(true);
+		 SPXArena::SetDebug(true);
+		 SPXOutputManager::SetDebug(true);
 #ifdef DEVELOP
 		 SPXGlobalCorrelation::SetDebug(true);
 		 //SPXSummaryFigures::SetDebug(true); \\will introduce loop
@@ -71,6 +86,13 @@ public:
 
 	void Initialize(void);
 	void Plot(void);
+	void Process(void);
+	void Release(void);
+
+	//--watch: an initialized plot is re-pointed at a re-read steering file, and its ratios
+	// can be rebuilt, without redoing its data and convolutions
+	void Reconfigure(void);
+	void RebuildRatios(void);
 
 	//Helper methods //@TODO Public or private?
 	void SetAxisLabels(void);
@@ -88,10 +110,14 @@ public:
 	void DrawRatio(void);
 	void PreparationDrawRatio(void);
 	void DrawBand(SPXPDF *pdf, std::string option, SPXPlotConfigurationInstance pc);
+	void DrawBands(std::vector<TGraphAsymmErrors *> graphs, std::string option, SPXPlotConfigurationInstance pci);
 	void DrawLegend();
 	void UpdateCanvas(void);
 	void CanvasToPNG(void);
 	std::string GetPNGFilename(std::string desc);
+	std::string GetROOTFilename(std::string desc);
+	void PrintChi2(void);
+	bool GetChi2(int icross, int &idata, double &chi2);
 
 	void StaggerConvoluteOverlay(void);
 	void StaggerConvoluteRatio(void);
@@ -102,6 +128,11 @@ public:
 
         void DrawBox(void);
 
+	//Files written by Plot/Process for this plot
+	const std::vector<std::string> & GetOutputFiles(void) const {
+		return outputFiles;
+	}
+
 	static bool GetDebug(void) {
 		return debug;
 	}
@@ -120,9 +151,16 @@ private:
 	static bool debug;					// Flag indicating debug mode
 	SPXSteeringFile *steeringFile;				// Fully parsed steering file
 	unsigned int id;					// Plot number ID (0-based)
+	SPXArena *arena;					// Owns the data and convolutions of this plot (shared by copies, deleted by Release)
+	SPXArena *ratioArena;					// Owns the ratio graphs (replaced by RebuildRatios)
+	SPXArena *drawArena;					// Owns the canvas, frames, legends and ROOT file of the last Plot/Process
+
+        void ReleaseDrawing(void);
 
         TFile *rootfile; // pointer to root file
 
+        std::vector<std::string> outputFiles; // all files written for this plot
+
         TLegend *leg;     // Legend
         TLegend *leginfo; // Legend info
         
@@ -144,6 +182,7 @@ private:
 	StringPairPDFMap_T convoluteFilePDFMap;
 
 	StringLabelMap_T dataFileLabelMap; // stores label of data
+	StringGraphVectorMap_T dataFileSystematicsMap; // individual systematics of each data file
 
 	//Sets used for eliminating duplicate data/cross section plots, since
 	// different plot configuration instances could share a data/cross section, and we
@@ -173,6 +212,7 @@ private:
 	double xMaxRatio;
 	double yMinRatio;
 	double yMaxRatio;
+	SPXGraphBounds_t overlayBounds;	//Extent of the overlay graphs (log-safe minima of the frame)
 
 	void InitializeData(void);
 	void InitializeCrossSections(void);
@@ -185,6 +225,16 @@ private:
         TString FormatwithExp(double xinput);
 
         void WriteRootFile(TString rootfilename);
+        void WriteResultsTable(void);
+        void WriteDump(void);
+        void PlotPdfBands(bool draw);
+        void PlotPartonLuminosity(bool draw);
+        void DrawBandPage(const std::string &suffix, const std::vector<std::string> &titles, const std::vector<std::vector<TGraphAsymmErrors *> > &bands,
+                          const std::vector<int> &instances, const std::vector<std::string> &names, const std::string &xtitle, const std::string &ytitle,
+                          bool logx, bool divide, bool draw);
+        void ScanParameter(void);
+        std::vector<TGraphAsymmErrors *> GetBeamEnergySweepGraphs(int icross);
+        void DrawBeamEnergySweep(void);
         void OrderSystVectorColorsByAlphabeth(std::vector<TGraphAsymmErrors *> vsyst);
         void SetSystGraphProperties(TGraphAsymmErrors * gsyst, Color_t icol);
 
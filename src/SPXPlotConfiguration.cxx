@@ -1513,6 +1513,15 @@ void SPXPlotConfiguration::Parse(std::map<std::string, std::vector<std::string>
         myopt.push_back("x_info_legend");
         myopt.push_back("y_info_legend");
 
+        myopt.push_back("luminosity_mass_min");
+        myopt.push_back("luminosity_mass_max");
+        myopt.push_back("luminosity_mass_points");
+        myopt.push_back("luminosity_sqrt_s");
+
+        myopt.push_back("pdf_band_x_min");
+        myopt.push_back("pdf_band_x_max");
+        myopt.push_back("pdf_band_x_points");
+
         for (int i=0; i<myopt.size(); i++) {
 	 std::string name=myopt.at(i);
          if (options.count(name)>0) {
@@ -1535,6 +1544,48 @@ void SPXPlotConfiguration::Parse(std::map<std::string, std::vector<std::string>
 	overlayStyle = SPXOverlayStyle(options["overlay_style"].at(0));
 	ratioTitle = options["ratio_title"].at(0);
 
+	if(options.count("parton_luminosity") > 0) {
+		partonLuminosities = options["parton_luminosity"];
+
+		for(int i = 0; i < partonLuminosities.size(); i++) {
+			std::string &channel = partonLuminosities.at(i);
+			if(channel.compare("gg") && channel.compare("qqbar") && channel.compare("qg")) {
+				throw SPXParseException(cn + mn + "Unknown parton_luminosity \"" + channel + "\": Must be gg, qqbar or qg");
+			}
+		}
+	}
+
+	if(options.count("pdf_bands") > 0) {
+		pdfBandFlavours = options["pdf_bands"];
+
+		//Flavour names of SPXPDF::GetFlavourName
+		const char *names[] = {"tbar", "bbar", "cbar", "sbar", "ubar", "dbar", "g", "d", "u", "s", "c", "b", "t", 0};
+
+		for(int i = 0; i < pdfBandFlavours.size(); i++) {
+			const std::string &flavour = pdfBandFlavours.at(i);
+			bool known = false;
+			for(int k = 0; names[k]; k++) {
+				if(!flavour.compare(names[k])) known = true;
+			}
+			if(!known) {
+				throw SPXParseException(cn + mn + "Unknown pdf_bands flavour \"" + flavour + "\": Must be one of tbar, bbar, cbar, sbar, ubar, dbar, g, d, u, s, c, b, t");
+			}
+		}
+
+		//Default scale: Q2 = 100 GeV^2
+		if(options.count("pdf_band_q2") > 0) {
+			for(int i = 0; i < options["pdf_band_q2"].size(); i++) {
+				double q2 = SPXStringUtilities::StringToNumber<double>(options["pdf_band_q2"].at(i));
+				if(q2 <= 0.) {
+					throw SPXParseException(cn + mn + "pdf_band_q2 values must be positive");
+				}
+				pdfBandQ2.push_back(q2);
+			}
+		} else {
+			pdfBandQ2.push_back(100.);
+		}
+	}
+
 	//Parse the ratio_style vector if the display style contains 'ratio'
 	if (debug) std::cout << cn << mn << "Loop over ratio_style" << std::endl;
 	if(displayStyle.ContainsRatio()) {
@@ -477,6 +477,20 @@ public:
 		return ratioTitle;
 	}
 
+	//Parton luminosity channels (gg, qqbar, qg) to draw next to this plot
+	const std::vector<std::string> & GetPartonLuminosities(void) const {
+		return partonLuminosities;
+	}
+
+	//Flavours (g, u, dbar, ...) and Q2 values of the PDF-vs-x bands to draw next to this plot
+	const std::vector<std::string> & GetPdfBandFlavours(void) const {
+		return pdfBandFlavours;
+	}
+
+	const std::vector<double> & GetPdfBandQ2(void) const {
+		return pdfBandQ2;
+	}
+
 	unsigned int GetNumberOfRatios(void) const {
 		return ratios.size();
 	}
@@ -547,6 +561,8 @@ public:
 	}
 
 
+	friend class SPXSteeringBundle;
+
 private:
 	static bool debug;
 	unsigned int id;
@@ -559,6 +575,9 @@ private:
 	std::string ratioTitle;
 	std::vector<SPXRatioStyle> ratioStyles;
 	std::vector<std::string> ratios;
+	std::vector<std::string> partonLuminosities;
+	std::vector<std::string> pdfBandFlavours;
+	std::vector<double> pdfBandQ2;
 
         std::map<std::string,double> plotoptions;
 
@@ -577,6 +596,9 @@ private:
 		ratioTitle.clear();
 		ratioStyles.clear();
 		ratios.clear();
+		partonLuminosities.clear();
+		pdfBandFlavours.clear();
+		pdfBandQ2.clear();
 		configurationInstances.clear();
 	}
 };
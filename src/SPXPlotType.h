@@ -185,6 +185,8 @@ public:
 		return false;
 	}
 
+	friend class SPXSteeringBundle;
+
 private:
 	static bool debug;
 	unsigned int type;
@@ -13,6 +13,8 @@
 //
 //************************************************************/
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <sstream>
 
@@ -52,6 +54,13 @@ void SPXRatio::Parse(std::string &s) {
 
     if(debug) std::cout << cn << mn << "Parsing ratio string: " << s << std::endl;
 
+    CompilePlan();
+
+    if(ratioStyle.IsExpression()) {
+        ParseExpression(s);
+        return;
+    }
+
     //Check for special cases (data stat and data tot)
     if(ratioStyle.IsDataStat()) {
         //Check for alias
@@ -422,66 +431,58 @@ void SPXRatio::Divide(void) {
  std::string mn = "Divide: ";
  if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
 
- //Grab the plot configuration instance
- SPXPlotConfigurationInstance pci;
-
  if(debug) std::cout <<cn<<mn<< "Starting " << std::endl;
 
- if(ratioStyle.IsDataStat()) {
-  try {
-
-   TGraphAsymmErrors *graph = SPXGraphUtilities::Divide(numeratorGraph.back(), denominatorGraph, ZeroDenGraphErrors);
-   graph->SetFillStyle(dataGraphFillStyle);
-   graph->SetFillColor(dataGraphFillColor);
-   ratioGraph.push_back(graph);
-
-   if(debug) std::cout<<cn<<mn<< "Successfully divided data stat graph with options: " << std::endl;
-   if(debug) std::cout<< "\t Fill Style = " << dataGraphFillStyle << std::endl;
-   if(debug) std::cout<< "\t Fill Color = " << dataGraphFillStyle << std::endl;
-  } catch(const SPXException &e) {
-   std::cerr << e.what() << std::endl;
-   throw SPXGraphException(cn + mn + "Unable to divide data stat graphs");
-  }
-
+ if(plan.numerator == RatioOperandExpression) {
+  std::string name = "ratio_" + SPXStringUtilities::RemoveCharacters(ratioString, " ");
+  AddRatioGraph(expression.Evaluate(name));
   return;
+ }
 
- } else if(ratioStyle.IsDataTot()) {
+ //Data stat and data tot: the data graph over itself
+ if(plan.sameData) {
   try {
 
-   TGraphAsymmErrors *graph = SPXGraphUtilities::Divide(numeratorGraph.back(), denominatorGraph, ZeroDenGraphErrors);
+   TGraphAsymmErrors *graph = SPXGraphUtilities::Divide(numeratorGraph.back(), denominatorGraph, plan.errors);
    graph->SetFillStyle(dataGraphFillStyle);
    graph->SetFillColor(dataGraphFillColor);
-   ratioGraph.push_back(graph);
+   AddRatioGraph(graph);
 
-   if(debug) std::cout<<cn<<mn<<"Successfully divided data tot graph with options: " << std::endl;
+   if(debug) std::cout<<cn<<mn<<"Successfully divided "<<ratioStyle.ToString()<<" graph with options: " << std::endl;
    if(debug) std::cout<< "\t Fill Style = " << dataGraphFillStyle << std::endl;
    if(debug) std::cout<< "\t Fill Color = " << dataGraphFillColor << std::endl;
 
   } catch(const SPXException &e) {
    std::cerr << e.what() << std::endl;
-   throw SPXGraphException(cn + mn + "Unable to divide data tot graphs");
+   throw SPXGraphException(cn + mn + "Unable to divide " + ratioStyle.ToString() + " graphs");
   }
 
   return;
  }
 
- if(ratioStyle.IsConvoluteOverData() || ratioStyle.IsConvoluteOverReference() || ratioStyle.IsConvoluteOverNominal()) {
+ bool dataNumerator = (plan.numerator == RatioOperandData);
+ bool dataOverData = dataNumerator && (plan.denominator == RatioOperandData);
+ bool dataOverConvolute = dataNumerator && (plan.denominator == RatioOperandConvoluteTotal);
 
-  pci = plotConfiguration.GetPlotConfigurationInstance(numeratorConvolutePDFFile);
+ //Convolute over data, reference or nominal
+ if(plan.numerator == RatioOperandConvolute && plan.denominator != RatioOperandConvoluteTotal) {
+
+  //Throws if the convolute is not part of the plot
+  SPXPlotConfigurationInstance &pci = GetPlotConfiguration().GetPlotConfigurationInstance(numeratorConvolutePDFFile);
 
   if(debug) {
    pci.Print();
   }
 
   //Match the convolute binning to the data binning
-  if(ratioStyle.IsConvoluteOverData()) {
+  if(plan.denominator == RatioOperandData) {
 
    if (debug) std::cout<<cn<<mn<<"ratioStyle.IsConvoluteOverData "<<std::endl;
 
    if (numeratorGraph.size()==0)
     throw SPXGraphException(cn + mn + "No numeratorGraph found !");
 
-   //plotConfiguration.GetPlotConfigurationInstance(index).SteeringFile;
+   //GetPlotConfiguration().GetPlotConfigurationInstance(index).SteeringFile;
 
    if (MatchBinning) {
     if (debug) {
@@ -512,8 +513,8 @@ void SPXRatio::Divide(void) {
     }
    }
   }
- } else if(ratioStyle.IsDataOverConvolute()) {
-  pci = plotConfiguration.GetPlotConfigurationInstance(denominatorConvolutePDFFile);
+ } else if(dataOverConvolute) {
+  SPXPlotConfigurationInstance &pci = GetPlotConfiguration().GetPlotConfigurationInstance(denominatorConvolutePDFFile);
   if(debug) {
    pci.Print();
   }
@@ -546,7 +547,7 @@ void SPXRatio::Divide(void) {
   }
  }
 //
- else if(ratioStyle.IsDataOverData()) {
+ else if(dataOverData) {
 
   if (debug) {
    std::cout<<cn<<mn<<"ratioStyle.IsDataOverData() "<<std::endl;
@@ -642,13 +643,7 @@ void SPXRatio::Divide(void) {
     throw SPXGraphException(cn + mn + "ratioStyle DataOverData Unable to match data binning to data binning");
    }
   }
- } else if (ratioStyle.IsConvoluteOverNominal()) {
-  if (debug) std::cout<<cn<<mn<<" ratioStyle.IsConvoluteOverNominal "<<std::endl;
-
-  std::cout<<cn<<mn<<" ratioStyle.IsConvoluteOverNominal() nothing implemented yet "<<std::endl;
-  throw SPXGraphException(cn + mn + "ratioStyle.IsConvoluteOverNominal() nothing implemented yet");
-
- } else if(ratioStyle.IsConvoluteOverConvolute()) { 
+ } else if(plan.numerator == RatioOperandConvolute && plan.denominator == RatioOperandConvoluteTotal) {
   if (debug) std::cout<<cn<<mn<<"HUHU ratiostyle is convolute / convolute  "<<std::endl;
 
   if (numeratorGraph.size()==0)
@@ -681,22 +676,8 @@ void SPXRatio::Divide(void) {
  }
  
  try {
-  //Determine how to divide based on ratioStyle: zeroNumErrors/zeroDenErrors set with '!'
-  DivideErrorType_t divideType;
-
-  if (ratioStyle.GetZeroNumeratorErrors() && ratioStyle.GetZeroDenominatorErrors()) {
-   if (debug) std::cout<<cn<<mn<<"Zero all error "<<std::endl;
-   divideType = ZeroAllErrors;
-  } else if (ratioStyle.GetZeroNumeratorErrors()) {
-   if (debug) std::cout<<cn<<mn<<"Zero numerator error "<<std::endl;
-   divideType = ZeroNumGraphErrors;
-  } else if (ratioStyle.GetZeroDenominatorErrors()) {
-   if (debug) std::cout<<cn<<mn<<"Zero denominator error "<<std::endl;
-   divideType = ZeroDenGraphErrors;
-  } else {
-   if (debug) std::cout<<cn<<mn<<"Add errors "<<std::endl;
-   divideType = AddErrors;
-  }
+  //Error model from the plan: zeroNumErrors/zeroDenErrors set with '!'
+  DivideErrorType_t divideType = plan.errors;
 
   //Divide graphs
   if (debug) std::cout<<cn<<mn<<"Now divide graph "<<std::endl;
@@ -722,11 +703,6 @@ void SPXRatio::Divide(void) {
                <<" denominatorGraph= "<<denominatorGraph->GetName()
                <<" nbin= "<<denominatorGraph->GetN()
                <<" divideType= "<<divideType<<std::endl;
-
-     std::cout <<cn<<mn<<"numeratorGraph["<<i<<"]= "<<numeratorGraph[i]->GetName()
-               <<" denominatorGraph= "<<denominatorGraph->GetName()<<" divideType= "<<divideType<<std::endl;
- 
-     //SPXGraphUtilities::SPXPrintGraphProperties((TGraphErrors*)numeratorGraph[i]);
    }
 
    if ( numeratorGraph[i]->GetN()!=denominatorGraph->GetN()) {
@@ -749,20 +725,39 @@ void SPXRatio::Divide(void) {
 
     }
    }
+  }
 
-   TGraphAsymmErrors *graph = SPXGraphUtilities::Divide(numeratorGraph[i], denominatorGraph,divideType); 
-   if (!graph) throw SPXGraphException(cn + mn + "Ratio Graph not found !");
-  
-   if (debug) {
+  //Predictions sharing PDF members: member by member, otherwise all bands against
+  // the one denominator in a single pass
+  std::vector<TGraphAsymmErrors *> graphs;
+  bool correlated = false;
+  if (plan.numerator == RatioOperandConvolute && plan.denominator == RatioOperandConvoluteTotal && divideType == AddErrors) {
+   correlated = DivideCorrelatedConvolutes(graphs);
+  }
+
+  if (!correlated) {
+   graphs = SPXGraphUtilities::DivideBands(numeratorGraph, denominatorGraph, divideType);
+  }
+
+  //Data sharing systematics: the systematics of the same name are correlated
+  if (dataOverData && divideType == AddErrors && graphs.size() == 1) {
+   CorrelateDataSystematics(graphs[0]);
+  }
+
+  if (debug) {
+   for (int i=0; i<graphs.size(); i++) {
     std::cout<<cn+mn+"After Divide numeratorGraph["<<i<<"]/denominatorGraph "<<numeratorGraph[i]->GetName()<< std::endl;
-    SPXGraphUtilities::SPXPrintGraphProperties((TGraphErrors*)graph);
-    graph->Print();
+    SPXGraphUtilities::SPXPrintGraphProperties((TGraphErrors*)graphs[i]);
+    graphs[i]->Print();
    }
-   ratioGraph.push_back(graph);
+  }
+
+  for (int i=0; i<graphs.size(); i++) {
+   AddRatioGraph(graphs[i]);
   }
 
   // add statistical error from Data as separate graph 
-  if (ratioStyle.IsDataOverConvolute() || ratioStyle.IsDataOverData()) {
+  if (dataNumerator) {
 
    if (debug) std::cout<<cn<<mn<<"Number of numeratorGraphstatonly= "<<numeratorGraphstatonly.size()<<std::endl;
    if (numeratorGraphstatonly.size()==0) std::cout<<cn<<mn<<"WARNING No statistical ratio graphs found !"<<std::endl;
@@ -777,7 +772,7 @@ void SPXRatio::Divide(void) {
     }
 
     TGraphAsymmErrors *graph =0;
-    if (ratioStyle.IsDataOverData()) {
+    if (dataOverData) {
      if (!denominatorGraphstatonly) {
       std::ostringstream oss;
       oss << "denominatorGraphstatonly was not found !";
@@ -795,7 +790,7 @@ void SPXRatio::Divide(void) {
 
     }
 
-    if (ratioStyle.IsDataOverConvolute()) {
+    if (dataOverConvolute) {
       graph = SPXGraphUtilities::Divide(numeratorGraphstatonly[i], denominatorGraph,divideType); 
     }
  
@@ -814,6 +809,31 @@ void SPXRatio::Divide(void) {
  }
 }
 
+void SPXRatio::AddRatioGraph(TGraphAsymmErrors *graph) {
+ ratioGraph.push_back(graph);
+ SPXGraphUtilities::ExtendBounds(bounds, SPXGraphUtilities::GetBounds(graph));
+}
+
+//Recomputes the extent of the ratio graphs after they were changed in place (staggering)
+void SPXRatio::UpdateBounds(void) {
+ bounds=SPXGraphUtilities::GetEmptyBounds();
+
+ for (int i=0; i<ratioGraph.size(); i++) {
+  SPXGraphUtilities::ExtendBounds(bounds, SPXGraphUtilities::GetBounds(ratioGraph[i]));
+ }
+}
+
+//Hands the ratio graphs made by Divide over to the arena of the plot
+void SPXRatio::AdoptGraphs(SPXArena *arena) {
+ for (int i=0; i<ratioGraph.size(); i++) {
+  arena->Adopt(ratioGraph[i]);
+ }
+
+ for (int i=0; i<ratioGraphstatonly.size(); i++) {
+  arena->Adopt(ratioGraphstatonly[i]);
+ }
+}
+
 //Checks the 'original' string to see whether it contains an alias, and attempts to
 // resolve that alias based on the alias type
 std::string SPXRatio::CheckForAlias(std::string &original, const std::string alias_type) {
@@ -853,18 +873,18 @@ std::string SPXRatio::CheckForAlias(std::string &original, const std::string ali
 
   try {
    if(!alias_type.compare("data")) {
-    alias = plotConfiguration.GetPlotConfigurationInstance(index).dataSteeringFile.GetFilename();
-    dataDirectory = plotConfiguration.GetPlotConfigurationInstance(index).dataDirectory;
+    alias = GetPlotConfiguration().GetPlotConfigurationInstance(index).dataSteeringFile.GetFilename();
+    dataDirectory = GetPlotConfiguration().GetPlotConfigurationInstance(index).dataDirectory;
    } else if(!alias_type.compare("grid")) {
-    alias = plotConfiguration.GetPlotConfigurationInstance(index).gridSteeringFile.GetFilename();
-    gridDirectory = plotConfiguration.GetPlotConfigurationInstance(index).gridDirectory;
+    alias = GetPlotConfiguration().GetPlotConfigurationInstance(index).gridSteeringFile.GetFilename();
+    gridDirectory = GetPlotConfiguration().GetPlotConfigurationInstance(index).gridDirectory;
     // special case if the same grid directory is given
     // In this case key name is _i (see SPXPlot::InitializeCrossSections)
 
     if (index>0) { 
      bool doubleentry=false;
      for (int i=0; i<index; i++) {
-      std::string aliasold = plotConfiguration.GetPlotConfigurationInstance(i).gridSteeringFile.GetFilename();
+      std::string aliasold = GetPlotConfiguration().GetPlotConfigurationInstance(i).gridSteeringFile.GetFilename();
       if (alias==aliasold) {
        doubleentry=true;
        std::cout<<cn<<mn<<"Double entry in grid directories for index= "<<i<<" "<<alias.c_str()<<std::endl;
@@ -879,8 +899,8 @@ std::string SPXRatio::CheckForAlias(std::string &original, const std::string ali
      }
     }
    } else if(!alias_type.compare("pdf")) {
-    alias = plotConfiguration.GetPlotConfigurationInstance(index).pdfSteeringFile.GetFilename();
-    pdfDirectory = plotConfiguration.GetPlotConfigurationInstance(index).pdfDirectory;
+    alias = GetPlotConfiguration().GetPlotConfigurationInstance(index).pdfSteeringFile.GetFilename();
+    pdfDirectory = GetPlotConfiguration().GetPlotConfigurationInstance(index).pdfDirectory;
    }
 
    if(debug) std::cout << cn << mn << "Successfully aliased \"" << original << "\" to " << alias << std::endl;
@@ -904,6 +924,10 @@ void SPXRatio::AddDataFileLabelMap(StringLabelMap_T &dataFileLabelMap) {
  this->dataFileLabelMap = &dataFileLabelMap;
 }
 
+void SPXRatio::AddDataFileSystematicsMap(StringGraphVectorMap_T &dataFileSystematicsMap) {
+ this->dataFileSystematicsMap = &dataFileSystematicsMap;
+}
+
 void SPXRatio::AddReferenceFileGraphMap(StringPairGraphMap_T &referenceFileGraphMap) {
  this->referenceFileGraphMap = &referenceFileGraphMap;
 }
@@ -920,646 +944,575 @@ void SPXRatio::AddConvoluteFilePDFMap(StringPairPDFMap_T &convoluteFilePDFMap) {
  this->convoluteFilePDFMap = &convoluteFilePDFMap;
 }
 
-void SPXRatio::GetGraphs(void) {
- std::string mn = "GetGraphs: ";
- if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+//Compiles the ratio style into the operands and the error model of the division
+void SPXRatio::CompilePlan(void) {
+ std::string mn = "CompilePlan: ";
+
+ plan.sameData = false;
+
+ if(ratioStyle.IsExpression()) {
+  plan.numerator   = RatioOperandExpression;
+  plan.denominator = RatioOperandExpression;
+ } else if(ratioStyle.IsDataStat() || ratioStyle.IsDataTot()) {
+  plan.numerator   = RatioOperandData;
+  plan.denominator = RatioOperandData;
+  plan.sameData    = true;
+ } else if(ratioStyle.IsConvoluteOverReference()) {
+  plan.numerator   = RatioOperandConvolute;
+  plan.denominator = RatioOperandReference;
+ } else if(ratioStyle.IsConvoluteOverNominal()) {
+  plan.numerator   = RatioOperandConvolute;
+  plan.denominator = RatioOperandNominal;
+ } else if(ratioStyle.IsDataOverConvolute()) {
+  plan.numerator   = RatioOperandData;
+  plan.denominator = RatioOperandConvoluteTotal;
+ } else if(ratioStyle.IsConvoluteOverData()) {
+  plan.numerator   = RatioOperandConvolute;
+  plan.denominator = RatioOperandData;
+ } else if(ratioStyle.IsDataOverData()) {
+  plan.numerator   = RatioOperandData;
+  plan.denominator = RatioOperandData;
+ } else if(ratioStyle.IsConvoluteOverConvolute()) {
+  plan.numerator   = RatioOperandConvolute;
+  plan.denominator = RatioOperandConvoluteTotal;
+ } else {
+  throw SPXParseException(cn + mn + "Unknown ratio style: " + ratioStyle.ToString());
+ }
 
- SPXOverlayStyle &os = plotConfiguration.GetOverlayStyle();
+ //The data itself is shown with its own uncertainty only
+ if(plan.sameData) {
+  plan.errors = ZeroDenGraphErrors;
+ } else if(ratioStyle.GetZeroNumeratorErrors() && ratioStyle.GetZeroDenominatorErrors()) {
+  plan.errors = ZeroAllErrors;
+ } else if(ratioStyle.GetZeroNumeratorErrors()) {
+  plan.errors = ZeroNumGraphErrors;
+ } else if(ratioStyle.GetZeroDenominatorErrors()) {
+  plan.errors = ZeroDenGraphErrors;
+ } else {
+  plan.errors = AddErrors;
+ }
 
- if(debug) std::cout<<cn<<mn<<"Ratio style is: " << ratioStyle.ToString() << " (" << ratioStyle.GetNumerator() \
-                     << " / " << ratioStyle.GetDenominator() << ")" << std::endl;
+ if(debug) std::cout << cn << mn << ratioStyle.ToString() << ": numerator= " << plan.numerator << " denominator= " << plan.denominator
+                     << " errors= " << plan.errors << std::endl;
+}
 
- if(ratioStyle.IsDataStat() || ratioStyle.IsDataTot()) {
+//Compiles a ratio expression and resolves the aliases and directories of its terms
+void SPXRatio::ParseExpression(std::string &s) {
+ std::string mn = "ParseExpression: ";
+ if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
 
-  if(!os.ContainsData()) {
-   throw SPXGraphException(cn + mn + "Overlay Style does NOT contain \"data\", yet a ratio with data is specified: " + ratioStyle.ToString());
-  }
+ expression.Compile(s);
+ ratioString = s;
 
-  std::string key = numeratorDataFile;
-  if(debug) std::cout << cn << mn << "Key = [" << key << "]" << std::endl;
+ for(int i = 0; i < expression.GetNumberOfTerms(); i++) {
+  SPXRatioTerm_t &term = expression.GetTerm(i);
 
-  //Check for existence of data key
-  if(dataFileGraphMap->count(key) == 0) {
-   PrintDataFileGraphMapKeys(std::cerr);
+  if(term.type == RatioTermData) {
+   std::string alias = CheckForAlias(term.data, "data");
+   term.data = (!term.data.compare(alias)) ? dataDirectory + "/" + term.data : alias;
 
-   std::ostringstream oss;
-   oss << "dataFileGraphMap[" << key << "] was not found: Invalid key";
-   throw SPXGraphException(cn + mn + oss.str());
+   if(debug) std::cout << cn << mn << "Term " << i << ": data " << term.data << std::endl;
+  } else {
+   std::string gridAlias = CheckForAlias(term.grid, "grid");
+   std::string pdfAlias = CheckForAlias(term.pdf, "pdf");
+   term.grid = (!term.grid.compare(gridAlias)) ? gridDirectory + "/" + term.grid : gridAlias;
+   term.pdf = (!term.pdf.compare(pdfAlias)) ? pdfDirectory + "/" + term.pdf : pdfAlias;
+
+   if(debug) std::cout << cn << mn << "Term " << i << ": convolute [" << term.grid << ", " << term.pdf << "]" << std::endl;
   }
+ }
+}
+
+//Gives every expression term its graph and error sources:
+// data: statistical and systematic (total minus statistical in quadrature) of the data file
+// convolute: each uncertainty component of the PDF file (the total band if there are none)
+void SPXRatio::BindExpression(void) {
+ std::string mn = "BindExpression: ";
+ if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
 
-  numeratorGraph.push_back((*dataFileGraphMap)[key]);
+ for(int i = 0; i < expression.GetNumberOfTerms(); i++) {
+  SPXRatioTerm_t &term = expression.GetTerm(i);
 
-  denominatorGraph = (*dataFileGraphMap)[key];
+  if(term.type == RatioTermData) {
+   TGraphAsymmErrors *total = FindDataGraph(term.data);
+   TGraphAsymmErrors *stat = FindDataGraph(term.data + "_stat");
 
-  //Make sure graphs are valid
-  if(!denominatorGraph) {
-   std::ostringstream oss;
-   oss << "TGraph denominatorGraph pointer at dataFileGraphMap[" << key << "] is NULL";
-   throw SPXGraphException(cn + mn + oss.str());
-  }
+   if(stat->GetN() != total->GetN()) {
+    throw SPXGraphException(cn + mn + "Statistical and total graphs of " + term.data + " have different binning");
+   }
 
-  for (int i=0; i<numeratorGraph.size(); i++) {
-   if(!numeratorGraph[i]) {
-    std::ostringstream oss;
-    oss << "TGraph numeratorGraph["<<i<<"] pointer at dataFileGraphMap[" << key << "] is NULL";
-    throw SPXGraphException(cn + mn + oss.str());
+   unsigned int n = total->GetN();
+   std::vector<double> up(n), down(n);
+   for(unsigned int ibin = 0; ibin < n; ibin++) {
+    double eyh = total->GetEYhigh()[ibin], syh = stat->GetEYhigh()[ibin];
+    double eyl = total->GetEYlow()[ibin],  syl = stat->GetEYlow()[ibin];
+    up[ibin]   = sqrt(std::max(0., eyh * eyh - syh * syh));
+    down[ibin] = sqrt(std::max(0., eyl * eyl - syl * syl));
    }
-  }
- }
 
- if(debug) std::cout << cn << mn << "data style passed" << std::endl;
+   expression.SetTermGraph(i, total);
+   expression.AddTermSource(i, term.data + ":stat", stat);
 
- if(ratioStyle.IsConvoluteOverReference()) {
-  StringPair_T convoluteKey = StringPair_T(numeratorConvoluteGridFile, numeratorConvolutePDFFile);
+   //Individual systematics are named sources: the same name in two data files is correlated
+   const std::vector<TGraphAsymmErrors *> *systematics = FindDataSystematics(term.data);
+   bool individual = (systematics != 0);
+   for(int isyst = 0; individual && isyst < systematics->size(); isyst++) {
+    individual = (systematics->at(isyst)->GetN() == n);
+   }
 
-  if(debug) std::cout << cn << mn << "Getting Graphs for convolute / reference" << std::endl;
+   if(individual) {
+    for(int isyst = 0; isyst < systematics->size(); isyst++) {
+     TGraphAsymmErrors *g = systematics->at(isyst);
+     for(unsigned int ibin = 0; ibin < n; ibin++) {
+      double value = fabs(g->GetY()[ibin]);
+      double scale = (value != 0.) ? fabs(total->GetY()[ibin]) / value : 0.;
+      //Signed shifts of the + and - variation
+      up[ibin]   =  g->GetEYhigh()[ibin] * scale;
+      down[ibin] = -g->GetEYlow()[ibin] * scale;
+     }
+     expression.AddTermSource(i, g->GetName(), up, down);
+    }
+   } else {
+    expression.AddTermSource(i, term.data + ":syst", up, down);
+   }
+  } else {
+   SPXPDF *pdf = FindConvolutePDF(StringPair_T(term.grid, term.pdf));
+   TGraphAsymmErrors *total = GetTotalBand(pdf);
 
-  if(!os.ContainsConvolute()) {
-   throw SPXGraphException(cn + mn + "Overlay Style does NOT contain \"convolute\", yet a ratio with convolute is specified: " + ratioStyle.ToString());
-  }
+   expression.SetTermGraph(i, total);
 
-  if(debug) {
-   std::cout << cn << mn << "Convolute Key = [" << convoluteKey.first << ", " << convoluteKey.second << "]" << std::endl;
-  }
+   //Components are named after the PDF file only: other grids with the same PDF file share them (fully correlated)
+   int ncomponents = 0;
+   for(int iband = 0; iband < pdf->GetNBands(); iband++) {
+    std::string type = pdf->GetBandType(iband);
+    if(type == "total") continue;
 
-  //Check for existence of convolute key in convolute graph map
-  if(convoluteFileGraphMap->count(convoluteKey) == 0) {
-   PrintConvoluteFileGraphMapKeys(std::cerr);
+    expression.AddTermSource(i, term.pdf + ":" + type, pdf->GetBand(iband));
+    ncomponents++;
+   }
 
-   std::ostringstream oss;
-   oss << "convoluteFileGraphMap[" << convoluteKey.first << ", " << convoluteKey.second << "] was not found: Invalid key";
-   throw SPXGraphException(cn + mn + oss.str());
+   if(!ncomponents) {
+    expression.AddTermSource(i, term.pdf + ":total", total);
+   }
   }
+ }
+}
 
-  //Check for existence of convolute key in reference graph map
-  if(referenceFileGraphMap->count(convoluteKey) == 0) {
-   PrintReferenceFileGraphMapKeys(std::cerr);
+//Individual systematics of a data file, 0 if there are none
+const std::vector<TGraphAsymmErrors *> * SPXRatio::FindDataSystematics(const std::string &key) {
+ if(!dataFileSystematicsMap) return 0;
 
-   std::ostringstream oss;
-   oss << "convoluteFileGraphMap[" << convoluteKey.first << ", " << convoluteKey.second << "] was not found: Invalid key";
-   throw SPXGraphException(cn + mn + oss.str());
-  }
+ StringGraphVectorMap_T::const_iterator it = dataFileSystematicsMap->find(key);
+ if(it == dataFileSystematicsMap->end() || it->second.empty()) return 0;
 
-  //if (debug)std::cout << cn << mn << "\n Key found push in nunmeratorGraph " <<std::endl;
-
-  //Keys exist, grab graphs
-  numeratorGraph.push_back((*convoluteFileGraphMap)[convoluteKey]);
-  denominatorGraph = (*referenceFileGraphMap)[convoluteKey];
+ for(int i = 0; i < it->second.size(); i++) {
+  if(!it->second.at(i)) return 0;
+ }
 
-  //Make sure graphs are valid
+ return &it->second;
+}
 
-  if(!numeratorGraph.size()==0) {
-   std::ostringstream oss;
-   oss << "TGraph numeratorGraph has zero size at convoluteFileGraphMap[" << convoluteKey.first << ", " << convoluteKey.second << "] is NULL";
-   throw SPXGraphException(cn + mn + oss.str());
-  }
+//Index of the point at x, -1 if there is none
+static int FindPointAt(TGraphAsymmErrors *g, double x) {
+ for(int i = 0; i < g->GetN(); i++) {
+  if(fabs(g->GetX()[i] - x) <= 1.e-6 * std::max(1., fabs(x))) return i;
+ }
+ return -1;
+}
 
-  if (debug) 
-   std::cout << cn << mn << "\n 1 Number of numeratorGraph " << numeratorGraph.size()<<std::endl;
+//Convolute over convolute with the same PDF set (or the same scale variations): the
+// pdf and scale bands are computed from the member by member ratios, the other components
+// are divided component by component and the total is their sum in quadrature.
+// Returns false (nothing divided) if no component can be correlated
+bool SPXRatio::DivideCorrelatedConvolutes(std::vector<TGraphAsymmErrors *> &graphs) {
+ std::string mn = "DivideCorrelatedConvolutes: ";
+ if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
 
-  for (int i=0; i< numeratorGraph.size(); i++) {
-   if (!numeratorGraph[i]) {
-    std::ostringstream oss;
-    oss << "TGraph numeratorGraph["<<i<<"] pointer at convoluteFileGraphMap[" << convoluteKey.first << ", " << convoluteKey.second << "] is NULL";
-    throw SPXGraphException(cn + mn + oss.str());
-   }
-  }
+ SPXPDF *numeratorPDF = FindConvolutePDF(StringPair_T(numeratorConvoluteGridFile, numeratorConvolutePDFFile));
+ SPXPDF *denominatorPDF = FindConvolutePDF(StringPair_T(denominatorConvoluteGridFile, denominatorConvolutePDFFile));
 
-  if(!denominatorGraph) {
-   std::ostringstream oss;
-   oss << "TGraph pointer at referenceFileGraphMap[" << convoluteKey.first << ", " << convoluteKey.second << "] is NULL";
-   throw SPXGraphException(cn + mn + oss.str());
-  }
+ unsigned int n = denominatorGraph->GetN();
 
-  //Print graphs (debug)
-  if(debug) {
-   for (int i=0; i<numeratorGraph.size(); i++) {
-    std::cout << cn << mn << "\n Printing  numeratorGraph["<<i<<"] (convolute) Graph: " << numeratorGraph[i]->GetName()<<std::endl;
-    numeratorGraph[i]->Print();
-   }
-   std::cout << cn << mn << "\n Printing Denominator (reference) Graph: "<< denominatorGraph->GetName()<< std::endl;
-   denominatorGraph->Print();
-  }
+ if(numeratorPDF->GetNBands() != numeratorGraph.size()) return false;
+ for(int i = 0; i < numeratorGraph.size(); i++) {
+  if(numeratorGraph[i]->GetN() != n) return false;
  }
 
- if(debug) std::cout << cn << mn << "data over reference passed" << std::endl;
+ std::map<std::string, TGraphAsymmErrors *> denominatorBands;
+ for(int iband = 0; iband < denominatorPDF->GetNBands(); iband++) {
+  denominatorBands[denominatorPDF->GetBandType(iband)] = denominatorPDF->GetBand(iband);
+ }
 
- if(ratioStyle.IsConvoluteOverNominal()) {
-  StringPair_T convoluteKey = StringPair_T(numeratorConvoluteGridFile, numeratorConvolutePDFFile);
+ //Points of the ratio: the components are summed in quadrature at the same x
+ TGraphAsymmErrors *total = SPXGraphUtilities::Divide(numeratorGraph[0], denominatorGraph, ZeroAllErrors);
 
-  if(debug) std::cout << cn << mn << "Getting Graphs for convolute / nominal" << std::endl;
+ std::vector<TGraphAsymmErrors *> result(numeratorGraph.size(), (TGraphAsymmErrors *)0);
+ std::vector<double> up2(total->GetN(), 0.), down2(total->GetN(), 0.);
+ int itotal = -1;
+ bool correlated = false;
 
-  if(!os.ContainsConvolute()) {
-   throw SPXGraphException(cn + mn + "Overlay Style does NOT contain \"convolute\", yet a ratio with convolute is specified: " + ratioStyle.ToString());
-  }
+ for(int i = 0; i < numeratorGraph.size(); i++) {
+  std::string type = numeratorPDF->GetBandType(i);
 
-  if(debug) {
-   std::cout << cn << mn << "Convolute Key = [" << convoluteKey.first << ", " << convoluteKey.second << "]" << std::endl;
+  if(type == "total") {
+   itotal = i;
+   continue;
   }
 
-  //Check for existence of convolute key in nominal graph map
-  if(nominalFileGraphMap->count(convoluteKey) == 0) {
-   PrintReferenceFileGraphMapKeys(std::cerr);
-
-   std::ostringstream oss;
-   oss << "convoluteFileGraphMap[" << convoluteKey.first << ", " << convoluteKey.second << "] was not found: Invalid key";
-   throw SPXGraphException(cn + mn + oss.str());
-  }
+  std::vector<double> relUp, relDown;
+  TGraphAsymmErrors *graph = SPXGraphUtilities::Divide(numeratorGraph[i], denominatorGraph, ZeroAllErrors);
 
-  denominatorGraph = (*nominalFileGraphMap)[convoluteKey];
-  if(!denominatorGraph) {
-   std::ostringstream oss;
-   oss << "TGraph pointer at nominalFileGraphMap[" << convoluteKey.first << ", " << convoluteKey.second << "] is NULL";
-   throw SPXGraphException(cn + mn + oss.str());
+  //Relative errors of each point of the divided graph, matched by x
+  if(numeratorPDF->GetCorrelatedRatioErrors(denominatorPDF, type, graph, relUp, relDown)) {
+   for(unsigned int ibin = 0; ibin < graph->GetN(); ibin++) {
+    double central = fabs(graph->GetY()[ibin]);
+    graph->SetPointEYhigh(ibin, central * relUp[ibin]);
+    graph->SetPointEYlow(ibin, central * relDown[ibin]);
+   }
+   correlated = true;
+   if(debug) std::cout << cn << mn << type << " band of the ratio from the member ratios" << std::endl;
+  } else if(denominatorBands.count(type) && (denominatorBands[type]->GetN() == n)) {
+   delete graph;
+   graph = SPXGraphUtilities::Divide(numeratorGraph[i], denominatorBands[type], AddErrors);
+  } else {
+   delete graph;
+   graph = SPXGraphUtilities::Divide(numeratorGraph[i], denominatorGraph, ZeroDenGraphErrors);
   }
 
-  if (debug) {
-   std::cout<<cn<<mn<<"ConvoluteOverNominal Look for convolute key [" <<convoluteKey.first.c_str()<<", "<< convoluteKey.second.c_str()<<"]"<< std::endl;
+  for(unsigned int ibin = 0; ibin < graph->GetN(); ibin++) {
+   double central = fabs(graph->GetY()[ibin]);
+   int jbin = FindPointAt(total, graph->GetX()[ibin]);
+   if(central == 0. || jbin < 0) continue;
+   up2[jbin]   += pow(graph->GetEYhigh()[ibin] / central, 2.);
+   down2[jbin] += pow(graph->GetEYlow()[ibin] / central, 2.);
   }
 
-  SPXPDF *pdf= (*convoluteFilePDFMap)[convoluteKey];
-  if (!pdf) throw SPXGraphException(cn + mn + "PDF not found for convolutekey="+convoluteKey.first);
-  else 
-   std::cout << cn << mn << "Found pdf= " << pdf->GetPDFName() << std::endl;
-  int nbands=pdf->GetNBands();
-   
-  for (int iband=0; iband<nbands; iband++) {
-   TGraphAsymmErrors * gband   =pdf->GetBand(iband);
-   std::string         gtype   =pdf->GetBandType(iband);
-   if (!gband) throw SPXParseException(cn+mn+" gband not found !");
-   if (debug) std::cout << cn <<mn<<"Band "<<gband->GetName()<<" type= "<<gtype.c_str()<<std::endl;
-   numeratorGraph.push_back(gband);
-  }
+  result[i] = graph;
+ }
 
-  if(numeratorGraph.size()==0) {
-   std::ostringstream oss;
-   oss << "TGraph numeratorGraph has zero size at convoluteFileGraphMap[] is NULL";
-   throw SPXGraphException(cn + mn + oss.str());
+ if(!correlated) {
+  for(int i = 0; i < result.size(); i++) {
+   delete result[i];
   }
+  delete total;
+  if(debug) std::cout << cn << mn << "No shared members: dividing the bands uncorrelated" << std::endl;
+  return false;
+ }
 
-  for (int i=0; i< numeratorGraph.size(); i++) {
-   if (!numeratorGraph[i]) {
-    std::ostringstream oss;
-    oss << "TGraph numeratorGraph["<<i<<"] pointer at convoluteFilePDFMap[ ] is NULL";
-    throw SPXGraphException(cn + mn + oss.str());
-   }
-  }       
-
-  if(debug) {
-   for (int i=0; i<numeratorGraph.size(); i++) {
-    std::cout << cn << mn << "\n Printing numeratorGraph["<<i<<"] (convolute) Graph:"<< numeratorGraph[i]->GetName() << std::endl;
-    numeratorGraph[i]->Print();
-    //if (!denominatorGraph) std::cout<<"denominatorGraph not found "<<std::endl;
-    std::cout << cn << mn << "\n Printing Denominator (nominal) Graph: " << denominatorGraph->GetName() << std::endl;
-    denominatorGraph->Print();
-   }
+ if(itotal >= 0) {
+  //Central values of the total band itself
+  delete total;
+  total = SPXGraphUtilities::Divide(numeratorGraph[itotal], denominatorGraph, ZeroAllErrors);
+  for(unsigned int ibin = 0; ibin < total->GetN(); ibin++) {
+   double central = fabs(total->GetY()[ibin]);
+   total->SetPointEYhigh(ibin, central * sqrt(up2[ibin]));
+   total->SetPointEYlow(ibin, central * sqrt(down2[ibin]));
   }
+  result[itotal] = total;
+ } else {
+  delete total;
  }
 
- if(debug) std::cout << cn << mn << "data over nominal passed" << std::endl;
+ graphs = result;
+ return true;
+}
 
- if(ratioStyle.IsDataOverConvolute()) {
-  //Create keys
-  std::string dataKey = numeratorDataFile;
-  StringPair_T convoluteKey = StringPair_T(denominatorConvoluteGridFile, denominatorConvolutePDFFile);
+//Data over data: systematics of the same name in numerator and denominator are shifted
+// together, the others and the statistical uncertainties are added in quadrature.
+// Leaves the ratio unchanged if the two data sets share no systematic
+bool SPXRatio::CorrelateDataSystematics(TGraphAsymmErrors *ratio) {
+ std::string mn = "CorrelateDataSystematics: ";
+ if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
 
-  std::string dataKeystat = numeratorDataFile+"_stat";
+ const std::vector<TGraphAsymmErrors *> *numeratorSystematics = FindDataSystematics(numeratorDataFile);
+ const std::vector<TGraphAsymmErrors *> *denominatorSystematics = FindDataSystematics(denominatorDataFile);
 
-  if(debug) std::cout << cn << mn << "Data over Convolute" << std::endl;
+ if(!numeratorSystematics || !denominatorSystematics || numeratorGraphstatonly.empty() || !denominatorGraphstatonly) return false;
 
-  if(!os.ContainsData()) {
-   throw SPXGraphException(cn + mn + "Overlay Style does NOT contain \"data\", yet a ratio with data is specified: " + ratioStyle.ToString());
-  }
+ std::map<std::string, TGraphAsymmErrors *> denominatorByName;
+ for(int i = 0; i < denominatorSystematics->size(); i++) {
+  denominatorByName[denominatorSystematics->at(i)->GetName()] = denominatorSystematics->at(i);
+ }
 
-  if(!os.ContainsConvolute()) {
-   throw SPXGraphException(cn + mn + "Overlay Style does NOT contain \"convolute\", yet a ratio with convolute is specified: " + ratioStyle.ToString());
-  }
+ int shared = 0;
+ for(int i = 0; i < numeratorSystematics->size(); i++) {
+  if(denominatorByName.count(numeratorSystematics->at(i)->GetName())) shared++;
+ }
 
-  if(debug) {
-   std::cout << cn << mn << "Data Key = [" << dataKey << "]" << std::endl;
-   std::cout << cn << mn << "Data Key stat only= [" << dataKeystat << "]" << std::endl;
-   std::cout << cn << mn << "Convolute Key = [" << convoluteKey.first << ", " << convoluteKey.second << "]" << std::endl;
+ if(!shared) return false;
 
-   PrintDataFileGraphMapKeys(std::cout);
-   PrintConvoluteFilePDFMapKeys(std::cout);
+ //Systematics are in the binning of the data file: map the ratio bins through the data graphs
+ TGraphAsymmErrors *numeratorData = FindDataGraph(numeratorDataFile);
+ TGraphAsymmErrors *denominatorData = FindDataGraph(denominatorDataFile);
 
-  }
+ std::vector<double> up2(ratio->GetN(), 0.), down2(ratio->GetN(), 0.);
 
-  //Check for existence of data key
-  if(dataFileGraphMap->count(dataKey) == 0) {
-   PrintDataFileGraphMapKeys(std::cerr);
-   std::ostringstream oss;
-   oss <<"dataFileGraphMap[" << dataKey << "] was not found: Invalid key";
-   throw SPXGraphException(cn + mn + oss.str());
-  }
+ for(int ibin = 0; ibin < ratio->GetN(); ibin++) {
+  double x = ratio->GetX()[ibin];
+  int inum = FindPointAt(numeratorData, x);
+  int iden = FindPointAt(denominatorData, x);
+  int inumstat = FindPointAt(numeratorGraphstatonly[0], x);
+  int idenstat = FindPointAt(denominatorGraphstatonly, x);
 
-  //Check for existence of data key statistical only
-  if(dataFileGraphMap->count(dataKeystat) == 0) {
-   PrintDataFileGraphMapKeys(std::cerr);
-   std::ostringstream oss;
-   oss <<"dataFileGraphMap[" << dataKeystat << "] was not found: Invalid key";
-   throw SPXGraphException(cn + mn + oss.str());
+  if(inum < 0 || iden < 0 || inumstat < 0 || idenstat < 0) {
+   if(debug) std::cout << cn << mn << "No data point at x= " << x << ": keeping uncorrelated errors" << std::endl;
+   return false;
   }
 
-  // Keys exist, grab graphs
-  numeratorGraph.push_back((*dataFileGraphMap)[dataKey]);
-
-  //Make sure graphs are valid
-  if(numeratorGraph.size()==0) {
-   std::ostringstream oss;
-   oss <<"numeratorGraph has zero size at dataFileGraphMap[" << dataKey << "]";
-   throw SPXGraphException(cn + mn + oss.str());
+  //Relative statistical uncertainties
+  double nstat = fabs(numeratorGraphstatonly[0]->GetY()[inumstat]);
+  double dstat = fabs(denominatorGraphstatonly->GetY()[idenstat]);
+  if(nstat != 0.) {
+   up2[ibin]   += pow(numeratorGraphstatonly[0]->GetEYhigh()[inumstat] / nstat, 2.);
+   down2[ibin] += pow(numeratorGraphstatonly[0]->GetEYlow()[inumstat] / nstat, 2.);
   }
-
-  for (int i=0; i< numeratorGraph.size(); i++) {
-   if (!numeratorGraph[i]) {
-    std::ostringstream oss;
-    oss <<"numeratorGraph["<<i<<"] pointer at dataFileGraphMap[" << dataKey << "] is zero";
-    throw SPXGraphException(cn + mn + oss.str());
-   }
-   if (debug) std::cout << cn << mn << "data graph is  "<< numeratorGraph[i]->GetName() << std::endl;
+  if(dstat != 0.) {
+   up2[ibin]   += pow(denominatorGraphstatonly->GetEYlow()[idenstat] / dstat, 2.);
+   down2[ibin] += pow(denominatorGraphstatonly->GetEYhigh()[idenstat] / dstat, 2.);
   }
 
-  // Keys exist, grab graphs
-  numeratorGraphstatonly.push_back((*dataFileGraphMap)[dataKeystat]);
-
-  //Make sure graphs are valid
-  if(numeratorGraphstatonly.size()==0) {
-   std::ostringstream oss;
-   oss<< "TGraph numeratorGraphstatonly has zero size at dataFileGraphMap[" << dataKey << "]";
-   throw SPXGraphException(cn + mn + oss.str());
+  //Signed relative shifts of the + and - variation of each systematic
+  std::map<std::string, std::pair<double, double> > denominatorShifts;
+  for(int i = 0; i < denominatorSystematics->size(); i++) {
+   TGraphAsymmErrors *g = denominatorSystematics->at(i);
+   double value = fabs(g->GetY()[iden]);
+   if(value == 0.) continue;
+   denominatorShifts[g->GetName()] = std::make_pair(g->GetEYhigh()[iden] / value, g->GetEYlow()[iden] / value);
   }
 
-  for (int i=0; i< numeratorGraphstatonly.size(); i++) {
-   if (!numeratorGraph[i]) {
-    std::ostringstream oss;
-    oss << "TGraph numeratorGraphstatonly["<<i<<"] pointer at dataFileGraphMap[" << dataKeystat << "] is zero";
-    throw SPXGraphException(cn + mn + oss.str());
-   }
-   if (debug) std::cout << cn << mn << "data stat only graph is  "<< numeratorGraphstatonly[i]->GetName() << std::endl;
-  }
+  for(int i = 0; i <= numeratorSystematics->size(); i++) {
+   double ru = 0., rd = 0.;
 
-  if (debug) {
-   std::cout<<cn<<mn<<"DataOverConvolute Look for convolute key [" <<convoluteKey.first.c_str()<<", "<< convoluteKey.second.c_str()<<"]"<< std::endl;
-  }
+   if(i < numeratorSystematics->size()) {
+    TGraphAsymmErrors *g = numeratorSystematics->at(i);
+    double value = fabs(g->GetY()[inum]);
+    double nu = (value != 0.) ? g->GetEYhigh()[inum] / value : 0.;
+    double nd = (value != 0.) ? g->GetEYlow()[inum] / value : 0.;
+    double du = 0., dd = 0.;
 
-  //denominatorGraph = (*convoluteFileGraphMap)[convoluteKey];
-  SPXPDF *pdf= (*convoluteFilePDFMap)[convoluteKey];
-  if (convoluteFilePDFMap->count(convoluteKey) == 0) {
-   std::cout<<cn<<mn<<"DataOverConvolute key [" <<convoluteKey.first.c_str()<<", "<< convoluteKey.second.c_str()<<"] not found !"<< std::endl;   
+    std::map<std::string, std::pair<double, double> >::iterator it = denominatorShifts.find(g->GetName());
+    if(it != denominatorShifts.end()) {
+     du = it->second.first;
+     dd = it->second.second;
+     denominatorShifts.erase(it);
+    }
 
-   //PrintConvoluteFilePDFMapKeys(std::cout);
-  } else if (debug) {
-   std::cout<<cn<<mn<<"DataOverConvolute key [" <<convoluteKey.first.c_str()<<", "<< convoluteKey.second.c_str()<<"] found !"<< std::endl;   
-  }
+    ru = (1. + du != 0.) ? (1. + nu) / (1. + du) - 1. : 0.;
+    rd = (1. + dd != 0.) ? (1. + nd) / (1. + dd) - 1. : 0.;
 
-  if (!pdf) {
-   std::cout<<cn<<mn<<"DataOverConvolute PDF not found !"<< std::endl;      
-   PrintConvoluteFilePDFMapKeys(std::cout);
-   throw SPXGraphException(cn + mn + "PDF object not found ! ");
-  }
-  else 
-   std::cout << cn << mn << "Found pdf= " << pdf->GetPDFName() << std::endl;
-
-  int nbands=pdf->GetNBands();
-  if (nbands==0)  std::cout << cn << mn << "No bands found " << std::endl;   
-  else std::cout << cn << mn << "Number of band nbands= " << nbands << std::endl;   
-
-  TGraphAsymmErrors * mygband=0;
-  for (int iband=0; iband<nbands; iband++) {
-   TGraphAsymmErrors * gband   =pdf->GetBand(iband);
-   std::string         gtype   =pdf->GetBandType(iband);
-   if (!gband) throw SPXParseException(cn+mn+" gband not found !");
-   if (debug) std::cout << cn <<mn<<"Band "<<gband->GetName()<<" type= "<<gtype.c_str()<<std::endl;
-   TString gname=gband->GetName();
-   if (gname.Contains("_total_")) mygband=gband; 
-  }
+    up2[ibin]   += pow(std::max(0., std::max(ru, rd)), 2.);
+    down2[ibin] += pow(std::min(0., std::min(ru, rd)), 2.);
+   } else {
+    //Systematics of the denominator only
+    for(std::map<std::string, std::pair<double, double> >::iterator it = denominatorShifts.begin(); it != denominatorShifts.end(); ++it) {
+     ru = (1. + it->second.first != 0.) ? 1. / (1. + it->second.first) - 1. : 0.;
+     rd = (1. + it->second.second != 0.) ? 1. / (1. + it->second.second) - 1. : 0.;
 
-  if (!mygband) {
-   if (!pdf->GetBand(0)) throw SPXParseException(cn+mn+"no band found in PDF !");
-   mygband=pdf->GetBand(0);
+     up2[ibin]   += pow(std::max(0., std::max(ru, rd)), 2.);
+     down2[ibin] += pow(std::min(0., std::min(ru, rd)), 2.);
+    }
+   }
   }
+ }
 
-  if (debug) std::cout << cn << mn << "use as denominator graph " << mygband->GetName() << std::endl;
+ for(int ibin = 0; ibin < ratio->GetN(); ibin++) {
+  double central = fabs(ratio->GetY()[ibin]);
+  ratio->SetPointEYhigh(ibin, central * sqrt(up2[ibin]));
+  ratio->SetPointEYlow(ibin, central * sqrt(down2[ibin]));
+ }
 
-  denominatorGraph=mygband;
+ if(debug) std::cout << cn << mn << shared << " systematics shared by " << numeratorDataFile << " and " << denominatorDataFile << std::endl;
 
- } else if(ratioStyle.IsConvoluteOverData()) {
- //Create keys
-  StringPair_T convoluteKey = StringPair_T(numeratorConvoluteGridFile, numeratorConvolutePDFFile);
-  std::string dataKey = denominatorDataFile;
+ return true;
+}
 
-  if(!os.ContainsConvolute()) {
-   throw SPXGraphException(cn + mn + "Overlay Style does NOT contain \"convolute\", yet a ratio with convolute is specified: " + ratioStyle.ToString());
-  }
+TGraphAsymmErrors * SPXRatio::FindDataGraph(const std::string &key) {
+ std::string mn = "FindDataGraph: ";
 
-  if(!os.ContainsData()) {
-   throw SPXGraphException(cn + mn + "Overlay Style does NOT contain \"data\", yet a ratio with data is specified: " + ratioStyle.ToString());
-  }
+ StringGraphMap_T::const_iterator it = dataFileGraphMap->find(key);
+ if(it == dataFileGraphMap->end()) {
+  PrintDataFileGraphMapKeys(std::cerr);
+  throw SPXGraphException(cn + mn + "dataFileGraphMap[" + key + "] was not found: Invalid key");
+ }
 
-  if(debug) {
-   std::cout << cn << mn << "Convolute Key = [" << convoluteKey.first << ", " << convoluteKey.second << "]" << std::endl;
-   std::cout << cn << mn << "Data Key = [" << dataKey << "]" << std::endl;
-  }
+ if(!it->second) {
+  throw SPXGraphException(cn + mn + "TGraph pointer at dataFileGraphMap[" + key + "] is NULL");
+ }
 
-  //Check for existence of data key
-  if(dataFileGraphMap->count(dataKey) == 0) {
-   PrintDataFileGraphMapKeys(std::cerr);
+ return it->second;
+}
 
-   std::ostringstream oss;
-   oss << "dataFileGraphMap[" << dataKey << "] was not found: Invalid key";
-   throw SPXGraphException(cn + mn + oss.str());
-  } else if(debug) std::cout << cn << mn << "dataFileGraphMap["<<dataKey<<"] " << " is  ok " << std::endl;
+TGraphAsymmErrors * SPXRatio::FindGridGraph(StringPairGraphMap_T *map, const StringPair_T &key, const std::string &mapName) {
+ std::string mn = "FindGridGraph: ";
 
-  //Keys exist, grab graphs
-  denominatorGraph = (*dataFileGraphMap)[dataKey];
-  if(!denominatorGraph) {
-   std::ostringstream oss;
-   oss << "TGraph pointer at dataFileGraphMap[" << dataKey << "] is NULL";
-   throw SPXGraphException(cn + mn + oss.str());
-  } else
-   if(debug) std::cout << cn << mn << "Found denominatorGraph= " << denominatorGraph->GetName() << std::endl;
+ StringPairGraphMap_T::const_iterator it = map->find(key);
+ if(it == map->end()) {
+  throw SPXGraphException(cn + mn + mapName + "[" + key.first + ", " + key.second + "] was not found: Invalid key");
+ }
 
-  if( convoluteFilePDFMap->count(convoluteKey) == 0) {
-   PrintConvoluteFilePDFMapKeys(std::cerr);
+ if(!it->second) {
+  throw SPXGraphException(cn + mn + "TGraph pointer at " + mapName + "[" + key.first + ", " + key.second + "] is NULL");
+ }
 
-   std::ostringstream oss;
-   oss << "convoluteFilePDFMap[" << convoluteKey.first<<","<<convoluteKey.second << "] was not found: Invalid key";
-   throw SPXGraphException(cn + mn + oss.str());
-  } 
+ return it->second;
+}
 
-  if (debug) {
-   std::cout<<cn<<mn<<"Look for convolute key [" <<convoluteKey.first.c_str()<<", "<< convoluteKey.second.c_str()<<"]"<< std::endl;
-  }
+SPXPDF * SPXRatio::FindConvolutePDF(const StringPair_T &key) {
+ std::string mn = "FindConvolutePDF: ";
 
-  SPXPDF *pdf= (*convoluteFilePDFMap)[convoluteKey];
-  if (!pdf) throw SPXGraphException(cn + mn + "PDF not found ");
-  else 
-   std::cout << cn << mn << "Found pdf= " << pdf->GetPDFName() << std::endl;
-  int nbands=pdf->GetNBands();
-   
-  for (int iband=0; iband<nbands; iband++) {
-   TGraphAsymmErrors * gband   =pdf->GetBand(iband);
-   std::string         gtype   =pdf->GetBandType(iband);
-   if (!gband) throw SPXParseException(cn+mn+" gband not found !");
-   if (debug) std::cout << cn <<mn<<"Band "<<gband->GetName()<<" type= "<<gtype.c_str()<<std::endl;
-   numeratorGraph.push_back(gband);
-  }
-   
-  //Make sure graphs are valid
-  if(numeratorGraph.size()==0) {
-   std::ostringstream oss;
-   oss << "TGraph numeratorGraph has zero size at convoluteFileGraphMap[" << dataKey << "]";
-   throw SPXGraphException(cn + mn + oss.str());
-  }
+ StringPairPDFMap_T::const_iterator it = convoluteFilePDFMap->find(key);
+ if(it == convoluteFilePDFMap->end() || !it->second) {
+  PrintConvoluteFilePDFMapKeys(std::cerr);
+  throw SPXGraphException(cn + mn + "convoluteFilePDFMap[" + key.first + ", " + key.second + "] was not found: Invalid key");
+ }
 
-  if(debug) std::cout << cn << mn << "Number of numeratorGraphs= "<<numeratorGraph.size() << std::endl;
+ if(debug) std::cout << cn << mn << "Found pdf= " << it->second->GetPDFName() << std::endl;
 
-  for (int i=0; i< numeratorGraph.size(); i++) {
-   if (!numeratorGraph[i]) {
-    std::ostringstream oss;
-    oss << "TGraph numeratorGraph["<<i<<"] pointer at convoluteFileGraphMap [" << dataKey << "] is zero";
-    throw SPXGraphException(cn + mn + oss.str());
-   } else {
-    if(debug) std::cout << cn << mn << " numeratorGraph["<<i<<"]= "<<numeratorGraph[i]->GetName() << std::endl;
-   }
-  }
- } else if(ratioStyle.IsDataOverData()) {
-  //Create keys
-  std::string numDataKey = numeratorDataFile;
-  std::string denDataKey = denominatorDataFile;
+ return it->second;
+}
 
-  if(!os.ContainsData()) {
-   throw SPXGraphException(cn + mn + "Overlay Style does NOT contain \"data\", yet a ratio with data is specified: " + ratioStyle.ToString());
-  }
+//Total band of a prediction, the first band if there is no total
+TGraphAsymmErrors * SPXRatio::GetTotalBand(SPXPDF *pdf) {
+ std::string mn = "GetTotalBand: ";
 
-  if(debug) {
-   std::cout << cn << mn << "Numerator   Data Key = [" << numDataKey << "]" << std::endl;
-   std::cout << cn << mn << "Denominator Data Key = [" << denDataKey << "]" << std::endl;
-  }
+ TGraphAsymmErrors *mygband = 0;
+ for(int iband = 0; iband < pdf->GetNBands(); iband++) {
+  TGraphAsymmErrors *gband = pdf->GetBand(iband);
+  if(!gband) throw SPXParseException(cn + mn + "gband not found !");
+  if(TString(gband->GetName()).Contains("_total_")) mygband = gband;
+ }
 
-  //Check for existence of numerator data key
-  if(dataFileGraphMap->count(numDataKey) == 0) {
-   PrintDataFileGraphMapKeys(std::cerr);
-   std::ostringstream oss;
-   oss << "dataFileGraphMap[" << numDataKey << "] was not found: Invalid key";
-   std::cout<<cn<<mn<<oss.str()<<std::endl;
-   throw SPXGraphException(cn + mn + oss.str());
-  }
+ if(!mygband) {
+  if(!pdf->GetBand(0)) throw SPXParseException(cn + mn + "no band found in PDF !");
+  mygband = pdf->GetBand(0);
+ }
 
-  //Check for existence of denominator data key
-  if(dataFileGraphMap->count(denDataKey) == 0) {
-   PrintDataFileGraphMapKeys(std::cerr);
-   std::ostringstream oss;
-   oss << "dataFileGraphMap[" << denDataKey << "] was not found: Invalid key";
-   std::cout<<cn<<mn<<oss.str()<<std::endl;
-   throw SPXGraphException(cn + mn + oss.str());
-  }
+ return mygband;
+}
 
-  if(dataFileLabelMap->count(denDataKey) == 0) {
-   PrintDataFileLabelMapKeys(std::cerr);
-   std::ostringstream oss;
-   oss << "dataFileLabelMap[" << denDataKey << "] was not found: Invalid key";
-   std::cout<<cn<<mn<<oss.str()<<std::endl;
-   throw SPXGraphException(cn + mn + oss.str());
-  }
+void SPXRatio::GetGraphs(void) {
+ std::string mn = "GetGraphs: ";
+ if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
 
-  if(dataFileLabelMap->count(numDataKey) == 0) {
-   PrintDataFileLabelMapKeys(std::cerr);
-   std::ostringstream oss;
-   oss << "dataFileLabelMap[" << numDataKey << "] was not found: Invalid key";
-   std::cout<<cn<<mn<<oss.str()<<std::endl;
-   throw SPXGraphException(cn + mn + oss.str());
-  }
+ SPXOverlayStyle &os = GetPlotConfiguration().GetOverlayStyle();
 
-  numeratorDataLabel=(*dataFileLabelMap)[numDataKey];
-  denominatorDataLabel=(*dataFileLabelMap)[denDataKey];
+ if(debug) std::cout<<cn<<mn<<"Ratio style is: " << ratioStyle.ToString() << " (" << ratioStyle.GetNumerator() \
+                     << " / " << ratioStyle.GetDenominator() << ")" << std::endl;
 
-  if (debug) {
-   std::cout<<cn<<mn<<"numeratorDataLabel= "<<numeratorDataLabel<<std::endl;
-   std::cout<<cn<<mn<<"denominatorDataLabel= "<<denominatorDataLabel<<std::endl;
-  }
+ bool hasData = (plan.numerator == RatioOperandData) || (plan.denominator == RatioOperandData);
+ bool hasConvolute = (plan.numerator == RatioOperandConvolute) || (plan.denominator == RatioOperandConvoluteTotal);
 
-  //Keys exist, grab graphs
+ if(plan.numerator == RatioOperandExpression) {
+  hasData = expression.HasData();
+  hasConvolute = expression.HasConvolute();
+ }
+
+ if(hasData && !os.ContainsData()) {
+  throw SPXGraphException(cn + mn + "Overlay Style does NOT contain \"data\", yet a ratio with data is specified: " + ratioStyle.ToString());
+ }
 
-  // now check if map contains systematic uncertainties
-  // PrintDataFileGraphMapKeys();
+ if(hasConvolute && !os.ContainsConvolute()) {
+  throw SPXGraphException(cn + mn + "Overlay Style does NOT contain \"convolute\", yet a ratio with convolute is specified: " + ratioStyle.ToString());
+ }
 
-   if (DataFileGraphMapHasSystematics()) {
-    for (StringGraphMap_T::iterator it = dataFileGraphMap->begin(); it != dataFileGraphMap->end(); ++it) {
-     std::string systkey =  it->first;
-     //if (debug) std::cout<<" denDataKey= "<< denDataKey <<" systkey= "<<systkey.c_str()<<std::endl;
+ if(plan.numerator == RatioOperandExpression) {
+  BindExpression();
+  return;
+ }
 
-     if (systkey!=denDataKey && systkey!=denDataKey+"_stat") {
-      //if (debug) std::cout<<" Add numeratorGraph systkey= "<<systkey.c_str()<<std::endl;
+ StringPair_T numeratorKey   = StringPair_T(numeratorConvoluteGridFile, numeratorConvolutePDFFile);
+ StringPair_T denominatorKey = StringPair_T(denominatorConvoluteGridFile, denominatorConvolutePDFFile);
 
-      numeratorGraph.push_back((*dataFileGraphMap)[systkey]);
+ //Numerator
+ if(plan.numerator == RatioOperandData) {
+  if(plan.sameData) {
+   numeratorGraph.push_back(FindDataGraph(numeratorDataFile));
+  } else {
+   if(plan.denominator == RatioOperandData && DataFileGraphMapHasSystematics()) {
+    //Every systematic of the data as its own numerator
+    for(StringGraphMap_T::iterator it = dataFileGraphMap->begin(); it != dataFileGraphMap->end(); ++it) {
+     if(it->first != denominatorDataFile && it->first != denominatorDataFile + "_stat") {
+      numeratorGraph.push_back(it->second);
      }
     }
-    denominatorGraph = (*dataFileGraphMap)[denDataKey];
    } else {
-    numeratorGraph.push_back((*dataFileGraphMap)[numDataKey]);
-    denominatorGraph = (*dataFileGraphMap)[denDataKey];
+    numeratorGraph.push_back(FindDataGraph(numeratorDataFile));
    }
 
-  if(!denominatorGraph) {
-   std::ostringstream oss; 
-   oss << "TGraph pointer at dataFileGraphMap[" << denDataKey << "] is NULL";
-   throw SPXGraphException(cn + mn + oss.str());
+   numeratorGraphstatonly.push_back(FindDataGraph(numeratorDataFile + "_stat"));
   }
+ } else {
+  SPXPDF *pdf = FindConvolutePDF(numeratorKey);
 
-  //Make sure graphs are valid
-  if(numeratorGraph.size()==0) {
-   std::ostringstream oss;
-   oss << "TGraph numeratorGraph has zero size at dataFileGraphMap[" << denDataKey << "]";
-   throw SPXGraphException(cn + mn + oss.str());
+  for(int iband = 0; iband < pdf->GetNBands(); iband++) {
+   TGraphAsymmErrors *gband = pdf->GetBand(iband);
+   if(!gband) throw SPXParseException(cn + mn + "numerator gband not found !");
+   if(debug) std::cout << cn << mn << "Band " << gband->GetName() << " type= " << pdf->GetBandType(iband) << std::endl;
+   numeratorGraph.push_back(gband);
   }
+ }
 
-  for (int i=0; i< numeratorGraph.size(); i++) {
-   if (!numeratorGraph[i]) {
-    std::ostringstream oss;
-    oss << "TGraph numeratorGraph["<<i<<"] pointer at dataFileGraphMap[" << numDataKey << "] is zero";
-    throw SPXGraphException(cn + mn + oss.str());
-   }
-  }
-  //
-  //if (!DataFileGraphMapHasSystematics()) {
-
-   std::string dataKeystat = numDataKey+"_stat";
-   //Check for existence of data key statistical only
-   if(dataFileGraphMap->count(dataKeystat) == 0) {
-    PrintDataFileGraphMapKeys(std::cerr);
-    std::ostringstream oss;
-    oss <<"dataFileGraphMap[" << dataKeystat << "] was not found: Invalid key";
-    throw SPXGraphException(cn + mn + oss.str());
+ //Denominator
+ switch(plan.denominator) {
+  case RatioOperandData:
+   if(plan.sameData) {
+    denominatorGraph = numeratorGraph.back();
    } else {
-    numeratorGraphstatonly.push_back((*dataFileGraphMap)[dataKeystat]);
+    denominatorGraph = FindDataGraph(denominatorDataFile);
    }
+   break;
 
-   dataKeystat = denDataKey+"_stat";
-   if (dataFileLabelMap->count(denDataKey) == 0) {
-    PrintDataFileLabelMapKeys(std::cerr);
-    std::ostringstream oss;
-    oss << "dataFileLabelMap[" << dataKeystat << "] was not found: Invalid key";
-    throw SPXGraphException(cn + mn + oss.str());
-   } else {
-    if (debug) std::cout<<cn<<mn<<"Added stat "<<dataKeystat<<" graph "<<(*dataFileGraphMap)[dataKeystat]->GetName()<<std::endl;
-    denominatorGraphstatonly=(*dataFileGraphMap)[dataKeystat];
-   }  
-  //}
-  //  
- }
+  case RatioOperandConvoluteTotal:
+   denominatorGraph = GetTotalBand(FindConvolutePDF(denominatorKey));
+   break;
 
- if(ratioStyle.IsConvoluteOverConvolute()) {
-  if (debug) std::cout<<cn<<mn<<"IsConvoluteOverConvolute "<<std::endl;
-  if(!os.ContainsConvolute()) {
-   throw SPXGraphException(cn + mn + "Overlay Style does NOT contain \"convolute\", yet a ratio with convolute is specified: " + ratioStyle.ToString());
-  }
-
-  //if(debug) {
-  // std::cout << cn << mn << "numeratorConvoluteGridFile= " << numeratorConvoluteGridFile<< std::endl;
-  // std::cout << cn << mn << "denominatorConvoluteGridFile= " << denominatorConvoluteGridFile<< std::endl;
-  // std::cout << cn << mn << "numeratorConvolutePDFFile= " << numeratorConvolutePDFFile<< std::endl;
-  // std::cout << cn << mn << "denominatorConvolutePDFFile= " << denominatorConvolutePDFFile<< std::endl;
-  //}
+  case RatioOperandReference:
+   denominatorGraph = FindGridGraph(referenceFileGraphMap, numeratorKey, "referenceFileGraphMap");
+   break;
 
-  StringPair_T numeratorconvoluteKey   = StringPair_T(numeratorConvoluteGridFile, numeratorConvolutePDFFile);
-  StringPair_T denominatorconvoluteKey = StringPair_T(denominatorConvoluteGridFile, denominatorConvolutePDFFile);
+  case RatioOperandNominal:
+   denominatorGraph = FindGridGraph(nominalFileGraphMap, numeratorKey, "nominalFileGraphMap");
+   break;
 
-  if(debug) {
-   std::cout << cn << mn << "numerator Convolute Key = [" << numeratorconvoluteKey.first << ", " << numeratorconvoluteKey.second << "]" << std::endl;
-   std::cout << cn << mn << "denominator Convolute Key = [" << denominatorconvoluteKey.first << ", " << denominatorconvoluteKey.second << "]" << std::endl;
-  }
-
-  if( convoluteFilePDFMap->count(denominatorconvoluteKey) == 0) {
-   PrintConvoluteFilePDFMapKeys(std::cerr);
-
-   std::ostringstream oss;
-   oss << "convoluteFilePDFMap[" << denominatorconvoluteKey.first<<","<<denominatorconvoluteKey.second << "] was not found: Invalid key";
-   throw SPXGraphException(cn + mn + oss.str());
-  } 
-
-  if( convoluteFilePDFMap->count(numeratorconvoluteKey) == 0) {
-   PrintConvoluteFilePDFMapKeys(std::cerr);
-
-   std::ostringstream oss;
-   oss << "convoluteFilePDFMap[" << numeratorconvoluteKey.first<<","<<numeratorconvoluteKey.second << "] was not found: Invalid key";
-   throw SPXGraphException(cn + mn + oss.str());
-  } 
-
-  if (debug) {
-   std::cout<<cn<<mn<<"Look for numerator convolute key [" <<numeratorconvoluteKey.first.c_str()<<", "<< numeratorconvoluteKey.second.c_str()<<"]"<< std::endl;
-   std::cout<<cn<<mn<<"Look for denominator convolute key [" <<denominatorconvoluteKey.first.c_str()<<", "<< denominatorconvoluteKey.second.c_str()<<"]"<< std::endl;
-  }
-
-  //
+  default:
+   throw SPXGraphException(cn + mn + "Invalid denominator in ratio plan");
+ }
 
-  if (convoluteFilePDFMap->count(denominatorconvoluteKey) == 0) {
-   std::cout<<cn<<mn<<"ConvoluteOverConvolute key [" <<denominatorconvoluteKey.first.c_str()<<", "<< denominatorconvoluteKey.second.c_str()<<"] not found !"<< std::endl;   
+ //Data over data: labels and statistical uncertainty of the denominator
+ if(plan.numerator == RatioOperandData && plan.denominator == RatioOperandData && !plan.sameData) {
+  StringLabelMap_T::const_iterator inum = dataFileLabelMap->find(numeratorDataFile);
+  StringLabelMap_T::const_iterator iden = dataFileLabelMap->find(denominatorDataFile);
 
-   PrintConvoluteFilePDFMapKeys(std::cout);
-  } else if (debug) {
-   std::cout<<cn<<mn<<"ConvoluteOverConvolute key [" <<denominatorconvoluteKey.first.c_str()<<", "<< denominatorconvoluteKey.second.c_str()<<"] found !"<< std::endl;   
+  if(inum == dataFileLabelMap->end() || iden == dataFileLabelMap->end()) {
+   PrintDataFileLabelMapKeys(std::cerr);
+   std::string key = (inum == dataFileLabelMap->end() ? numeratorDataFile : denominatorDataFile);
+   throw SPXGraphException(cn + mn + "dataFileLabelMap[" + key + "] was not found: Invalid key");
   }
 
-  SPXPDF *denominatorpdf= (*convoluteFilePDFMap)[denominatorconvoluteKey];
-  if (!denominatorpdf) {
-   std::cout<<cn<<mn<<"ConvoluteOverConvolute PDF not found !"<< std::endl;      
-   PrintConvoluteFilePDFMapKeys(std::cout);
-   throw SPXGraphException(cn + mn + "denominator PDF object not found ! ");
-  }
-  else 
-   std::cout << cn << mn << "Found pdf= " << denominatorpdf->GetPDFName() << std::endl;
-
-  int denominatornbands=denominatorpdf->GetNBands();
-  if (denominatornbands==0)  std::cout << cn << mn << "No denominator bands found " << std::endl;   
-  else std::cout << cn << mn << "Number of denominator band nbands= " << denominatornbands << std::endl;   
-
-  TGraphAsymmErrors * mygband=0;
-  for (int iband=0; iband<denominatornbands; iband++) {
-   TGraphAsymmErrors * gband   =denominatorpdf->GetBand(iband);
-   std::string         gtype   =denominatorpdf->GetBandType(iband);
-   if (!gband) throw SPXParseException(cn+mn+"denomaintor gband not found !");
-   if (debug) std::cout << cn <<mn<<"Band "<<gband->GetName()<<" type= "<<gtype.c_str()<<std::endl;
-   TString gname=gband->GetName();
-   if (gname.Contains("_total_")) mygband=gband; 
-  }
-  if (!mygband) {
-   if (!denominatorpdf->GetBand(0)) throw SPXParseException(cn+mn+"no denominator band found in PDF !");
-   mygband=denominatorpdf->GetBand(0);
-  }
+  numeratorDataLabel   = inum->second;
+  denominatorDataLabel = iden->second;
 
-  if (debug) std::cout << cn << mn << "use as denominator graph " << mygband->GetName() << std::endl;
+  denominatorGraphstatonly = FindDataGraph(denominatorDataFile + "_stat");
+ }
 
-  denominatorGraph=mygband;
-  //
+ if(numeratorGraph.size() == 0) {
+  throw SPXGraphException(cn + mn + "TGraph numeratorGraph has zero size for ratio " + ratioStyle.ToString());
+ }
 
-   
-  SPXPDF *numeratorpdf= (*convoluteFilePDFMap)[numeratorconvoluteKey];
-  if (!numeratorpdf) throw SPXGraphException(cn + mn + "numerator PDF not found ");
-  else 
-   std::cout << cn << mn << "Found numerator pdf= " << numeratorpdf->GetPDFName() << std::endl;
-
-  int numeratornbands=numeratorpdf->GetNBands();
-   
-  for (int iband=0; iband<numeratornbands; iband++) {
-   TGraphAsymmErrors * gband   =numeratorpdf->GetBand(iband);
-   std::string         gtype   =numeratorpdf->GetBandType(iband);
-   if (!gband) throw SPXParseException(cn+mn+"numerator gband not found !");
-   if (debug) std::cout << cn <<mn<<"Band "<<gband->GetName()<<" type= "<<gtype.c_str()<<std::endl;
-   numeratorGraph.push_back(gband);
-  }
-   
-  //Make sure graphs are valid
-  if(numeratorGraph.size()==0) {
+ for(int i = 0; i < numeratorGraph.size(); i++) {
+  if(!numeratorGraph[i]) {
    std::ostringstream oss;
-   oss <<cn<<mn<<"TGraph numeratorGraph has zero size at convoluteFileGraphMap[" << numeratorconvoluteKey.first.c_str() << "]";
+   oss << "TGraph numeratorGraph[" << i << "] pointer is NULL for ratio " << ratioStyle.ToString();
    throw SPXGraphException(cn + mn + oss.str());
   }
-
  }
 
- return;
+ if(debug) {
+  for(int i = 0; i < numeratorGraph.size(); i++) {
+   std::cout << cn << mn << "numeratorGraph[" << i << "]= " << numeratorGraph[i]->GetName() << std::endl;
+  }
+  std::cout << cn << mn << "denominatorGraph= " << denominatorGraph->GetName() << std::endl;
+ }
 }
 
 bool SPXRatio::MatchesConvoluteString(std::string &s) {
@@ -1587,6 +1540,14 @@ void SPXRatio::Draw(std::string option, int statRatios, int totRatios, bool plot
   std::cout<<cn<<mn<<"WARNING: Ratio graph is empty "<<std::endl;
 
  if(debug) std::cout<<cn<<mn<<"ratioStyle= "<<ratioStyle.ToString()<<std::endl;
+
+ if(ratioStyle.IsExpression()) {
+  for (int igraph=0; igraph < ratioGraph.size(); igraph++) {
+   if (debug) std::cout<<cn<<mn<<"Draw expression "<<ratioGraph[igraph]->GetName()<<" option= "<<option.c_str()<<std::endl;
+   ratioGraph[igraph]->Draw(option.c_str());
+  }
+  return;
+ }
   
  // plot data if requested
  if(IsDataStat() || IsDataTot()) {
@@ -1626,13 +1587,13 @@ void SPXRatio::Draw(std::string option, int statRatios, int totRatios, bool plot
 
      isyst++;
 
-     TH1D *hedgelow =SPXGraphUtilities::GetEdgeHistogram(graph,true);
+     TH1D *hedgelow =SPXArena::AdoptCurrent(SPXGraphUtilities::GetEdgeHistogram(graph,true));
      if (!hedgelow) {
       std::cout<<cn<<mn<<"EdgeLow histogram not found !"<<std::endl;
       std::cerr<<cn<<mn<<"EdgeLow histogram not found !"<<std::endl;
      }
 
-     TH1D *hedgehigh=SPXGraphUtilities::GetEdgeHistogram(graph,false);
+     TH1D *hedgehigh=SPXArena::AdoptCurrent(SPXGraphUtilities::GetEdgeHistogram(graph,false));
      if (!hedgehigh) {
       std::cout<<cn<<mn<<"EdgeHigh histogram not found !"<<std::endl;
       std::cerr<<cn<<mn<<"EdgeHigh histogram not found !"<<std::endl;
@@ -1818,15 +1779,13 @@ void SPXRatio::Draw(std::string option, int statRatios, int totRatios, bool plot
 
   if (debug) std::cout<<cn<<mn<<"ordering done"<<std::endl;
 
-  SPXPlotConfigurationInstance pci;
-
   if(ratioStyle.IsDataOverConvolute()) {
    if (debug) std::cout<<cn<<mn<<"Get plot configuration: "<<numeratorDataFile.c_str()<<std::endl;
    throw SPXGraphException(cn+mn+"You should not come here, can not plot detailed band for data in numerator");
-  } else {
-   if (debug) std::cout<<cn<<mn<<"Get plot configuration: "<<numeratorConvolutePDFFile.c_str()<<std::endl;
-   pci=plotConfiguration.GetPlotConfigurationInstance(numeratorConvolutePDFFile);
   }
+
+  if (debug) std::cout<<cn<<mn<<"Get plot configuration: "<<numeratorConvolutePDFFile.c_str()<<std::endl;
+  SPXPlotConfigurationInstance &pci=GetPlotConfiguration().GetPlotConfigurationInstance(numeratorConvolutePDFFile);
   
   //if (!pci) std::cout<<cn<<mn<<"WARNING: pci not found "<<std::endl;
 
@@ -1903,9 +1862,9 @@ void SPXRatio::Draw(std::string option, int statRatios, int totRatios, bool plot
 
    if (edgecolor!=DEFAULT && edgecolor!=0) {
 
-    TH1D *hedgelow =SPXGraphUtilities::GetEdgeHistogram(graph,true);
+    TH1D *hedgelow =SPXArena::AdoptCurrent(SPXGraphUtilities::GetEdgeHistogram(graph,true));
     //std::cout<<cn<<mn<<"create edge histogram "<<edgecolor<<" name= "<<hedgelow->GetName()<<std::endl;
-    TH1D *hedgehigh=SPXGraphUtilities::GetEdgeHistogram(graph,false);
+    TH1D *hedgehigh=SPXArena::AdoptCurrent(SPXGraphUtilities::GetEdgeHistogram(graph,false));
     hedgelow ->SetLineColor(abs(edgecolor));
     hedgehigh->SetLineColor(abs(edgecolor));
     if (edgestyle!=DEFAULT) {
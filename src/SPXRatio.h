@@ -22,8 +22,10 @@
 
 #include "SPXPDF.h"
 
-#include "SPXPlotConfiguration.h"
+#include "SPXSteeringFile.h"
 #include "SPXRatioStyle.h"
+#include "SPXRatioExpression.h"
+#include "SPXArena.h"
 #include "SPXUtilities.h"
 #include "SPXException.h"
 
@@ -36,25 +38,48 @@ typedef std::pair<StringPair_T, SPXPDF *> StringPairPDFPair_T;
 
 //typedef std::pair<std::string, std::string> StringPair_T;
 
+//Where the graphs of one side of a ratio come from
+typedef enum RatioOperand_t {
+	RatioOperandData = 0,			//Data steering file: total (and statistical only) graph
+	RatioOperandConvolute = 1,		//[grid, pdf]: every band of the prediction
+	RatioOperandConvoluteTotal = 2,		//[grid, pdf]: the total band of the prediction
+	RatioOperandReference = 3,		//Reference histogram of the grid
+	RatioOperandNominal = 4,		//Nominal prediction of the grid
+	RatioOperandExpression = 5		//Ratio expression: terms bound and evaluated by SPXRatioExpression
+} RatioOperand_t;
+
+//Ratio specification compiled once in Parse: GetGraphs does one lookup per operand and
+//Divide does not inspect the ratio style again
+typedef struct SPXRatioPlan_t {
+	RatioOperand_t numerator;
+	RatioOperand_t denominator;
+	bool sameData;				//data_stat, data_tot: numerator and denominator are one data graph
+	DivideErrorType_t errors;		//Error model of the division
+} SPXRatioPlan_t;
+
 class SPXRatio {
 
 public:
 
-    SPXRatio(SPXPlotConfiguration &pc, SPXRatioStyle &rs) {
-        plotConfiguration = pc;
+    SPXRatio(SPXSteeringFile *steeringFile, unsigned int plotNumber, SPXRatioStyle &rs) {
+        this->steeringFile = steeringFile;
+        this->id = plotNumber;
     	ratioStyle = rs;
         MatchBinning=true;
         AddTotalSyst=0;  
 
         denominatorGraph=0;
 	denominatorGraphstatonly=0;
+        dataFileSystematicsMap=0;
         dataGraphFillColor=kGray;
         dataGraphFillStyle=1001; 
+        bounds=SPXGraphUtilities::GetEmptyBounds();
     }
 
     void Parse(std::string &s);
     void AddDataFileGraphMap(StringGraphMap_T &);
     void AddDataFileLabelMap(StringLabelMap_T &);
+    void AddDataFileSystematicsMap(StringGraphVectorMap_T &);
 
     void AddReferenceFileGraphMap(StringPairGraphMap_T &);
     void AddNominalFileGraphMap(StringPairGraphMap_T &);
@@ -103,6 +128,10 @@ public:
             return true;
         }
 
+        if(ratioStyle.IsExpression() && expression.HasConvolute()) {
+            return true;
+        }
+
         return false;
     }
 
@@ -111,6 +140,10 @@ public:
             return true;
         }
 
+        if(ratioStyle.IsExpression() && expression.HasData()) {
+            return true;
+        }
+
         return false;
     }
 
@@ -141,6 +174,7 @@ public:
     bool DataFileGraphMapHasSystematics();
    
     void Divide(void);
+    void AdoptGraphs(SPXArena *arena);
 
     std::vector<TGraphAsymmErrors *> GetRatioGraph(void) {
      if(ratioGraph.size()==0) {
@@ -149,6 +183,13 @@ public:
      return ratioGraph;
     }
 
+    //Extent of the ratio graphs, extended as Divide adds them
+    const SPXGraphBounds_t & GetBounds(void) const {
+     return bounds;
+    }
+
+    void UpdateBounds(void);
+
     std::vector<TGraphAsymmErrors *> GetRatioGraphStat(void) {
      //if(ratioGraphstatonly.size()==0) {
        //throw SPXGraphException("SPXRatio::GetRatioGraph: Ratio graphstatonly is empty");
@@ -230,8 +271,17 @@ public:
 private:
     static bool debug;
 
-    SPXPlotConfiguration plotConfiguration;
+    SPXSteeringFile *steeringFile;		    // Steering file owning the plot configuration
+    unsigned int id;				    // Plot number ID (0-based) of the plot configuration
+
+    //Plot configuration looked up on each use: the ratio never holds it across a reparse
+    SPXPlotConfiguration & GetPlotConfiguration(void) {
+        return steeringFile->GetPlotConfiguration(id);
+    }
+
     SPXRatioStyle ratioStyle;
+    SPXRatioPlan_t plan;
+    SPXRatioExpression expression;		    // Compiled ratio_N if the ratio style is "expression"
 
     std::string dataDirectory;
     std::string gridDirectory;
@@ -259,6 +309,7 @@ private:
     std::vector<TGraphAsymmErrors *> numeratorGraphstatonly;
     std::vector<TGraphAsymmErrors *> ratioGraph;
     std::vector<TGraphAsymmErrors *> ratioGraphstatonly;
+    SPXGraphBounds_t bounds;                        //Extent of ratioGraph
 
     int AddTotalSyst;  // Flag to add total systematics in ratio 0: off >0 color
     bool MatchBinning;  //Flag to indocate if matchbinning should be called
@@ -269,6 +320,7 @@ private:
     StringGraphMap_T * dataFileGraphMap;            //Map of data files to their data TGraph
 
     StringLabelMap_T * dataFileLabelMap;        //Map of data file to their data labels
+    StringGraphVectorMap_T * dataFileSystematicsMap; //Map of data file to their individual systematics (may be 0)
     StringPairGraphMap_T * referenceFileGraphMap;   //Map of grid/graph file pairs to their grid reference TGraph
     StringPairGraphMap_T * nominalFileGraphMap;     //Map of grid/graph file pairs to their pdf nominal TGraph
     StringPairGraphMap_T * convoluteFileGraphMap;   //Map of grid/graph file pairs to their convolute pdf objects
@@ -276,6 +328,18 @@ private:
 
     bool MatchesConvoluteString(std::string &s);
 
+    void CompilePlan(void);
+    void ParseExpression(std::string &s);
+    void BindExpression(void);
+    bool DivideCorrelatedConvolutes(std::vector<TGraphAsymmErrors *> &graphs);
+    bool CorrelateDataSystematics(TGraphAsymmErrors *ratio);
+    const std::vector<TGraphAsymmErrors *> * FindDataSystematics(const std::string &key);
+    TGraphAsymmErrors * FindDataGraph(const std::string &key);
+    TGraphAsymmErrors * FindGridGraph(StringPairGraphMap_T *map, const StringPair_T &key, const std::string &mapName);
+    SPXPDF * FindConvolutePDF(const StringPair_T &key);
+    void AddRatioGraph(TGraphAsymmErrors *graph);
+    static TGraphAsymmErrors * GetTotalBand(SPXPDF *pdf);
+
     int dataGraphFillColor; // Fill color for data in ratio with data as denominator
     int dataGraphFillStyle; // Fill style for data in ratio with data as denominator
 
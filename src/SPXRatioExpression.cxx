@@ -0,0 +1,515 @@
+//************************************************************/
+//
+//	Ratio Expression Implementation
+//
+//	Implements the SPXRatioExpression class
+//
+//	@Author: 	Spectrum contributors
+//	@Date:		19.10.2026
+//
+//************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+
+#include "SPXRatioExpression.h"
+#include "SPXUtilities.h"
+
+//Class name for debug statements
+const std::string cn = "SPXRatioExpression::";
+
+//Must define the static debug variable in the implementation
+bool SPXRatioExpression::debug;
+
+//Relative tolerance when comparing the bin centres of the terms
+const double EXPRESSION_BIN_TOLERANCE = 1.e-6;
+
+//Grammar (operators separated by spaces):
+//
+//	sum     := product (('+' | '-') product)*
+//	product := unary (('*' | '/') unary)*
+//	unary   := '-' unary | primary
+//	primary := number | data | '[' grid ',' pdf ']' | 'norm' '(' sum ')' | '(' sum ')'
+void SPXRatioExpression::Compile(const std::string &s) {
+	std::string mn = "Compile: ";
+	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+	expression = s;
+	terms.clear();
+	program.clear();
+	sourceIndex.clear();
+	sourceNames.clear();
+
+	Tokenize(s);
+
+	if(tokens.empty()) {
+		throw SPXParseException(cn + mn + "Empty ratio expression");
+	}
+
+	position = 0;
+	ParseSum();
+
+	if(position != tokens.size()) {
+		throw SPXParseException(cn + mn + "Unexpected \"" + tokens.at(position) + "\" in ratio expression: " + s);
+	}
+
+	//Stack depth needed by the evaluation
+	unsigned int depth = 0;
+	stackDepth = 0;
+	for(int i = 0; i < program.size(); i++) {
+		RatioOpcode_t opcode = program.at(i).opcode;
+		if((opcode == RatioOpTerm) || (opcode == RatioOpConstant)) {
+			depth++;
+		} else if((opcode != RatioOpNegate) && (opcode != RatioOpNormalise)) {
+			depth--;
+		}
+		if(depth > stackDepth) stackDepth = depth;
+	}
+
+	if(terms.empty()) {
+		throw SPXParseException(cn + mn + "Ratio expression contains no data or convolute: " + s);
+	}
+
+	if(debug) std::cout << cn << mn << s << ": " << terms.size() << " terms, " << program.size() << " instructions, stack depth " << stackDepth << std::endl;
+}
+
+void SPXRatioExpression::Tokenize(const std::string &s) {
+	tokens.clear();
+
+	std::string token;
+	for(int i = 0; i <= s.size(); i++) {
+		char c = (i < s.size()) ? s.at(i) : ' ';
+
+		bool space = (c == ' ') || (c == '\t');
+		bool single = (c == '(') || (c == ')') || (c == '[') || (c == ']') || (c == ',');
+
+		if(space || single) {
+			if(!token.empty()) {
+				tokens.push_back(token);
+				token.clear();
+			}
+			if(single) {
+				tokens.push_back(std::string(1, c));
+			}
+		} else {
+			token += c;
+		}
+	}
+}
+
+std::string SPXRatioExpression::Next(void) {
+	std::string mn = "Next: ";
+
+	if(position >= tokens.size()) {
+		throw SPXParseException(cn + mn + "Unexpected end of ratio expression: " + expression);
+	}
+
+	return tokens.at(position++);
+}
+
+bool SPXRatioExpression::Accept(const std::string &token) {
+	if((position < tokens.size()) && (tokens.at(position) == token)) {
+		position++;
+		return true;
+	}
+
+	return false;
+}
+
+void SPXRatioExpression::Expect(const std::string &token) {
+	std::string mn = "Expect: ";
+
+	if(!Accept(token)) {
+		std::string found = (position < tokens.size()) ? tokens.at(position) : "end of expression";
+		throw SPXParseException(cn + mn + "Expected \"" + token + "\" but found \"" + found + "\" in ratio expression: " + expression);
+	}
+}
+
+void SPXRatioExpression::Emit(RatioOpcode_t opcode, unsigned int term, double constant) {
+	SPXRatioInstruction_t instruction;
+	instruction.opcode = opcode;
+	instruction.term = term;
+	instruction.constant = constant;
+
+	program.push_back(instruction);
+}
+
+void SPXRatioExpression::ParseSum(void) {
+	ParseProduct();
+
+	while(true) {
+		if(Accept("+")) {
+			ParseProduct();
+			Emit(RatioOpAdd);
+		} else if(Accept("-")) {
+			ParseProduct();
+			Emit(RatioOpSubtract);
+		} else {
+			return;
+		}
+	}
+}
+
+void SPXRatioExpression::ParseProduct(void) {
+	ParseUnary();
+
+	while(true) {
+		if(Accept("*")) {
+			ParseUnary();
+			Emit(RatioOpMultiply);
+		} else if(Accept("/")) {
+			ParseUnary();
+			Emit(RatioOpDivide);
+		} else {
+			return;
+		}
+	}
+}
+
+void SPXRatioExpression::ParseUnary(void) {
+	if(Accept("-")) {
+		ParseUnary();
+		Emit(RatioOpNegate);
+		return;
+	}
+
+	ParsePrimary();
+}
+
+void SPXRatioExpression::ParsePrimary(void) {
+	std::string mn = "ParsePrimary: ";
+
+	std::string token = Next();
+
+	if(token == "(") {
+		ParseSum();
+		Expect(")");
+		return;
+	}
+
+	if((token == "norm") && Accept("(")) {
+		ParseSum();
+		Expect(")");
+		Emit(RatioOpNormalise);
+		return;
+	}
+
+	if((token == ")") || (token == "]") || (token == ",") || (token == "+") || (token == "-") || (token == "*") || (token == "/")) {
+		throw SPXParseException(cn + mn + "Unexpected \"" + token + "\" in ratio expression: " + expression);
+	}
+
+	SPXRatioTerm_t term;
+	term.graph = 0;
+
+	if(token == "[") {
+		term.type = RatioTermConvolute;
+		term.grid = Next();
+		Expect(",");
+		term.pdf = Next();
+		Expect("]");
+	} else {
+		//Constant if the whole token is a number
+		char *end = 0;
+		double constant = strtod(token.c_str(), &end);
+		if(end && (*end == '\0')) {
+			Emit(RatioOpConstant, 0, constant);
+			return;
+		}
+
+		term.type = RatioTermData;
+		term.data = token;
+	}
+
+	//The same term used twice is the same entry, so it is loaded once
+	for(int i = 0; i < terms.size(); i++) {
+		if((terms.at(i).type == term.type) && (terms.at(i).data == term.data) && (terms.at(i).grid == term.grid) && (terms.at(i).pdf == term.pdf)) {
+			Emit(RatioOpTerm, i);
+			return;
+		}
+	}
+
+	terms.push_back(term);
+	Emit(RatioOpTerm, terms.size() - 1);
+}
+
+bool SPXRatioExpression::HasData(void) const {
+	for(int i = 0; i < terms.size(); i++) {
+		if(terms.at(i).type == RatioTermData) return true;
+	}
+
+	return false;
+}
+
+bool SPXRatioExpression::HasConvolute(void) const {
+	for(int i = 0; i < terms.size(); i++) {
+		if(terms.at(i).type == RatioTermConvolute) return true;
+	}
+
+	return false;
+}
+
+void SPXRatioExpression::SetTermGraph(unsigned int term, TGraphAsymmErrors *graph) {
+	std::string mn = "SetTermGraph: ";
+
+	if(!graph) {
+		throw SPXGraphException(cn + mn + "Graph is invalid");
+	}
+
+	SPXRatioTerm_t &t = terms.at(term);
+	t.graph = graph;
+	t.sources.clear();
+	t.up.clear();
+	t.down.clear();
+}
+
+void SPXRatioExpression::AddTermSource(unsigned int term, const std::string &source, const std::vector<double> &up, const std::vector<double> &down) {
+	std::string mn = "AddTermSource: ";
+
+	SPXRatioTerm_t &t = terms.at(term);
+
+	if(!t.graph) {
+		throw SPXGraphException(cn + mn + "Term graph must be set before its error sources");
+	}
+
+	if((up.size() != t.graph->GetN()) || (down.size() != t.graph->GetN())) {
+		std::ostringstream oss;
+		oss << cn << mn << "Error source " << source << " has " << up.size() << " bins, but the term has " << t.graph->GetN();
+		throw SPXGraphException(oss.str());
+	}
+
+	std::map<std::string, unsigned int>::const_iterator it = sourceIndex.find(source);
+	unsigned int index;
+	if(it == sourceIndex.end()) {
+		index = sourceNames.size();
+		sourceIndex[source] = index;
+		sourceNames.push_back(source);
+	} else {
+		index = it->second;
+	}
+
+	t.sources.push_back(index);
+	t.up.push_back(up);
+	t.down.push_back(down);
+
+	if(debug) std::cout << cn << mn << "Term " << term << ": error source " << source << " (" << index << ")" << std::endl;
+}
+
+void SPXRatioExpression::AddTermSource(unsigned int term, const std::string &source, TGraphAsymmErrors *graph) {
+	std::string mn = "AddTermSource: ";
+
+	if(!graph) {
+		throw SPXGraphException(cn + mn + "Graph of error source " + source + " is invalid");
+	}
+
+	unsigned int n = graph->GetN();
+	std::vector<double> up(graph->GetEYhigh(), graph->GetEYhigh() + n);
+	std::vector<double> down(graph->GetEYlow(), graph->GetEYlow() + n);
+
+	AddTermSource(term, source, up, down);
+}
+
+//Rows of the value block: central, then up and down variation of every source
+void SPXRatioExpression::Load(unsigned int term, double *values) const {
+	const SPXRatioTerm_t &t = terms.at(term);
+	const double *y = t.graph->GetY();
+	unsigned int n = numberOfBins;
+	unsigned int rows = 1 + 2 * sourceNames.size();
+
+	for(unsigned int r = 0; r < rows; r++) {
+		for(unsigned int i = 0; i < n; i++) {
+			values[r * n + i] = y[i];
+		}
+	}
+
+	for(int s = 0; s < t.sources.size(); s++) {
+		double *up = values + (1 + 2 * t.sources[s]) * n;
+		double *down = up + n;
+		for(unsigned int i = 0; i < n; i++) {
+			up[i] += t.up[s][i];
+			down[i] -= t.down[s][i];
+		}
+	}
+}
+
+//A zero integral (e.g. bins without width) can not be normalised: the ratio would be meaningless
+void SPXRatioExpression::Normalise(double *values, const std::vector<double> &widths) const {
+	std::string mn = "Normalise: ";
+
+	unsigned int n = numberOfBins;
+	unsigned int rows = 1 + 2 * sourceNames.size();
+
+	for(unsigned int r = 0; r < rows; r++) {
+		double *row = values + r * n;
+
+		double integral = 0.;
+		for(unsigned int i = 0; i < n; i++) {
+			integral += row[i] * widths[i];
+		}
+
+		if(integral == 0.) {
+			std::ostringstream oss;
+			oss << cn << mn << "Integral is zero in norm() of " << GetRowName(r) << " in ratio expression: " << expression;
+			throw SPXGraphException(oss.str());
+		}
+
+		for(unsigned int i = 0; i < n; i++) {
+			row[i] /= integral;
+		}
+	}
+}
+
+//Central values or the up/down variation of a source, for error messages
+std::string SPXRatioExpression::GetRowName(unsigned int row) const {
+	if(row == 0) {
+		return "the central values";
+	}
+
+	return std::string((row % 2) ? "the up" : "the down") + " variation of " + sourceNames.at((row - 1) / 2);
+}
+
+//Runs the program once over the value blocks: every operation is one loop over
+// all bins of the central values and of all source variations
+TGraphAsymmErrors * SPXRatioExpression::Evaluate(const std::string &name) {
+	std::string mn = "Evaluate: ";
+	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+	for(int i = 0; i < terms.size(); i++) {
+		if(!terms.at(i).graph) {
+			std::ostringstream oss;
+			oss << cn << mn << "No graph for term " << i << " of ratio expression: " << expression;
+			throw SPXGraphException(oss.str());
+		}
+	}
+
+	//Binning of the first term: all terms must have the same bins
+	TGraphAsymmErrors *first = terms.front().graph;
+	numberOfBins = first->GetN();
+	unsigned int n = numberOfBins;
+
+	for(int it = 1; it < terms.size(); it++) {
+		TGraphAsymmErrors *graph = terms.at(it).graph;
+		bool same = (graph->GetN() == n);
+		for(unsigned int i = 0; same && (i < n); i++) {
+			double x0 = first->GetX()[i];
+			same = (fabs(graph->GetX()[i] - x0) <= EXPRESSION_BIN_TOLERANCE * std::max(1., fabs(x0)));
+		}
+
+		if(!same) {
+			std::ostringstream oss;
+			oss << cn << mn << graph->GetName() << " (" << graph->GetN() << " bins) does not have the binning of "
+			    << first->GetName() << " (" << n << " bins) in ratio expression: " << expression;
+			throw SPXGraphException(oss.str());
+		}
+	}
+
+	std::vector<double> widths(n);
+	for(unsigned int i = 0; i < n; i++) {
+		widths[i] = first->GetEXlow()[i] + first->GetEXhigh()[i];
+	}
+
+	unsigned int rows = 1 + 2 * sourceNames.size();
+	unsigned int size = rows * n;
+
+	std::vector<std::vector<double> > stack(stackDepth, std::vector<double>(size, 0.));
+	unsigned int sp = 0;
+
+	for(int ip = 0; ip < program.size(); ip++) {
+		const SPXRatioInstruction_t &instruction = program[ip];
+
+		if(instruction.opcode == RatioOpTerm) {
+			Load(instruction.term, &stack[sp++][0]);
+			continue;
+		}
+
+		if(instruction.opcode == RatioOpConstant) {
+			stack[sp++].assign(size, instruction.constant);
+			continue;
+		}
+
+		double *a = &stack[sp - 1][0];
+
+		if(instruction.opcode == RatioOpNegate) {
+			for(unsigned int k = 0; k < size; k++) a[k] = -a[k];
+			continue;
+		}
+
+		if(instruction.opcode == RatioOpNormalise) {
+			Normalise(a, widths);
+			continue;
+		}
+
+		//Binary: a = a op b
+		a = &stack[sp - 2][0];
+		const double *b = &stack[sp - 1][0];
+		sp--;
+
+		switch(instruction.opcode) {
+			case RatioOpAdd:
+				for(unsigned int k = 0; k < size; k++) a[k] += b[k];
+				break;
+			case RatioOpSubtract:
+				for(unsigned int k = 0; k < size; k++) a[k] -= b[k];
+				break;
+			case RatioOpMultiply:
+				for(unsigned int k = 0; k < size; k++) a[k] *= b[k];
+				break;
+			case RatioOpDivide:
+				for(unsigned int k = 0; k < size; k++) {
+					if(b[k] == 0.) {
+						std::ostringstream oss;
+						oss << cn << mn << "Division by zero in bin " << k % n << " of " << GetRowName(k / n)
+						    << " in ratio expression: " << expression;
+						throw SPXGraphException(oss.str());
+					}
+					a[k] /= b[k];
+				}
+				break;
+			default:
+				throw SPXGraphException(cn + mn + "Invalid instruction in ratio expression: " + expression);
+		}
+	}
+
+	const std::vector<double> &values = stack[0];
+
+	TGraphAsymmErrors *graph = new TGraphAsymmErrors(n);
+	graph->SetName(name.c_str());
+
+	for(unsigned int i = 0; i < n; i++) {
+		double central = values[i];
+		double up2 = 0., down2 = 0.;
+
+		//Each source contributes its largest upward and downward shift
+		for(int s = 0; s < sourceNames.size(); s++) {
+			double du = values[(1 + 2 * s) * n + i] - central;
+			double dd = values[(2 + 2 * s) * n + i] - central;
+
+			double high = std::max(0., std::max(du, dd));
+			double low = std::min(0., std::min(du, dd));
+
+			up2 += high * high;
+			down2 += low * low;
+		}
+
+		graph->SetPoint(i, first->GetX()[i], central);
+		graph->SetPointError(i, first->GetEXlow()[i], first->GetEXhigh()[i], sqrt(down2), sqrt(up2));
+	}
+
+	//Style of the first term
+	graph->SetLineColor(first->GetLineColor());
+	graph->SetLineStyle(first->GetLineStyle());
+	graph->SetLineWidth(first->GetLineWidth());
+	graph->SetFillColor(first->GetFillColor());
+	graph->SetFillStyle(first->GetFillStyle());
+	graph->SetMarkerColor(first->GetMarkerColor());
+	graph->SetMarkerStyle(first->GetMarkerStyle());
+	graph->SetMarkerSize(first->GetMarkerSize());
+
+	if(debug) {
+		std::cout << cn << mn << expression << " with " << sourceNames.size() << " error sources:" << std::endl;
+		graph->Print();
+	}
+
+	return graph;
+}
@@ -0,0 +1,146 @@
+//************************************************************/
+//
+//	Ratio Expression Header
+//
+//	Outlines the SPXRatioExpression class, which compiles a
+//	ratio_N expression over data and convolute terms, e.g.
+//
+//		norm([grid_0, pdf_0]) / norm(data_0)
+//		(data_0 / data_1) / ([grid_0, pdf_0] / [grid_1, pdf_0])
+//		([grid_0, pdf_0] + [grid_1, pdf_0]) / data_0
+//
+//	into a small stack program, and evaluates it for all bins
+//	at once. Operators (+ - * /) must be separated by spaces,
+//	since file names may contain them; norm(x) divides x by its
+//	integral (sum of value times bin width).
+//
+//	Every term carries named error sources (data statistical
+//	and systematic, each PDF band component). The program is
+//	evaluated for the central values and for the up and down
+//	variation of each source: sources with the same name are
+//	varied together, so they are fully correlated between terms
+//	and e.g. cancel in data_0 / data_0. PDF sources are named
+//	after the PDF file only: the PDF uncertainty components of
+//	different grids (processes) using the same PDF file are
+//	taken as fully correlated.
+//
+//	A division by zero or the norm() of a zero integral, in the
+//	central values or in any variation, throws SPXGraphException.
+//
+//	@Author: 	Spectrum contributors
+//	@Date:		19.10.2026
+//
+//************************************************************/
+
+#ifndef SPXRATIOEXPRESSION_H
+#define SPXRATIOEXPRESSION_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "SPXROOT.h"
+#include "SPXException.h"
+
+typedef enum RatioOpcode_t {
+	RatioOpTerm = 0,		//Push term
+	RatioOpConstant = 1,		//Push constant
+	RatioOpAdd = 2,
+	RatioOpSubtract = 3,
+	RatioOpMultiply = 4,
+	RatioOpDivide = 5,
+	RatioOpNegate = 6,
+	RatioOpNormalise = 7		//Divide by the integral
+} RatioOpcode_t;
+
+typedef struct SPXRatioInstruction_t {
+	RatioOpcode_t opcode;
+	unsigned int term;		//RatioOpTerm: index in the term table
+	double constant;		//RatioOpConstant: value
+} SPXRatioInstruction_t;
+
+typedef enum RatioTermType_t {
+	RatioTermData = 0,		//Data steering file (or data_i alias)
+	RatioTermConvolute = 1		//[grid steering file, pdf steering file]
+} RatioTermType_t;
+
+typedef struct SPXRatioTerm_t {
+	RatioTermType_t type;
+	std::string data;		//Data file, as written (resolved by SPXRatio)
+	std::string grid;		//Grid file, as written
+	std::string pdf;		//PDF file, as written
+
+	TGraphAsymmErrors *graph;	//Central values and binning
+	std::vector<unsigned int> sources;		//Error source indices
+	std::vector<std::vector<double> > up;		//Shift added for the up variation of each source (signed)
+	std::vector<std::vector<double> > down;		//Shift subtracted for the down variation of each source (signed)
+} SPXRatioTerm_t;
+
+class SPXRatioExpression {
+
+public:
+	SPXRatioExpression() : numberOfBins(0), stackDepth(0) {}
+
+	void Compile(const std::string &expression);
+
+	unsigned int GetNumberOfTerms(void) const {
+		return terms.size();
+	}
+
+	SPXRatioTerm_t & GetTerm(unsigned int i) {
+		return terms.at(i);
+	}
+
+	bool HasData(void) const;
+	bool HasConvolute(void) const;
+
+	void SetTermGraph(unsigned int term, TGraphAsymmErrors *graph);
+	void AddTermSource(unsigned int term, const std::string &source, const std::vector<double> &up, const std::vector<double> &down);
+	void AddTermSource(unsigned int term, const std::string &source, TGraphAsymmErrors *graph);
+
+	TGraphAsymmErrors * Evaluate(const std::string &name);
+
+	const std::string & ToString(void) const {
+		return expression;
+	}
+
+	static bool GetDebug(void) {
+		return debug;
+	}
+
+	static void SetDebug(bool b) {
+		debug = b;
+	}
+
+private:
+	static bool debug;				// Flag indicating debug mode
+
+	std::string expression;				// Expression as given in the steering file
+	std::vector<SPXRatioTerm_t> terms;		// Term table, indexed by the program
+	std::vector<SPXRatioInstruction_t> program;	// Reverse polish program
+
+	std::vector<std::string> tokens;		// Parser state
+	unsigned int position;
+
+	std::map<std::string, unsigned int> sourceIndex;	// Error source name to index
+	std::vector<std::string> sourceNames;
+
+	unsigned int numberOfBins;
+	unsigned int stackDepth;			// Largest stack depth of the program
+
+	void Tokenize(const std::string &s);
+	void ParseSum(void);
+	void ParseProduct(void);
+	void ParseUnary(void);
+	void ParsePrimary(void);
+	void Emit(RatioOpcode_t opcode, unsigned int term = 0, double constant = 0.);
+	bool Accept(const std::string &token);
+	void Expect(const std::string &token);
+	std::string Next(void);
+
+	void Load(unsigned int term, double *values) const;
+	void Normalise(double *values, const std::vector<double> &widths) const;
+	std::string GetRowName(unsigned int row) const;
+};
+
+#endif
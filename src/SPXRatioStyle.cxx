@@ -45,6 +45,8 @@ SPXRatioStyle::SPXRatioStyle(std::string &s, unsigned int pn, unsigned int rsn)
 //		convolute / reference
 //		data / data
 //
+// or one of the special styles data_stat, data_tot and expression
+//
 // Sets the numerator and denominator bitfields based on the input string
 void SPXRatioStyle::Parse(std::string &s) {
 	std::string mn = "Parse: ";
@@ -73,6 +75,13 @@ void SPXRatioStyle::Parse(std::string &s) {
 		return;
 	}
 
+	//	expression	<-- ratio_N is an arbitrary expression over data and convolutes
+	if(!s.compare("expression")) {
+		expression = true;
+		if(debug) std::cout << cn << mn << "Ratio Style set to \"expression\"" << std::endl;
+		return;
+	}
+
 	dataStat = false;
 	dataTot = false;
 
@@ -218,6 +227,10 @@ std::string SPXRatioStyle::ToString(void) {
 		return "data_tot";
 	}
 
+	if(expression) {
+		return "expression";
+	}
+
 	//Empty style
 	if(this->IsEmpty()) {
 		return "";
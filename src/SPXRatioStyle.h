@@ -26,13 +26,14 @@ const int RS_NOMINAL = 		(1 << 3);	//0b00001000
 class SPXRatioStyle {
 
 public:
-	SPXRatioStyle () : numerator(0), denominator(0), dataStat(false), dataTot(false) {}
+	SPXRatioStyle () : numerator(0), denominator(0), dataStat(false), dataTot(false), expression(false) {}
 	SPXRatioStyle(unsigned int numerator, unsigned int denominator) {
 		this->numerator = numerator;
 		this->denominator = denominator;
 
 		dataStat = false;
 		dataTot = false;
+		expression = false;
 	}
 
 	//Constructor with style string, plot number string, and ratio style number string
@@ -50,6 +51,7 @@ public:
 
 		dataStat = false;
 		dataTot = false;
+		expression = false;
 
 		zeroNumeratorErrors = false;
 		zeroDenominatorErrors = false;
@@ -81,6 +83,10 @@ public:
 		return dataTot;
 	}
 
+	bool IsExpression(void) {
+		return expression;
+	}
+
 	bool GetZeroNumeratorErrors(void) {
 		return zeroNumeratorErrors;
 	}
@@ -179,6 +185,8 @@ public:
 		return false;
 	}
 
+	friend class SPXSteeringBundle;
+
 private:
 	static bool debug;
 	unsigned int numerator;
@@ -186,6 +194,7 @@ private:
 
 	bool dataStat;	//Special ratio: Plot data/data with statistical errors
 	bool dataTot;	//Specrial ratio: Plot data/data with total errors
+	bool expression;	//Special ratio: ratio_N is an expression over data and convolutes (SPXRatioExpression)
 
 	bool zeroNumeratorErrors;		//Flags for whether or not to zero num/den errors. Set with '!' in steering file
 	bool zeroDenominatorErrors;
@@ -0,0 +1,280 @@
+//************************************************************/
+//
+//	Render Pool Implementation
+//
+//	Implements the SPXRenderPool class
+//
+//	@Author: 	Spectrum contributors
+//	@Date:		19.10.2026
+//
+//************************************************************/
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+
+#include "SPXRenderPool.h"
+#include "SPXUtilities.h"
+
+//Class name for debug statements
+const std::string cn = "SPXRenderPool::";
+
+//Must define the static debug variable in the implementation
+bool SPXRenderPool::debug;
+
+//Prefix of the line a failed worker writes to its pipe, after the files it did write
+const std::string SPX_RENDER_ERROR = "ERROR ";
+
+SPXRenderPool::SPXRenderPool(unsigned int numberOfWorkers) {
+	this->numberOfWorkers = (numberOfWorkers > 0) ? numberOfWorkers : 1;
+	this->running = 0;
+}
+
+double SPXRenderPool::GetTime(void) {
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0;
+}
+
+//Forks a worker drawing the (initialized) plot; waits for a free slot first
+void SPXRenderPool::Submit(SPXPlot &plot, unsigned int id) {
+	std::string mn = "Submit: ";
+	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+	while(running >= numberOfWorkers) {
+		WaitForWorker();
+	}
+
+	int fds[2];
+	if(pipe(fds) != 0) {
+		throw SPXGeneralException(cn + mn + "Unable to create pipe: " + strerror(errno));
+	}
+
+	//The worker must not inherit raster files being written by threads of this process
+	SPXOutputManager::Wait();
+
+	//Buffered output would otherwise be written by both processes
+	std::cout.flush();
+	std::cerr.flush();
+
+	pid_t pid = fork();
+
+	if(pid < 0) {
+		close(fds[0]);
+		close(fds[1]);
+		throw SPXGeneralException(cn + mn + "Unable to fork render worker: " + strerror(errno));
+	}
+
+	if(pid == 0) {
+		close(fds[0]);
+		RunWorker(plot, fds[1]);
+	}
+
+	close(fds[1]);
+
+	SPXRenderJob_t job;
+	job.plot = id;
+	job.pid = pid;
+	job.pipe = fds[0];
+	job.start = GetTime();
+	job.time = 0;
+	job.status = 0;
+	jobs.push_back(job);
+
+	running++;
+
+	if(debug) std::cout << cn << mn << "Plot " << id << " is drawn by worker " << pid << std::endl;
+}
+
+//Writes all of s to fd: false if the pipe is broken
+bool SPXRenderPool::WriteAll(int fd, const std::string &s) {
+	const char *p = s.c_str();
+	size_t left = s.size();
+
+	while(left > 0) {
+		ssize_t n = write(fd, p, left);
+		if(n < 0 && errno == EINTR) continue;
+		if(n <= 0) return false;
+		p += n;
+		left -= n;
+	}
+
+	return true;
+}
+
+//Worker process: draws and writes the plot, reports the files written (or the error) and
+// exits without running the destructors and exit handlers of the main process: nothing may
+// leave this function other than through _exit
+void SPXRenderPool::RunWorker(SPXPlot &plot, int fd) {
+	int status = 0;
+	std::string error;
+	std::ostringstream oss;
+
+	gROOT->SetBatch(kTRUE);
+
+	try {
+		plot.Plot();
+
+		const std::vector<std::string> &files = plot.GetOutputFiles();
+		for(int i = 0; i < files.size(); i++) {
+			oss << files[i] << std::endl;
+		}
+
+		//Closes the ROOT file(s) of the plot
+		plot.Release();
+
+		if(SPXOutputManager::Wait()) {
+			error = "Could not write all graphic files";
+		}
+	} catch(const SPXException &e) {
+		error = e.what();
+	} catch(const std::exception &e) {
+		error = e.what();
+	} catch(...) {
+		error = "Unknown exception";
+	}
+
+	//One line per file, then the error if there was one
+	if(!error.empty()) {
+		std::cerr << error << std::endl;
+		std::replace(error.begin(), error.end(), '\n', ' ');
+		oss << SPX_RENDER_ERROR << error << std::endl;
+		status = 1;
+	}
+
+	if(!WriteAll(fd, oss.str())) {
+		status = 1;
+	}
+
+	close(fd);
+
+	std::cout.flush();
+	std::cerr.flush();
+
+	_exit(status);
+}
+
+//Reaps the oldest running worker: its pipe is read to the end before waiting for it, so that
+// a worker never blocks on a full pipe, and only this worker is waited for
+void SPXRenderPool::WaitForWorker(void) {
+	std::string mn = "WaitForWorker: ";
+
+	SPXRenderJob_t *job = 0;
+	for(int i = 0; i < jobs.size() && !job; i++) {
+		if(jobs[i].pid != 0) job = &jobs[i];
+	}
+
+	if(!job) {
+		running = 0;
+		return;
+	}
+
+	//The pipe reaches its end when the worker has exited
+	std::string data;
+	char buffer[4096];
+	ssize_t n;
+	while((n = read(job->pipe, buffer, sizeof(buffer))) != 0) {
+		if(n < 0) {
+			if(errno == EINTR) continue;
+			break;
+		}
+		data.append(buffer, n);
+	}
+	close(job->pipe);
+
+	int status = 0;
+	pid_t pid;
+	do {
+		pid = waitpid(job->pid, &status, 0);
+	} while(pid < 0 && errno == EINTR);
+
+	job->time = GetTime() - job->start;
+	if(pid < 0) {
+		std::cerr << cn << mn << "WARNING: waitpid failed for worker " << job->pid << ": " << strerror(errno) << std::endl;
+		job->status = -1;
+	} else {
+		job->status = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+	}
+	job->pid = 0;
+
+	std::string error;
+	std::istringstream iss(data);
+	std::string line;
+	while(std::getline(iss, line)) {
+		if(!line.compare(0, SPX_RENDER_ERROR.size(), SPX_RENDER_ERROR)) {
+			error = line.substr(SPX_RENDER_ERROR.size());
+		} else if(!line.empty()) {
+			job->outputFiles.push_back(line);
+		}
+	}
+
+	//A worker reporting an error has failed, whatever its exit status
+	if(!error.empty() && job->status == 0) {
+		job->status = 1;
+	}
+
+	running--;
+
+	if(job->status != 0) {
+		std::cerr << cn << mn << "WARNING: Worker drawing plot " << job->plot << " failed (status " << job->status << ")";
+		if(!error.empty()) std::cerr << ": " << error;
+		std::cerr << std::endl;
+	} else if(debug) {
+		std::cout << cn << mn << "Plot " << job->plot << " drawn in " << job->time << " ms" << std::endl;
+	}
+}
+
+void SPXRenderPool::Wait(void) {
+	while(running > 0) {
+		WaitForWorker();
+	}
+}
+
+unsigned int SPXRenderPool::GetNumberOfFailures(void) const {
+	unsigned int failures = 0;
+
+	for(int i = 0; i < jobs.size(); i++) {
+		if(jobs[i].status != 0) failures++;
+	}
+
+	return failures;
+}
+
+std::vector<std::string> SPXRenderPool::GetOutputFiles(void) const {
+	std::vector<std::string> files;
+
+	for(int i = 0; i < jobs.size(); i++) {
+		files.insert(files.end(), jobs[i].outputFiles.begin(), jobs[i].outputFiles.end());
+	}
+
+	return files;
+}
+
+void SPXRenderPool::PrintSummary(std::ostream &out) const {
+	double total = 0;
+
+	out << std::endl;
+	out << "==================================" << std::endl;
+	out << "      	Render Workers		        " << std::endl;
+	out << "==================================" << std::endl;
+	out << std::left << std::setw(8) << "plot" << std::right << std::setw(10) << "status" << std::setw(12) << "time [ms]"
+	    << std::setw(8) << "files" << std::endl;
+
+	for(int i = 0; i < jobs.size(); i++) {
+		const SPXRenderJob_t &job = jobs[i];
+
+		out << std::left << std::setw(8) << job.plot << std::right << std::setw(10) << job.status
+		    << std::setw(12) << std::fixed << std::setprecision(1) << job.time << std::setw(8) << job.outputFiles.size() << std::endl;
+
+		total += job.time;
+	}
+
+	out << jobs.size() << " plots on " << numberOfWorkers << " workers, " << std::fixed << std::setprecision(1)
+	    << total << " ms of drawing, " << GetNumberOfFailures() << " failed" << std::endl;
+	out << "==================================" << std::endl;
+}
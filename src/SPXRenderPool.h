@@ -0,0 +1,77 @@
+//************************************************************/
+//
+//	Render Pool Header
+//
+//	Outlines the SPXRenderPool class, which draws plots in
+//	parallel worker processes (Spectrum --render-workers <n>).
+//	ROOT graphics are not thread safe, so each plot is drawn in
+//	its own process: once the main process has computed a plot
+//	(data, convolutions, ratios) it forks, and the child draws
+//	and writes it (canvas, PNG/EPS/ROOT/table output) from its
+//	copy of the computed objects, then reports its output files
+//	(and its error, if it failed) through a pipe and exits. The
+//	main process continues with the next plot, with at most <n>
+//	workers at a time, and collects the exit status and wall
+//	time of every worker.
+//
+//	@Author: 	Spectrum contributors
+//	@Date:		19.10.2026
+//
+//************************************************************/
+
+#ifndef SPXRENDERPOOL_H
+#define SPXRENDERPOOL_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+#include "SPXPlot.h"
+#include "SPXException.h"
+
+//One plot handed to a worker process
+typedef struct SPXRenderJob_t {
+	unsigned int plot;			// Plot number
+	pid_t pid;				// Worker process (0: finished)
+	int pipe;				// Read end of the output file pipe
+	double start;				// Wall time of the fork [ms]
+	double time;				// Wall time until the worker was reaped [ms]
+	int status;				// Exit status (0: success, -1: killed by a signal)
+	std::vector<std::string> outputFiles;	// Files written by the worker
+} SPXRenderJob_t;
+
+class SPXRenderPool {
+
+public:
+	explicit SPXRenderPool(unsigned int numberOfWorkers);
+
+	void Submit(SPXPlot &plot, unsigned int id);
+	void Wait(void);
+
+	unsigned int GetNumberOfFailures(void) const;
+	std::vector<std::string> GetOutputFiles(void) const;
+	void PrintSummary(std::ostream &out) const;
+
+	static bool GetDebug(void) {
+		return debug;
+	}
+
+	static void SetDebug(bool b) {
+		debug = b;
+	}
+
+private:
+	static bool debug;			// Flag indicating debug mode
+
+	unsigned int numberOfWorkers;		// Largest number of workers running at once
+	unsigned int running;			// Workers not reaped yet
+	std::vector<SPXRenderJob_t> jobs;	// In order of submission
+
+	void WaitForWorker(void);
+	static void RunWorker(SPXPlot &plot, int fd);
+	static bool WriteAll(int fd, const std::string &s);
+	static double GetTime(void);
+};
+
+#endif
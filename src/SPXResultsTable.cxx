@@ -0,0 +1,391 @@
+//************************************************************/
+//
+//	Results Table Implementation
+//
+//	Implements the SPXResultsTable class, which collects the
+//	per-bin results of one plot into a single columnar table
+//
+//	@Author: 	Spectrum contributors
+//	@Date:		19.10.2026
+//
+//************************************************************/
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <limits>
+#include <cmath>
+
+#include "SPXResultsTable.h"
+#include "SPXUtilities.h"
+
+//Class name for debug statements
+const std::string cn = "SPXResultsTable::";
+
+//Must define the static debug variable in the implementation
+bool SPXResultsTable::debug;
+
+SPXResultsTable::SPXResultsTable(std::vector<SPXData*> &data, std::vector<SPXCrossSection> &crossSections) {
+	std::string mn = "SPXResultsTable: ";
+	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+	numberOfRows = 0;
+
+	this->Fill(data, crossSections);
+}
+
+//Column names may only contain characters that are valid in a TTree leaf name: '+' and '-' (asymmetric
+//	systematics) are spelled out, other characters become '_', and a name already used gets a numeric suffix
+std::string SPXResultsTable::GetColumnName(const std::string &name) {
+	std::string s;
+
+	for(int i = 0; i < name.size(); i++) {
+		if(isalnum((int)name[i])) {
+			s += name[i];
+		} else if(name[i] == '+') {
+			s += "_plus";
+		} else if(name[i] == '-') {
+			s += "_minus";
+		} else {
+			s += '_';
+		}
+	}
+
+	std::string unique = s;
+
+	for(int i = 2; usedNames.count(unique); i++) {
+		std::ostringstream oss;
+		oss << s << "_" << i;
+		unique = oss.str();
+	}
+
+	if(unique != s) {
+		std::cerr << cn << "GetColumnName: WARNING: Column name " << s << " (" << name << ") already used: Renamed to " << unique << std::endl;
+	}
+
+	usedNames.insert(unique);
+
+	return unique;
+}
+
+//Row of the bin with the given edges, or -1 if the table has no such bin
+int SPXResultsTable::FindRow(double low, double high) const {
+	for(int i = 0; i < numberOfRows; i++) {
+		double tolerance = 1e-6 * fabs(xhigh[i] - xlow[i]);
+
+		if(fabs(low - xlow[i]) <= tolerance && fabs(high - xhigh[i]) <= tolerance) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+//Rows of the bins of a graph (-1 for bins the table does not have)
+std::vector<int> SPXResultsTable::GetRows(const std::string &name, TGraphAsymmErrors *g) const {
+	std::vector<int> rows(g->GetN());
+	unsigned int unmatched = 0;
+
+	for(int i = 0; i < g->GetN(); i++) {
+		double x = g->GetX()[i];
+		rows[i] = FindRow(x - g->GetErrorXlow(i), x + g->GetErrorXhigh(i));
+		if(rows[i] < 0) unmatched++;
+	}
+
+	if(unmatched) {
+		std::cerr << cn << "GetRows: WARNING: " << unmatched << " bin(s) of " << name << " are not bins of the table: Not written" << std::endl;
+	}
+
+	return rows;
+}
+
+std::vector<int> SPXResultsTable::GetRows(const std::string &name, TH1 *h) const {
+	std::vector<int> rows(h->GetNbinsX());
+	unsigned int unmatched = 0;
+
+	for(int i = 0; i < h->GetNbinsX(); i++) {
+		rows[i] = FindRow(h->GetBinLowEdge(i + 1), h->GetBinLowEdge(i + 1) + h->GetBinWidth(i + 1));
+		if(rows[i] < 0) unmatched++;
+	}
+
+	if(unmatched) {
+		std::cerr << cn << "GetRows: WARNING: " << unmatched << " bin(s) of " << name << " are not bins of the table: Not written" << std::endl;
+	}
+
+	return rows;
+}
+
+//Bin edge columns: every other column is matched to these bins by its bin edges
+void SPXResultsTable::SetBins(const std::vector<double> &x, const std::vector<double> &xlow, const std::vector<double> &xhigh) {
+	numberOfRows = x.size();
+	this->xlow = xlow;
+	this->xhigh = xhigh;
+
+	AddColumn("x", std::vector<int>(), x);
+	AddColumn("xlow", std::vector<int>(), xlow);
+	AddColumn("xhigh", std::vector<int>(), xhigh);
+}
+
+//Values of bin i go to row rows[i] (all rows if rows is empty), rows without a value are NaN
+void SPXResultsTable::AddColumn(const std::string &name, const std::vector<int> &rows, const std::vector<double> &values) {
+	std::string mn = "AddColumn: ";
+
+	std::vector<double> column(numberOfRows, std::numeric_limits<double>::quiet_NaN());
+
+	for(int i = 0; i < values.size(); i++) {
+		int row = rows.empty() ? i : rows[i];
+		if(row >= 0 && row < numberOfRows) column[row] = values[i];
+	}
+
+	names.push_back(GetColumnName(name));
+	columns.push_back(column);
+
+	if(debug) std::cout << cn << mn << "Added column " << names.back() << " with " << values.size() << " rows" << std::endl;
+}
+
+//Per-plot value, e.g. a chi2: written in the canonical form only, the columnar forms have one row per bin
+void SPXResultsTable::AddScalar(const std::string &name, double value) {
+	scalarNames.push_back(GetColumnName(name));
+	scalars.push_back(value);
+}
+
+//Adds (central,) low and high edge columns of a graph: low = y - eyl, high = y + eyh
+void SPXResultsTable::AddGraphColumns(const std::string &prefix, TGraphAsymmErrors *g, bool central) {
+	if(!g) {
+		return;
+	}
+
+	int n = g->GetN();
+	std::vector<double> y(n), low(n), high(n);
+
+	for(int i = 0; i < n; i++) {
+		y[i]    = g->GetY()[i];
+		low[i]  = y[i] - g->GetErrorYlow(i);
+		high[i] = y[i] + g->GetErrorYhigh(i);
+	}
+
+	std::vector<int> rows = GetRows(prefix, g);
+
+	if(central) AddColumn(prefix, rows, y);
+	AddColumn(prefix + "_low", rows, low);
+	AddColumn(prefix + "_high", rows, high);
+}
+
+void SPXResultsTable::AddGraphCentralColumn(const std::string &name, TGraphAsymmErrors *g) {
+	if(!g) {
+		return;
+	}
+
+	AddColumn(name, GetRows(name, g), std::vector<double>(g->GetY(), g->GetY() + g->GetN()));
+}
+
+//Central, low and high edge columns of a graph which is not part of the plot data, e.g. a ratio
+void SPXResultsTable::AddGraph(const std::string &prefix, TGraphAsymmErrors *g) {
+	AddGraphColumns(prefix, g, true);
+}
+
+void SPXResultsTable::AddHistogramColumn(const std::string &name, TH1 *h) {
+	if(!h) {
+		return;
+	}
+
+	int n = h->GetNbinsX();
+	std::vector<double> y(n);
+
+	for(int i = 0; i < n; i++) {
+		y[i] = h->GetBinContent(i + 1);
+	}
+
+	AddColumn(name, GetRows(name, h), y);
+}
+
+void SPXResultsTable::Fill(std::vector<SPXData*> &data, std::vector<SPXCrossSection> &crossSections) {
+	std::string mn = "Fill: ";
+	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+	//Bin edges from the master graph: 0th data set, or the 0th cross section if there is no data
+	TGraphAsymmErrors *master = 0;
+	if(data.size() > 0) {
+		master = data.at(0)->GetTotalErrorGraph();
+	} else if(crossSections.size() > 0 && crossSections.at(0).GetPDF()) {
+		SPXPDF *pdf = crossSections.at(0).GetPDF();
+		if(pdf->GetNBands() > 0) master = pdf->GetBand(0);
+	}
+
+	if(!master) {
+		throw SPXGraphException(cn + mn + "No data or cross section graph to take the binning from");
+	}
+
+	int nbins = master->GetN();
+	std::vector<double> x(nbins), xlow(nbins), xhigh(nbins);
+
+	for(int i = 0; i < nbins; i++) {
+		x[i]     = master->GetX()[i];
+		xlow[i]  = x[i] - master->GetErrorXlow(i);
+		xhigh[i] = x[i] + master->GetErrorXhigh(i);
+	}
+
+	SetBins(x, xlow, xhigh);
+
+	for(int icross = 0; icross < crossSections.size(); icross++) {
+		SPXPDF *pdf = crossSections.at(icross).GetPDF();
+		if(!pdf) {
+			std::cout << cn << mn << "WARNING: PDF object not found for cross section " << icross << std::endl;
+			continue;
+		}
+
+		std::ostringstream prefix;
+		prefix << "xsec" << icross << "_";
+
+		//All bands share the nominal central value: one "nominal" column, then the edges of each band
+		if(pdf->GetNBands() > 0) {
+			AddGraphCentralColumn(prefix.str() + "nominal", pdf->GetBand(0));
+		}
+
+		for(int iband = 0; iband < pdf->GetNBands(); iband++) {
+			AddGraphColumns(prefix.str() + pdf->GetBandType(iband), pdf->GetBand(iband), false);
+		}
+
+		for(int i = 0; i < pdf->GetNumberOfIndividualPDFComponents(); i++) {
+			std::ostringstream name;
+			name << prefix.str() << "pdf_member_" << i;
+			AddHistogramColumn(name.str(), pdf->GetIndividualPDFComponent(i));
+		}
+
+		for(int i = 0; i < pdf->GetNumberOfIndividualScaleVariations(); i++) {
+			std::ostringstream name;
+			name << prefix.str() << "scale_" << i;
+			AddHistogramColumn(name.str(), pdf->GetIndividualScaleVariation(i));
+		}
+
+		for(int i = 0; i < pdf->GetNumberOfIndividualAlphaSVariations(); i++) {
+			std::ostringstream name;
+			name << prefix.str() << "alphas_" << i;
+			AddHistogramColumn(name.str(), pdf->GetIndividualAlphaSVariation(i));
+		}
+	}
+
+	for(int idata = 0; idata < data.size(); idata++) {
+		std::ostringstream prefix;
+		prefix << "data" << idata << "_";
+
+		AddGraphColumns(prefix.str() + "sigma", data.at(idata)->GetTotalErrorGraph(), true);
+		AddGraphColumns(prefix.str() + "stat", data.at(idata)->GetStatisticalErrorGraph(), false);
+		AddGraphColumns(prefix.str() + "syst", data.at(idata)->GetSystematicErrorGraph(), false);
+
+		std::vector<TGraphAsymmErrors *> vsyst = data.at(idata)->GetSystematicsErrorGraphs();
+		for(int isyst = 0; isyst < vsyst.size(); isyst++) {
+			if(!vsyst.at(isyst)) continue;
+			//Systematics are named syst_<name> already
+			std::string name = vsyst.at(isyst)->GetName();
+			if(name.compare(0, 5, "syst_") == 0) name.erase(0, 5);
+
+			AddGraphColumns(prefix.str() + "syst_" + name, vsyst.at(isyst), false);
+		}
+	}
+
+	if(debug) std::cout << cn << mn << "Table has " << names.size() << " columns and " << numberOfRows << " rows" << std::endl;
+}
+
+void SPXResultsTable::Write(const std::string &filename, const std::string &format) {
+	std::string mn = "Write: ";
+	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+	if(format == "csv") {
+		WriteCSV(filename);
+	} else if(format == "root") {
+		WriteTree(filename);
+	} else {
+		throw SPXParseException(cn + mn + "Unknown results table format \"" + format + "\": Must be csv or root");
+	}
+
+	std::cout << cn << mn << "Wrote " << numberOfRows << " bins x " << names.size() << " columns to " << filename << std::endl;
+}
+
+void SPXResultsTable::WriteCSV(const std::string &filename) {
+	std::string mn = "WriteCSV: ";
+
+	std::ofstream file(filename.c_str(), std::ios::trunc);
+
+	if(!file.is_open()) {
+		throw SPXFileIOException(filename, "Unable to open results table file");
+	}
+
+	for(int j = 0; j < names.size(); j++) {
+		file << (j ? "," : "") << names[j];
+	}
+	file << std::endl;
+
+	file << std::setprecision(std::numeric_limits<double>::digits10 + 1);
+
+	for(int i = 0; i < numberOfRows; i++) {
+		for(int j = 0; j < columns.size(); j++) {
+			if(j) file << ",";
+			if(i < columns[j].size()) file << columns[j][i];
+			else                      file << "nan";
+		}
+		file << std::endl;
+	}
+
+	file.close();
+}
+
+//One line per value: quantity,bin,value (bin -1 for per-plot values), in column order
+void SPXResultsTable::WriteCanonical(const std::string &filename) {
+	std::string mn = "WriteCanonical: ";
+	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+	std::ofstream file(filename.c_str(), std::ios::trunc);
+
+	if(!file.is_open()) {
+		throw SPXFileIOException(filename, "Unable to open results dump file");
+	}
+
+	file << "quantity,bin,value" << std::endl;
+	file << std::setprecision(std::numeric_limits<double>::digits10 + 2);
+
+	for(int j = 0; j < columns.size(); j++) {
+		for(int i = 0; i < columns[j].size(); i++) {
+			file << names[j] << "," << i << "," << columns[j][i] << std::endl;
+		}
+	}
+
+	for(int j = 0; j < scalars.size(); j++) {
+		file << scalarNames[j] << ",-1," << scalars[j] << std::endl;
+	}
+
+	file.close();
+
+	if(debug) std::cout << cn << mn << "Wrote " << names.size() << " columns and " << scalars.size() << " values to " << filename << std::endl;
+}
+
+void SPXResultsTable::WriteTree(const std::string &filename) {
+	std::string mn = "WriteTree: ";
+
+	TFile *file = new TFile(filename.c_str(), "recreate");
+
+	if(!file || file->IsZombie()) {
+		delete file;
+		throw SPXFileIOException(filename, "Unable to open results table ROOT file");
+	}
+
+	TTree *tree = new TTree("results", "Spectrum per-bin results");
+
+	//One double branch per column, filled row by row from a single buffer
+	std::vector<double> row(columns.size());
+
+	for(int j = 0; j < names.size(); j++) {
+		tree->Branch(names[j].c_str(), &row[j], (names[j] + "/D").c_str());
+	}
+
+	for(int i = 0; i < numberOfRows; i++) {
+		for(int j = 0; j < columns.size(); j++) {
+			row[j] = (i < columns[j].size()) ? columns[j][i] : std::numeric_limits<double>::quiet_NaN();
+		}
+		tree->Fill();
+	}
+
+	tree->Write();
+	file->Close();
+	delete file;
+}
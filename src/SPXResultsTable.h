@@ -0,0 +1,101 @@
+//************************************************************/
+//
+//	Results Table Header
+//
+//	Outlines the SPXResultsTable class, which collects the
+//	per-bin results of one plot (cross section nominal, bands,
+//	individual PDF members and scale/alphas variations, data and
+//	systematics) into a single columnar table, written as CSV
+//	or as a ROOT TTree with one entry per bin. The bins are those
+//	of the 0th data set (or of the 0th cross section): the values
+//	of every other graph or histogram are matched to them by
+//	their bin edges, and are NaN in the bins they do not have.
+//
+//	The canonical form (WriteCanonical, Spectrum --dump) has one
+//	line per value, "quantity,bin,value" with full precision, and
+//	also holds per-plot numbers such as chi2: it is the form kept
+//	as golden output by the regression runner (regression/)
+//
+//	@Author: 	Spectrum contributors
+//	@Date:		19.10.2026
+//
+//************************************************************/
+
+#ifndef SPXRESULTSTABLE_H
+#define SPXRESULTSTABLE_H
+
+#include <vector>
+#include <string>
+#include <set>
+
+#include "SPXCrossSection.h"
+#include "SPXData.h"
+
+#include "SPXException.h"
+
+class SPXResultsTable {
+
+public:
+
+	SPXResultsTable(std::vector<SPXData*> &data, std::vector<SPXCrossSection> &crossSections);
+
+	void Write(const std::string &filename, const std::string &format);
+	void WriteCanonical(const std::string &filename);
+
+	void AddScalar(const std::string &name, double value);
+	void AddGraph(const std::string &prefix, TGraphAsymmErrors *g);
+
+	unsigned int GetNumberOfColumns(void) const {
+		return names.size();
+	}
+
+	unsigned int GetNumberOfRows(void) const {
+		return numberOfRows;
+	}
+
+	static bool IsValidFormat(const std::string &format) {
+		return (format == "csv") || (format == "root");
+	}
+
+	static bool GetDebug(void) {
+		return debug;
+	}
+
+	static void SetDebug(bool b) {
+		debug = b;
+	}
+
+private:
+	static bool debug;					// Flag indicating debug mode
+
+	unsigned int numberOfRows;				// Number of bins (rows) in the table
+
+	std::vector<std::string> names;				// Column names
+	std::vector<std::vector<double> > columns;		// Column values, one entry per bin (NaN if a column does not have the bin)
+	std::set<std::string> usedNames;			// Column and per-plot value names given out so far
+
+	std::vector<double> xlow;				// Bin edges of the rows
+	std::vector<double> xhigh;
+
+	std::vector<std::string> scalarNames;			// Per-plot values (canonical form only)
+	std::vector<double> scalars;
+
+	void SetBins(const std::vector<double> &x, const std::vector<double> &xlow, const std::vector<double> &xhigh);
+	int FindRow(double low, double high) const;
+	std::vector<int> GetRows(const std::string &name, TGraphAsymmErrors *g) const;
+	std::vector<int> GetRows(const std::string &name, TH1 *h) const;
+
+	void AddColumn(const std::string &name, const std::vector<int> &rows, const std::vector<double> &values);
+	void AddGraphColumns(const std::string &prefix, TGraphAsymmErrors *g, bool central);
+	void AddGraphCentralColumn(const std::string &name, TGraphAsymmErrors *g);
+	void AddHistogramColumn(const std::string &name, TH1 *h);
+
+	void Fill(std::vector<SPXData*> &data, std::vector<SPXCrossSection> &crossSections);
+
+	void WriteCSV(const std::string &filename);
+	void WriteTree(const std::string &filename);
+
+	std::string GetColumnName(const std::string &name);
+};
+
+#endif
@@ -0,0 +1,231 @@
+//************************************************************/
+//
+//	Server Implementation
+//
+//	Implements the SPXServer class (Spectrum --serve mode)
+//
+//	@Author: 	Spectrum contributors
+//	@Date:		19.10.2026
+//
+//************************************************************/
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "SPXServer.h"
+#include "SPXSteeringFile.h"
+#include "SPXAnalysis.h"
+#include "SPXGrid.h"
+#include "SPXPDF.h"
+#include "SPXUtilities.h"
+
+//Class name for debug statements
+const std::string cn = "SPXServer::";
+
+//Must define the static debug variable in the implementation
+bool SPXServer::debug;
+
+//Longest accepted request line (a steering file path)
+const unsigned int MAX_REQUEST_SIZE = 4096;
+
+//Wall time in ms
+double SPXServer::GetTime(void) {
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0;
+}
+
+void SPXServer::Run(void) {
+	std::string mn = "Run: ";
+	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+	struct sockaddr_un address;
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+
+	if(socketPath.empty() || socketPath.size() >= sizeof(address.sun_path)) {
+		throw SPXGeneralException(cn + mn + "Invalid socket path \"" + socketPath + "\"");
+	}
+
+	strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+	int server = socket(AF_UNIX, SOCK_STREAM, 0);
+	if(server < 0) {
+		throw SPXGeneralException(cn + mn + "Unable to create socket: " + strerror(errno));
+	}
+
+	//Remove a stale socket left behind by a previous server
+	unlink(socketPath.c_str());
+
+	if(bind(server, (struct sockaddr *)&address, sizeof(address)) < 0) {
+		close(server);
+		throw SPXGeneralException(cn + mn + "Unable to bind socket " + socketPath + ": " + strerror(errno));
+	}
+
+	if(listen(server, 8) < 0) {
+		close(server);
+		throw SPXGeneralException(cn + mn + "Unable to listen on socket " + socketPath + ": " + strerror(errno));
+	}
+
+	std::cout << cn << mn << "Listening on " << socketPath << std::endl;
+
+	bool running = true;
+
+	while(running) {
+		int client = accept(server, NULL, NULL);
+
+		if(client < 0) {
+			if(errno == EINTR) continue;
+			std::cerr << cn << mn << "WARNING: accept failed: " << strerror(errno) << std::endl;
+			continue;
+		}
+
+		std::string request = SPXStringUtilities::Trim(ReadRequest(client));
+		if(debug) std::cout << cn << mn << "Request: \"" << request << "\"" << std::endl;
+
+		if(request.empty()) {
+			Reply(client, "ERROR empty request\nEND\n");
+		} else if(request == "quit") {
+			Reply(client, "BYE\n");
+			running = false;
+		} else if(request == "stats") {
+			Reply(client, GetStatistics() + "END\n");
+		} else {
+			Reply(client, ProcessSteeringFile(request));
+		}
+
+		close(client);
+	}
+
+	close(server);
+	unlink(socketPath.c_str());
+
+	std::cout << cn << mn << "Server stopped after " << numberOfRequests << " request(s)" << std::endl;
+}
+
+//Reads up to the first newline (or until the client closes its end)
+std::string SPXServer::ReadRequest(int fd) {
+	std::string request;
+	char c;
+
+	while(request.size() < MAX_REQUEST_SIZE) {
+		ssize_t n = read(fd, &c, 1);
+
+		if(n < 0 && errno == EINTR) continue;
+		if(n <= 0 || c == '\n') break;
+
+		request += c;
+	}
+
+	return request;
+}
+
+void SPXServer::Reply(int fd, const std::string &s) {
+	std::string mn = "Reply: ";
+
+	size_t written = 0;
+
+	while(written < s.size()) {
+		ssize_t n = write(fd, s.c_str() + written, s.size() - written);
+
+		if(n < 0 && errno == EINTR) continue;
+		if(n <= 0) {
+			std::cerr << cn << mn << "WARNING: Client went away before the reply was complete" << std::endl;
+			return;
+		}
+
+		written += n;
+	}
+}
+
+//Runs the full analysis for one steering file: grids and PDF members are served from the process-wide caches
+std::string SPXServer::ProcessSteeringFile(const std::string &file) {
+	std::string mn = "ProcessSteeringFile: ";
+	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+	std::ostringstream reply;
+	numberOfRequests++;
+
+	double t0 = GetTime();
+
+	//Released after the request whether it succeeded or not: the server keeps no plot between requests
+	SPXSteeringFile *steeringFile = 0;
+	SPXAnalysis *analysis = 0;
+
+	try {
+		//Steering files are cheap and may have been edited since the last request: always re-read them
+		//	(a compiled bundle is only used if none of its steering files changed)
+		SPXSteeringFile::ClearSteeringFileCache();
+
+		steeringFile = new SPXSteeringFile(file);
+		steeringFile->LoadAll(false);
+		double t1 = GetTime();
+
+		analysis = new SPXAnalysis(steeringFile);
+		double t2 = GetTime();
+
+		analysis->Run();
+		double t3 = GetTime();
+
+		std::vector<std::string> files = analysis->GetOutputFiles();
+
+		reply << "OK " << file << std::endl;
+		reply << "time_parse_ms " << t1 - t0 << std::endl;
+		reply << "time_initialize_ms " << t2 - t1 << std::endl;
+		reply << "time_run_ms " << t3 - t2 << std::endl;
+		reply << "time_total_ms " << t3 - t0 << std::endl;
+
+		for(int i = 0; i < files.size(); i++) {
+			reply << "output " << files.at(i) << std::endl;
+		}
+
+		std::cout << cn << mn << "Processed " << file << " in " << t3 - t0 << " ms" << std::endl;
+
+	} catch(const SPXException &e) {
+		std::cerr << e.what() << std::endl;
+		std::cerr << cn << mn << "Unable to process steering file: " << file << std::endl;
+
+		reply.str("");
+		reply << "ERROR " << file << ": " << e.what() << std::endl;
+		reply << "time_total_ms " << GetTime() - t0 << std::endl;
+	} catch(const std::exception &e) {
+		std::cerr << cn << mn << "Unable to process steering file: " << file << ": " << e.what() << std::endl;
+
+		reply.str("");
+		reply << "ERROR " << file << ": " << e.what() << std::endl;
+		reply << "time_total_ms " << GetTime() - t0 << std::endl;
+	} catch(...) {
+		std::cerr << cn << mn << "Unable to process steering file: " << file << ": Unknown exception" << std::endl;
+
+		reply.str("");
+		reply << "ERROR " << file << ": Unknown exception" << std::endl;
+		reply << "time_total_ms " << GetTime() - t0 << std::endl;
+	}
+
+	if(analysis) {
+		analysis->ReleasePlots();
+		delete analysis;
+	}
+	delete steeringFile;
+
+	reply << "END" << std::endl;
+
+	return reply.str();
+}
+
+std::string SPXServer::GetStatistics(void) {
+	std::ostringstream oss;
+
+	oss << "requests " << numberOfRequests << std::endl;
+	oss << "cached_grids " << SPXGrid::GetNumberOfCachedGrids() << std::endl;
+	oss << "cached_pdf_members " << SPXPDF::GetNumberOfCachedPDFMembers() << std::endl;
+
+	return oss.str();
+}
@@ -0,0 +1,57 @@
+//************************************************************/
+//
+//	Server Header
+//
+//	Outlines the SPXServer class, which implements the
+//	Spectrum --serve mode: a long-lived process listening on a
+//	local Unix socket for steering file paths. Each request runs
+//	the full analysis, while grids and LHAPDF members stay cached
+//	in memory between requests.
+//
+//	Protocol (one request per connection, line based):
+//		<steering file>	-> OK, timings, output files, END
+//		stats		-> cache statistics, END
+//		quit		-> BYE (server shuts down)
+//
+//	@Author: 	Spectrum contributors
+//	@Date:		19.10.2026
+//
+//************************************************************/
+
+#ifndef SPXSERVER_H
+#define SPXSERVER_H
+
+#include <string>
+
+#include "SPXException.h"
+
+class SPXServer {
+
+public:
+	explicit SPXServer(const std::string &socketPath) : socketPath(socketPath), numberOfRequests(0) {}
+
+	void Run(void);
+
+	static bool GetDebug(void) {
+		return debug;
+	}
+
+	static void SetDebug(bool b) {
+		debug = b;
+	}
+
+private:
+	static bool debug;		// Flag indicating debug mode
+	std::string socketPath;		// Path of the Unix socket
+	unsigned int numberOfRequests;	// Number of steering files processed
+
+	std::string ReadRequest(int fd);
+	void Reply(int fd, const std::string &s);
+
+	std::string ProcessSteeringFile(const std::string &file);
+	std::string GetStatistics(void);
+
+	static double GetTime(void);
+};
+
+#endif
@@ -0,0 +1,162 @@
+//************************************************************/
+//
+//	Stage Timer Implementation
+//
+//	Implements the SPXStageTimer class
+//
+//	@Author: 	Spectrum contributors
+//	@Date:		19.10.2026
+//
+//************************************************************/
+
+#include <fstream>
+#include <iomanip>
+#include <sys/time.h>
+
+#include "SPXStageTimer.h"
+#include "SPXUtilities.h"
+
+//Class name for debug statements
+const std::string cn = "SPXStageTimer::";
+
+//Must define the static debug variable in the implementation
+bool SPXStageTimer::debug;
+
+bool SPXStageTimer::enabled = false;
+pthread_t SPXStageTimer::thread;
+double SPXStageTimer::start = 0;
+std::vector<SPXStage_t> SPXStageTimer::stages;
+std::vector<int> SPXStageTimer::active;
+std::vector<double> SPXStageTimer::elapsed;
+double SPXStageTimer::mark = 0;
+
+double SPXStageTimer::GetTime(void) {
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0;
+}
+
+//Times the stages entered by the calling thread from now on
+void SPXStageTimer::Enable(void) {
+	thread = pthread_self();
+	start = GetTime();
+	mark = start;
+	enabled = true;
+}
+
+int SPXStageTimer::GetStage(const std::string &name) {
+	for(int i = 0; i < stages.size(); i++) {
+		if(stages[i].name == name) {
+			return i;
+		}
+	}
+
+	SPXStage_t stage;
+	stage.name = name;
+	stage.calls = 0;
+	stage.total = 0;
+	stage.max = 0;
+	stages.push_back(stage);
+
+	return stages.size() - 1;
+}
+
+void SPXStageTimer::Begin(const std::string &name) {
+	if(!enabled || !pthread_equal(pthread_self(), thread)) {
+		return;
+	}
+
+	double now = GetTime();
+
+	//The enclosing stage is paused
+	if(!elapsed.empty()) {
+		elapsed.back() += now - mark;
+	}
+
+	int i = GetStage(name);
+	stages[i].calls++;
+	active.push_back(i);
+	elapsed.push_back(0);
+
+	mark = now;
+}
+
+void SPXStageTimer::End(void) {
+	std::string mn = "End: ";
+
+	if(!enabled || !pthread_equal(pthread_self(), thread) || active.empty()) {
+		return;
+	}
+
+	double now = GetTime();
+
+	SPXStage_t &stage = stages[active.back()];
+	double time = elapsed.back() + now - mark;
+
+	stage.total += time;
+	if(time > stage.max) stage.max = time;
+
+	if(debug) std::cout << cn << mn << stage.name << ": " << std::fixed << std::setprecision(3) << time << " ms" << std::endl;
+
+	active.pop_back();
+	elapsed.pop_back();
+
+	mark = now;
+}
+
+//Wall time since the timer was enabled
+double SPXStageTimer::GetTotalTime(void) {
+	return enabled ? GetTime() - start : 0;
+}
+
+void SPXStageTimer::PrintReport(std::ostream &out) {
+	double total = GetTotalTime();
+	double timed = 0;
+
+	out << std::endl;
+	out << "==================================" << std::endl;
+	out << "      	Stage Timing		        " << std::endl;
+	out << "==================================" << std::endl;
+	out << std::left << std::setw(16) << "stage" << std::right << std::setw(10) << "calls" << std::setw(14) << "total [ms]"
+	    << std::setw(14) << "max [ms]" << std::setw(8) << "%" << std::endl;
+
+	for(int i = 0; i < stages.size(); i++) {
+		const SPXStage_t &s = stages[i];
+
+		out << std::left << std::setw(16) << s.name << std::right << std::setw(10) << s.calls << std::setw(14) << std::fixed
+		    << std::setprecision(1) << s.total << std::setw(14) << s.max << std::setw(8)
+		    << (total > 0 ? 100. * s.total / total : 0.) << std::endl;
+
+		timed += s.total;
+	}
+
+	out << "Timed stages: " << std::fixed << std::setprecision(1) << timed << " ms of " << total << " ms" << std::endl;
+	out << "==================================" << std::endl;
+}
+
+//One line per stage (stage,calls,total_ms,max_ms) and a last line "run" with the wall time of the run
+void SPXStageTimer::WriteCSV(const std::string &filename) {
+	std::string mn = "WriteCSV: ";
+	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+	std::ofstream file(filename.c_str());
+
+	if(!file.is_open()) {
+		throw SPXFileIOException(cn + mn + "Unable to open timing file: " + filename);
+	}
+
+	file << "stage,calls,total_ms,max_ms" << std::endl;
+	file << std::fixed << std::setprecision(3);
+
+	for(int i = 0; i < stages.size(); i++) {
+		const SPXStage_t &s = stages[i];
+		file << s.name << "," << s.calls << "," << s.total << "," << s.max << std::endl;
+	}
+
+	double total = GetTotalTime();
+	file << "run,1," << total << "," << total << std::endl;
+
+	file.close();
+
+	if(debug) std::cout << cn << mn << "Wrote stage timing to " << filename << std::endl;
+}
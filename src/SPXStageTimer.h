@@ -0,0 +1,99 @@
+//************************************************************/
+//
+//	Stage Timer Header
+//
+//	Outlines the SPXStageTimer class, which accumulates the wall
+//	time spent in each stage of the pipeline (parse, load,
+//	convolute, bands, matchbinning, chi2, draw, write) and
+//	writes it as CSV (Spectrum --timing <file>, make bench).
+//
+//	A stage is timed by an SPXStageScope for as long as the scope
+//	lives. Times are exclusive: while a nested stage runs (e.g. a
+//	PDF member is loaded during the convolutions) the time counts
+//	for the nested stage only, so that the stages of a run add up
+//	to its total. Only the thread which enabled the timer is
+//	timed: the stages are entered from the main thread, and scopes
+//	opened by worker threads or render worker processes are not
+//	counted.
+//
+//	@Author: 	Spectrum contributors
+//	@Date:		19.10.2026
+//
+//************************************************************/
+
+#ifndef SPXSTAGETIMER_H
+#define SPXSTAGETIMER_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <pthread.h>
+
+#include "SPXException.h"
+
+//Accumulated time of one stage
+typedef struct SPXStage_t {
+	std::string name;
+	unsigned long calls;		// Number of times the stage was entered
+	double total;			// Exclusive wall time [ms]
+	double max;			// Longest single call (exclusive) [ms]
+} SPXStage_t;
+
+class SPXStageTimer {
+
+public:
+	static void Enable(void);
+	static bool IsEnabled(void) {
+		return enabled;
+	}
+
+	static void Begin(const std::string &name);
+	static void End(void);
+
+	static const std::vector<SPXStage_t> & GetStages(void) {
+		return stages;
+	}
+
+	static double GetTotalTime(void);
+
+	static void PrintReport(std::ostream &out);
+	static void WriteCSV(const std::string &filename);
+
+	static bool GetDebug(void) {
+		return debug;
+	}
+
+	static void SetDebug(bool b) {
+		debug = b;
+	}
+
+private:
+	static bool debug;			// Flag indicating debug mode
+	static bool enabled;			// Stages are timed
+	static pthread_t thread;		// Thread which is timed
+	static double start;			// Wall time when the timer was enabled [ms]
+	static std::vector<SPXStage_t> stages;	// In order of first use
+	static std::vector<int> active;		// Stages entered and not left, innermost last
+	static std::vector<double> elapsed;	// Exclusive time of each active call so far [ms]
+	static double mark;			// Wall time of the last Begin/End [ms]
+
+	static double GetTime(void);
+	static int GetStage(const std::string &name);
+};
+
+//Times a stage for the lifetime of the scope
+class SPXStageScope {
+public:
+	explicit SPXStageScope(const char *name) : timed(SPXStageTimer::IsEnabled()) {
+		if(timed) SPXStageTimer::Begin(name);
+	}
+
+	~SPXStageScope() {
+		if(timed) SPXStageTimer::End();
+	}
+
+private:
+	bool timed;
+};
+
+#endif
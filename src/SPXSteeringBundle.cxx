@@ -0,0 +1,670 @@
+//************************************************************/
+//
+//	Steering Bundle Implementation
+//
+//	Implements the SPXSteeringBundle class
+//
+//	@Author: 	Spectrum contributors
+//	@Date:		19.10.2026
+//
+//************************************************************/
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <sys/stat.h>
+
+#include "SPXSteeringBundle.h"
+#include "SPXFileUtilities.h"
+#include "SPXUtilities.h"
+
+//Class name for debug statements
+const std::string cn = "SPXSteeringBundle::";
+
+//Must define the static debug variable in the implementation
+bool SPXSteeringBundle::debug;
+
+//First bytes of every bundle
+const std::string SPX_BUNDLE_MAGIC = "SPXBUNDLE";
+
+std::string SPXSteeringBundle::GetFilename(const std::string &steeringFilename) {
+	return steeringFilename + ".spxb";
+}
+
+bool SPXSteeringBundle::Exists(const std::string &filename) {
+	struct stat st;
+	return (stat(filename.c_str(), &st) == 0);
+}
+
+std::vector<std::string> SPXSteeringBundle::GetSourceFiles(SPXSteeringFile &steeringFile) {
+	std::vector<std::string> sources;
+	std::set<std::string> seen;
+
+	sources.push_back(steeringFile.GetFilename());
+	seen.insert(steeringFile.GetFilename());
+
+	for(int i = 0; i < steeringFile.GetNumberOfPlotConfigurations(); i++) {
+		for(int j = 0; j < steeringFile.GetNumberOfConfigurationInstances(i); j++) {
+			SPXPlotConfigurationInstance &pci = steeringFile.GetPlotConfigurationInstance(i, j);
+
+			std::string files[3];
+			files[0] = pci.dataSteeringFile.GetFilename();
+			files[1] = pci.gridSteeringFile.GetFilename();
+			files[2] = pci.pdfSteeringFile.GetFilename();
+
+			for(int k = 0; k < 3; k++) {
+				if(!files[k].empty() && seen.insert(files[k]).second) {
+					sources.push_back(files[k]);
+				}
+			}
+		}
+	}
+
+	return sources;
+}
+
+void SPXSteeringBundle::Write(SPXSteeringFile &steeringFile, const std::string &filename) {
+	std::string mn = "Write: ";
+	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+	SPXSteeringBundle bundle(filename, false);
+
+	std::string magic = SPX_BUNDLE_MAGIC;
+	unsigned int version = SPX_BUNDLE_VERSION;
+	unsigned int layout = SPXFileUtilities::GetBinaryLayout();
+	std::string steeringFilename = steeringFile.GetFilename();
+
+	bundle.Stream(magic);
+	bundle.Stream(version);
+	bundle.Stream(layout);
+	bundle.Stream(steeringFilename);
+
+	//Size and checksum of each INI file, checked before the bundle is used
+	std::vector<std::string> sources = GetSourceFiles(steeringFile);
+	unsigned int numberOfSources = sources.size();
+	bundle.Stream(numberOfSources);
+
+	for(int i = 0; i < sources.size(); i++) {
+		std::string contents;
+
+		if(!SPXFileUtilities::ReadFile(sources.at(i), contents)) {
+			throw SPXFileIOException(sources.at(i), "SPXSteeringBundle::Write: Unable to read the steering file");
+		}
+
+		unsigned long long size = contents.size();
+		unsigned long long checksum = SPXFileUtilities::GetChecksum(contents.data(), contents.size());
+
+		bundle.Stream(sources.at(i));
+		bundle.Stream(size);
+		bundle.Stream(checksum);
+
+		if(debug) std::cout << cn << mn << "Source " << sources.at(i) << ": " << size << " bytes" << std::endl;
+	}
+
+	bundle.Stream(steeringFile);
+
+	//Checksum of the whole bundle, to detect truncated or damaged files
+	unsigned long long checksum = SPXFileUtilities::GetChecksum(bundle.buffer.data(), bundle.buffer.size());
+	bundle.Stream(checksum);
+
+	//Write to a temporary file and rename it, so that a run never reads a partially written bundle
+	std::string tmpFilename = filename + ".tmp";
+	std::ofstream file(tmpFilename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+
+	if(!file.is_open()) {
+		throw SPXFileIOException(tmpFilename, "SPXSteeringBundle::Write: Unable to open the bundle for writing");
+	}
+
+	file.write(bundle.buffer.data(), bundle.buffer.size());
+	file.close();
+
+	if(file.fail() || (rename(tmpFilename.c_str(), filename.c_str()) != 0)) {
+		remove(tmpFilename.c_str());
+		throw SPXFileIOException(filename, "SPXSteeringBundle::Write: Unable to write the bundle");
+	}
+
+	std::cout << cn << mn << "Wrote " << filename << " (" << bundle.buffer.size() << " bytes, " << \
+		numberOfSources << " steering files, " << steeringFile.GetNumberOfPlotConfigurations() << " plots)" << std::endl;
+}
+
+bool SPXSteeringBundle::Read(SPXSteeringFile &steeringFile, const std::string &filename) {
+	std::string mn = "Read: ";
+	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+	SPXSteeringBundle bundle(filename, true);
+
+	if(!SPXFileUtilities::ReadFile(filename, bundle.buffer)) {
+		std::cout << cn << mn << "INFO: Unable to read the steering bundle " << filename << ": parsing the steering files" << std::endl;
+		return false;
+	}
+
+	try {
+		//The last bytes are the checksum of the rest of the bundle
+		unsigned long long checksum = 0;
+		if(bundle.buffer.size() < sizeof(checksum)) {
+			throw SPXFileIOException(filename, "SPXSteeringBundle::Read: Bundle is truncated");
+		}
+
+		std::size_t end = bundle.buffer.size() - sizeof(checksum);
+		memcpy(&checksum, bundle.buffer.data() + end, sizeof(checksum));
+
+		if(checksum != SPXFileUtilities::GetChecksum(bundle.buffer.data(), end)) {
+			throw SPXFileIOException(filename, "SPXSteeringBundle::Read: Bundle is damaged (checksum mismatch)");
+		}
+
+		std::string magic;
+		unsigned int version = 0;
+		unsigned int layout = 0;
+		std::string steeringFilename;
+
+		bundle.Stream(magic);
+		if(magic != SPX_BUNDLE_MAGIC) {
+			throw SPXFileIOException(filename, "SPXSteeringBundle::Read: Not a steering bundle");
+		}
+
+		bundle.Stream(version);
+		bundle.Stream(layout);
+		if((version != SPX_BUNDLE_VERSION) || (layout != SPXFileUtilities::GetBinaryLayout())) {
+			std::cout << cn << mn << "INFO: Steering bundle " << filename << " was compiled by another version of Spectrum or on another machine type: " << \
+				"parsing the steering files (run Spectrum --compile-steering to update it)" << std::endl;
+			return false;
+		}
+
+		bundle.Stream(steeringFilename);
+		if(steeringFilename != steeringFile.GetFilename()) {
+			std::cout << cn << mn << "INFO: Steering bundle " << filename << " was compiled from " << steeringFilename << \
+				": parsing the steering files" << std::endl;
+			return false;
+		}
+
+		unsigned int numberOfSources = 0;
+		bundle.Stream(numberOfSources);
+
+		for(unsigned int i = 0; i < numberOfSources; i++) {
+			std::string source;
+			unsigned long long size = 0;
+			unsigned long long sourceChecksum = 0;
+
+			bundle.Stream(source);
+			bundle.Stream(size);
+			bundle.Stream(sourceChecksum);
+
+			std::string contents;
+			if(!SPXFileUtilities::ReadFile(source, contents) || (contents.size() != size) || (SPXFileUtilities::GetChecksum(contents.data(), contents.size()) != sourceChecksum)) {
+				std::cout << cn << mn << "INFO: Steering bundle " << filename << " is out of date (" << source << " changed): " << \
+					"parsing the steering files (run Spectrum --compile-steering to update it)" << std::endl;
+				return false;
+			}
+		}
+
+		//Fill a copy, so that the steering file is left untouched if the bundle turns out to be damaged
+		SPXSteeringFile loaded(steeringFile.GetFilename());
+		bundle.Stream(loaded);
+
+		if(bundle.position != end) {
+			throw SPXFileIOException(filename, "SPXSteeringBundle::Read: Unexpected data at the end of the bundle");
+		}
+
+		steeringFile = loaded;
+
+	} catch(const SPXException &e) {
+		std::cerr << e.what() << std::endl;
+		std::cerr << cn << mn << "WARNING: Unable to use the steering bundle " << filename << ": parsing the steering files" << std::endl;
+		return false;
+	}
+
+	std::cout << cn << mn << "Loaded the steering bundle " << filename << std::endl;
+
+	return true;
+}
+
+void SPXSteeringBundle::StreamBytes(void *p, std::size_t n) {
+	if(!reading) {
+		buffer.append((const char *)p, n);
+		return;
+	}
+
+	if(position + n > buffer.size()) {
+		throw SPXFileIOException(filename, "SPXSteeringBundle::StreamBytes: Bundle is truncated");
+	}
+
+	memcpy(p, buffer.data() + position, n);
+	position += n;
+}
+
+void SPXSteeringBundle::Stream(bool &b) {
+	unsigned char c = b ? 1 : 0;
+	StreamBytes(&c, sizeof(c));
+	b = (c != 0);
+}
+
+void SPXSteeringBundle::Stream(int &i) {
+	StreamBytes(&i, sizeof(i));
+}
+
+void SPXSteeringBundle::Stream(unsigned int &i) {
+	StreamBytes(&i, sizeof(i));
+}
+
+void SPXSteeringBundle::Stream(unsigned long long &i) {
+	StreamBytes(&i, sizeof(i));
+}
+
+void SPXSteeringBundle::Stream(double &d) {
+	StreamBytes(&d, sizeof(d));
+}
+
+void SPXSteeringBundle::Stream(std::string &s) {
+	unsigned int n = s.size();
+	Stream(n);
+
+	if(!reading) {
+		buffer.append(s);
+		return;
+	}
+
+	if(position + n > buffer.size()) {
+		throw SPXFileIOException(filename, "SPXSteeringBundle::Stream: Bundle is truncated");
+	}
+
+	s.assign(buffer, position, n);
+	position += n;
+}
+
+void SPXSteeringBundle::Stream(std::vector<bool> &v) {
+	unsigned int n = v.size();
+	Stream(n);
+	if(reading) v.assign(n, false);
+
+	for(unsigned int i = 0; i < n; i++) {
+		bool b = v[i];
+		Stream(b);
+		v[i] = b;
+	}
+}
+
+void SPXSteeringBundle::Stream(SPXPlotType &t) {
+	Stream(t.type);
+}
+
+void SPXSteeringBundle::Stream(SPXDisplayStyle &s) {
+	Stream(s.style);
+}
+
+void SPXSteeringBundle::Stream(SPXOverlayStyle &s) {
+	Stream(s.style);
+}
+
+void SPXSteeringBundle::Stream(SPXRatioStyle &s) {
+	Stream(s.numerator);
+	Stream(s.denominator);
+	Stream(s.dataStat);
+	Stream(s.dataTot);
+	Stream(s.expression);
+	Stream(s.zeroNumeratorErrors);
+	Stream(s.zeroDenominatorErrors);
+	Stream(s.plotNumber);
+	Stream(s.ratioStyleNumber);
+}
+
+void SPXSteeringBundle::Stream(SPXDataFormat &f) {
+	Stream(f.format);
+}
+
+void SPXSteeringBundle::Stream(SPXPDFBandType &t) {
+	Stream(t.type);
+}
+
+void SPXSteeringBundle::Stream(SPXPDFErrorType &t) {
+	Stream(t.type);
+}
+
+void SPXSteeringBundle::Stream(SPXDataSteeringFile &f) {
+	if(reading) f.reader = NULL;
+
+	Stream(f.filename);
+	Stream(f.debug);
+
+	//[DESC]
+	Stream(f.name);
+	Stream(f.comments);
+	Stream(f.experiment);
+	Stream(f.reaction);
+	Stream(f.datasetYear);
+	Stream(f.datasetLumilabel);
+	Stream(f.referenceJournalName);
+	Stream(f.referenceJournalYear);
+	Stream(f.referenceArXivNumber);
+	Stream(f.referenceArXivYear);
+	Stream(f.publicationStatus);
+	Stream(f.date);
+
+	//[GRAPH]
+	Stream(f.sqrtS);
+	Stream(f.legendLabel);
+	Stream(f.xLabel);
+	Stream(f.yLabel);
+	Stream(f.xUnits);
+	Stream(f.yUnits);
+	Stream(f.yBinWidthUnits);
+	Stream(f.jetAlgorithmLabel);
+	Stream(f.jetAlgorithmRadius);
+	Stream(f.doublediffBinname);
+	Stream(f.doublediffBinValueMin);
+	Stream(f.doublediffBinValueMax);
+	Stream(f.doublediffBinWidth);
+
+	//[DATA]
+	Stream(f.dataFormat);
+	Stream(f.dataFilepath);
+	Stream(f.heraFitterXColumns);
+	Stream(f.corrtotalfilename);
+	Stream(f.corrstatfilename);
+	Stream(f.dividedByDoubleDiffBinWidth);
+	Stream(f.dividedByBinWidth);
+	Stream(f.normalizedToTotalSigma);
+	Stream(f.errorInPercent);
+	Stream(f.lumiScaleFactor);
+	Stream(f.lumiValue);
+	Stream(f.lumiError);
+	Stream(f.addLumiSystematic);
+	Stream(f.RemoveXbins);
+	Stream(f.DataCutXmin);
+	Stream(f.DataCutXmax);
+	Stream(f.SystematicsUncorrelatedBetweenBins);
+}
+
+void SPXSteeringBundle::Stream(SPXGridSteeringFile &f) {
+	if(reading) f.reader = NULL;
+
+	Stream(f.filename);
+	Stream(f.debug);
+
+	//[DESC]
+	Stream(f.name);
+	Stream(f.comments);
+	Stream(f.author);
+	Stream(f.lumiConfigFile);
+	Stream(f.scaleform);
+	Stream(f.scaleformAlternativeScaleChoice);
+	Stream(f.referenceJournalName);
+	Stream(f.referenceLinkToArXiv);
+	Stream(f.nloProgramName);
+	Stream(f.gridProgramName);
+	Stream(f.observableDefinitionLinkToCode);
+
+	//[GRAPH]
+	Stream(f.xUnits);
+	Stream(f.yUnits);
+	Stream(f.gridDividedByBinWidth);
+	Stream(f.referenceDividedByBinWidth);
+	Stream(f.AlternativeGridChoicegridDividedByBinWidth);
+	Stream(f.AlternativeGridChoicegridDividedByDoubleDiffBinWidth);
+	Stream(f.gridDividedByDoubleDiffBinWidth);
+	Stream(f.referenceDividedByDoubleDiffBinWidth);
+	Stream(f.yScale);
+
+	//[GRID]
+	Stream(f.vgridFilepath);
+	Stream(f.gridFilepath);
+	Stream(f.vgridFilepathAlternativeScaleChoice);
+	Stream(f.correctionFiles);
+	Stream(f.correctionFilesLabel);
+	Stream(f.correctionFilesAuthor);
+	Stream(f.correctionFilesProgram);
+	Stream(f.correctionFilesReference);
+	Stream(f.lowestOrder);
+	Stream(f.changesqrts);
+	Stream(f.sqrtssweep);
+
+	Stream(f.ParameterValue);
+	Stream(f.ParameterName);
+	Stream(f.ParameterUnit);
+}
+
+void SPXSteeringBundle::Stream(SPXPDFSteeringFile &f) {
+	if(reading) f.reader = NULL;
+
+	Stream(f.filename);
+	Stream(f.debug);
+
+	//[DESC]
+	Stream(f.name);
+	Stream(f.nameVar);
+	Stream(f.type);
+	Stream(f.order);
+	Stream(f.numberOfMembers);
+	Stream(f.pdfSetPath);
+
+	//[STYLE]
+	Stream(f.fillStyle);
+	Stream(f.fillColor);
+	Stream(f.markerStyle);
+
+	//[PDF]
+	Stream(f.defaultID);
+	Stream(f.defaultIDVar);
+	Stream(f.firstEig);
+	Stream(f.lastEig);
+	Stream(f.firstQuad);
+	Stream(f.lastQuad);
+	Stream(f.firstMax);
+	Stream(f.lastMax);
+	Stream(f.includeEig);
+	Stream(f.includeQuad);
+	Stream(f.includeMax);
+	Stream(f.is90Percent);
+	Stream(f.ErrorPropagationType);
+	Stream(f.bandType);
+	Stream(f.errorType);
+	Stream(f.alphaSErrorNumberUp);
+	Stream(f.alphaSErrorNumberDown);
+	Stream(f.alphaSPDFNameUp);
+	Stream(f.alphaSPDFNameDown);
+
+	//SPXPDFSteeringFile::Parse turns on the debug output of the band and error types
+	if(reading && f.debug) {
+		SPXPDFBandType::SetDebug(true);
+		SPXPDFErrorType::SetDebug(true);
+	}
+}
+
+void SPXSteeringBundle::Stream(SPXPlotConfigurationInstance &pci) {
+	Stream(pci.dataDirectory);
+	Stream(pci.gridDirectory);
+	Stream(pci.pdfDirectory);
+
+	Stream(pci.dataSteeringFile);
+	Stream(pci.gridSteeringFile);
+	Stream(pci.pdfSteeringFile);
+
+	Stream(pci.dataMarkerStyle);
+	Stream(pci.dataMarkerColor);
+
+	Stream(pci.gridMarkerStyle);
+	Stream(pci.gridFillStyle);
+	Stream(pci.gridMarkerColor);
+
+	Stream(pci.totalFillColor);
+	Stream(pci.totalFillStyle);
+	Stream(pci.totalEdgeColor);
+	Stream(pci.totalEdgeStyle);
+	Stream(pci.totalMarkerStyle);
+
+	Stream(pci.pdfFillColor);
+	Stream(pci.pdfFillStyle);
+	Stream(pci.pdfEdgeColor);
+	Stream(pci.pdfEdgeStyle);
+	Stream(pci.pdfMarkerStyle);
+
+	Stream(pci.scaleFillColor);
+	Stream(pci.scaleFillStyle);
+	Stream(pci.scaleEdgeColor);
+	Stream(pci.scaleEdgeStyle);
+	Stream(pci.scaleMarkerStyle);
+
+	Stream(pci.AlternativeScaleChoiceFillColor);
+	Stream(pci.AlternativeScaleChoiceFillStyle);
+	Stream(pci.AlternativeScaleChoiceEdgeColor);
+	Stream(pci.AlternativeScaleChoiceEdgeStyle);
+	Stream(pci.AlternativeScaleChoiceMarkerStyle);
+
+	Stream(pci.alphasFillColor);
+	Stream(pci.alphasFillStyle);
+	Stream(pci.alphasEdgeColor);
+	Stream(pci.alphasEdgeStyle);
+	Stream(pci.alphasMarkerStyle);
+
+	Stream(pci.beamuncertaintyFillColor);
+	Stream(pci.beamuncertaintyFillStyle);
+	Stream(pci.beamuncertaintyEdgeColor);
+	Stream(pci.beamuncertaintyEdgeStyle);
+	Stream(pci.beamuncertaintyMarkerStyle);
+
+	Stream(pci.correctionsFillColor);
+	Stream(pci.correctionsFillStyle);
+	Stream(pci.correctionsEdgeColor);
+	Stream(pci.correctionsEdgeStyle);
+	Stream(pci.correctionsMarkerStyle);
+
+	Stream(pci.xScale);
+	Stream(pci.yScale);
+	Stream(pci.id);
+
+	Stream(pci.systematicsclasses);
+	Stream(pci.systematicsclassescolor);
+	Stream(pci.systematicsclassesedgecolor);
+	Stream(pci.systematicsclassesedgestyle);
+	Stream(pci.systematicsclassesedgewidth);
+	Stream(pci.removesystematicsclasses);
+	Stream(pci.containsystematicsclasses);
+}
+
+void SPXSteeringBundle::Stream(SPXPlotConfiguration &pc) {
+	Stream(pc.id);
+	Stream(pc.xLog);
+	Stream(pc.yLog);
+	Stream(pc.description);
+	Stream(pc.plotType);
+	Stream(pc.displayStyle);
+	Stream(pc.overlayStyle);
+	Stream(pc.ratioTitle);
+	Stream(pc.ratioStyles);
+	Stream(pc.ratios);
+	Stream(pc.partonLuminosities);
+	Stream(pc.pdfBandFlavours);
+	Stream(pc.pdfBandQ2);
+	Stream(pc.plotoptions);
+	Stream(pc.configurationInstances);
+	Stream(pc.filenameToPCIMap);
+}
+
+void SPXSteeringBundle::Stream(SPXSteeringFile &s) {
+	if(reading) s.reader = NULL;
+
+	Stream(s.filename);
+
+	//[GEN]
+	Stream(s.debug);
+	Stream(s.OutputRootfile);
+	Stream(s.OutputGraphicFormat);
+	Stream(s.OutputGraphicFormats);
+	Stream(s.OutputTableFormat);
+
+	//[GRAPH]
+	Stream(s.addonLegendNLOProgramName);
+	Stream(s.plotBand);
+	Stream(s.plotErrorTicks);
+	Stream(s.plotMarker);
+	Stream(s.plotStaggered);
+	Stream(s.matchBinning);
+	Stream(s.TakeSignforTotalError);
+	Stream(s.set_grid_styles);
+	Stream(s.AddMCStattoTotalStatError);
+
+	Stream(s.RemoveXbins);
+	Stream(s.DataCutXmin);
+	Stream(s.DataCutXmax);
+
+	Stream(s.printTotalSigma);
+	Stream(s.gridCorr);
+	Stream(s.ContainGridCorr);
+	Stream(s.MCstatNametoAddtoTotal);
+	Stream(s.nomCorr);
+	Stream(s.labelSqrtS);
+	Stream(s.labelChi2);
+	Stream(s.labelDate);
+
+	Stream(s.showIndividualSystematicswithName);
+	Stream(s.showIndividualSystematics);
+	Stream(s.showTotalSystematics);
+	Stream(s.showIndividualSystematicsAsLine);
+	Stream(s.ordersystematiccolorbyalphabeth);
+
+	Stream(s.XDataBoxLabel);
+	Stream(s.YDataBoxLabel);
+	Stream(s.BeamUncertainty);
+
+	Stream(s.BandwithPDF);
+	Stream(s.BandwithAlphaS);
+	Stream(s.BandwithScales);
+	Stream(s.BandwithScalesAlternativeScaleChoice);
+	Stream(s.BandTotal);
+
+	Stream(s.gridcorrections);
+	Stream(s.replicasteeringfile);
+
+	Stream(s.systematicsclasses);
+	Stream(s.systematicsclassescolor);
+	Stream(s.systematicsclassesedgecolor);
+	Stream(s.systematicsclassesedgestyle);
+	Stream(s.systematicsclassesedgewidth);
+	Stream(s.removesystematicsclasses);
+	Stream(s.containsystematicsclasses);
+
+	Stream(s.RenScales);
+	Stream(s.FacScales);
+
+	Stream(s.xLegend);
+	Stream(s.yLegend);
+	Stream(s.xInfoLegend);
+	Stream(s.yInfoLegend);
+	Stream(s.InfoLegendLabel);
+	Stream(s.yOverlayMin);
+	Stream(s.yOverlayMax);
+	Stream(s.xOverlayMin);
+	Stream(s.xOverlayMax);
+	Stream(s.yRatioMin);
+	Stream(s.yRatioMax);
+
+	Stream(s.xLegendPlot);
+	Stream(s.yLegendPlot);
+	Stream(s.xInfoLegendPlot);
+	Stream(s.yInfoLegendPlot);
+	Stream(s.InfoLegendLabelPlot);
+	Stream(s.yOverlayMinPlot);
+	Stream(s.yOverlayMaxPlot);
+	Stream(s.xOverlayMinPlot);
+	Stream(s.xOverlayMaxPlot);
+	Stream(s.yRatioMinPlot);
+	Stream(s.yRatioMaxPlot);
+
+	Stream(s.CalculateChi2);
+	Stream(s.DumpTables);
+	Stream(s.AddScaleFunctionalForm);
+	Stream(s.AddLumi);
+	Stream(s.AddJournal);
+	Stream(s.AddJournalYear);
+
+	//[PLOT_n]
+	Stream(s.plotConfigurations);
+
+	Stream(s.ParameterScan);
+	Stream(s.ParameterScanInterpolation);
+	Stream(s.ParameterScanPoints);
+	Stream(s.ParameterScanMin);
+	Stream(s.ParameterScanMax);
+	Stream(s.ParameterScanLegend);
+}
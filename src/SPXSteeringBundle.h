@@ -0,0 +1,133 @@
+//************************************************************/
+//
+//	Steering Bundle Header
+//
+//	Outlines the SPXSteeringBundle class, which writes a parsed
+//	and validated steering file, with its plot configurations
+//	and every Data, Grid and PDF steering file they reference,
+//	to a binary bundle (Spectrum --compile-steering), and reads
+//	it back in place of parsing the INI files.
+//
+//	The bundle holds the size and checksum of each INI file it
+//	was compiled from: if any of them changed, is missing, or
+//	the bundle was written by a different bundle version or
+//	machine type, Read returns false and the steering files are
+//	parsed as usual (SPXSteeringFile::LoadAll).
+//
+//	The bundle is a byte copy of the members of the steering
+//	classes: SPX_BUNDLE_VERSION must be incremented whenever a
+//	member is added to, removed from or reordered in any of
+//	the Stream functions.
+//
+//	@Author: 	Spectrum contributors
+//	@Date:		19.10.2026
+//
+//************************************************************/
+
+#ifndef SPXSTEERINGBUNDLE_H
+#define SPXSTEERINGBUNDLE_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "SPXSteeringFile.h"
+#include "SPXException.h"
+
+const unsigned int SPX_BUNDLE_VERSION = 4;
+
+class SPXSteeringBundle {
+
+public:
+	//Bundle of a top-level steering file: <steering file>.spxb
+	static std::string GetFilename(const std::string &steeringFilename);
+
+	static bool Exists(const std::string &filename);
+
+	//Writes the (parsed) steering file to the bundle
+	static void Write(SPXSteeringFile &steeringFile, const std::string &filename);
+
+	//Fills the steering file from the bundle: false if the bundle is out of date or unreadable
+	static bool Read(SPXSteeringFile &steeringFile, const std::string &filename);
+
+	static bool GetDebug(void) {
+		return debug;
+	}
+
+	static void SetDebug(bool b) {
+		debug = b;
+	}
+
+private:
+	static bool debug;
+
+	std::string filename;		// Bundle file, for error messages
+	std::string buffer;		// Contents of the bundle
+	std::size_t position;		// Read position in the buffer
+	bool reading;			// Direction of the Stream functions
+
+	SPXSteeringBundle(const std::string &filename, bool reading) : filename(filename), position(0), reading(reading) {}
+
+	//Top-level steering file and the unique Data, Grid and PDF steering files of all plots
+	static std::vector<std::string> GetSourceFiles(SPXSteeringFile &steeringFile);
+
+	//Each Stream function writes (or reads) its argument to (from) the buffer
+	void StreamBytes(void *p, std::size_t n);
+
+	void Stream(bool &b);
+	void Stream(int &i);
+	void Stream(unsigned int &i);
+	void Stream(unsigned long long &i);
+	void Stream(double &d);
+	void Stream(std::string &s);
+	void Stream(std::vector<bool> &v);
+
+	template<class T> void Stream(std::vector<T> &v) {
+		unsigned int n = v.size();
+		Stream(n);
+		if(reading) v.assign(n, T());
+		for(unsigned int i = 0; i < n; i++) {
+			Stream(v[i]);
+		}
+	}
+
+	template<class T> void Stream(std::map<std::string, T> &m) {
+		unsigned int n = m.size();
+		Stream(n);
+
+		if(!reading) {
+			for(typename std::map<std::string, T>::iterator it = m.begin(); it != m.end(); ++it) {
+				std::string key = it->first;
+				Stream(key);
+				Stream(it->second);
+			}
+			return;
+		}
+
+		m.clear();
+		for(unsigned int i = 0; i < n; i++) {
+			std::string key;
+			T value;
+			Stream(key);
+			Stream(value);
+			m.insert(std::make_pair(key, value));
+		}
+	}
+
+	void Stream(SPXPlotType &t);
+	void Stream(SPXDisplayStyle &s);
+	void Stream(SPXOverlayStyle &s);
+	void Stream(SPXRatioStyle &s);
+	void Stream(SPXDataFormat &f);
+	void Stream(SPXPDFBandType &t);
+	void Stream(SPXPDFErrorType &t);
+
+	void Stream(SPXDataSteeringFile &f);
+	void Stream(SPXGridSteeringFile &f);
+	void Stream(SPXPDFSteeringFile &f);
+	void Stream(SPXPlotConfigurationInstance &pci);
+	void Stream(SPXPlotConfiguration &pc);
+	void Stream(SPXSteeringFile &s);
+};
+
+#endif
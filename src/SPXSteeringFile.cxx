@@ -16,10 +16,46 @@
 
 #include "SPXSteeringFile.h"
 #include "SPXUtilities.h"
+#include "SPXResultsTable.h"
+#include "SPXOutputManager.h"
+#include "SPXSteeringBundle.h"
+#include "SPXWorkQueue.h"
 
 //Class name for debug statements
 const std::string cn = "SPXSteeringFile::";
 
+//Upper limit on the number of threads used to preload the Data/Grid/PDF steering files
+const unsigned int MAX_PARSE_THREADS = 8;
+
+//Must define the static steering file caches in the implementation
+std::map<std::string, SPXDataSteeringFile> SPXSteeringFile::dataSteeringFileCache;
+std::map<std::string, SPXGridSteeringFile> SPXSteeringFile::gridSteeringFileCache;
+std::map<std::string, SPXPDFSteeringFile> SPXSteeringFile::pdfSteeringFileCache;
+
+//A single preload job: exactly one of the steering file pointers is set, and points into a cache entry
+typedef struct SPXSteeringFileParseJob_t {
+	std::string filename;
+	SPXDataSteeringFile *dataSteeringFile;
+	SPXGridSteeringFile *gridSteeringFile;
+	SPXPDFSteeringFile *pdfSteeringFile;
+	std::string error;
+} SPXSteeringFileParseJob_t;
+
+//Parses one preload job: exceptions are recorded in the job and rethrown by the caller
+static void ParseSteeringFileJob(void *context, unsigned int i, unsigned int thread) {
+	SPXSteeringFileParseJob_t &job = ((std::vector<SPXSteeringFileParseJob_t> *)context)->at(i);
+
+	try {
+		if(job.dataSteeringFile) job.dataSteeringFile->Parse();
+		if(job.gridSteeringFile) job.gridSteeringFile->Parse();
+		if(job.pdfSteeringFile)  job.pdfSteeringFile->Parse();
+	} catch(const std::exception &e) {
+		job.error = e.what();
+	} catch(...) {
+		job.error = "Unknown exception";
+	}
+}
+
 const int DEFAULT_DATA_MARKER_STYLE = 20;	//Circle
 const int DEFAULT_DATA_MARKER_COLOR = 1;	//Black
 
@@ -212,6 +248,13 @@ void SPXSteeringFile::SetDefaults(void) {
         ParameterScan = false;
 	if(debug) std::cout << cn << mn << "Parameter scan set to default: OFF" << std::endl;
 
+        ParameterScanInterpolation = "poly2";
+        ParameterScanPoints = 1000;
+        ParameterScanMin = 0.;
+        ParameterScanMax = 0.;
+        ParameterScanLegend = false;
+	if(debug) std::cout << cn << mn << "Parameter scan interpolation set to default: poly2 with 1000 scan points" << std::endl;
+
 	CalculateChi2 = 0;
 	if(debug) std::cout << cn << mn << "CalculateChi2 set to default: OFF" << std::endl;
 
@@ -252,6 +295,14 @@ void SPXSteeringFile::ParseAll(bool print) {
 		throw SPXParseException("Error parsing Steering File");
 	}
 
+	try {
+		if(debug) std::cout << cn << mn << "Preloading Data, Grid and PDF Steering Files" << std::endl;
+		this->PreloadSteeringFiles();
+	} catch(const SPXException &e) {
+		std::cerr << e.what() << std::endl;
+		throw SPXParseException("Error preloading Data, Grid and PDF Steering Files");
+	}
+
 	try {
 		if(debug) std::cout << cn << mn << "Parsing PDF Steering Files" << std::endl;
 		this->ParsePDFSteeringFiles();
@@ -280,6 +331,171 @@ void SPXSteeringFile::ParseAll(bool print) {
 	}
 }
 
+void SPXSteeringFile::LoadAll(bool print) {
+	std::string mn = "LoadAll: ";
+	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+	std::string bundle = SPXSteeringBundle::GetFilename(filename);
+
+	if(!filename.empty() && overrides.empty() && SPXSteeringBundle::Exists(bundle) && SPXSteeringBundle::Read(*this, bundle)) {
+		if(debug) this->EnableDebug();
+		if(print) this->PrintAll();
+		return;
+	}
+
+	this->ParseAll(print);
+}
+
+void SPXSteeringFile::SetOverride(const std::string &section, const std::string &key, const std::string &value) {
+	std::string mn = "SetOverride: ";
+	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+	SPXSteeringOverride_t o;
+	o.section = section;
+	o.key = key;
+	o.value = value;
+
+	overrides.push_back(o);
+
+	if(debug) std::cout << cn << mn << "[" << section << "] " << key << " = " << value << std::endl;
+}
+
+void SPXSteeringFile::ApplyOverrides(void) {
+	std::string mn = "ApplyOverrides: ";
+	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+	if(overrides.empty()) {
+		return;
+	}
+
+	//Count the plots before any override of the keys they are detected by
+	unsigned int numPlots = ParseNumberOfPlots();
+
+	for(unsigned int i = 0; i < overrides.size(); i++) {
+		SPXSteeringOverride_t &o = overrides.at(i);
+
+		if(o.section.compare("PLOT")) {
+			reader->Set(o.section, o.key, o.value);
+			continue;
+		}
+
+		for(unsigned int j = 0; j < numPlots; j++) {
+			std::ostringstream plotSection;
+			plotSection << "PLOT_" << j;
+			reader->Set(plotSection.str(), o.key, o.value);
+		}
+	}
+}
+
+void SPXSteeringFile::EnableDebug(void) {
+	SPXPlotType::SetDebug(true);
+	SPXPlotConfiguration::SetDebug(true);
+	SPXRatioStyle::SetDebug(true);
+	SPXOverlayStyle::SetDebug(true);
+	SPXDisplayStyle::SetDebug(true);
+	SPXPDFBandType::SetDebug(true);
+	SPXPDFErrorType::SetDebug(true);
+	SPXPDFErrorSize::SetDebug(true);
+}
+
+void SPXSteeringFile::PreloadSteeringFiles(void) {
+	std::string mn = "PreloadSteeringFiles: ";
+	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+	std::vector<SPXSteeringFileParseJob_t> jobs;
+	unsigned int numberOfReferences = 0;
+
+	//Collect the unique steering files not yet in the cache: the cache entries are inserted here (unparsed)
+	//	so that the threads only ever write into their own, already existing, map node
+	for(int i = 0; i < plotConfigurations.size(); i++) {
+		for(int j = 0; j < plotConfigurations.at(i).GetNumberOfConfigurationInstances(); j++) {
+			SPXPlotConfigurationInstance &pci = plotConfigurations.at(i).GetPlotConfigurationInstance(j);
+			numberOfReferences += 3;
+
+			SPXSteeringFileParseJob_t job;
+			job.dataSteeringFile = NULL;
+			job.gridSteeringFile = NULL;
+			job.pdfSteeringFile = NULL;
+
+			job.filename = pci.dataSteeringFile.GetFilename();
+			std::pair<std::map<std::string, SPXDataSteeringFile>::iterator, bool> d = \
+				dataSteeringFileCache.insert(std::make_pair(job.filename, pci.dataSteeringFile));
+			if(d.second) {
+				SPXSteeringFileParseJob_t dataJob = job;
+				dataJob.dataSteeringFile = &(d.first->second);
+				jobs.push_back(dataJob);
+			}
+
+			job.filename = pci.gridSteeringFile.GetFilename();
+			std::pair<std::map<std::string, SPXGridSteeringFile>::iterator, bool> g = \
+				gridSteeringFileCache.insert(std::make_pair(job.filename, pci.gridSteeringFile));
+			if(g.second) {
+				SPXSteeringFileParseJob_t gridJob = job;
+				gridJob.gridSteeringFile = &(g.first->second);
+				jobs.push_back(gridJob);
+			}
+
+			job.filename = pci.pdfSteeringFile.GetFilename();
+			std::pair<std::map<std::string, SPXPDFSteeringFile>::iterator, bool> p = \
+				pdfSteeringFileCache.insert(std::make_pair(job.filename, pci.pdfSteeringFile));
+			if(p.second) {
+				SPXSteeringFileParseJob_t pdfJob = job;
+				pdfJob.pdfSteeringFile = &(p.first->second);
+				jobs.push_back(pdfJob);
+			}
+		}
+	}
+
+	if(jobs.empty()) {
+		if(debug) std::cout << cn << mn << "All " << numberOfReferences << " steering file references already cached" << std::endl;
+		return;
+	}
+
+	//Keep debug output readable by parsing serially in debug mode
+	unsigned int numberOfThreads = SPXWorkQueue::GetNumberOfThreads(jobs.size(), MAX_PARSE_THREADS);
+	if(debug) numberOfThreads = 1;
+
+	if(debug) std::cout << cn << mn << "Parsing " << jobs.size() << " unique steering files (" << numberOfReferences << \
+		" references) with " << numberOfThreads << " thread(s)" << std::endl;
+
+	SPXWorkQueue::Run(ParseSteeringFileJob, &jobs, jobs.size(), numberOfThreads, "parse");
+
+	//Drop failed entries from the cache so they are not mistaken for parsed files, then report the first failure
+	std::string firstError;
+	std::string firstFilename;
+
+	for(int i = 0; i < jobs.size(); i++) {
+		SPXSteeringFileParseJob_t &job = jobs.at(i);
+
+		if(job.error.empty()) {
+			continue;
+		}
+
+		std::cerr << job.error << std::endl;
+
+		if(job.dataSteeringFile) dataSteeringFileCache.erase(job.filename);
+		if(job.gridSteeringFile) gridSteeringFileCache.erase(job.filename);
+		if(job.pdfSteeringFile)  pdfSteeringFileCache.erase(job.filename);
+
+		if(firstFilename.empty()) {
+			firstError = job.error;
+			firstFilename = job.filename;
+		}
+	}
+
+	if(!firstFilename.empty()) {
+		std::ostringstream oss;
+		oss << "Unable to parse the Steering File: " << firstFilename << ": " << firstError;
+		throw SPXParseException(oss.str());
+	}
+}
+
+void SPXSteeringFile::ClearSteeringFileCache(void) {
+	dataSteeringFileCache.clear();
+	gridSteeringFileCache.clear();
+	pdfSteeringFileCache.clear();
+}
+
 void SPXSteeringFile::PrintDataMetadata(void) {
 	std::string mn = "PrintDataMetadata: ";
 
@@ -370,6 +586,7 @@ void SPXSteeringFile::Print(void) {
 	std::cout << "\t\t Debug is " << (debug ? "ON" : "OFF") << std::endl;
         std::cout << "\t\t OutputGraphicFormat= "<<OutputGraphicFormat<< std::endl;
 	std::cout << "\t\t OutputRootfile is " << (OutputRootfile ? "ON" : "OFF") << std::endl;
+	std::cout << "\t\t OutputTableFormat= " << (OutputTableFormat.empty() ? "OFF" : OutputTableFormat) << std::endl;
 
 	std::cout << "\t Graphing configurations [GRAPH]" << std::endl;
 	std::cout << "\t\t Plot Band is: " << (plotBand ? "ON" : "OFF") << std::endl;
@@ -398,7 +615,9 @@ void SPXSteeringFile::Print(void) {
         if (CalculateChi2==0) std::cout << "\t\t Calculate Chi2: OFF" << std::endl;
         if (CalculateChi2==1) std::cout << "\t\t Calculate Simple Chi2" << std::endl;
 
-        if (ParameterScan) std::cout << "\t\t Parameter Scan is ON " << std::endl;
+        if (ParameterScan) std::cout << "\t\t Parameter Scan is ON: " << ParameterScanInterpolation << " interpolation, "
+                                     << ParameterScanPoints << " scan points" << std::endl;
+        if (ParameterScanLegend) std::cout << "\t\t Parameter scan legend is ON " << std::endl;
 
         if (DumpTables==0) std::cout << "\t\t Dump Latex tables ON" << std::endl;
 
@@ -2484,6 +2703,56 @@ void SPXSteeringFile::ParsePlotConfigurations(void) {
 			if(debug) std::cout << cn << mn << "configurations[ratio_title] = " << configurations["ratio_title"].at(0) << std::endl;
 		}
 
+		//Get the parton luminosities (optional) and their mass range
+		tmp = reader->Get(plotSection, "parton_luminosity", "EMPTY");
+		if(tmp.compare("EMPTY")) {
+			tmpVector = SPXStringUtilities::CommaSeparatedListToVector(tmp);
+			configurations.insert(std::pair<std::string, std::vector<std::string> >("parton_luminosity", tmpVector));
+			tmpVector.clear();
+			if(debug) std::cout << cn << mn << "configurations[parton_luminosity] = " << tmp << std::endl;
+
+			const char *lumiOptions[] = {"luminosity_mass_min", "luminosity_mass_max", "luminosity_mass_points", "luminosity_sqrt_s", 0};
+			for(int k = 0; lumiOptions[k]; k++) {
+				tmp = reader->Get(plotSection, lumiOptions[k], "EMPTY");
+				if(!tmp.compare("EMPTY")) continue;
+
+				tmpVector.clear();
+				tmpVector.push_back(tmp);
+				configurations.insert(std::pair<std::string, std::vector<std::string> >(lumiOptions[k], tmpVector));
+				tmpVector.clear();
+				if(debug) std::cout << cn << mn << "configurations[" << lumiOptions[k] << "] = " << tmp << std::endl;
+			}
+		}
+
+		//Get the PDF-vs-x bands (optional), their Q2 values and x range
+		tmp = reader->Get(plotSection, "pdf_bands", "EMPTY");
+		if(tmp.compare("EMPTY")) {
+			tmpVector = SPXStringUtilities::CommaSeparatedListToVector(tmp);
+			configurations.insert(std::pair<std::string, std::vector<std::string> >("pdf_bands", tmpVector));
+			tmpVector.clear();
+			if(debug) std::cout << cn << mn << "configurations[pdf_bands] = " << tmp << std::endl;
+
+			tmp = reader->Get(plotSection, "pdf_band_q2", "EMPTY");
+			if(tmp.compare("EMPTY")) {
+				tmpVector = SPXStringUtilities::CommaSeparatedListToVector(tmp);
+				configurations.insert(std::pair<std::string, std::vector<std::string> >("pdf_band_q2", tmpVector));
+				tmpVector.clear();
+				if(debug) std::cout << cn << mn << "configurations[pdf_band_q2] = " << tmp << std::endl;
+			}
+
+			const char *bandOptions[] = {"pdf_band_x_min", "pdf_band_x_max", "pdf_band_x_points", 0};
+			for(int k = 0; bandOptions[k]; k++) {
+				tmp = reader->Get(plotSection, bandOptions[k], "EMPTY");
+				if(!tmp.compare("EMPTY")) continue;
+
+				tmpVector.clear();
+				tmpVector.push_back(tmp);
+				configurations.insert(std::pair<std::string, std::vector<std::string> >(bandOptions[k], tmpVector));
+				tmpVector.clear();
+				if(debug) std::cout << cn << mn << "configurations[" << bandOptions[k] << "] = " << tmp << std::endl;
+			}
+		}
+
 		//Get the ratio styles and ratios
 		unsigned int numberOfRatios = ParseNumberOfRatios(i);
 		std::string ratioStyle;
@@ -2558,6 +2827,8 @@ void SPXSteeringFile::Parse(void) {
     	throw SPXFileIOException(filename, "INIReader::INIReader(): ParseError generated when parsing file");
 	}
 
+	this->ApplyOverrides();
+
 	if(debug) std::cout << cn << mn << " INIReader done " << std::endl;
 
 	std::string tmp;
@@ -2574,9 +2845,40 @@ void SPXSteeringFile::Parse(void) {
 	OutputRootfile= reader->GetBoolean("GEN", "output_rootfile", OutputRootfile);
         if (OutputRootfile) std::cout << cn << mn << "OutputRootfile is ON" << std::endl;
 
+        OutputTableFormat="";
+	OutputTableFormat = reader->Get("GEN", "output_table", OutputTableFormat);
+        if (!OutputTableFormat.empty()) {
+         if (!SPXResultsTable::IsValidFormat(OutputTableFormat)) {
+          throw SPXParseException(cn+mn+"output_table must be csv or root, but is "+OutputTableFormat);
+         }
+         std::cout << cn << mn << "OutputTableFormat= "<< OutputTableFormat  << std::endl;
+        }
+
 	OutputGraphicFormat = reader->Get("GEN", "output_graphicformat", OutputGraphicFormat);
         if (debug) std::cout << cn << mn << "OutputGraphicFormat= "<< OutputGraphicFormat  << std::endl;
 
+        //List of formats: root and table turn on the ROOT file and the (csv) results table
+        OutputGraphicFormats.clear();
+        if (!OutputGraphicFormat.empty()) {
+         std::vector<std::string> formats = SPXStringUtilities::CommaSeparatedListToVector(OutputGraphicFormat);
+         for (int i=0; i<formats.size(); i++) {
+          if (formats[i].empty()) continue;
+          if (formats[i]=="root") {
+           OutputRootfile=true;
+          } else if (formats[i]=="table") {
+           if (OutputTableFormat.empty()) OutputTableFormat="csv";
+          } else if (std::find(OutputGraphicFormats.begin(), OutputGraphicFormats.end(), formats[i])!=OutputGraphicFormats.end()) {
+           continue;
+          } else {
+           //Other formats are written by TCanvas::Print as they are
+           if (!SPXOutputManager::IsValidFormat(formats[i])) {
+            std::cerr<<cn<<mn<<"WARNING: output_graphicformat "<<formats[i]<<" is not one of png, gif, jpg, pdf, eps, ps, svg, root or table: passed to ROOT as it is"<<std::endl;
+           }
+           OutputGraphicFormats.push_back(formats[i]);
+          }
+         }
+        }
+
 	//Set Defaults
         if (debug) std::cout << cn << mn << "SetDefaults " << std::endl;
 	this->SetDefaults();
@@ -2584,14 +2886,7 @@ void SPXSteeringFile::Parse(void) {
 	//Enable all debug configurations if debug is on
 	if(debug) {
 		std::cout << cn << mn << "Debug is ON" << std::endl;
-		SPXPlotType::SetDebug(true);
-		SPXPlotConfiguration::SetDebug(true);
-		SPXRatioStyle::SetDebug(true);
-		SPXOverlayStyle::SetDebug(true);
-		SPXDisplayStyle::SetDebug(true);
-		SPXPDFBandType::SetDebug(true);
-		SPXPDFErrorType::SetDebug(true);
-		SPXPDFErrorSize::SetDebug(true);
+		this->EnableDebug();
 	}
 
 	//Graphing configurations [GRAPH]
@@ -2715,6 +3010,13 @@ void SPXSteeringFile::Parse(void) {
 
 	printTotalSigma = reader->GetBoolean("GRAPH", "print_total_sigma", printTotalSigma);
 
+	ParameterScan = reader->GetBoolean("GRAPH", "grid_parameter_scan", ParameterScan);
+	ParameterScanInterpolation = reader->Get("GRAPH", "parameter_scan_interpolation", ParameterScanInterpolation);
+	ParameterScanPoints = reader->GetInteger("GRAPH", "parameter_scan_points", ParameterScanPoints);
+	ParameterScanMin = reader->GetReal("GRAPH", "parameter_scan_min", ParameterScanMin);
+	ParameterScanMax = reader->GetReal("GRAPH", "parameter_scan_max", ParameterScanMax);
+	ParameterScanLegend = reader->GetBoolean("GRAPH", "parameter_scan_legend", ParameterScanLegend);
+
 	gridCorr       = reader->GetBoolean("GRAPH", "apply_grid_corr", gridCorr);
 
         //Choice of nominal correction only if gridCorr is ON
@@ -2817,7 +3119,14 @@ void SPXSteeringFile::ParseDataSteeringFiles(void) {
 
 			//Attempt to parse the Data Steering File
 			try {
-				dataSteeringFile.Parse();
+				//Copy the parsed steering file from the cache, parsing it now if it was not preloaded
+				std::map<std::string, SPXDataSteeringFile>::iterator it = dataSteeringFileCache.find(dataSteeringFile.GetFilename());
+				if(it != dataSteeringFileCache.end()) {
+					dataSteeringFile = it->second;
+				} else {
+					dataSteeringFile.Parse();
+					dataSteeringFileCache.insert(std::make_pair(dataSteeringFile.GetFilename(), dataSteeringFile));
+				}
 
 				//Prepend the data directory onto the steering file's data path
 				dataSteeringFile.PrependDataFile(pci.dataDirectory);
@@ -2901,7 +3210,14 @@ void SPXSteeringFile::ParseGridSteeringFiles(void) {
 
 			//Attempt to parse the Grid Steering File
 			try {
-				gridSteeringFile.Parse();
+				//Copy the parsed steering file from the cache, parsing it now if it was not preloaded
+				std::map<std::string, SPXGridSteeringFile>::iterator it = gridSteeringFileCache.find(gridSteeringFile.GetFilename());
+				if(it != gridSteeringFileCache.end()) {
+					gridSteeringFile = it->second;
+				} else {
+					gridSteeringFile.Parse();
+					gridSteeringFileCache.insert(std::make_pair(gridSteeringFile.GetFilename(), gridSteeringFile));
+				}
 
 				gridSteeringFile.PrependGridFilepath(pci.gridDirectory);
 
@@ -2943,7 +3259,14 @@ void SPXSteeringFile::ParsePDFSteeringFiles(void) {
 
 			//Attempt to parse the PDF Steering File
 			try {
-				pdfSteeringFile.Parse();
+				//Copy the parsed steering file from the cache, parsing it now if it was not preloaded
+				std::map<std::string, SPXPDFSteeringFile>::iterator it = pdfSteeringFileCache.find(pdfSteeringFile.GetFilename());
+				if(it != pdfSteeringFileCache.end()) {
+					pdfSteeringFile = it->second;
+				} else {
+					pdfSteeringFile.Parse();
+					pdfSteeringFileCache.insert(std::make_pair(pdfSteeringFile.GetFilename(), pdfSteeringFile));
+				}
 
 				//Use default pdfFillStyle, pdfFillColor, and pdfMarkerStyle if currently empty
 				if(pci.totalFillStyle == PC_EMPTY_STYLE) {
@@ -48,13 +48,27 @@ const int COLOR_EMPTY = -1;
 const double MAX_EMPTY = -HUGE_VAL;
 const double MIN_EMPTY =  HUGE_VAL;
 
+//Value replacing a key of the steering file when it is parsed (section "PLOT": every [PLOT_n])
+typedef struct SPXSteeringOverride_t {
+	std::string section;
+	std::string key;
+	std::string value;
+} SPXSteeringOverride_t;
+
 class SPXSteeringFile {
 
+	friend class SPXSteeringBundle;
+
 private:
 
 	//INI Reader
 	INIReader *reader;
 
+	//Parsed Data/Grid/PDF steering files keyed by steering file path, shared by all instances in the process
+	static std::map<std::string, SPXDataSteeringFile> dataSteeringFileCache;
+	static std::map<std::string, SPXGridSteeringFile> gridSteeringFileCache;
+	static std::map<std::string, SPXPDFSteeringFile> pdfSteeringFileCache;
+
 	//Metadata
 	std::string filename;
 
@@ -63,6 +77,8 @@ private:
 
         bool  OutputRootfile; // Flag to write out rootfile with all objects
 	std::string OutputGraphicFormat; // string specifying graphic format of figures
+	std::vector<std::string> OutputGraphicFormats; // graphic formats of output_graphicformat (comma separated list)
+	std::string OutputTableFormat;   // format of the per-bin results table (csv or root), empty: no table
 
 	//[GRAPH]
         bool addonLegendNLOProgramName; // Flag to indicate that NLO program name should be added in Legend
@@ -167,11 +183,22 @@ private:
 	std::vector<SPXPlotConfiguration> plotConfigurations;	//Options for each plot
 	void SetDefaultScales(void);
 	void SetDefaults(void);
+	void EnableDebug(void);
+
+	//Overrides of steering file keys, applied to the reader in Parse (not stored in the steering bundle)
+	std::vector<SPXSteeringOverride_t> overrides;
+	void ApplyOverrides(void);
+
 	unsigned int ParseNumberOfPlots(void);
 	unsigned int ParseNumberOfRatios(unsigned int plotNumber);
 	void ParsePlotConfigurations();
  
         bool ParameterScan; // grid has parameter scan
+        std::string ParameterScanInterpolation; // interpolation in the parameter: spline or poly<degree>
+        int ParameterScanPoints;                // number of chi2 scan points, 0: no scan
+        double ParameterScanMin;                // scan range, default: range of the grids
+        double ParameterScanMax;
+        bool ParameterScanLegend;               // legend layout for grids at different parameter values
 
 public:
 
@@ -183,6 +210,12 @@ public:
 	void PrintAll(void);
 	void ParseAll(bool print);
 
+	//Reads the compiled steering bundle (SPXSteeringBundle) if it is up to date, or parses the steering files
+	void LoadAll(bool print);
+
+	//Replaces the value of a key before parsing, e.g. to run the same steering file with another PDF (SPXSteeringSweep)
+	void SetOverride(const std::string &section, const std::string &key, const std::string &value);
+
 	void Print(void);
 	void PrintPDFSteeringFiles(void);
 	void PrintDataSteeringFiles(void);
@@ -195,6 +228,10 @@ public:
 	void ParseDataSteeringFiles(void);
 	void ParseGridSteeringFiles(void);
 
+	//Parses each unique Data/Grid/PDF steering file once, concurrently, into the steering file cache
+	void PreloadSteeringFiles(void);
+	static void ClearSteeringFileCache(void);
+
 	explicit SPXSteeringFile(const std::string &filename) : debug(false){
 		//Set filename
 		this->filename = filename;
@@ -220,6 +257,14 @@ public:
 		return this->OutputGraphicFormat;
 	}
 
+	const std::vector<std::string> & GetOutputGraphicFormats(void) const {
+		return this->OutputGraphicFormats;
+	}
+
+	std::string GetOutputTableFormat(void) const {
+		return this->OutputTableFormat;
+	}
+
 	bool GetPlotBand(void) const {
 		return this->plotBand;
 	}
@@ -515,6 +560,26 @@ public:
 		return this->ParameterScan;
 	}
 
+	std::string GetParameterScanInterpolation(void) const {
+		return this->ParameterScanInterpolation;
+	}
+
+	int GetParameterScanPoints(void) const {
+		return this->ParameterScanPoints;
+	}
+
+	double GetParameterScanMin(void) const {
+		return this->ParameterScanMin;
+	}
+
+	double GetParameterScanMax(void) const {
+		return this->ParameterScanMax;
+	}
+
+	bool GetParameterScanLegend(void) const {
+		return this->ParameterScanLegend;
+	}
+
          
 	//std::vector<std::string >  GetReplicaFileNames() { return replicasteeringfile;} 
 	std::string   GetReplicaFileName() { return replicasteeringfile;} 
@@ -0,0 +1,534 @@
+//************************************************************/
+//
+//	Steering Sweep Implementation
+//
+//	Implements the SPXSteeringSweep class
+//
+//	@Author: 	Spectrum contributors
+//	@Date:		19.10.2026
+//
+//************************************************************/
+
+#include <iomanip>
+#include <set>
+#include <sstream>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+
+#include "SPXSteeringSweep.h"
+#include "SPXAnalysis.h"
+#include "SPXHERAFitterTable.h"
+#include "SPXOutputManager.h"
+#include "SPXStageTimer.h"
+#include "SPXFileUtilities.h"
+#include "SPXStringUtilities.h"
+#include "SPXUtilities.h"
+
+//Class name for debug statements
+const std::string cn = "SPXSteeringSweep::";
+
+//Interval between two looks at the running workers [us]
+const useconds_t SWEEP_WAIT_INTERVAL = 10000;
+
+//Must define the static debug variable in the implementation
+bool SPXSteeringSweep::debug;
+
+SPXSteeringSweep::SPXSteeringSweep(const std::string &filename, unsigned int numberOfJobs) {
+	this->filename = filename;
+	this->running = 0;
+
+	if(!numberOfJobs) {
+		long numberOfCores = sysconf(_SC_NPROCESSORS_ONLN);
+		numberOfJobs = (numberOfCores > 0) ? (unsigned int)numberOfCores : 1;
+	}
+
+	this->numberOfJobs = numberOfJobs;
+}
+
+double SPXSteeringSweep::GetTime(void) {
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0;
+}
+
+//Values of an axis: separated by '|' or newlines (continuation lines), empty values are ignored
+std::vector<std::string> SPXSteeringSweep::ParseAxis(const std::string &value) {
+	std::vector<std::string> values;
+
+	std::string s = SPXStringUtilities::ReplaceAll(value, "\n", "|");
+	std::vector<std::string> tokens = SPXStringUtilities::SplitString(s, "|");
+
+	for(int i = 0; i < tokens.size(); i++) {
+		std::string token = SPXStringUtilities::Trim(tokens[i]);
+		if(!token.empty()) values.push_back(token);
+	}
+
+	return values;
+}
+
+//Label of a (comma separated) list of steering files: file names without directory and extension
+std::string SPXSteeringSweep::GetLabel(const std::string &files) {
+	std::vector<std::string> v = SPXStringUtilities::CommaSeparatedListToVector(files);
+	std::string label;
+
+	for(int i = 0; i < v.size(); i++) {
+		std::string name = SPXStringUtilities::Trim(v[i]);
+
+		size_t pos = name.find_last_of('/');
+		if(pos != std::string::npos) name.erase(0, pos + 1);
+
+		pos = name.find_last_of('.');
+		if(pos != std::string::npos && pos > 0) name.erase(pos);
+
+		if(!label.empty()) label += "+";
+		label += name;
+	}
+
+	return label;
+}
+
+void SPXSteeringSweep::Parse(void) {
+	std::string mn = "Parse: ";
+	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+	INIReader reader(filename);
+
+	if(reader.ParseError() < 0) {
+		throw SPXFileIOException(filename, "INIReader::INIReader(): ParseError generated when parsing file");
+	}
+
+	std::vector<std::string> pdfs = ParseAxis(reader.Get("SWEEP", "pdf_steering_files", ""));
+	std::vector<std::string> grids = ParseAxis(reader.Get("SWEEP", "grid_steering_files", ""));
+	std::vector<std::string> renScales = ParseAxis(reader.Get("SWEEP", "ren_scales", ""));
+	std::vector<std::string> facScales = ParseAxis(reader.Get("SWEEP", "fac_scales", ""));
+	std::vector<std::string> members = ParseAxis(reader.Get("SWEEP", "pdf_members", ""));
+	std::vector<std::string> alphaSValues = ParseAxis(reader.Get("SWEEP", "alpha_s", ""));
+
+	if(pdfs.empty() && grids.empty() && renScales.empty() && facScales.empty() && members.empty() && alphaSValues.empty()) {
+		throw SPXParseException(filename, "No sweep axis found: [SWEEP] must give pdf_steering_files, grid_steering_files, ren_scales/fac_scales, pdf_members or alpha_s");
+	}
+
+	if(renScales.size() != facScales.size()) {
+		std::ostringstream oss;
+		oss << "[SWEEP] ren_scales has " << renScales.size() << " scale sets, but fac_scales has " << facScales.size();
+		throw SPXParseException(filename, oss.str());
+	}
+
+	for(int i = 0; i < renScales.size(); i++) {
+		if(SPXStringUtilities::CommaSeparatedListToVector(renScales[i]).size() != SPXStringUtilities::CommaSeparatedListToVector(facScales[i]).size()) {
+			throw SPXParseException(filename, "[SWEEP] ren_scales " + renScales[i] + " and fac_scales " + facScales[i] + " have a different number of scales");
+		}
+	}
+
+	std::vector<int> pdfMembers;
+	for(int i = 0; i < members.size(); i++) {
+		int member = SPXStringUtilities::StringToNumber<int>(members[i]);
+		if(member < 0) {
+			throw SPXParseException(filename, "[SWEEP] pdf_members must be >= 0, but is " + members[i]);
+		}
+		pdfMembers.push_back(member);
+	}
+
+	std::vector<int> alphaS;
+	for(int i = 0; i < alphaSValues.size(); i++) {
+		if(!alphaSValues[i].compare("down")) {
+			alphaS.push_back(-1);
+		} else if(!alphaSValues[i].compare("central")) {
+			alphaS.push_back(0);
+		} else if(!alphaSValues[i].compare("up")) {
+			alphaS.push_back(1);
+		} else {
+			throw SPXParseException(filename, "[SWEEP] alpha_s values must be down, central or up, but one is " + alphaSValues[i]);
+		}
+	}
+
+	//An axis not given has one value: the one of the steering file
+	if(pdfs.empty()) pdfs.push_back("");
+	if(grids.empty()) grids.push_back("");
+	if(renScales.empty()) {
+		renScales.push_back("");
+		facScales.push_back("");
+	}
+	if(pdfMembers.empty()) pdfMembers.push_back(-1);
+	if(alphaS.empty()) alphaS.push_back(0);
+
+	points.clear();
+	std::set<std::string> labels;
+
+	for(int ipdf = 0; ipdf < pdfs.size(); ipdf++) {
+		for(int igrid = 0; igrid < grids.size(); igrid++) {
+			for(int iscale = 0; iscale < renScales.size(); iscale++) {
+				for(int imember = 0; imember < pdfMembers.size(); imember++) {
+					for(int ialphas = 0; ialphas < alphaS.size(); ialphas++) {
+						SPXSweepPoint_t point;
+						point.pdfSteeringFiles = pdfs[ipdf];
+						point.gridSteeringFiles = grids[igrid];
+						point.renScales = renScales[iscale];
+						point.facScales = facScales[iscale];
+						point.pdfMember = pdfMembers[imember];
+						point.alphaS = alphaS[ialphas];
+						point.pid = 0;
+						point.start = 0;
+						point.time = 0;
+						point.status = 0;
+
+						std::ostringstream label;
+						if(!point.pdfSteeringFiles.empty()) label << "_" << GetLabel(point.pdfSteeringFiles);
+						if(!point.gridSteeringFiles.empty()) label << "_" << GetLabel(point.gridSteeringFiles);
+						if(!point.renScales.empty()) label << "_scales" << iscale;
+						if(point.pdfMember >= 0) label << "_member" << point.pdfMember;
+						if(!alphaSValues.empty()) label << "_alphas_" << alphaSValues[ialphas];
+
+						point.label = label.str().substr(1);
+
+						//e.g. the same PDF twice in the axis: the labels must still differ
+						if(labels.count(point.label)) {
+							std::ostringstream oss;
+							oss << point.label << "_" << points.size();
+							point.label = oss.str();
+						}
+						labels.insert(point.label);
+
+						points.push_back(point);
+					}
+				}
+			}
+		}
+	}
+
+	std::cout << cn << mn << "Sweep of " << filename << ": " << points.size() << " point(s)" << std::endl;
+
+	//Parse the steering files of all points before running any: errors are reported before the sweep starts
+	steeringFiles.clear();
+
+	for(int i = 0; i < points.size(); i++) {
+		SPXSweepPoint_t &point = points[i];
+
+		if(debug) std::cout << cn << mn << "Parsing the steering file of point " << i << ": " << point.label << std::endl;
+
+		SPXSteeringFile steeringFile = SPXSteeringFile(filename);
+
+		if(!point.pdfSteeringFiles.empty()) steeringFile.SetOverride("PLOT", "pdf_steering_files", point.pdfSteeringFiles);
+		if(!point.gridSteeringFiles.empty()) steeringFile.SetOverride("PLOT", "grid_steering_files", point.gridSteeringFiles);
+		if(!point.renScales.empty()) {
+			steeringFile.SetOverride("GRAPH", "ren_scales", point.renScales);
+			steeringFile.SetOverride("GRAPH", "fac_scales", point.facScales);
+		}
+		if(point.alphaS != 0) {
+			steeringFile.SetOverride("GRAPH", "band_with_pdf", "false");
+			steeringFile.SetOverride("GRAPH", "band_with_alphas", "false");
+		}
+
+		try {
+			steeringFile.ParseAll(false);
+		} catch(const SPXException &e) {
+			std::cerr << e.what() << std::endl;
+			throw SPXParseException(filename, "Unable to parse the steering file for sweep point " + point.label);
+		}
+
+		for(int j = 0; j < steeringFile.GetNumberOfPlotConfigurations(); j++) {
+			SPXPlotConfiguration &pc = steeringFile.GetPlotConfiguration(j);
+
+			for(int k = 0; k < pc.GetNumberOfConfigurationInstances(); k++) {
+				SPXPDFSteeringFile &psf = pc.GetPlotConfigurationInstance(k).pdfSteeringFile;
+
+				if(point.pdfMember >= 0) psf.SetDefaultID(point.pdfMember);
+				if(point.alphaS != 0) SetAlphaS(psf, point.alphaS, point.label);
+			}
+
+			std::string &description = pc.GetDescription();
+			if(description.empty()) description = "general";
+			description += "_" + point.label;
+		}
+
+		steeringFiles.push_back(steeringFile);
+	}
+}
+
+//Replaces the central PDF by the alpha_s down (-1) or up (+1) set of the PDF steering file
+void SPXSteeringSweep::SetAlphaS(SPXPDFSteeringFile &psf, int alphaS, const std::string &label) {
+	const std::string &name = (alphaS < 0) ? psf.GetAlphaSPDFNameDown() : psf.GetAlphaSPDFNameUp();
+	int member = (alphaS < 0) ? psf.GetAlphaSErrorNumberDown() : psf.GetAlphaSErrorNumberUp();
+
+	if(name.empty() || !name.compare("none") || member == ALPHA_S_ERROR_NUM_EMPTY) {
+		throw SPXParseException(psf.GetFilename(), "Sweep point " + label + " needs alpha_s_pdf_name_up/down and alpha_s_error_number_up/down in the PDF steering file");
+	}
+
+	psf.SetName(name);
+	psf.SetDefaultID(member);
+}
+
+//Reads every grid of every point into the grid cache (SPXGrid), shared by the workers; the references
+// are held until ReleaseGrids, so that no point trims them from the cache
+void SPXSteeringSweep::PreloadGrids(void) {
+	std::string mn = "PreloadGrids: ";
+	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+	SPXStageScope stage("load");
+
+	std::set<std::string> files;
+
+	for(int i = 0; i < steeringFiles.size(); i++) {
+		SPXSteeringFile &steeringFile = steeringFiles[i];
+
+		for(int j = 0; j < steeringFile.GetNumberOfPlotConfigurations(); j++) {
+			SPXPlotConfiguration &pc = steeringFile.GetPlotConfiguration(j);
+
+			for(int k = 0; k < pc.GetNumberOfConfigurationInstances(); k++) {
+				SPXGridSteeringFile &gsf = pc.GetPlotConfigurationInstance(k).gridSteeringFile;
+
+				std::vector<std::string> v = gsf.GetGridFilepathVector();
+				files.insert(v.begin(), v.end());
+
+				v = gsf.GetGridFilepathAlternativeScaleChoiceVector();
+				files.insert(v.begin(), v.end());
+			}
+		}
+	}
+
+	unsigned int n = 0;
+
+	for(std::set<std::string>::iterator it = files.begin(); it != files.end(); ++it) {
+		//Missing grids are reported by the point using them
+		if(it->empty() || !SPXFileUtilities::FileExists(*it)) continue;
+
+		grids.push_back(SPXGrid::GetCachedGrid(*it));
+		n++;
+	}
+
+	std::cout << cn << mn << "Read " << n << " grid file(s) shared by " << points.size() << " sweep point(s)" << std::endl;
+}
+
+void SPXSteeringSweep::ReleaseGrids(void) {
+	for(int i = 0; i < grids.size(); i++) {
+		SPXGrid::ReleaseCachedGrid(grids[i]);
+	}
+
+	grids.clear();
+}
+
+//Parses the HERAFitter tables of every point, shared by the workers
+void SPXSteeringSweep::PreloadData(void) {
+	std::string mn = "PreloadData: ";
+	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+	SPXStageScope stage("parse");
+
+	std::set<std::string> files;
+
+	for(int i = 0; i < steeringFiles.size(); i++) {
+		SPXSteeringFile &steeringFile = steeringFiles[i];
+
+		for(int j = 0; j < steeringFile.GetNumberOfPlotConfigurations(); j++) {
+			SPXPlotConfiguration &pc = steeringFile.GetPlotConfiguration(j);
+
+			for(int k = 0; k < pc.GetNumberOfConfigurationInstances(); k++) {
+				SPXDataSteeringFile &dsf = pc.GetPlotConfigurationInstance(k).dataSteeringFile;
+
+				if(dsf.GetDataFormat().IsHERAFitter()) {
+					files.insert(dsf.GetDataFile());
+				}
+			}
+		}
+	}
+
+	SPXHERAFitterTable::Preload(std::vector<std::string>(files.begin(), files.end()));
+}
+
+void SPXSteeringSweep::Run(void) {
+	std::string mn = "Run: ";
+	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+	if(steeringFiles.size() != points.size()) {
+		throw SPXGeneralException(cn + mn + "Parse must be called before Run");
+	}
+
+	PreloadGrids();
+
+	if(numberOfJobs > points.size()) numberOfJobs = points.size();
+
+	try {
+		PreloadData();
+
+		//A single job runs the points in this process: simpler to debug, nothing to fork
+		if(numberOfJobs <= 1) {
+			for(int i = 0; i < points.size(); i++) {
+				RunPoint(i);
+			}
+		} else {
+			for(int i = 0; i < points.size(); i++) {
+				while(running >= numberOfJobs) {
+					WaitForWorker();
+				}
+
+				StartWorker(i);
+			}
+
+			while(running > 0) {
+				WaitForWorker();
+			}
+		}
+	} catch(...) {
+		//e.g. a failed fork: the workers already started are still reaped
+		while(running > 0) {
+			WaitForWorker();
+		}
+		ReleaseGrids();
+		throw;
+	}
+
+	ReleaseGrids();
+}
+
+//Runs one point in this process
+void SPXSteeringSweep::RunPoint(unsigned int index) {
+	std::string mn = "RunPoint: ";
+
+	SPXSweepPoint_t &point = points[index];
+
+	std::cout << cn << mn << "Running sweep point " << index << ": " << point.label << std::endl;
+
+	point.start = GetTime();
+
+	try {
+		SPXAnalysis analysis = SPXAnalysis(&steeringFiles[index]);
+		analysis.Run();
+
+		point.status = SPXOutputManager::Wait() ? 1 : 0;
+	} catch(const SPXException &e) {
+		std::cerr << e.what() << std::endl;
+		point.status = 1;
+	}
+
+	point.time = GetTime() - point.start;
+
+	if(point.status != 0) {
+		std::cerr << cn << mn << "WARNING: Sweep point " << point.label << " failed" << std::endl;
+	}
+}
+
+//Forks a worker running one point; the worker exits without running the destructors and exit
+// handlers of the main process
+void SPXSteeringSweep::StartWorker(unsigned int index) {
+	std::string mn = "StartWorker: ";
+	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+	SPXSweepPoint_t &point = points[index];
+
+	//The worker must not inherit raster files being written by threads of this process
+	SPXOutputManager::Wait();
+
+	//Buffered output would otherwise be written by both processes
+	std::cout.flush();
+	std::cerr.flush();
+
+	pid_t pid = fork();
+
+	if(pid < 0) {
+		throw SPXGeneralException(cn + mn + "Unable to fork sweep worker: " + strerror(errno));
+	}
+
+	if(pid == 0) {
+		gROOT->SetBatch(kTRUE);
+
+		RunPoint(index);
+
+		std::cout.flush();
+		std::cerr.flush();
+
+		_exit(point.status);
+	}
+
+	point.pid = pid;
+	point.start = GetTime();
+
+	running++;
+
+	std::cout << cn << mn << "Sweep point " << index << " (" << point.label << ") runs in worker " << pid << std::endl;
+}
+
+//Reaps one worker of this sweep; only the pids of its own workers are waited for, so that no other
+// child of the process (e.g. a render worker) is reaped here
+void SPXSteeringSweep::WaitForWorker(void) {
+	std::string mn = "WaitForWorker: ";
+
+	while(running > 0) {
+		for(int i = 0; i < points.size(); i++) {
+			SPXSweepPoint_t &point = points[i];
+
+			if(point.pid == 0) {
+				continue;
+			}
+
+			int status = 0;
+			pid_t pid = waitpid(point.pid, &status, WNOHANG);
+
+			if(pid == 0 || (pid < 0 && errno == EINTR)) {
+				continue;
+			}
+
+			point.time = GetTime() - point.start;
+
+			if(pid < 0) {
+				std::cerr << cn << mn << "WARNING: Unable to wait for worker " << point.pid << ": " << strerror(errno) << std::endl;
+				point.status = -1;
+			} else {
+				point.status = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+			}
+
+			point.pid = 0;
+
+			running--;
+
+			if(point.status != 0) {
+				std::cerr << cn << mn << "WARNING: Worker running sweep point " << point.label << " failed (status " << point.status << ")" << std::endl;
+			} else if(debug) {
+				std::cout << cn << mn << "Sweep point " << point.label << " done in " << point.time << " ms" << std::endl;
+			}
+
+			return;
+		}
+
+		usleep(SWEEP_WAIT_INTERVAL);
+	}
+}
+
+unsigned int SPXSteeringSweep::GetNumberOfFailures(void) const {
+	unsigned int failures = 0;
+
+	for(int i = 0; i < points.size(); i++) {
+		if(points[i].status != 0) failures++;
+	}
+
+	return failures;
+}
+
+void SPXSteeringSweep::PrintSummary(std::ostream &out) const {
+	double total = 0;
+	double first = 0;
+	double last = 0;
+
+	out << std::endl;
+	out << "==================================" << std::endl;
+	out << "      	   Sweep		        " << std::endl;
+	out << "==================================" << std::endl;
+	out << std::left << std::setw(40) << "point" << std::right << std::setw(10) << "status" << std::setw(12) << "time [ms]" << std::endl;
+
+	for(int i = 0; i < points.size(); i++) {
+		const SPXSweepPoint_t &point = points[i];
+
+		out << std::left << std::setw(40) << point.label << std::right << std::setw(10) << point.status
+		    << std::setw(12) << std::fixed << std::setprecision(1) << point.time << std::endl;
+
+		total += point.time;
+		if(i == 0 || point.start < first) first = point.start;
+		if(point.start + point.time > last) last = point.start + point.time;
+	}
+
+	out << points.size() << " points on " << numberOfJobs << " jobs, " << std::fixed << std::setprecision(1)
+	    << total << " ms of analysis in " << (last - first) << " ms, " << GetNumberOfFailures() << " failed" << std::endl;
+	out << "==================================" << std::endl;
+}
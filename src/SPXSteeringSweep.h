@@ -0,0 +1,120 @@
+//************************************************************/
+//
+//	Steering Sweep Header
+//
+//	Outlines the SPXSteeringSweep class, which runs one steering
+//	file over all combinations of the axes declared in its
+//	[SWEEP] section (Spectrum --sweep):
+//
+//	[SWEEP]
+//	pdf_steering_files = CT10.txt | CT14.txt | MMHT2014.txt
+//	grid_steering_files = ...
+//	ren_scales = 2.0, 0.5 | 2.0, 2.0, 1.0, 1.0, 0.5, 0.5
+//	fac_scales = 2.0, 0.5 | 2.0, 1.0, 2.0, 0.5, 1.0, 0.5
+//	pdf_members = 0 | 2
+//	alpha_s = down | central | up
+//
+//	Values of an axis are separated by '|' (or are given on
+//	continuation lines); ren_scales and fac_scales form one axis
+//	of sets of scale variations, and must have the same number
+//	of sets and of scales in each set. PDF and grid steering
+//	files replace those of every [PLOT_n], the scales those of
+//	[GRAPH], and pdf_members the central member of every PDF.
+//	alpha_s down/up replaces the central PDF by the alpha_s_pdf_name
+//	and alpha_s_error_number of the PDF steering files, with the
+//	PDF and alpha_s bands turned off (they belong to the nominal
+//	set). Axes not given keep the values of the steering file. Each
+//	combination is a sweep point: its label is added to the
+//	description of each plot, so that the output files of the
+//	points do not overwrite each other.
+//
+//	All steering files are parsed, and all grids and HERAFitter
+//	tables are read once in the main process, then each point is
+//	run in a forked worker process (at most <n> at a time), which
+//	shares them with the main process. The sweep holds the grids
+//	until it ends, so that --stream does not delete them between
+//	points. Data in the other formats is read by each point.
+//
+//	@Author: 	Spectrum contributors
+//	@Date:		19.10.2026
+//
+//************************************************************/
+
+#ifndef SPXSTEERINGSWEEP_H
+#define SPXSTEERINGSWEEP_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+#include "SPXSteeringFile.h"
+#include "SPXGrid.h"
+#include "SPXException.h"
+
+//One combination of the sweep axes
+typedef struct SPXSweepPoint_t {
+	std::string label;			// Added to the plot descriptions
+	std::string pdfSteeringFiles;		// Empty: as in the steering file
+	std::string gridSteeringFiles;
+	std::string renScales;
+	std::string facScales;
+	int pdfMember;				// -1: as in the PDF steering files
+	int alphaS;				// -1/+1: alpha_s down/up set, 0: as in the PDF steering files
+	pid_t pid;				// Worker process (0: not running)
+	double start;				// Wall time of the start [ms]
+	double time;				// Wall time of the point [ms]
+	int status;				// Exit status (0: success, -1: killed by a signal)
+} SPXSweepPoint_t;
+
+class SPXSteeringSweep {
+
+public:
+	//numberOfJobs = 0: one job per core
+	SPXSteeringSweep(const std::string &filename, unsigned int numberOfJobs);
+
+	//Reads the [SWEEP] section and parses the steering files of all points
+	void Parse(void);
+
+	//Reads the grids of all points once, then runs the points
+	void Run(void);
+
+	unsigned int GetNumberOfPoints(void) const {
+		return points.size();
+	}
+
+	unsigned int GetNumberOfFailures(void) const;
+	void PrintSummary(std::ostream &out) const;
+
+	static bool GetDebug(void) {
+		return debug;
+	}
+
+	static void SetDebug(bool b) {
+		debug = b;
+	}
+
+private:
+	static bool debug;			// Flag indicating debug mode
+
+	std::string filename;			// Steering file with the [SWEEP] section
+	unsigned int numberOfJobs;		// Largest number of points running at once
+	unsigned int running;			// Workers not reaped yet
+	std::vector<SPXSweepPoint_t> points;
+	std::vector<SPXSteeringFile> steeringFiles;	// Parsed steering file of each point
+	std::vector<appl::grid *> grids;	// References held on the cached grids until the sweep ends
+
+	static std::vector<std::string> ParseAxis(const std::string &value);
+	static std::string GetLabel(const std::string &files);
+
+	void SetAlphaS(SPXPDFSteeringFile &psf, int alphaS, const std::string &label);
+	void PreloadGrids(void);
+	void ReleaseGrids(void);
+	void PreloadData(void);
+	void RunPoint(unsigned int index);
+	void StartWorker(unsigned int index);
+	void WaitForWorker(void);
+	static double GetTime(void);
+};
+
+#endif
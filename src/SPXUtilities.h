@@ -25,6 +25,13 @@ namespace Test {
 
 namespace Options {
     extern bool Metadata;
+    extern bool NoDraw;     //Batch mode: convolute and write results, never create a canvas or pad
+    extern bool KeepPlots;  //Keep the objects of each plot after it is drawn (interactive canvases, --watch redraws)
+    extern bool MemReport;  //Print the peak number and size of ROOT objects of each phase at the end
+    extern unsigned int StreamWindow; //Streaming: plots are initialized when they are drawn, at most this many are kept (0: off)
+    extern unsigned int RenderWorkers; //Number of worker processes drawing the plots (0: draw in the main process)
+    extern std::string TimingFile;  //Write the time spent in each stage of the run to this CSV file (empty: off)
+    extern std::string DumpDirectory; //Write all results of each plot in canonical form to this directory (empty: off)
 }
 
 //Typedefs for Maps/Pairs
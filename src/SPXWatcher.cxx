@@ -0,0 +1,383 @@
+//************************************************************/
+//
+//	Watcher Implementation
+//
+//	Implements the SPXWatcher class (Spectrum --watch mode)
+//
+//	@Author: 	Spectrum contributors
+//	@Date:		19.10.2026
+//
+//************************************************************/
+
+#include <iostream>
+#include <sstream>
+#include <cstdlib>
+#include <climits>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#endif
+
+#include "ini.h"
+
+#include "SPXWatcher.h"
+#include "SPXUtilities.h"
+
+//Class name for debug statements
+const std::string cn = "SPXWatcher::";
+
+//Must define the static debug variable in the implementation
+bool SPXWatcher::debug;
+
+//Quiet time after the last file event before re-processing (editors write files in several steps)
+const int WATCH_SETTLE_MS = 200;
+
+//Top-level steering keys which only affect how an already computed plot is drawn and written.
+//Styles are not among them: they are copied into the graphs at initialization
+static const char *DRAW_ONLY_KEYS[] = {
+	"output_graphicformat", "output_rootfile", "output_table",
+	"label_chi2", "label_date", "label_informationlegend", "label_journalreference", "label_journalyear",
+	"label_lumi", "label_nlo_program_name", "label_scaleform", "label_sqrt_s",
+	"x_legend", "y_legend", "x_info_legend", "y_info_legend", "x_databox", "y_databox",
+	"x_overlay_min", "x_overlay_max", "y_overlay_min", "y_overlay_max", "y_ratio_min", "y_ratio_max",
+	"x_log", "y_log", "desc", "ratio_title", "plot_error_ticks", "print_total_sigma", "dump_latex_tables",
+	0
+};
+
+SPXWatcher::SPXWatcher(SPXSteeringFile *steeringFile, SPXAnalysis *analysis) {
+	std::string mn = "SPXWatcher: ";
+	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+	this->steeringFile = steeringFile;
+	this->analysis = analysis;
+
+	steeringFilename = GetCanonicalPath(steeringFile->GetFilename());
+	steeringKeys = ReadSteeringKeys(steeringFile->GetFilename());
+
+	BuildDependencies();
+}
+
+//Resolves the directory part only: the file itself may be (re)moved while an editor saves it
+std::string SPXWatcher::GetCanonicalPath(const std::string &file) {
+	std::string dir = ".";
+	std::string base = file;
+
+	size_t pos = file.find_last_of('/');
+	if(pos != std::string::npos) {
+		dir = (pos == 0) ? "/" : file.substr(0, pos);
+		base = file.substr(pos + 1);
+	}
+
+	char resolved[PATH_MAX];
+	if(realpath(dir.c_str(), resolved)) {
+		dir = std::string(resolved);
+	}
+
+	if(dir == "/") {
+		return dir + base;
+	}
+
+	return dir + "/" + base;
+}
+
+static int SteeringKeyHandler(void *user, const char *section, const char *name, const char *value) {
+	SPXSteeringKeys_T *keys = (SPXSteeringKeys_T *)user;
+	(*keys)[std::string(section) + "." + std::string(name)] = std::string(value);
+	return 1;
+}
+
+SPXSteeringKeys_T SPXWatcher::ReadSteeringKeys(const std::string &file) {
+	std::string mn = "ReadSteeringKeys: ";
+
+	SPXSteeringKeys_T keys;
+
+	if(ini_parse(file.c_str(), SteeringKeyHandler, &keys) < 0) {
+		throw SPXFileIOException(file, cn + mn + "Unable to read steering file");
+	}
+
+	return keys;
+}
+
+//Ratio definitions (ratio_<n>, ratio_style_<n>) and the display style are read by InitializeRatios and Plot only
+SPXWatchStage_t SPXWatcher::GetKeyStage(const std::string &key) {
+	for(int i = 0; DRAW_ONLY_KEYS[i]; i++) {
+		if(key == DRAW_ONLY_KEYS[i]) {
+			return WatchStageDraw;
+		}
+	}
+
+	if(!key.compare(0, 6, "ratio_") || key == "display_style") {
+		return WatchStageRatio;
+	}
+
+	return WatchStageConvolute;
+}
+
+void SPXWatcher::AddDependency(const std::string &file, unsigned int plot) {
+	if(file.empty()) {
+		return;
+	}
+
+	std::string path = GetCanonicalPath(file);
+	dependencies[path].insert(plot);
+	directories.insert(path.substr(0, path.find_last_of('/')));
+}
+
+//File -> plots map of everything a plot reads: data, grid, PDF and correction files and their steering files
+void SPXWatcher::BuildDependencies(void) {
+	std::string mn = "BuildDependencies: ";
+	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+	dependencies.clear();
+
+	for(unsigned int i = 0; i < steeringFile->GetNumberOfPlotConfigurations(); i++) {
+		AddDependency(steeringFile->GetFilename(), i);
+
+		for(unsigned int j = 0; j < steeringFile->GetNumberOfConfigurationInstances(i); j++) {
+			SPXPlotConfigurationInstance &pci = steeringFile->GetPlotConfigurationInstance(i, j);
+
+			AddDependency(pci.dataSteeringFile.GetFilename(), i);
+			AddDependency(pci.dataSteeringFile.GetDataFile(), i);
+
+			AddDependency(pci.gridSteeringFile.GetFilename(), i);
+
+			std::vector<std::string> grids = pci.gridSteeringFile.GetGridFilepathVector();
+			for(int k = 0; k < grids.size(); k++) {
+				AddDependency(grids.at(k), i);
+			}
+
+			grids = pci.gridSteeringFile.GetGridFilepathAlternativeScaleChoiceVector();
+			for(int k = 0; k < grids.size(); k++) {
+				AddDependency(grids.at(k), i);
+			}
+
+			for(unsigned int k = 0; k < pci.gridSteeringFile.GetNumberOfCorrectionFiles(); k++) {
+				AddDependency(pci.gridDirectory + "/" + pci.gridSteeringFile.GetCorrectionFile(k), i);
+			}
+
+			AddDependency(pci.pdfSteeringFile.GetFilename(), i);
+		}
+	}
+
+	if(debug) {
+		std::map<std::string, std::set<unsigned int> >::iterator it;
+		for(it = dependencies.begin(); it != dependencies.end(); it++) {
+			std::cout << cn << mn << it->first << " -> " << it->second.size() << " plot(s)" << std::endl;
+		}
+	}
+}
+
+void SPXWatcher::Update(const std::set<std::string> &changedFiles) {
+	std::string mn = "Update: ";
+	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+	//Plots to re-initialize (data and convolutions), to rebuild the ratios of, and to draw again only
+	std::set<unsigned int> reinitialize;
+	std::set<unsigned int> ratios;
+	std::set<unsigned int> redraw;
+	bool full = false;
+
+	std::set<std::string>::const_iterator f;
+	for(f = changedFiles.begin(); f != changedFiles.end(); f++) {
+		std::cout << cn << mn << "Changed: " << *f << std::endl;
+
+		//The top-level steering file is resolved key by key below
+		if(*f == steeringFilename) continue;
+
+		std::set<unsigned int> &plots = dependencies[*f];
+		reinitialize.insert(plots.begin(), plots.end());
+	}
+
+	//Re-read the whole configuration: the per-file steering caches would otherwise return the old contents
+	SPXSteeringFile::ClearSteeringFileCache();
+
+	SPXSteeringFile newSteeringFile = SPXSteeringFile(steeringFile->GetFilename());
+	SPXSteeringKeys_T newSteeringKeys;
+
+	try {
+		newSteeringFile.ParseAll(false);
+		newSteeringKeys = ReadSteeringKeys(steeringFile->GetFilename());
+	} catch(const SPXException &e) {
+		std::cerr << e.what() << std::endl;
+		std::cerr << cn << mn << "WARNING: Steering file does not parse: Keeping the previous results until it is fixed" << std::endl;
+		return;
+	}
+
+	unsigned int nplots = steeringFile->GetNumberOfPlotConfigurations();
+
+	if(newSteeringFile.GetNumberOfPlotConfigurations() != nplots) {
+		full = true;
+	} else {
+		for(unsigned int i = 0; i < nplots; i++) {
+			if(newSteeringFile.GetNumberOfConfigurationInstances(i) != steeringFile->GetNumberOfConfigurationInstances(i)) {
+				full = true;
+			}
+		}
+	}
+
+	//Classify every top-level key that was added, removed or changed
+	std::set<std::string> keys;
+	SPXSteeringKeys_T::iterator it;
+	for(it = steeringKeys.begin(); it != steeringKeys.end(); it++) keys.insert(it->first);
+	for(it = newSteeringKeys.begin(); it != newSteeringKeys.end(); it++) keys.insert(it->first);
+
+	for(std::set<std::string>::iterator k = keys.begin(); k != keys.end() && !full; k++) {
+		SPXSteeringKeys_T::iterator o = steeringKeys.find(*k);
+		SPXSteeringKeys_T::iterator n = newSteeringKeys.find(*k);
+
+		if(o != steeringKeys.end() && n != newSteeringKeys.end() && o->second == n->second) continue;
+
+		std::string section = k->substr(0, k->find('.'));
+		std::string name = k->substr(k->find('.') + 1);
+
+		SPXWatchStage_t stage = GetKeyStage(name);
+		std::set<unsigned int> &plots = (stage == WatchStageDraw) ? redraw : ((stage == WatchStageRatio) ? ratios : reinitialize);
+
+		if(debug) std::cout << cn << mn << "Key " << *k << " changed (" << (stage == WatchStageDraw ? "draw" : (stage == WatchStageRatio ? "ratios" : "data and convolutions")) << ")" << std::endl;
+
+		if(!section.compare(0, 5, "PLOT_")) {
+			plots.insert(atoi(section.substr(5).c_str()));
+		} else {
+			for(unsigned int i = 0; i < nplots; i++) plots.insert(i);
+		}
+	}
+
+	//Staggering shifts the convolution points when drawing: drawing the same graphs twice would stagger them twice
+	if(newSteeringFile.GetPlotStaggered() && !newSteeringFile.GetPlotBand()) {
+		reinitialize.insert(ratios.begin(), ratios.end());
+		reinitialize.insert(redraw.begin(), redraw.end());
+	}
+
+	steeringKeys = newSteeringKeys;
+
+	try {
+		if(full) {
+			std::cout << cn << mn << "Plot layout changed: Re-running all plots" << std::endl;
+
+			analysis->ReleasePlots();
+			*steeringFile = newSteeringFile;
+			*analysis = SPXAnalysis(steeringFile);
+			analysis->Run();
+		} else {
+			//The plots point into the configuration instances of the steering file, which the assignment may
+			//reallocate: the plots to re-initialize are released before it, the others are re-pointed after it
+			for(unsigned int i = 0; i < nplots; i++) {
+				if(reinitialize.count(i)) analysis->ReleasePlot(i);
+			}
+
+			*steeringFile = newSteeringFile;
+			analysis->ReconfigurePlots();
+
+			for(unsigned int i = 0; i < nplots; i++) {
+				if(reinitialize.count(i)) {
+					std::cout << cn << mn << "Re-initializing plot " << i << std::endl;
+				} else if(ratios.count(i)) {
+					std::cout << cn << mn << "Rebuilding the ratios of plot " << i << std::endl;
+					analysis->RebuildRatios(i);
+				} else if(redraw.count(i)) {
+					std::cout << cn << mn << "Redrawing plot " << i << std::endl;
+				} else {
+					continue;
+				}
+
+				analysis->RunPlot(i);
+			}
+
+			if(reinitialize.empty() && ratios.empty() && redraw.empty()) {
+				std::cout << cn << mn << "No plot affected" << std::endl;
+			}
+
+			//Updated files are complete once the change is reported
+			if(SPXOutputManager::Wait()) {
+				std::cerr << cn << mn << "WARNING: Could not write all graphic files" << std::endl;
+			}
+		}
+	} catch(const SPXException &e) {
+		std::cerr << e.what() << std::endl;
+		std::cerr << cn << mn << "WARNING: Unable to update the plots: Waiting for the next change" << std::endl;
+	}
+
+	BuildDependencies();
+}
+
+void SPXWatcher::Run(void) {
+	std::string mn = "Run: ";
+	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+#ifdef __linux__
+	int fd = inotify_init();
+	if(fd < 0) {
+		throw SPXGeneralException(cn + mn + "Unable to initialize inotify: " + strerror(errno));
+	}
+
+	std::map<int, std::string> watches;
+	std::set<std::string> watched;
+
+	const uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE;
+	char buffer[16 * (sizeof(struct inotify_event) + NAME_MAX + 1)];
+
+	while(true) {
+		//Watch directories rather than files: editors commonly replace a file on save
+		for(std::set<std::string>::iterator d = directories.begin(); d != directories.end(); d++) {
+			if(watched.count(*d)) continue;
+
+			int wd = inotify_add_watch(fd, d->c_str(), mask);
+			if(wd < 0) {
+				std::cerr << cn << mn << "WARNING: Unable to watch " << *d << ": " << strerror(errno) << std::endl;
+				continue;
+			}
+
+			watches[wd] = *d;
+			watched.insert(*d);
+			if(debug) std::cout << cn << mn << "Watching " << *d << std::endl;
+		}
+
+		std::cout << cn << mn << "Watching " << dependencies.size() << " file(s) in " << watched.size() << " director(y/ies): Press Ctrl-C to stop" << std::endl;
+
+		std::set<std::string> changedFiles;
+		bool settled = false;
+
+		//Block for the first event, then keep collecting until nothing happened for WATCH_SETTLE_MS
+		while(!settled) {
+			ssize_t n = read(fd, buffer, sizeof(buffer));
+
+			if(n < 0) {
+				if(errno == EINTR) continue;
+				close(fd);
+				throw SPXGeneralException(cn + mn + "Unable to read file events: " + strerror(errno));
+			}
+
+			for(char *p = buffer; p < buffer + n; ) {
+				struct inotify_event *event = (struct inotify_event *)p;
+
+				if(event->len > 0 && watches.count(event->wd)) {
+					std::string file = watches[event->wd] + "/" + std::string(event->name);
+					if(dependencies.count(file)) {
+						changedFiles.insert(file);
+					}
+				}
+
+				p += sizeof(struct inotify_event) + event->len;
+			}
+
+			if(changedFiles.empty()) continue;
+
+			struct pollfd pfd;
+			pfd.fd = fd;
+			pfd.events = POLLIN;
+
+			settled = (poll(&pfd, 1, WATCH_SETTLE_MS) == 0);
+		}
+
+		Update(changedFiles);
+	}
+
+	close(fd);
+#else
+	throw SPXGeneralException(cn + mn + "--watch requires inotify and is only available on Linux");
+#endif
+}
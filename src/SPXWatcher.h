@@ -0,0 +1,83 @@
+//************************************************************/
+//
+//	Watcher Header
+//
+//	Outlines the SPXWatcher class, which implements the
+//	Spectrum --watch mode: after the first run the top-level
+//	steering file and every file it pulls in (data, grid, PDF
+//	and correction steering/data files) are watched, and on a
+//	change only the plots depending on the changed files are
+//	re-processed, from the earliest stage the change affects:
+//	a changed data, grid, PDF or correction file, or steering
+//	key other than those below, redoes the data and convolution
+//	(from the grids and PDF members still in memory); a changed
+//	ratio definition or display style rebuilds the ratios; a
+//	changed label, legend position, axis range or output key
+//	only draws and writes the plot again. If the plot layout
+//	changed, all plots are redone.
+//
+//	@Author: 	Spectrum contributors
+//	@Date:		19.10.2026
+//
+//************************************************************/
+
+#ifndef SPXWATCHER_H
+#define SPXWATCHER_H
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "SPXSteeringFile.h"
+#include "SPXAnalysis.h"
+#include "SPXException.h"
+
+//Raw (section.key -> value) content of an INI steering file
+typedef std::map<std::string, std::string> SPXSteeringKeys_T;
+
+//Earliest stage of a plot a changed steering key invalidates
+typedef enum SPXWatchStage_t {
+	WatchStageDraw = 0,		//Drawing and output only
+	WatchStageRatio,		//Ratios, then drawing
+	WatchStageConvolute		//Data and convolutions, then ratios and drawing
+} SPXWatchStage_t;
+
+class SPXWatcher {
+
+public:
+	SPXWatcher(SPXSteeringFile *steeringFile, SPXAnalysis *analysis);
+
+	void Run(void);
+
+	static bool GetDebug(void) {
+		return debug;
+	}
+
+	static void SetDebug(bool b) {
+		debug = b;
+	}
+
+private:
+	static bool debug;					// Flag indicating debug mode
+
+	SPXSteeringFile *steeringFile;				// Top-level steering file (updated in place on a change)
+	SPXAnalysis *analysis;					// Analysis owning the plots
+
+	std::string steeringFilename;				// Canonical path of the top-level steering file
+	SPXSteeringKeys_T steeringKeys;				// Top-level steering keys of the last successful run
+
+	std::map<std::string, std::set<unsigned int> > dependencies;	// Canonical file path -> plots depending on it
+	std::set<std::string> directories;				// Directories currently watched
+
+	void BuildDependencies(void);
+	void AddDependency(const std::string &file, unsigned int plot);
+
+	void Update(const std::set<std::string> &changedFiles);
+
+	static std::string GetCanonicalPath(const std::string &file);
+	static SPXSteeringKeys_T ReadSteeringKeys(const std::string &file);
+	static SPXWatchStage_t GetKeyStage(const std::string &key);
+};
+
+#endif
@@ -0,0 +1,135 @@
+//************************************************************/
+//
+//	Work Queue Implementation
+//
+//	Implements the SPXWorkQueue class
+//
+//	@Author: 	Spectrum contributors
+//	@Date:		19.10.2026
+//
+//************************************************************/
+
+#include <vector>
+#include <unistd.h>
+
+#include "SPXWorkQueue.h"
+#include "SPXUtilities.h"
+
+//Class name for debug statements
+const std::string cn = "SPXWorkQueue::";
+
+//Must define the static debug variable in the implementation
+bool SPXWorkQueue::debug;
+
+//State shared by the threads of one Run
+typedef struct SPXWorkQueueState_t {
+	SPXWorkQueue::Job_t function;
+	void *context;
+	unsigned int numberOfJobs;
+	unsigned int next;
+	std::string error;		// First exception leaving a job
+	pthread_mutex_t mutex;
+} SPXWorkQueueState_t;
+
+//Arguments of one thread
+typedef struct SPXWorkQueueThread_t {
+	SPXWorkQueueState_t *state;
+	unsigned int index;
+	pthread_t thread;
+} SPXWorkQueueThread_t;
+
+unsigned int SPXWorkQueue::GetNumberOfThreads(unsigned int numberOfJobs, unsigned int maxThreads) {
+	long numberOfCores = sysconf(_SC_NPROCESSORS_ONLN);
+	unsigned int numberOfThreads = (numberOfCores > 0) ? (unsigned int)numberOfCores : 1;
+	if(numberOfThreads > maxThreads) numberOfThreads = maxThreads;
+	if(numberOfThreads > numberOfJobs) numberOfThreads = numberOfJobs;
+	if(numberOfThreads < 1) numberOfThreads = 1;
+
+	return numberOfThreads;
+}
+
+//Pops jobs off the queue until it is empty
+void * SPXWorkQueue::Worker(void *arg) {
+	SPXWorkQueueThread_t *thread = (SPXWorkQueueThread_t *)arg;
+	SPXWorkQueueState_t *state = thread->state;
+
+	while(true) {
+		pthread_mutex_lock(&state->mutex);
+		unsigned int job = state->next++;
+		pthread_mutex_unlock(&state->mutex);
+
+		if(job >= state->numberOfJobs) {
+			break;
+		}
+
+		std::string error;
+
+		try {
+			state->function(state->context, job, thread->index);
+		} catch(const std::exception &e) {
+			error = e.what();
+		} catch(...) {
+			error = "Unknown exception";
+		}
+
+		if(!error.empty()) {
+			pthread_mutex_lock(&state->mutex);
+			if(state->error.empty()) state->error = error;
+			pthread_mutex_unlock(&state->mutex);
+		}
+	}
+
+	return NULL;
+}
+
+unsigned int SPXWorkQueue::Run(Job_t function, void *context, unsigned int numberOfJobs, unsigned int numberOfThreads,
+                               const std::string &name) {
+	std::string mn = "Run: ";
+	if(debug) SPXUtilities::PrintMethodHeader(cn, mn);
+
+	if(numberOfJobs == 0) {
+		return 0;
+	}
+
+	if(numberOfThreads < 1) numberOfThreads = 1;
+	if(numberOfThreads > numberOfJobs) numberOfThreads = numberOfJobs;
+
+	SPXWorkQueueState_t state;
+	state.function = function;
+	state.context = context;
+	state.numberOfJobs = numberOfJobs;
+	state.next = 0;
+	pthread_mutex_init(&state.mutex, NULL);
+
+	std::vector<SPXWorkQueueThread_t> threads(numberOfThreads);
+	for(unsigned int i = 0; i < numberOfThreads; i++) {
+		threads[i].state = &state;
+		threads[i].index = i;
+	}
+
+	//Thread 0 is the calling thread
+	unsigned int numberOfStarted = 1;
+	for(unsigned int i = 1; i < numberOfThreads; i++) {
+		if(pthread_create(&threads[i].thread, NULL, Worker, &threads[i]) != 0) {
+			std::cerr << cn << mn << "WARNING: Unable to create " << name << " thread: Continuing with " << numberOfStarted << " thread(s)" << std::endl;
+			break;
+		}
+		numberOfStarted++;
+	}
+
+	Worker(&threads[0]);
+
+	for(unsigned int i = 1; i < numberOfStarted; i++) {
+		pthread_join(threads[i].thread, NULL);
+	}
+
+	pthread_mutex_destroy(&state.mutex);
+
+	if(debug) std::cout << cn << mn << numberOfJobs << " " << name << " job(s) on " << numberOfStarted << " thread(s)" << std::endl;
+
+	if(!state.error.empty()) {
+		throw SPXGeneralException(cn + mn + "A " + name + " job failed: " + state.error);
+	}
+
+	return numberOfStarted;
+}
@@ -0,0 +1,60 @@
+//************************************************************/
+//
+//	Work Queue Header
+//
+//	Outlines the SPXWorkQueue class, which runs the jobs 0..n-1
+//	of a job function on a few threads, the calling thread
+//	included: each job is taken by exactly one thread, in order
+//	of the job index. Used by the steering file and table
+//	preloads, the PDF member sweep, the parton luminosity
+//	integration and the sub-grid convolution.
+//
+//	The job function gets the index of the thread running it
+//	(0 is the calling thread), so that a job can use objects of
+//	its thread only. An exception leaving a job is kept and the
+//	first one is rethrown as SPXGeneralException by Run, once all
+//	threads have finished: jobs which should not stop the others
+//	record their errors themselves.
+//
+//	@Author: 	Spectrum contributors
+//	@Date:		19.10.2026
+//
+//************************************************************/
+
+#ifndef SPXWORKQUEUE_H
+#define SPXWORKQUEUE_H
+
+#include <iostream>
+#include <string>
+#include <pthread.h>
+
+#include "SPXException.h"
+
+class SPXWorkQueue {
+
+public:
+	typedef void (*Job_t)(void *context, unsigned int job, unsigned int thread);
+
+	//Number of threads Run uses for numberOfJobs jobs: the number of cores, at most maxThreads, at least 1
+	static unsigned int GetNumberOfThreads(unsigned int numberOfJobs, unsigned int maxThreads);
+
+	//Runs all jobs on up to numberOfThreads threads and returns the number of threads used;
+	//name is used in the warnings when a thread can not be created
+	static unsigned int Run(Job_t function, void *context, unsigned int numberOfJobs, unsigned int numberOfThreads,
+	                        const std::string &name);
+
+	static bool GetDebug(void) {
+		return debug;
+	}
+
+	static void SetDebug(bool b) {
+		debug = b;
+	}
+
+private:
+	static bool debug;			// Flag indicating debug mode
+
+	static void * Worker(void *arg);
+};
+
+#endif
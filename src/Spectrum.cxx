@@ -8,12 +8,23 @@
 //
 //************************************************************/
 
+#include <cstdlib>
 #include <iostream>
 
 #include "SPXROOT.h"
+#include "RVersion.h"
+#if ROOT_VERSION_CODE < ROOT_VERSION(6,6,0)
+#include "TThread.h"
+#endif
 #include "SPXAtlasStyle.h"
 #include "SPXSteeringFile.h"
+#include "SPXSteeringBundle.h"
+#include "SPXSteeringSweep.h"
 #include "SPXAnalysis.h"
+#include "SPXArena.h"
+#include "SPXStageTimer.h"
+#include "SPXServer.h"
+#include "SPXWatcher.h"
 #include "SPXException.h"
 
 namespace Test {
@@ -22,12 +33,23 @@ namespace Test {
 
 namespace Options {
 	bool Metadata = false;
+	bool NoDraw = false;
+	bool KeepPlots = false;
+	bool MemReport = false;
+	unsigned int StreamWindow = 0;
+	unsigned int RenderWorkers = 0;
+	std::string TimingFile;
+	std::string DumpDirectory;
 }
 
 int main(int argc, char *argv[]) {
 
 	if((argc - 1) < 1) {
-		std::cout << "@usage: Spectrum [-p] <steering_file>" << std::endl;
+		std::cout << "@usage: Spectrum [-p] [--no-draw] [--stream] [--render-workers <n>] [--mem-report] [--timing <file>] [--dump <dir>] <steering_file>" << std::endl;
+		std::cout << "        Spectrum --serve [--socket <path>]" << std::endl;
+		std::cout << "        Spectrum --watch [--no-draw] <steering_file>" << std::endl;
+		std::cout << "        Spectrum --compile-steering <steering_file>" << std::endl;
+		std::cout << "        Spectrum --sweep [--sweep-jobs <n>] [--no-draw] [--dump <dir>] <steering_file>" << std::endl;
 		exit(0);
 	}
  
@@ -36,6 +58,17 @@ int main(int argc, char *argv[]) {
 	 std::cout << "Spectrum -p DrawApplication " << std::endl;
 	 std::cout << "Spectrum -t Testfeatures " << std::endl;
 	 std::cout << "Spectrum -m write metadata to text file " << std::endl;
+	 std::cout << "Spectrum --no-draw batch mode: convolute and write results, no canvas/graphics " << std::endl;
+	 std::cout << "Spectrum --serve [--socket <path>] keep grids/PDFs in memory and process steering files sent to a Unix socket " << std::endl;
+	 std::cout << "Spectrum --watch <steering_file> re-run only the plots affected when steering/data/grid files change " << std::endl;
+	 std::cout << "Spectrum --stream initialize, draw and release one plot at a time (--stream-window <n>: keep the last n plots) " << std::endl;
+	 std::cout << "Spectrum -p --render-workers <n> draw and write the plots in n parallel worker processes " << std::endl;
+	 std::cout << "Spectrum --mem-report print the peak number and size of ROOT objects of each phase at the end " << std::endl;
+	 std::cout << "Spectrum --timing <file> write the time spent in each stage (parse, load, convolute, ...) to a CSV file " << std::endl;
+	 std::cout << "Spectrum --dump <dir> write all values, bands, members and chi2 of each plot in canonical form to <dir> " << std::endl;
+	 std::cout << "Spectrum --compile-steering <steering_file> parse and validate all steering files into <steering_file>.spxb, used by the next runs while no steering file changes " << std::endl;
+	 std::cout << "Spectrum --sweep <steering_file> run the steering file for all combinations of the PDFs/grids/scales/members of its [SWEEP] section " << std::endl;
+	 std::cout << "Spectrum --sweep --sweep-jobs <n> run at most n sweep points at once (default: number of cores) " << std::endl;
 	 std::cout << "Spectrum -latex_table not yet implemented " << std::endl;
 	 exit(0);
 	}
@@ -44,7 +77,19 @@ int main(int argc, char *argv[]) {
 
 	Test::TestFeatures = false;
 	Options::Metadata = false;
+	Options::NoDraw = false;
+	Options::MemReport = false;
+	Options::StreamWindow = 0;
+	Options::RenderWorkers = 0;
+	Options::TimingFile.clear();
+	Options::DumpDirectory.clear();
 	bool drawApplication = true;
+	bool serve = false;
+	bool watch = false;
+	bool compileSteering = false;
+	bool sweep = false;
+	unsigned int sweepJobs = 0;
+	std::string socketPath = "./spectrum.sock";
 
 	std::cout << "==================================" << std::endl;
 	std::cout << "      	   Spectrum		        " << std::endl;
@@ -68,6 +113,97 @@ int main(int argc, char *argv[]) {
 		else if(!arg.compare("-m")) {
 			Options::Metadata = true;
 		}
+
+		//Batch mode: no TApplication, no canvas/pads, numerical output only
+		else if(!arg.compare("--no-draw")) {
+			Options::NoDraw = true;
+			drawApplication = false;
+		}
+
+		//Server mode: process steering files received on a Unix socket
+		else if(!arg.compare("--serve")) {
+			serve = true;
+			drawApplication = false;
+		}
+
+		//Watch mode: keep running and re-process plots whose input files change
+		else if(!arg.compare("--watch")) {
+			watch = true;
+			drawApplication = false;
+		}
+
+		//Compile mode: write the parsed steering files to a bundle and exit
+		else if(!arg.compare("--compile-steering")) {
+			compileSteering = true;
+			drawApplication = false;
+		}
+
+		//Sweep mode: run all combinations of the [SWEEP] axes of the steering file
+		else if(!arg.compare("--sweep")) {
+			sweep = true;
+			drawApplication = false;
+		}
+
+		else if(!arg.compare("--sweep-jobs")) {
+			if(i + 1 >= argc || atoi(argv[i + 1]) < 1) {
+				std::cerr << "FATAL: --sweep-jobs requires a number of jobs >= 1" << std::endl;
+				exit(-1);
+			}
+			sweepJobs = atoi(argv[++i]);
+		}
+
+		//Memory report: peak number and size of the ROOT objects owned by the plots, per phase
+		else if(!arg.compare("--mem-report")) {
+			Options::MemReport = true;
+		}
+
+		//Streaming: plots are initialized one at a time instead of all before the first is drawn
+		else if(!arg.compare("--stream")) {
+			if(!Options::StreamWindow) Options::StreamWindow = 1;
+		}
+
+		else if(!arg.compare("--stream-window")) {
+			if(i + 1 >= argc || atoi(argv[i + 1]) < 1) {
+				std::cerr << "FATAL: --stream-window requires a number of plots >= 1" << std::endl;
+				exit(-1);
+			}
+			Options::StreamWindow = atoi(argv[++i]);
+		}
+
+		//Render workers: plots are drawn in parallel by forked processes (batch graphics only)
+		else if(!arg.compare("--render-workers")) {
+			if(i + 1 >= argc || atoi(argv[i + 1]) < 1) {
+				std::cerr << "FATAL: --render-workers requires a number of workers >= 1" << std::endl;
+				exit(-1);
+			}
+			Options::RenderWorkers = atoi(argv[++i]);
+		}
+
+		//Stage timing: wall time of parse, load, convolute, bands, matchbinning, chi2, draw and write
+		else if(!arg.compare("--timing")) {
+			if(i + 1 >= argc) {
+				std::cerr << "FATAL: --timing requires a file name" << std::endl;
+				exit(-1);
+			}
+			Options::TimingFile = std::string(argv[++i]);
+		}
+
+		//Results dump: one canonical table (quantity,bin,value) per plot, e.g. for golden output comparisons
+		else if(!arg.compare("--dump")) {
+			if(i + 1 >= argc) {
+				std::cerr << "FATAL: --dump requires a directory" << std::endl;
+				exit(-1);
+			}
+			Options::DumpDirectory = std::string(argv[++i]);
+		}
+
+		else if(!arg.compare("--socket")) {
+			if(i + 1 >= argc) {
+				std::cerr << "FATAL: --socket requires a path" << std::endl;
+				exit(-1);
+			}
+			socketPath = std::string(argv[++i]);
+		}
                 else if(!arg.compare("-latex_table")) {
 		  std::cout<<" option latex_table not yet implemented "<<std::endl;
                   exit (0);
@@ -80,8 +216,109 @@ int main(int argc, char *argv[]) {
 		}
 	}
 
-	//Set Atlas Style (SPXAtlasStyle.h)
-	SetAtlasStyle();
+	//Histograms are owned by the plot arenas (SPXArena), not by gDirectory
+	TH1::AddDirectory(kFALSE);
+
+	//Each plot is released once drawn, unless its canvas stays on screen or --watch may redraw it
+	Options::KeepPlots = drawApplication || watch;
+#ifdef DEVELOP
+	//Global correlation and p-value collect the data of all plots
+	Options::KeepPlots = true;
+	Options::StreamWindow = 0;
+#endif
+
+	//Workers draw in batch mode and exit: canvases kept on screen or redrawn need the main process
+	if(Options::RenderWorkers && (Options::KeepPlots || Options::NoDraw)) {
+		std::cerr << "WARNING: --render-workers is only used with -p (without --no-draw or --watch): plots are drawn in the main process" << std::endl;
+		Options::RenderWorkers = 0;
+	}
+
+	//Sweep points already run in parallel worker processes
+	if(Options::RenderWorkers && sweep) {
+		std::cerr << "WARNING: --render-workers is not used with --sweep: each sweep point draws its plots itself" << std::endl;
+		Options::RenderWorkers = 0;
+	}
+
+	//Raster files are encoded by background threads (SPXOutputManager) while the main thread goes on painting,
+	//and convolutions run on worker threads: ROOT must guard its global state before any thread is started
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,6,0)
+	ROOT::EnableThreadSafety();
+#else
+	TThread::Initialize();
+#endif
+
+	if(!Options::TimingFile.empty()) {
+		SPXStageTimer::Enable();
+	}
+
+	if(!Options::DumpDirectory.empty()) {
+		gSystem->mkdir(Options::DumpDirectory.c_str(), kTRUE);
+	}
+
+	//Set Atlas Style (SPXAtlasStyle.h): not needed when nothing is drawn
+	if(Options::NoDraw) {
+		gROOT->SetBatch(kTRUE);
+	} else {
+		SetAtlasStyle();
+	}
+
+	//=========================================================
+	//   Server
+	//=========================================================
+	if(serve) {
+		gROOT->SetBatch(kTRUE);
+
+		try {
+			SPXServer server = SPXServer(socketPath);
+			server.Run();
+		} catch(const SPXException &e) {
+			std::cerr << e.what() << std::endl;
+			std::cerr << "FATAL: Server stopped" << std::endl;
+			exit(-1);
+		}
+
+		return 0;
+	}
+
+	//=========================================================
+	//   Steering Bundle
+	//=========================================================
+	if(compileSteering) {
+		try {
+			SPXSteeringFile steeringFile = SPXSteeringFile(file);
+			steeringFile.ParseAll(false);
+			SPXSteeringBundle::Write(steeringFile, SPXSteeringBundle::GetFilename(file));
+		} catch(const SPXException &e) {
+			std::cerr << e.what() << std::endl;
+			std::cerr << "FATAL: Could not compile the steering file: " << file << std::endl;
+			exit(-1);
+		}
+
+		return 0;
+	}
+
+	//=========================================================
+	//   Sweep
+	//=========================================================
+	if(sweep) {
+		gROOT->SetBatch(kTRUE);
+
+		unsigned int failures = 0;
+
+		try {
+			SPXSteeringSweep steeringSweep = SPXSteeringSweep(file, sweepJobs);
+			steeringSweep.Parse();
+			steeringSweep.Run();
+			steeringSweep.PrintSummary(std::cout);
+			failures = steeringSweep.GetNumberOfFailures();
+		} catch(const SPXException &e) {
+			std::cerr << e.what() << std::endl;
+			std::cerr << "FATAL: Unable to run the sweep of the steering file: " << file << std::endl;
+			exit(-1);
+		}
+
+		return failures ? 1 : 0;
+	}
 
 	TApplication *spectrum;
 
@@ -96,7 +333,11 @@ int main(int argc, char *argv[]) {
 	//   Configuration
 	//=========================================================
     try {
-    	steeringFile.ParseAll(false);
+    	//The parse stage is the loading only, not the printing of the configuration
+    	{
+    		SPXStageScope stage("parse");
+    		steeringFile.LoadAll(false);
+    	}
 		steeringFile.PrintAll();
     } catch(const SPXException &e) {
     	std::cerr << e.what() << std::endl;
@@ -120,19 +361,44 @@ int main(int argc, char *argv[]) {
     //=========================================================
     //     Analysis
     //=========================================================
+    SPXAnalysis *analysis = 0;
+
     try {
-      SPXAnalysis analysis = SPXAnalysis(&steeringFile);
-      analysis.Run();
+      analysis = new SPXAnalysis(&steeringFile);
+      analysis->Run();
+
+      if(watch) {
+        SPXWatcher watcher = SPXWatcher(&steeringFile, analysis);
+        watcher.Run();
+      }
 
     } catch(const SPXException &e) {
+    	if(analysis) analysis->ReleasePlots();
     	std::cerr << e.what() << std::endl;
     	std::cerr << "FATAL: Unable to perform successful analysis" << std::endl;
     	exit(-1);
     }
 
+	if(Options::MemReport) {
+		SPXArena::PrintReport(std::cout);
+	}
+
+	if(!Options::TimingFile.empty()) {
+		SPXStageTimer::PrintReport(std::cout);
+
+		try {
+			SPXStageTimer::WriteCSV(Options::TimingFile);
+		} catch(const SPXException &e) {
+			std::cerr << e.what() << std::endl;
+			std::cerr << "WARNING: Could not write the stage timing" << std::endl;
+		}
+	}
+
 	if(drawApplication) {
 	 spectrum->Run(kTRUE);
 	}
 
+	delete analysis;
+
 	return 0;
 }